@@ -38,12 +38,16 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "metadata/Checkpoint.h"
 #include "metadata/Metadata.h"
 #include "metadata/SchemaElement.h"
+#include "metadata/SerializerBinary.h"
 #include "metadata/SerializerJson.h"
 #include "parser/TransactionBuffer.h"
 #include "replicator/Replicator.h"
 #include "replicator/ReplicatorBatch.h"
 #include "state/StateDisk.h"
+#include "state/StateJournal.h"
+#include "stream/ShmRing.h"
 #include "writer/WriterFile.h"
+#include "writer/WriterShm.h"
 #include "OpenLogReplicator.h"
 
 #ifdef LINK_LIBRARY_OCI
@@ -248,6 +252,55 @@ namespace OpenLogReplicator {
                                                  ", expected: at least: " + std::to_string(MEMORY_CHUNK_SIZE_MB * 2));
             }
 
+            uint64_t memoryHugePages = MEMORY_HUGE_PAGES_NONE;
+            if (sourceJson.HasMember("memory-huge-pages")) {
+                memoryHugePages = Ctx::getJsonFieldU64(configFileName, sourceJson, "memory-huge-pages");
+                if (memoryHugePages > MEMORY_HUGE_PAGES_1GB)
+                    throw ConfigurationException(30001, "bad JSON, invalid 'memory-huge-pages' value: " + std::to_string(memoryHugePages) +
+                                                 ", expected: one of {0 .. 3}");
+            }
+
+            if (sourceJson.HasMember("numa-node-parser")) {
+                ctx->numaNodeParser = Ctx::getJsonFieldI64(configFileName, sourceJson, "numa-node-parser");
+                if (ctx->numaNodeParser < NUMA_NODE_NONE || ctx->numaNodeParser > NUMA_NODE_MAX)
+                    throw ConfigurationException(30001, "bad JSON, invalid 'numa-node-parser' value: " + std::to_string(ctx->numaNodeParser) +
+                                                 ", expected: one of {-1 .. " + std::to_string(NUMA_NODE_MAX) + "}");
+            }
+
+            if (sourceJson.HasMember("numa-node-reader")) {
+                ctx->numaNodeReader = Ctx::getJsonFieldI64(configFileName, sourceJson, "numa-node-reader");
+                if (ctx->numaNodeReader < NUMA_NODE_NONE || ctx->numaNodeReader > NUMA_NODE_MAX)
+                    throw ConfigurationException(30001, "bad JSON, invalid 'numa-node-reader' value: " + std::to_string(ctx->numaNodeReader) +
+                                                 ", expected: one of {-1 .. " + std::to_string(NUMA_NODE_MAX) + "}");
+            }
+
+            if (sourceJson.HasMember("numa-node-writer")) {
+                ctx->numaNodeWriter = Ctx::getJsonFieldI64(configFileName, sourceJson, "numa-node-writer");
+                if (ctx->numaNodeWriter < NUMA_NODE_NONE || ctx->numaNodeWriter > NUMA_NODE_MAX)
+                    throw ConfigurationException(30001, "bad JSON, invalid 'numa-node-writer' value: " + std::to_string(ctx->numaNodeWriter) +
+                                                 ", expected: one of {-1 .. " + std::to_string(NUMA_NODE_MAX) + "}");
+            }
+
+            for (uint64_t role = 0; role < THREAD_ROLES; ++role) {
+                std::string cpusField("cpus-" + std::string(Ctx::threadRoles[role]));
+                if (sourceJson.HasMember(cpusField.c_str())) {
+                    ctx->threadCpus[role] = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, sourceJson, cpusField.c_str());
+                    cpu_set_t cpuSet;
+                    if (!Ctx::parseCpuList(ctx->threadCpus[role], cpuSet))
+                        throw ConfigurationException(30001, "bad JSON, invalid '" + cpusField + "' value: " + ctx->threadCpus[role] +
+                                                     ", expected: list of CPUs like: 0-3,8");
+                }
+
+                std::string priorityField("priority-" + std::string(Ctx::threadRoles[role]));
+                if (sourceJson.HasMember(priorityField.c_str())) {
+                    ctx->threadPriority[role] = Ctx::getJsonFieldI64(configFileName, sourceJson, priorityField.c_str());
+                    if (ctx->threadPriority[role] < THREAD_PRIORITY_NONE || ctx->threadPriority[role] > THREAD_PRIORITY_MAX)
+                        throw ConfigurationException(30001, "bad JSON, invalid '" + priorityField + "' value: " +
+                                                     std::to_string(ctx->threadPriority[role]) + ", expected: one of {0 .. " +
+                                                     std::to_string(THREAD_PRIORITY_MAX) + "}");
+                }
+            }
+
             const char* name = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, sourceJson, "name");
             const rapidjson::Value& readerJson = Ctx::getJsonFieldO(configFileName, sourceJson, "reader");
 
@@ -296,6 +349,7 @@ namespace OpenLogReplicator {
 
             uint64_t stateType = STATE_TYPE_DISK;
             const char* statePath = "checkpoint";
+            uint64_t stateFormat = STATE_FORMAT_JSON;
 
             if (sourceJson.HasMember("state")) {
                 const rapidjson::Value& stateJson = Ctx::getJsonFieldO(configFileName, sourceJson, "state");
@@ -306,9 +360,24 @@ namespace OpenLogReplicator {
                         stateType = STATE_TYPE_DISK;
                         if (stateJson.HasMember("path"))
                             statePath = Ctx::getJsonFieldS(configFileName, MAX_PATH_LENGTH, stateJson, "path");
+                    } else if (strcmp(stateTypeStr, "journal") == 0) {
+                        stateType = STATE_TYPE_JOURNAL;
+                        if (stateJson.HasMember("path"))
+                            statePath = Ctx::getJsonFieldS(configFileName, MAX_PATH_LENGTH, stateJson, "path");
                     } else
                         throw ConfigurationException(30001, std::string("bad JSON, invalid 'type' value: ") + stateTypeStr +
-                                                     ", expected: one of {'disk'}");
+                                                     ", expected: one of {'disk', 'journal'}");
+                }
+
+                if (stateJson.HasMember("format")) {
+                    const char* stateFormatStr = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, stateJson, "format");
+                    if (strcmp(stateFormatStr, "json") == 0)
+                        stateFormat = STATE_FORMAT_JSON;
+                    else if (strcmp(stateFormatStr, "binary") == 0)
+                        stateFormat = STATE_FORMAT_BINARY;
+                    else
+                        throw ConfigurationException(30001, std::string("bad JSON, invalid 'format' value: ") + stateFormatStr +
+                                                     ", expected: one of {'json', 'binary'}");
                 }
 
                 if (stateJson.HasMember("interval-s"))
@@ -320,6 +389,13 @@ namespace OpenLogReplicator {
                 if (stateJson.HasMember("keep-checkpoints"))
                     ctx->checkpointKeep = Ctx::getJsonFieldU64(configFileName, stateJson, "keep-checkpoints");
 
+                if (stateJson.HasMember("schema-delta")) {
+                    ctx->schemaDelta = Ctx::getJsonFieldU64(configFileName, stateJson, "schema-delta");
+                    if (ctx->schemaDelta > 1)
+                        throw ConfigurationException(30001, "bad JSON, invalid 'schema-delta' value: " + std::to_string(ctx->schemaDelta) +
+                                                     ", expected: one of {0, 1}");
+                }
+
                 if (stateJson.HasMember("schema-force-interval"))
                     ctx->schemaForceInterval = Ctx::getJsonFieldU64(configFileName, stateJson, "schema-force-interval");
             }
@@ -366,8 +442,37 @@ namespace OpenLogReplicator {
                 ctx->transactionSizeMax = transactionMaxMb * 1024 * 1024;
             }
 
+            if (sourceJson.HasMember("memory-quota")) {
+                const rapidjson::Value& memoryQuotaJson = Ctx::getJsonFieldO(configFileName, sourceJson, "memory-quota");
+
+                for (uint64_t module = 0; module < MEMORY_MODULES_NUM; ++module) {
+                    std::string hardName(std::string(Ctx::memoryModules[module]) + "-hard-mb");
+                    if (memoryQuotaJson.HasMember(hardName.c_str())) {
+                        uint64_t hardMb = Ctx::getJsonFieldU64(configFileName, memoryQuotaJson, hardName.c_str());
+                        if (hardMb < MEMORY_CHUNK_SIZE_MB * 2 || hardMb > memoryMaxMb)
+                            throw ConfigurationException(30001, "bad JSON, invalid '" + hardName + "' value: " + std::to_string(hardMb) +
+                                                         ", expected: one of {" + std::to_string(MEMORY_CHUNK_SIZE_MB * 2) + " .. " +
+                                                         std::to_string(memoryMaxMb) + "}");
+                        ctx->memoryModulesHard[module] = hardMb / MEMORY_CHUNK_SIZE_MB;
+                    }
+                }
+
+                // Only the builder releases memory independently of the parser
+                if (memoryQuotaJson.HasMember("builder-soft-mb")) {
+                    uint64_t softMb = Ctx::getJsonFieldU64(configFileName, memoryQuotaJson, "builder-soft-mb");
+                    uint64_t softMaxMb = memoryMaxMb;
+                    if (ctx->memoryModulesHard[MEMORY_MODULE_BUILDER] != 0)
+                        softMaxMb = ctx->memoryModulesHard[MEMORY_MODULE_BUILDER] * MEMORY_CHUNK_SIZE_MB;
+                    if (softMb < MEMORY_CHUNK_SIZE_MB || softMb > softMaxMb)
+                        throw ConfigurationException(30001, "bad JSON, invalid 'builder-soft-mb' value: " + std::to_string(softMb) +
+                                                     ", expected: one of {" + std::to_string(MEMORY_CHUNK_SIZE_MB) + " .. " +
+                                                     std::to_string(softMaxMb) + "}");
+                    ctx->memoryModulesSoft[MEMORY_MODULE_BUILDER] = softMb / MEMORY_CHUNK_SIZE_MB;
+                }
+            }
+
             // MEMORY MANAGER
-            ctx->initialize(memoryMinMb, memoryMaxMb, readBufferMax);
+            ctx->initialize(memoryMinMb, memoryMaxMb, readBufferMax, memoryHugePages);
 
             // METADATA
             Metadata* metadata = new Metadata(ctx, locales, name, conId, startScn,
@@ -383,10 +488,17 @@ namespace OpenLogReplicator {
                 metadata->addElement(".*", ".*", 0);
 
             if (stateType == STATE_TYPE_DISK) {
-                metadata->state = new StateDisk(ctx, statePath);
-                metadata->stateDisk = new StateDisk(ctx, "scripts");
-                metadata->serializer = new SerializerJson();
+                metadata->state = new StateDisk(ctx, statePath, stateFormat);
+            } else if (stateType == STATE_TYPE_JOURNAL) {
+                auto stateJournal = new StateJournal(ctx, statePath);
+                metadata->state = stateJournal;
+                stateJournal->initialize();
             }
+            metadata->stateDisk = new StateDisk(ctx, "scripts", STATE_FORMAT_JSON);
+            if (stateFormat == STATE_FORMAT_BINARY)
+                metadata->serializer = new SerializerBinary();
+            else
+                metadata->serializer = new SerializerJson();
 
             // CHECKPOINT
             auto checkpoint = new Checkpoint(ctx, metadata, std::string(alias) + "-checkpoint", configFileName,
@@ -706,6 +818,13 @@ namespace OpenLogReplicator {
                     }
                 }
 
+                if (filterJson.HasMember("lazy-tables")) {
+                    ctx->lazyTables = Ctx::getJsonFieldU64(configFileName, filterJson, "lazy-tables");
+                    if (ctx->lazyTables > 1)
+                        throw ConfigurationException(30001, "bad JSON, invalid 'lazy-tables' value: " + std::to_string(ctx->lazyTables) +
+                                                     ", expected: one of {0, 1}");
+                }
+
                 if (filterJson.HasMember("skip-xid")) {
                     const rapidjson::Value& skipXidArrayJson = Ctx::getJsonFieldA(configFileName, filterJson, "skip-xid");
                     for (rapidjson::SizeType k = 0; k < skipXidArrayJson.Size(); ++k) {
@@ -739,9 +858,9 @@ namespace OpenLogReplicator {
 
         // Iterate through targets
         const rapidjson::Value& targetArrayJson = Ctx::getJsonFieldA(configFileName, document, "target");
-        if (targetArrayJson.Size() != 1) {
+        if (targetArrayJson.Size() < 1) {
             throw ConfigurationException(30001, "bad JSON, invalid 'target' value: " + std::to_string(targetArrayJson.Size()) +
-                                         " elements, expected: 1 element");
+                                         " elements, expected: at least 1 element");
         }
 
         for (rapidjson::SizeType j = 0; j < targetArrayJson.Size(); ++j) {
@@ -750,6 +869,11 @@ namespace OpenLogReplicator {
             const char* source = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, targetJson, "source");
 
             ctx->info(0, "adding target: " + std::string(alias));
+            // Alias is a part of the checkpoint name
+            for (Writer* writerTmp : writers)
+                if (writerTmp->alias == std::string(alias) + "-writer")
+                    throw ConfigurationException(30001, "bad JSON, invalid 'alias' value: " + std::string(alias) +
+                                                 ", expected: value not used by other targets");
             Replicator* replicator2 = nullptr;
             for (Replicator* replicatorTmp : replicators)
                 if (replicatorTmp->alias == source)
@@ -809,9 +933,25 @@ namespace OpenLogReplicator {
                                                      ", expected: one of {0, 1}");
                 }
 
+                uint64_t writeBufferFlushSize = 0;
+                if (writerJson.HasMember("write-buffer-flush-size")) {
+                    writeBufferFlushSize = Ctx::getJsonFieldU64(configFileName, writerJson, "write-buffer-flush-size");
+                    if (writeBufferFlushSize > 1073741824)
+                        throw ConfigurationException(30001, "bad JSON, invalid 'write-buffer-flush-size' value: " +
+                                                     std::to_string(writeBufferFlushSize) + ", expected: one of {0 .. 1073741824}");
+                }
+
+                uint64_t writeSync = 0;
+                if (writerJson.HasMember("write-sync")) {
+                    writeSync = Ctx::getJsonFieldU64(configFileName, writerJson, "write-sync");
+                    if (writeSync > 1)
+                        throw ConfigurationException(30001, "bad JSON, invalid 'write-sync' value: " + std::to_string(writeSync) +
+                                                     ", expected: one of {0, 1}");
+                }
+
                 writer = new WriterFile(ctx, std::string(alias) + "-writer", replicator2->database,
                                         replicator2->builder, replicator2->metadata, output, timestampFormat,
-                                        maxFileSize, newLine, append);
+                                        maxFileSize, newLine, append, writeBufferFlushSize, writeSync);
             } else if (strcmp(writerType, "kafka") == 0) {
 #ifdef LINK_LIBRARY_RDKAFKA
                 uint64_t maxMessageMb = 100;
@@ -825,8 +965,44 @@ namespace OpenLogReplicator {
 
                 const char* topic = Ctx::getJsonFieldS(configFileName, JSON_TOPIC_LENGTH, writerJson, "topic");
 
+                uint64_t keyType = KAFKA_KEY_NONE;
+                if (writerJson.HasMember("key")) {
+                    keyType = Ctx::getJsonFieldU64(configFileName, writerJson, "key");
+                    if (keyType > KAFKA_KEY_PRIMARY_KEY)
+                        throw ConfigurationException(30001, "bad JSON, invalid 'key' value: " + std::to_string(keyType) +
+                                                     ", expected: one of {0, 1}");
+                }
+                if (keyType == KAFKA_KEY_PRIMARY_KEY)
+                    replicator2->builder->setTagFormat(OUTPUT_TAG_TABLE | OUTPUT_TAG_KEY);
+
+                uint64_t batchSize = KAFKA_BATCH_SIZE_DEFAULT;
+                if (writerJson.HasMember("batch-size")) {
+                    batchSize = Ctx::getJsonFieldU64(configFileName, writerJson, "batch-size");
+                    if (batchSize < 1 || batchSize > KAFKA_BATCH_SIZE_MAX)
+                        throw ConfigurationException(30001, "bad JSON, invalid 'batch-size' value: " + std::to_string(batchSize) +
+                                                     ", expected: one of {1 .. " + std::to_string(KAFKA_BATCH_SIZE_MAX) + "}");
+                }
+
                 writer = new WriterKafka(ctx, std::string(alias) + "-writer", replicator2->database,
-                                                 replicator2->builder, replicator2->metadata, topic);
+                                                 replicator2->builder, replicator2->metadata, topic, keyType, batchSize);
+
+                if (writerJson.HasMember("topics")) {
+                    const rapidjson::Value& topicsArrayJson = Ctx::getJsonFieldA(configFileName, writerJson, "topics");
+
+                    for (rapidjson::SizeType k = 0; k < topicsArrayJson.Size(); ++k) {
+                        const rapidjson::Value& topicElementJson = Ctx::getJsonFieldO(configFileName, topicsArrayJson, "topics", k);
+
+                        const char* owner = "";
+                        if (topicElementJson.HasMember("owner"))
+                            owner = Ctx::getJsonFieldS(configFileName, SYS_USER_NAME_LENGTH, topicElementJson, "owner");
+                        const char* table = "";
+                        if (topicElementJson.HasMember("table"))
+                            table = Ctx::getJsonFieldS(configFileName, SYS_OBJ_NAME_LENGTH, topicElementJson, "table");
+                        const char* routeTopic = Ctx::getJsonFieldS(configFileName, JSON_TOPIC_LENGTH, topicElementJson, "topic");
+                        reinterpret_cast<WriterKafka*>(writer)->addTopicRoute(owner, table, routeTopic);
+                    }
+                    replicator2->builder->setTagFormat(OUTPUT_TAG_TABLE);
+                }
 
                 if (writerJson.HasMember("properties")) {
                     const rapidjson::Value& propertiesJson = Ctx::getJsonFieldO(configFileName, writerJson, "properties");
@@ -864,11 +1040,39 @@ namespace OpenLogReplicator {
                 throw ConfigurationException(30001, "bad JSON, invalid 'type' value: " + std::string(writerType) +
                                              ", expected: not 'network' since the code is not compiled");
 #endif /* LINK_LIBRARY_PROTOBUF */
+            } else if (strcmp(writerType, "shm") == 0) {
+                const char* name = Ctx::getJsonFieldS(configFileName, JSON_PARAMETER_LENGTH, writerJson, "name");
+                if (name[0] != '/')
+                    throw ConfigurationException(30001, "bad JSON, invalid 'name' value: " + std::string(name) +
+                                                 ", expected: name starting with '/'");
+
+                uint64_t sizeMb = SHM_SIZE_MB_DEFAULT;
+                if (writerJson.HasMember("size-mb")) {
+                    sizeMb = Ctx::getJsonFieldU64(configFileName, writerJson, "size-mb");
+                    if (sizeMb < 1 || sizeMb > SHM_SIZE_MB_MAX)
+                        throw ConfigurationException(30001, "bad JSON, invalid 'size-mb' value: " + std::to_string(sizeMb) +
+                                                     ", expected: one of {1 .. " + std::to_string(SHM_SIZE_MB_MAX) + "}");
+                }
+
+                uint64_t dropWithoutConsumer = 0;
+                if (writerJson.HasMember("drop-without-consumer")) {
+                    dropWithoutConsumer = Ctx::getJsonFieldU64(configFileName, writerJson, "drop-without-consumer");
+                    if (dropWithoutConsumer > 1)
+                        throw ConfigurationException(30001, "bad JSON, invalid 'drop-without-consumer' value: " + std::to_string(dropWithoutConsumer) +
+                                                     ", expected: one of {0, 1}");
+                }
+
+                writer = new WriterShm(ctx, std::string(alias) + "-writer", replicator2->database,
+                                       replicator2->builder, replicator2->metadata, name, sizeMb, dropWithoutConsumer == 1);
             } else
                 throw ConfigurationException(30001, "bad JSON, invalid 'type' value: " + std::string(writerType) +
-                                             ", expected: one of {'file', 'kafka', 'zeromq', 'network'}");
+                                             ", expected: one of {'file', 'kafka', 'zeromq', 'network', 'shm'}");
 
             writers.push_back(writer);
+        }
+
+        // Start writers when all are known - replication starts from the oldest checkpoint of the writers of a source
+        for (Writer* writer : writers) {
             writer->initialize();
             ctx->spawnThread(writer);
         }
@@ -0,0 +1,78 @@
+/* Test client for shared memory writer
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include "common/Ctx.h"
+#include "common/RuntimeException.h"
+#include "common/types.h"
+#include "stream/ShmConsumer.h"
+
+// Confirm after so many messages or when no more messages are available
+#define CLIENT_CONFIRM_MESSAGES 1000
+#define CLIENT_WAIT_US 1000000
+
+int main(int argc, char** argv) {
+    OpenLogReplicator::Ctx ctx;
+    ctx.welcome("OpenLogReplicator v." + std::to_string(OpenLogReplicator_VERSION_MAJOR) + "." +
+                std::to_string(OpenLogReplicator_VERSION_MINOR) + "." + std::to_string(OpenLogReplicator_VERSION_PATCH) +
+                " ShmClient (C) 2018-2023 by Adam Leszczynski (aleszczynski@bersler.com), see LICENSE file for licensing information");
+
+    // Run arguments:
+    // 1. name - shared memory segment name, the same as 'name' parameter of the writer
+    if (argc != 2) {
+        ctx.info(0, "use: ShmClient <name>");
+        return 0;
+    }
+
+    try {
+        OpenLogReplicator::ShmConsumer consumer(argv[1]);
+        consumer.attach();
+        ctx.info(0, "attached to: " + std::string(argv[1]));
+
+        uint64_t num = 0;
+        for (;;) {
+            const uint8_t* msg;
+            uint64_t length;
+            typeScn scn;
+            typeIdx idx;
+
+            if (!consumer.receive(msg, length, scn, idx, 0)) {
+                if (num > 0) {
+                    consumer.confirm();
+                    num = 0;
+                }
+                if (!consumer.receive(msg, length, scn, idx, CLIENT_WAIT_US))
+                    continue;
+            }
+
+            ctx.info(0, "- scn: " + std::to_string(scn) + ", idx: " + std::to_string(idx) + ", length: " + std::to_string(length) +
+                        ", message: " + std::string(reinterpret_cast<const char*>(msg), length));
+
+            if (++num >= CLIENT_CONFIRM_MESSAGES) {
+                consumer.confirm();
+                num = 0;
+            }
+        }
+    } catch (OpenLogReplicator::RuntimeException& ex) {
+        ctx.error(ex.code, "error: " + ex.msg);
+    } catch (std::bad_alloc& ex) {
+        ctx.error(0, "memory allocation failed: " + std::string(ex.what()));
+    }
+
+    return 0;
+}
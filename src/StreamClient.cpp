@@ -34,6 +34,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #endif /* LINK_LIBRARY_ZEROMQ */
 
 #define MAX_CLIENT_MESSAGE_SIZE (2*1024*1024*1024ul - 1)
+#define CLIENT_WINDOW (16*1024*1024ul)
 
 void send(OpenLogReplicator::pb::RedoRequest& request, OpenLogReplicator::Stream* stream, OpenLogReplicator::Ctx* ctx __attribute__((unused))) {
     std::string buffer;
@@ -122,18 +123,28 @@ int main(int argc, char** argv) {
         else
             throw OpenLogReplicator::RuntimeException(1, "incorrect format, expected: [protobuf|json]");
 
+        // Servers supporting the credit window return it, older servers ignore the field
         request.set_code(OpenLogReplicator::pb::RequestCode::INFO);
         request.set_database_name(argv[3]);
+        request.set_window(CLIENT_WINDOW);
         ctx.info(0, "database: " + request.database_name());
         send(request, stream, &ctx);
         receive(response, stream, &ctx, buffer, true);
         ctx.info(0, "- code: " + std::to_string(static_cast<uint64_t>(response.code())) + ", scn: " + std::to_string(response.scn()) +
                  ", confirmed: " + std::to_string(response.c_scn()) + "," + std::to_string(response.c_idx()));
 
+        uint64_t window = 0;
+        if (response.has_window()) {
+            window = response.window();
+            ctx.info(0, "- window: " + std::to_string(window));
+        }
+
         typeScn confirmedScn = 0;
         typeIdx confirmedIdx = 0;
         request.Clear();
         request.set_database_name(argv[3]);
+        if (window > 0)
+            request.set_window(window);
 
         if (response.code() == OpenLogReplicator::pb::ResponseCode::REPLICATE) {
             request.set_code(OpenLogReplicator::pb::RequestCode::CONTINUE);
@@ -183,6 +194,7 @@ int main(int argc, char** argv) {
 
         // Index to count messages, to confirm after 1000th
         uint64_t num = 0;
+        uint64_t bytes = 0;
         time_t last = OpenLogReplicator::Timer::getTime();
 
         send(request, stream, &ctx);
@@ -255,11 +267,13 @@ int main(int argc, char** argv) {
             }
 
             ++num;
+            bytes += length;
             time_t now = OpenLogReplicator::Timer::getTime();
             double timeDelta = (double)(now - last) / 1000000.0;
 
-            // Confirm every 1000 messages or every 10 seconds
-            if (num > 1000 || timeDelta > 10) {
+            // Confirm every 1000 messages or every 10 seconds, with the credit window confirm when half of it is used, the server stops
+            // sending when the whole window is not confirmed
+            if ((window == 0 && num > 1000) || (window > 0 && bytes >= window / 2) || timeDelta > 10) {
                 request.Clear();
                 request.set_code(OpenLogReplicator::pb::RequestCode::CONFIRM);
                 request.set_c_scn(cScn);
@@ -269,6 +283,7 @@ int main(int argc, char** argv) {
                          ", database: " + request.database_name());
                 send(request, stream, &ctx);
                 num = 0;
+                bytes = 0;
                 last = now;
             }
         }
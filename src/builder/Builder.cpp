@@ -20,9 +20,11 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "../common/OracleColumn.h"
 #include "../common/OracleTable.h"
 #include "../common/RedoLogRecord.h"
+#include "../common/RuntimeException.h"
 #include "../common/SysCol.h"
 #include "../metadata/Metadata.h"
 #include "../metadata/Schema.h"
+#include "../writer/Writer.h"
 #include "Builder.h"
 #include "SystemTransaction.h"
 
@@ -62,6 +64,8 @@ namespace OpenLogReplicator {
             valueBufferLength(0),
             valueBufferOld(nullptr),
             valueLengthOld(0),
+            lobStreamColumn(nullptr),
+            lobStreaming(false),
             commitScn(ZERO_SCN),
             lastXid(typeXid()),
             valuesMax(0),
@@ -69,10 +73,12 @@ namespace OpenLogReplicator {
             id(0),
             num(0),
             maxMessageMb(0),
+            tagFormat(0),
             newTran(false),
             compressedBefore(false),
             compressedAfter(false),
             prevCharsSize(0),
+            writerWorkSeq(0),
             systemTransaction(nullptr),
             buffersAllocated(0),
             firstBuilderQueue(nullptr),
@@ -91,7 +97,7 @@ namespace OpenLogReplicator {
 
         while (firstBuilderQueue != nullptr) {
             BuilderQueue* nextBuffer = firstBuilderQueue->next;
-            ctx->freeMemoryChunk("builder", reinterpret_cast<uint8_t*>(firstBuilderQueue), true);
+            ctx->freeMemoryChunk(MEMORY_MODULE_BUILDER, reinterpret_cast<uint8_t*>(firstBuilderQueue), true);
             firstBuilderQueue = nextBuffer;
             --buffersAllocated;
         }
@@ -114,7 +120,7 @@ namespace OpenLogReplicator {
 
     void Builder::initialize() {
         buffersAllocated = 1;
-        firstBuilderQueue = reinterpret_cast<BuilderQueue*>(ctx->getMemoryChunk("builder", true));
+        firstBuilderQueue = reinterpret_cast<BuilderQueue*>(ctx->getMemoryChunk(MEMORY_MODULE_BUILDER, true));
         firstBuilderQueue->id = 0;
         firstBuilderQueue->next = nullptr;
         firstBuilderQueue->data = reinterpret_cast<uint8_t*>(firstBuilderQueue) + sizeof(struct BuilderQueue);
@@ -126,6 +132,42 @@ namespace OpenLogReplicator {
         valueBufferLength = VALUE_BUFFER_MIN;
     }
 
+    bool Builder::lobStreamEnd(const std::string& columnName, bool lobValid, bool isClob, uint64_t offset) {
+        lobStreamColumn = nullptr;
+        if (!lobStreaming)
+            return false;
+
+        // Part of the value is already in the output, the rest has to follow
+        if (valueLength > 0)
+            columnStreamAppend(reinterpret_cast<const uint8_t*>(valueBuffer), valueLength, isClob);
+        columnStreamEnd();
+        lobStreaming = false;
+        valueBufferPurge();
+
+        if (!lobValid)
+            ctx->warning(60040, "incomplete LOB value for xid: " + lastXid.toString() + ", column: " + columnName + ", offset: " +
+                         std::to_string(offset));
+        return true;
+    }
+
+    const Builder::ColumnDecoder Builder::columnDecoders[BUILDER_DECODERS] = {
+            &Builder::decodeColumnSkip,
+            &Builder::decodeColumnRaw,
+            &Builder::decodeColumnString,
+            &Builder::decodeColumnNumber,
+            &Builder::decodeColumnBlob,
+            &Builder::decodeColumnClob,
+            &Builder::decodeColumnDate,
+            &Builder::decodeColumnRaw,
+            &Builder::decodeColumnFloat,
+            &Builder::decodeColumnDouble,
+            &Builder::decodeColumnTimestampTz,
+            &Builder::decodeColumnIntervalYtm,
+            &Builder::decodeColumnIntervalDts,
+            &Builder::decodeColumnUrowid,
+            &Builder::decodeColumnUnknown
+    };
+
     void Builder::processValue(LobCtx* lobCtx, OracleTable* table, typeCol col, const uint8_t* data, uint64_t length, uint64_t offset, bool after,
                                bool compressed) {
         if (compressed) {
@@ -138,455 +180,582 @@ namespace OpenLogReplicator {
             columnRaw(columnName, data, length);
             return;
         }
-        OracleColumn* column = table->columns[col];
-        if (FLAG(REDO_FLAGS_RAW_COLUMN_DATA)) {
-            columnRaw(column->name, data, length);
-            return;
-        }
-        if (column->guard && !FLAG(REDO_FLAGS_SHOW_GUARD_COLUMNS))
-            return;
-        if (column->nested && !FLAG(REDO_FLAGS_SHOW_NESTED_COLUMNS))
-            return;
-        if (column->hidden && !FLAG(REDO_FLAGS_SHOW_HIDDEN_COLUMNS))
-            return;
-        if (column->unused && !FLAG(REDO_FLAGS_SHOW_UNUSED_COLUMNS))
-            return;
+        if (table->decoders.size() != table->columns.size())
+            prepareDecoders(table);
 
-        if (length == 0)
+        const OracleColumnDecoder& decoder = table->decoders[col];
+        OracleColumn* column = table->columns[col];
+        if (length == 0 && decoder.decoder > BUILDER_DECODER_RAW_DATA)
             throw RedoLogException(50013, "trying to output null data for column: " + column->name + ", offset: " +
                                    std::to_string(offset));
 
-        if (column->storedAsLob) {
-            // VARCHAR2 stored as CLOB
-            if (column->type == SYS_COL_TYPE_VARCHAR)
-                column->type = SYS_COL_TYPE_CLOB;
-            // RAW stored as BLOB
-            else if (column->type == SYS_COL_TYPE_RAW)
-                column->type = SYS_COL_TYPE_BLOB;
-        }
+        (this->*columnDecoders[decoder.decoder])(lobCtx, table, column, decoder.characterSet, data, length, offset, after);
+    }
 
-        switch (column->type) {
-            case SYS_COL_TYPE_VARCHAR:
-            case SYS_COL_TYPE_CHAR:
-                parseString(data, length, column->charsetId, offset, false, false, false, table->systemTable > 0);
-                columnString(column->name);
-                break;
-
-            case SYS_COL_TYPE_NUMBER:
-                parseNumber(data, length, offset);
-                columnNumber(column->name, column->precision, column->scale);
-                break;
-
-            case SYS_COL_TYPE_BLOB:
-                if (after && table != nullptr) {
-                    if (parseLob(lobCtx, data, length, 0, table->obj, offset, false, table->sys)) {
-                        if (column->xmlType && FLAG(REDO_FLAGS_EXPERIMENTAL_XMLTYPE)) {
-                            if (parseXml(reinterpret_cast<uint8_t *>(valueBuffer), valueLength, offset))
-                                columnString(column->name);
-                            else
-                                columnUnknown(column->name, reinterpret_cast<uint8_t *>(valueBufferOld), valueLengthOld);
-                        } else
-                            columnRaw(column->name, reinterpret_cast<uint8_t *>(valueBuffer), valueLength);
+    // Flags of the columns which are not present in the output
+    uint8_t Builder::hiddenColumnFlags() const {
+        uint8_t flags = 0;
+        if (!FLAG(REDO_FLAGS_SHOW_GUARD_COLUMNS))
+            flags |= TABLE_COLUMN_GUARD;
+        if (!FLAG(REDO_FLAGS_SHOW_NESTED_COLUMNS))
+            flags |= TABLE_COLUMN_NESTED;
+        if (!FLAG(REDO_FLAGS_SHOW_HIDDEN_COLUMNS))
+            flags |= TABLE_COLUMN_HIDDEN;
+        if (!FLAG(REDO_FLAGS_SHOW_UNUSED_COLUMNS))
+            flags |= TABLE_COLUMN_UNUSED;
+        return flags;
+    }
+
+    // The way of decoding every column depends only on the table definition and the output format, so it is chosen once for the table.
+    // Decoders are dropped together with the table when the schema changes.
+    void Builder::prepareDecoders(OracleTable* table) {
+        table->decoders.clear();
+        table->decoders.reserve(table->columns.size());
+
+        uint8_t hiddenFlags = hiddenColumnFlags();
+        for (uint64_t i = 0; i < table->columns.size(); ++i) {
+            OracleColumn* column = table->columns[i];
+            OracleColumnDecoder decoder = {BUILDER_DECODER_SKIP, nullptr};
+
+            if (FLAG(REDO_FLAGS_RAW_COLUMN_DATA))
+                decoder.decoder = BUILDER_DECODER_RAW_DATA;
+            else if ((table->columnFlags[i] & hiddenFlags) != 0)
+                decoder.decoder = BUILDER_DECODER_SKIP;
+            else {
+                if (column->storedAsLob) {
+                    // VARCHAR2 stored as CLOB
+                    if (column->type == SYS_COL_TYPE_VARCHAR)
+                        column->type = SYS_COL_TYPE_CLOB;
+                    // RAW stored as BLOB
+                    else if (column->type == SYS_COL_TYPE_RAW)
+                        column->type = SYS_COL_TYPE_BLOB;
+                    table->columnTypes[i] = static_cast<uint16_t>(column->type);
+                }
+
+                switch (column->type) {
+                    case SYS_COL_TYPE_VARCHAR:
+                    case SYS_COL_TYPE_CHAR: {
+                        decoder.decoder = BUILDER_DECODER_STRING;
+                        auto characterMapIt = locales->characterMap.find(column->charsetId);
+                        if (characterMapIt != locales->characterMap.end())
+                            decoder.characterSet = characterMapIt->second;
+                        break;
                     }
+
+                    case SYS_COL_TYPE_NUMBER:
+                        decoder.decoder = BUILDER_DECODER_NUMBER;
+                        break;
+
+                    case SYS_COL_TYPE_BLOB:
+                        decoder.decoder = BUILDER_DECODER_BLOB;
+                        break;
+
+                    case SYS_COL_TYPE_CLOB:
+                        decoder.decoder = BUILDER_DECODER_CLOB;
+                        break;
+
+                    case SYS_COL_TYPE_DATE:
+                    case SYS_COL_TYPE_TIMESTAMP:
+                    case SYS_COL_TYPE_TIMESTAMP_WITH_LOCAL_TZ:
+                        decoder.decoder = BUILDER_DECODER_DATE;
+                        break;
+
+                    case SYS_COL_TYPE_RAW:
+                        decoder.decoder = BUILDER_DECODER_RAW;
+                        break;
+
+                    case SYS_COL_TYPE_FLOAT:
+                        decoder.decoder = BUILDER_DECODER_FLOAT;
+                        break;
+
+                    case SYS_COL_TYPE_DOUBLE:
+                        decoder.decoder = BUILDER_DECODER_DOUBLE;
+                        break;
+
+                    case SYS_COL_TYPE_TIMESTAMP_WITH_TZ:
+                        decoder.decoder = BUILDER_DECODER_TIMESTAMP_TZ;
+                        break;
+
+                    case SYS_COL_TYPE_INTERVAL_YEAR_TO_MONTH:
+                        decoder.decoder = BUILDER_DECODER_INTERVAL_YTM;
+                        break;
+
+                    case SYS_COL_TYPE_INTERVAL_DAY_TO_SECOND:
+                        decoder.decoder = BUILDER_DECODER_INTERVAL_DTS;
+                        break;
+
+                    case SYS_COL_TYPE_UROWID:
+                        decoder.decoder = BUILDER_DECODER_UROWID;
+                        break;
+
+                    default:
+                        if (unknownType == UNKNOWN_TYPE_SHOW)
+                            decoder.decoder = BUILDER_DECODER_UNKNOWN;
                 }
-                break;
+            }
+
+            table->decoders.push_back(decoder);
+        }
+    }
+
+    void Builder::decodeColumnSkip(LobCtx* lobCtx __attribute__((unused)), OracleTable* table __attribute__((unused)),
+                                   OracleColumn* column __attribute__((unused)), CharacterSet* characterSet __attribute__((unused)),
+                                   const uint8_t* data __attribute__((unused)), uint64_t length __attribute__((unused)),
+                                   uint64_t offset __attribute__((unused)), bool after __attribute__((unused))) {
+    }
 
-            case SYS_COL_TYPE_CLOB:
-                if (after && table != nullptr) {
-                    if (parseLob(lobCtx, data, length, column->charsetId, table->obj, offset, true, table->systemTable > 0))
+    void Builder::decodeColumnString(LobCtx* lobCtx __attribute__((unused)), OracleTable* table, OracleColumn* column, CharacterSet* characterSet,
+                                     const uint8_t* data, uint64_t length, uint64_t offset, bool after __attribute__((unused))) {
+        parseString(data, length, characterSet, column->charsetId, offset, false, false, false, table->systemTable > 0);
+        columnString(column->name);
+    }
+
+    void Builder::decodeColumnNumber(LobCtx* lobCtx __attribute__((unused)), OracleTable* table __attribute__((unused)), OracleColumn* column,
+                                     CharacterSet* characterSet __attribute__((unused)), const uint8_t* data, uint64_t length, uint64_t offset,
+                                     bool after __attribute__((unused))) {
+        parseNumber(data, length, offset);
+        columnNumber(column->name, column->precision, column->scale);
+    }
+
+    void Builder::decodeColumnBlob(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet __attribute__((unused)),
+                                   const uint8_t* data, uint64_t length, uint64_t offset, bool after) {
+        if (after && table != nullptr) {
+            // XMLType is parsed as a whole, can't be streamed
+            if (columnStreamable() && !(column->xmlType && FLAG(REDO_FLAGS_EXPERIMENTAL_XMLTYPE)))
+                lobStreamColumn = &column->name;
+            bool lobValid = parseLob(lobCtx, data, length, 0, table->obj, offset, false, table->sys);
+            if (lobStreamEnd(column->name, lobValid, false, offset))
+                return;
+
+            if (lobValid) {
+                if (column->xmlType && FLAG(REDO_FLAGS_EXPERIMENTAL_XMLTYPE)) {
+                    if (parseXml(reinterpret_cast<uint8_t *>(valueBuffer), valueLength, offset))
                         columnString(column->name);
-                }
-                break;
+                    else
+                        columnUnknown(column->name, reinterpret_cast<uint8_t *>(valueBufferOld), valueLengthOld);
+                } else
+                    columnRaw(column->name, reinterpret_cast<uint8_t *>(valueBuffer), valueLength);
+            }
+        }
+    }
 
-            case SYS_COL_TYPE_DATE:
-            case SYS_COL_TYPE_TIMESTAMP:
-            case SYS_COL_TYPE_TIMESTAMP_WITH_LOCAL_TZ:
-                if (length != 7 && length != 11)
-                    columnUnknown(column->name, data, length);
-                else {
-                    struct tm epochTime = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                            nullptr};
-                    epochTime.tm_sec = data[6] - 1;  // 0..59
-                    epochTime.tm_min = data[5] - 1;  // 0..59
-                    epochTime.tm_hour = data[4] - 1; // 0..23
-                    epochTime.tm_mday = data[3];     // 1..31
-                    epochTime.tm_mon = data[2];      // 1..12
-
-                    int val1 = data[0];
-                    int val2 = data[1];
-                    // AD
-                    if (val1 >= 100 && val2 >= 100) {
-                        val1 -= 100;
-                        val2 -= 100;
-                        epochTime.tm_year = val1 * 100 + val2;
+    void Builder::decodeColumnClob(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet __attribute__((unused)),
+                                   const uint8_t* data, uint64_t length, uint64_t offset, bool after) {
+        if (after && table != nullptr) {
+            if (columnStreamable())
+                lobStreamColumn = &column->name;
+            bool lobValid = parseLob(lobCtx, data, length, column->charsetId, table->obj, offset, true, table->systemTable > 0);
+            if (lobStreamEnd(column->name, lobValid, true, offset))
+                return;
 
-                    } else {
-                        val1 = 100 - val1;
-                        val2 = 100 - val2;
-                        epochTime.tm_year = - (val1 * 100 + val2);
-                    }
+            if (lobValid)
+                columnString(column->name);
+        }
+    }
 
-                    uint64_t fraction = 0;
-                    if (length == 11)
-                        fraction = Ctx::read32Big(data + 7);
+    void Builder::decodeColumnDate(LobCtx* lobCtx __attribute__((unused)), OracleTable* table __attribute__((unused)), OracleColumn* column,
+                                   CharacterSet* characterSet __attribute__((unused)), const uint8_t* data, uint64_t length,
+                                   uint64_t offset __attribute__((unused)), bool after __attribute__((unused))) {
+        if (length != 7 && length != 11)
+            columnUnknown(column->name, data, length);
+        else {
+            struct tm epochTime = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                    nullptr};
+            epochTime.tm_sec = data[6] - 1;  // 0..59
+            epochTime.tm_min = data[5] - 1;  // 0..59
+            epochTime.tm_hour = data[4] - 1; // 0..23
+            epochTime.tm_mday = data[3];     // 1..31
+            epochTime.tm_mon = data[2];      // 1..12
+
+            int val1 = data[0];
+            int val2 = data[1];
+            // AD
+            if (val1 >= 100 && val2 >= 100) {
+                val1 -= 100;
+                val2 -= 100;
+                epochTime.tm_year = val1 * 100 + val2;
 
-                    if (epochTime.tm_sec < 0 || epochTime.tm_sec > 59 ||
-                        epochTime.tm_min < 0 || epochTime.tm_min > 59 ||
-                        epochTime.tm_hour < 0 || epochTime.tm_hour > 23 ||
-                        epochTime.tm_mday < 1 || epochTime.tm_mday > 31 ||
-                        epochTime.tm_mon < 1 || epochTime.tm_mon > 12) {
-                        columnUnknown(column->name, data, length);
-                    } else {
-                        columnTimestamp(column->name, epochTime, fraction);
-                    }
-                }
-                break;
+            } else {
+                val1 = 100 - val1;
+                val2 = 100 - val2;
+                epochTime.tm_year = - (val1 * 100 + val2);
+            }
 
-            case SYS_COL_TYPE_RAW:
-                columnRaw(column->name, data, length);
-                break;
+            uint64_t fraction = 0;
+            if (length == 11)
+                fraction = Ctx::read32Big(data + 7);
 
-            case SYS_COL_TYPE_FLOAT:
-                if (length == 4)
-                    columnFloat(column->name, decodeFloat(data));
-                else
-                    columnUnknown(column->name, data, length);
-                break;
+            if (epochTime.tm_sec < 0 || epochTime.tm_sec > 59 ||
+                epochTime.tm_min < 0 || epochTime.tm_min > 59 ||
+                epochTime.tm_hour < 0 || epochTime.tm_hour > 23 ||
+                epochTime.tm_mday < 1 || epochTime.tm_mday > 31 ||
+                epochTime.tm_mon < 1 || epochTime.tm_mon > 12) {
+                columnUnknown(column->name, data, length);
+            } else {
+                columnTimestamp(column->name, epochTime, fraction);
+            }
+        }
+    }
 
-            case SYS_COL_TYPE_DOUBLE:
-                if (length == 8)
-                    columnDouble(column->name, decodeDouble(data));
-                else
-                    columnUnknown(column->name, data, length);
-                break;
+    void Builder::decodeColumnRaw(LobCtx* lobCtx __attribute__((unused)), OracleTable* table __attribute__((unused)), OracleColumn* column,
+                                  CharacterSet* characterSet __attribute__((unused)), const uint8_t* data, uint64_t length,
+                                  uint64_t offset __attribute__((unused)), bool after __attribute__((unused))) {
+        columnRaw(column->name, data, length);
+    }
 
-            case SYS_COL_TYPE_TIMESTAMP_WITH_TZ:
-                if (length != 9 && length != 13) {
-                    columnUnknown(column->name, data, length);
-                } else {
-                    struct tm epochTime = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                            nullptr};
-                    epochTime.tm_sec = data[6] - 1;  // 0..59
-                    epochTime.tm_min = data[5] - 1;  // 0..59
-                    epochTime.tm_hour = data[4] - 1; // 0..23
-                    epochTime.tm_mday = data[3];     // 1..31
-                    epochTime.tm_mon = data[2];      // 1..12
-
-                    int val1 = data[0];
-                    int val2 = data[1];
-                    // AD
-                    if (val1 >= 100 && val2 >= 100) {
-                        val1 -= 100;
-                        val2 -= 100;
-                        epochTime.tm_year = val1 * 100 + val2;
+    void Builder::decodeColumnFloat(LobCtx* lobCtx __attribute__((unused)), OracleTable* table __attribute__((unused)), OracleColumn* column,
+                                    CharacterSet* characterSet __attribute__((unused)), const uint8_t* data, uint64_t length,
+                                    uint64_t offset __attribute__((unused)), bool after __attribute__((unused))) {
+        if (length == 4)
+            columnFloat(column->name, decodeFloat(data));
+        else
+            columnUnknown(column->name, data, length);
+    }
 
-                    } else {
-                        val1 = 100 - val1;
-                        val2 = 100 - val2;
-                        epochTime.tm_year = - (val1 * 100 + val2);
-                    }
+    void Builder::decodeColumnDouble(LobCtx* lobCtx __attribute__((unused)), OracleTable* table __attribute__((unused)), OracleColumn* column,
+                                     CharacterSet* characterSet __attribute__((unused)), const uint8_t* data, uint64_t length,
+                                     uint64_t offset __attribute__((unused)), bool after __attribute__((unused))) {
+        if (length == 8)
+            columnDouble(column->name, decodeDouble(data));
+        else
+            columnUnknown(column->name, data, length);
+    }
 
-                    uint64_t fraction = 0;
-                    if (length == 13)
-                        fraction = Ctx::read32Big(data + 7);
+    void Builder::decodeColumnTimestampTz(LobCtx* lobCtx __attribute__((unused)), OracleTable* table __attribute__((unused)), OracleColumn* column,
+                                          CharacterSet* characterSet __attribute__((unused)), const uint8_t* data, uint64_t length,
+                                          uint64_t offset __attribute__((unused)), bool after __attribute__((unused))) {
+        if (length != 9 && length != 13) {
+            columnUnknown(column->name, data, length);
+        } else {
+            struct tm epochTime = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                    nullptr};
+            epochTime.tm_sec = data[6] - 1;  // 0..59
+            epochTime.tm_min = data[5] - 1;  // 0..59
+            epochTime.tm_hour = data[4] - 1; // 0..23
+            epochTime.tm_mday = data[3];     // 1..31
+            epochTime.tm_mon = data[2];      // 1..12
+
+            int val1 = data[0];
+            int val2 = data[1];
+            // AD
+            if (val1 >= 100 && val2 >= 100) {
+                val1 -= 100;
+                val2 -= 100;
+                epochTime.tm_year = val1 * 100 + val2;
 
-                    const char* tz = nullptr;
-                    char tz2[7];
+            } else {
+                val1 = 100 - val1;
+                val2 = 100 - val2;
+                epochTime.tm_year = - (val1 * 100 + val2);
+            }
 
-                    if (data[11] >= 5 && data[11] <= 36) {
-                        if (data[11] < 20 ||
-                                (data[11] == 20 && data[12] < 60))
-                            tz2[0] = '-';
-                        else
-                            tz2[0] = '+';
-
-                        if (data[11] < 20) {
-                            uint64_t val = 20 - data[11];
-                            tz2[1] = ctx->map10[val / 10];
-                            tz2[2] = ctx->map10[val % 10];
-                        } else {
-                            uint64_t val = data[11] - 20;
-                            tz2[1] = ctx->map10[val / 10];
-                            tz2[2] = ctx->map10[val % 10];
-                        }
+            uint64_t fraction = 0;
+            if (length == 13)
+                fraction = Ctx::read32Big(data + 7);
 
-                        tz2[3] = ':';
+            const char* tz = nullptr;
+            char tz2[7];
 
-                        if (data[12] < 60) {
-                            uint64_t val = 60 - data[12];
-                            tz2[4] = ctx->map10[val / 10];
-                            tz2[5] = ctx->map10[val % 10];
-                        } else {
-                            uint64_t val = data[12] - 60;
-                            tz2[4] = ctx->map10[val / 10];
-                            tz2[5] = ctx->map10[val % 10];
-                        }
-                        tz2[6] = 0;
-                        tz = tz2;
-                    } else {
-                        uint16_t tzKey = (data[11] << 8) | data[12];
-                        auto timeZoneMapIt = locales->timeZoneMap.find(tzKey);
-                        if (timeZoneMapIt != locales->timeZoneMap.end())
-                            tz = timeZoneMapIt->second;
-                        else
-                            tz = "TZ?";
-                    }
+            if (data[11] >= 5 && data[11] <= 36) {
+                if (data[11] < 20 ||
+                        (data[11] == 20 && data[12] < 60))
+                    tz2[0] = '-';
+                else
+                    tz2[0] = '+';
 
-                    if (epochTime.tm_sec < 0 || epochTime.tm_sec > 59 ||
-                        epochTime.tm_min < 0 || epochTime.tm_min > 59 ||
-                        epochTime.tm_hour < 0 || epochTime.tm_hour > 23 ||
-                        epochTime.tm_mday < 1 || epochTime.tm_mday > 31 ||
-                        epochTime.tm_mon < 1 || epochTime.tm_mon > 12) {
-                        columnUnknown(column->name, data, length);
-                    } else {
-                        columnTimestampTz(column->name, epochTime, fraction, tz);
-                    }
+                if (data[11] < 20) {
+                    uint64_t val = 20 - data[11];
+                    tz2[1] = ctx->map10[val / 10];
+                    tz2[2] = ctx->map10[val % 10];
+                } else {
+                    uint64_t val = data[11] - 20;
+                    tz2[1] = ctx->map10[val / 10];
+                    tz2[2] = ctx->map10[val % 10];
                 }
-                break;
 
-            case SYS_COL_TYPE_INTERVAL_YEAR_TO_MONTH:
-                if (length != 5 || data[4] < 49 || data[4] > 71)
-                    columnUnknown(column->name, data, length);
-                else {
-                    bool minus = false;
-                    uint64_t year = 0;
-                    if ((data[0] & 0x80) != 0)
-                        year = Ctx::read32Big(data) - 0x80000000;
-                    else {
-                        year = 0x80000000 - Ctx::read32Big(data);
-                        minus = true;
-                    }
+                tz2[3] = ':';
 
-                    if (year > 999999999)
-                        columnUnknown(column->name, data, length);
-                    else {
-                        uint64_t month = 0;
-                        if (data[4] >= 60)
-                            month = data[4] - 60;
-                        else {
-                            month = 60 - data[4];
-                            minus = true;
-                        }
+                if (data[12] < 60) {
+                    uint64_t val = 60 - data[12];
+                    tz2[4] = ctx->map10[val / 10];
+                    tz2[5] = ctx->map10[val % 10];
+                } else {
+                    uint64_t val = data[12] - 60;
+                    tz2[4] = ctx->map10[val / 10];
+                    tz2[5] = ctx->map10[val % 10];
+                }
+                tz2[6] = 0;
+                tz = tz2;
+            } else {
+                uint16_t tzKey = (data[11] << 8) | data[12];
+                auto timeZoneMapIt = locales->timeZoneMap.find(tzKey);
+                if (timeZoneMapIt != locales->timeZoneMap.end())
+                    tz = timeZoneMapIt->second;
+                else
+                    tz = "TZ?";
+            }
 
-                        char buffer[12];
-                        uint64_t val = 0;
-                        uint64_t len = 0;
-                        valueLength = 0;
+            if (epochTime.tm_sec < 0 || epochTime.tm_sec > 59 ||
+                epochTime.tm_min < 0 || epochTime.tm_min > 59 ||
+                epochTime.tm_hour < 0 || epochTime.tm_hour > 23 ||
+                epochTime.tm_mday < 1 || epochTime.tm_mday > 31 ||
+                epochTime.tm_mon < 1 || epochTime.tm_mon > 12) {
+                columnUnknown(column->name, data, length);
+            } else {
+                columnTimestampTz(column->name, epochTime, fraction, tz);
+            }
+        }
+    }
 
-                        if (minus)
-                            valueBuffer[valueLength++] = '-';
+    void Builder::decodeColumnIntervalYtm(LobCtx* lobCtx __attribute__((unused)), OracleTable* table __attribute__((unused)), OracleColumn* column,
+                                          CharacterSet* characterSet __attribute__((unused)), const uint8_t* data, uint64_t length,
+                                          uint64_t offset __attribute__((unused)), bool after __attribute__((unused))) {
+        if (length != 5 || data[4] < 49 || data[4] > 71)
+            columnUnknown(column->name, data, length);
+        else {
+            bool minus = false;
+            uint64_t year = 0;
+            if ((data[0] & 0x80) != 0)
+                year = Ctx::read32Big(data) - 0x80000000;
+            else {
+                year = 0x80000000 - Ctx::read32Big(data);
+                minus = true;
+            }
 
-                        if (intervalYtmFormat == INTERVAL_YTM_FORMAT_MONTHS || intervalYtmFormat == INTERVAL_YTM_FORMAT_MONTHS_STRING) {
-                            val = year * 12 + month;
-                            if (val == 0) {
-                                valueBuffer[valueLength++] = '0';
-                            } else {
-                                while (val) {
-                                    buffer[len++] = ctx->map10[val % 10];
-                                    val /= 10;
-                                }
-                                while (len > 0)
-                                    valueBuffer[valueLength++] = buffer[--len];
-                            }
+            if (year > 999999999)
+                columnUnknown(column->name, data, length);
+            else {
+                uint64_t month = 0;
+                if (data[4] >= 60)
+                    month = data[4] - 60;
+                else {
+                    month = 60 - data[4];
+                    minus = true;
+                }
 
-                            if (intervalYtmFormat == INTERVAL_YTM_FORMAT_MONTHS)
-                                columnNumber(column->name, 17, 0);
-                            else
-                                columnString(column->name);
-                        } else {
-                            val = year;
-                            if (val == 0) {
-                                valueBuffer[valueLength++] = '0';
-                            } else {
-                                while (val) {
-                                    buffer[len++] = ctx->map10[val % 10];
-                                    val /= 10;
-                                }
-                                while (len > 0)
-                                    valueBuffer[valueLength++] = buffer[--len];
-                            }
+                char buffer[12];
+                uint64_t val = 0;
+                uint64_t len = 0;
+                valueLength = 0;
 
-                            if (intervalYtmFormat == INTERVAL_YTM_FORMAT_STRING_YM_SPACE)
-                                valueBuffer[valueLength++] = ' ';
-                            else if (intervalYtmFormat == INTERVAL_YTM_FORMAT_STRING_YM_COMMA)
-                                valueBuffer[valueLength++] = ',';
-                            else if (intervalYtmFormat == INTERVAL_YTM_FORMAT_STRING_YM_DASH)
-                                valueBuffer[valueLength++] = '-';
+                if (minus)
+                    valueBuffer[valueLength++] = '-';
 
-                            if (month >= 10) {
-                                valueBuffer[valueLength++] = '1';
-                                valueBuffer[valueLength++] = ctx->map10[month - 10];
-                            } else
-                                valueBuffer[valueLength++] = ctx->map10[month];
+                if (intervalYtmFormat == INTERVAL_YTM_FORMAT_MONTHS || intervalYtmFormat == INTERVAL_YTM_FORMAT_MONTHS_STRING) {
+                    val = year * 12 + month;
+                    if (val == 0) {
+                        valueBuffer[valueLength++] = '0';
+                    } else {
+                        while (val) {
+                            buffer[len++] = ctx->map10[val % 10];
+                            val /= 10;
+                        }
+                        while (len > 0)
+                            valueBuffer[valueLength++] = buffer[--len];
+                    }
 
-                            columnString(column->name);
+                    if (intervalYtmFormat == INTERVAL_YTM_FORMAT_MONTHS)
+                        columnNumber(column->name, 17, 0);
+                    else
+                        columnString(column->name);
+                } else {
+                    val = year;
+                    if (val == 0) {
+                        valueBuffer[valueLength++] = '0';
+                    } else {
+                        while (val) {
+                            buffer[len++] = ctx->map10[val % 10];
+                            val /= 10;
                         }
+                        while (len > 0)
+                            valueBuffer[valueLength++] = buffer[--len];
                     }
+
+                    if (intervalYtmFormat == INTERVAL_YTM_FORMAT_STRING_YM_SPACE)
+                        valueBuffer[valueLength++] = ' ';
+                    else if (intervalYtmFormat == INTERVAL_YTM_FORMAT_STRING_YM_COMMA)
+                        valueBuffer[valueLength++] = ',';
+                    else if (intervalYtmFormat == INTERVAL_YTM_FORMAT_STRING_YM_DASH)
+                        valueBuffer[valueLength++] = '-';
+
+                    if (month >= 10) {
+                        valueBuffer[valueLength++] = '1';
+                        valueBuffer[valueLength++] = ctx->map10[month - 10];
+                    } else
+                        valueBuffer[valueLength++] = ctx->map10[month];
+
+                    columnString(column->name);
                 }
-                break;
+            }
+        }
+    }
+
+    void Builder::decodeColumnIntervalDts(LobCtx* lobCtx __attribute__((unused)), OracleTable* table __attribute__((unused)), OracleColumn* column,
+                                          CharacterSet* characterSet __attribute__((unused)), const uint8_t* data, uint64_t length,
+                                          uint64_t offset __attribute__((unused)), bool after __attribute__((unused))) {
+        if (length != 11 || data[4] < 37 || data[4] > 83 || data[5] < 1 || data[5] > 119 || data[6] < 1 || data[6] > 119)
+            columnUnknown(column->name, data, length);
+        else {
+            bool minus = false;
+            uint64_t day = 0;
+            if ((data[0] & 0x80) != 0)
+                day = Ctx::read32Big(data) - 0x80000000;
+            else {
+                day = 0x80000000 - Ctx::read32Big(data);
+                minus = true;
+            }
 
-            case SYS_COL_TYPE_INTERVAL_DAY_TO_SECOND:
-                if (length != 11 || data[4] < 37 || data[4] > 83 || data[5] < 1 || data[5] > 119 || data[6] < 1 || data[6] > 119)
-                    columnUnknown(column->name, data, length);
+            int32_t us = 0;
+            if ((data[7] & 0x80) != 0)
+                us = Ctx::read32Big(data + 7) - 0x80000000;
+            else {
+                us = 0x80000000 - Ctx::read32Big(data + 7);
+                minus = true;
+            }
+
+            if (day > 999999999 || us > 999999999)
+                columnUnknown(column->name, data, length);
+            else {
+                uint64_t hour = 0;
+                if (data[4] >= 60)
+                    hour = data[4] - 60;
                 else {
-                    bool minus = false;
-                    uint64_t day = 0;
-                    if ((data[0] & 0x80) != 0)
-                        day = Ctx::read32Big(data) - 0x80000000;
-                    else {
-                        day = 0x80000000 - Ctx::read32Big(data);
-                        minus = true;
-                    }
+                    hour = 60 - data[4];
+                    minus = true;
+                }
 
-                    int32_t us = 0;
-                    if ((data[7] & 0x80) != 0)
-                        us = Ctx::read32Big(data + 7) - 0x80000000;
-                    else {
-                        us = 0x80000000 - Ctx::read32Big(data + 7);
-                        minus = true;
-                    }
+                uint64_t minute = 0;
+                if (data[5] >= 60)
+                    minute = data[5] - 60;
+                else {
+                    minute = 60 - data[5];
+                    minus = true;
+                }
 
-                    if (day > 999999999 || us > 999999999)
-                        columnUnknown(column->name, data, length);
-                    else {
-                        uint64_t hour = 0;
-                        if (data[4] >= 60)
-                            hour = data[4] - 60;
-                        else {
-                            hour = 60 - data[4];
-                            minus = true;
-                        }
+                uint64_t second = 0;
+                if (data[6] >= 60)
+                    second = data[6] - 60;
+                else {
+                    second = 60 - data[6];
+                    minus = true;
+                }
 
-                        uint64_t minute = 0;
-                        if (data[5] >= 60)
-                            minute = data[5] - 60;
-                        else {
-                            minute = 60 - data[5];
-                            minus = true;
-                        }
+                char buffer[30];
+                valueLength = 0;
+                uint64_t val = 0;
+                uint64_t len = 0;
 
-                        uint64_t second = 0;
-                        if (data[6] >= 60)
-                            second = data[6] - 60;
-                        else {
-                            second = 60 - data[6];
-                            minus = true;
-                        }
+                if (minus)
+                    valueBuffer[valueLength++] = '-';
 
-                        char buffer[30];
-                        valueLength = 0;
-                        uint64_t val = 0;
-                        uint64_t len = 0;
+                if (intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_SPACE || intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_COMMA ||
+                        intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_DASH) {
+                    val = day;
+                    if (day == 0) {
+                        valueBuffer[valueLength++] = '0';
+                    } else {
+                        while (val) {
+                            buffer[len++] = ctx->map10[val % 10];
+                            val /= 10;
+                        }
+                        while (len > 0)
+                            valueBuffer[valueLength++] = buffer[--len];
+                    }
 
-                        if (minus)
-                            valueBuffer[valueLength++] = '-';
+                    if (intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_SPACE)
+                        valueBuffer[valueLength++] = ' ';
+                    else if (intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_COMMA)
+                        valueBuffer[valueLength++] = ',';
+                    else if (intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_DASH)
+                        valueBuffer[valueLength++] = '-';
+
+                    valueBuffer[valueLength++] = ctx->map10[hour / 10];
+                    valueBuffer[valueLength++] = ctx->map10[hour % 10];
+                    valueBuffer[valueLength++] = ':';
+                    valueBuffer[valueLength++] = ctx->map10[minute / 10];
+                    valueBuffer[valueLength++] = ctx->map10[minute % 10];
+                    valueBuffer[valueLength++] = ':';
+                    valueBuffer[valueLength++] = ctx->map10[second / 10];
+                    valueBuffer[valueLength++] = ctx->map10[second % 10];
+                    valueBuffer[valueLength++] = '.';
+
+                    for (uint64_t j = 0; j < 9; ++j) {
+                        valueBuffer[valueLength + 8 - j] = ctx->map10[us % 10];
+                        us /= 10;
+                    }
+                    valueLength += 9;
 
-                        if (intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_SPACE || intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_COMMA ||
-                                intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_DASH) {
-                            val = day;
-                            if (day == 0) {
-                                valueBuffer[valueLength++] = '0';
-                            } else {
-                                while (val) {
-                                    buffer[len++] = ctx->map10[val % 10];
-                                    val /= 10;
-                                }
-                                while (len > 0)
-                                    valueBuffer[valueLength++] = buffer[--len];
-                            }
+                    columnString(column->name);
+                } else {
+                    switch (intervalDtsFormat) {
+                        case INTERVAL_DTS_FORMAT_UNIX_NANO:
+                        case INTERVAL_DTS_FORMAT_UNIX_NANO_STRING:
+                            val = (((day * 24 + hour) * 60 + minute) * 60 + second) * 1000000000 + us;
+                            break;
 
-                            if (intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_SPACE)
-                                valueBuffer[valueLength++] = ' ';
-                            else if (intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_COMMA)
-                                valueBuffer[valueLength++] = ',';
-                            else if (intervalDtsFormat == INTERVAL_DTS_FORMAT_ISO8601_DASH)
-                                valueBuffer[valueLength++] = '-';
-
-                            valueBuffer[valueLength++] = ctx->map10[hour / 10];
-                            valueBuffer[valueLength++] = ctx->map10[hour % 10];
-                            valueBuffer[valueLength++] = ':';
-                            valueBuffer[valueLength++] = ctx->map10[minute / 10];
-                            valueBuffer[valueLength++] = ctx->map10[minute % 10];
-                            valueBuffer[valueLength++] = ':';
-                            valueBuffer[valueLength++] = ctx->map10[second / 10];
-                            valueBuffer[valueLength++] = ctx->map10[second % 10];
-                            valueBuffer[valueLength++] = '.';
-
-                            for (uint64_t j = 0; j < 9; ++j) {
-                                valueBuffer[valueLength + 8 - j] = ctx->map10[us % 10];
-                                us /= 10;
-                            }
-                            valueLength += 9;
+                        case INTERVAL_DTS_FORMAT_UNIX_MICRO:
+                        case INTERVAL_DTS_FORMAT_UNIX_MICRO_STRING:
+                            val = ((((day * 24 + hour) * 60 + minute) * 60 + second) * 1000000000 + us + 500) / 1000;
+                            break;
 
-                            columnString(column->name);
-                        } else {
-                            switch (intervalDtsFormat) {
-                                case INTERVAL_DTS_FORMAT_UNIX_NANO:
-                                case INTERVAL_DTS_FORMAT_UNIX_NANO_STRING:
-                                    val = (((day * 24 + hour) * 60 + minute) * 60 + second) * 1000000000 + us;
-                                    break;
-
-                                case INTERVAL_DTS_FORMAT_UNIX_MICRO:
-                                case INTERVAL_DTS_FORMAT_UNIX_MICRO_STRING:
-                                    val = ((((day * 24 + hour) * 60 + minute) * 60 + second) * 1000000000 + us + 500) / 1000;
-                                    break;
-
-                                case INTERVAL_DTS_FORMAT_UNIX_MILLI:
-                                case INTERVAL_DTS_FORMAT_UNIX_MILLI_STRING:
-                                    val = ((((day * 24 + hour) * 60 + minute) * 60 + second) * 1000000000 + us + 500000) / 1000000;
-                                    break;
-
-                                case INTERVAL_DTS_FORMAT_UNIX:
-                                case INTERVAL_DTS_FORMAT_UNIX_STRING:
-                                    val = ((((day * 24 + hour) * 60 + minute) * 60 + second) * 1000000000 + us + 500000000) / 1000000000;
-                            }
+                        case INTERVAL_DTS_FORMAT_UNIX_MILLI:
+                        case INTERVAL_DTS_FORMAT_UNIX_MILLI_STRING:
+                            val = ((((day * 24 + hour) * 60 + minute) * 60 + second) * 1000000000 + us + 500000) / 1000000;
+                            break;
 
-                            if (val == 0) {
-                                valueBuffer[valueLength++] = '0';
-                            } else {
-                                while (val) {
-                                    buffer[len++] = ctx->map10[val % 10];
-                                    val /= 10;
-                                }
-                                while (len > 0)
-                                    valueBuffer[valueLength++] = buffer[--len];
-                            }
+                        case INTERVAL_DTS_FORMAT_UNIX:
+                        case INTERVAL_DTS_FORMAT_UNIX_STRING:
+                            val = ((((day * 24 + hour) * 60 + minute) * 60 + second) * 1000000000 + us + 500000000) / 1000000000;
+                    }
 
-                            switch (intervalDtsFormat) {
-                                case INTERVAL_DTS_FORMAT_UNIX_NANO:
-                                case INTERVAL_DTS_FORMAT_UNIX_MICRO:
-                                case INTERVAL_DTS_FORMAT_UNIX_MILLI:
-                                case INTERVAL_DTS_FORMAT_UNIX:
-                                    columnNumber(column->name, 17, 0);
-                                    break;
-
-                                case INTERVAL_DTS_FORMAT_UNIX_NANO_STRING:
-                                case INTERVAL_DTS_FORMAT_UNIX_MICRO_STRING:
-                                case INTERVAL_DTS_FORMAT_UNIX_MILLI_STRING:
-                                case INTERVAL_DTS_FORMAT_UNIX_STRING:
-                                    columnString(column->name);
-                            }
+                    if (val == 0) {
+                        valueBuffer[valueLength++] = '0';
+                    } else {
+                        while (val) {
+                            buffer[len++] = ctx->map10[val % 10];
+                            val /= 10;
                         }
+                        while (len > 0)
+                            valueBuffer[valueLength++] = buffer[--len];
                     }
-                }
-                break;
 
-            case SYS_COL_TYPE_UROWID:
-                if (length == 13 && data[0] == 0x01) {
-                    typeRowId rowId;
-                    rowId.decodeFromHex(data + 1);
-                    columnRowId(column->name, rowId);
-                } else {
-                    columnUnknown(column->name, data, length);
+                    switch (intervalDtsFormat) {
+                        case INTERVAL_DTS_FORMAT_UNIX_NANO:
+                        case INTERVAL_DTS_FORMAT_UNIX_MICRO:
+                        case INTERVAL_DTS_FORMAT_UNIX_MILLI:
+                        case INTERVAL_DTS_FORMAT_UNIX:
+                            columnNumber(column->name, 17, 0);
+                            break;
+
+                        case INTERVAL_DTS_FORMAT_UNIX_NANO_STRING:
+                        case INTERVAL_DTS_FORMAT_UNIX_MICRO_STRING:
+                        case INTERVAL_DTS_FORMAT_UNIX_MILLI_STRING:
+                        case INTERVAL_DTS_FORMAT_UNIX_STRING:
+                            columnString(column->name);
+                    }
                 }
-                break;
+            }
+        }
+    }
 
-            default:
-                if (unknownType == UNKNOWN_TYPE_SHOW)
-                    columnUnknown(column->name, data, length);
+    void Builder::decodeColumnUrowid(LobCtx* lobCtx __attribute__((unused)), OracleTable* table __attribute__((unused)), OracleColumn* column,
+                                     CharacterSet* characterSet __attribute__((unused)), const uint8_t* data, uint64_t length,
+                                     uint64_t offset __attribute__((unused)), bool after __attribute__((unused))) {
+        if (length == 13 && data[0] == 0x01) {
+            typeRowId rowId;
+            rowId.decodeFromHex(data + 1);
+            columnRowId(column->name, rowId);
+        } else {
+            columnUnknown(column->name, data, length);
         }
     }
 
+    void Builder::decodeColumnUnknown(LobCtx* lobCtx __attribute__((unused)), OracleTable* table __attribute__((unused)), OracleColumn* column,
+                                      CharacterSet* characterSet __attribute__((unused)), const uint8_t* data, uint64_t length,
+                                      uint64_t offset __attribute__((unused)), bool after __attribute__((unused))) {
+        columnUnknown(column->name, data, length);
+    }
+
     double Builder::decodeFloat(const uint8_t* data) {
         uint8_t sign = data[0] & 0x80;
         int64_t exponent = (static_cast<uint64_t>(data[0] & 0x7F) << 1) | (static_cast<uint64_t>(data[1]) >> 7);
@@ -650,7 +819,25 @@ namespace OpenLogReplicator {
     }
 
     void Builder::builderRotate(bool copy) {
-        auto nextBuffer = reinterpret_cast<BuilderQueue*>(ctx->getMemoryChunk("builder", true));
+        // The message being built fills every buffer kept by the builder, so writers can't release any of them to make room
+        if (msg != nullptr && ctx->memoryModulesHard[MEMORY_MODULE_BUILDER] != 0) {
+            uint64_t held;
+            BuilderQueue* firstQueue;
+            {
+                std::unique_lock<std::mutex> lck(mtx);
+                held = buffersAllocated;
+                firstQueue = firstBuilderQueue;
+            }
+            auto msgStart = reinterpret_cast<uint8_t*>(msg);
+            if (held >= ctx->memoryModulesHard[MEMORY_MODULE_BUILDER] && msgStart >= firstQueue->data &&
+                    msgStart < firstQueue->data + OUTPUT_BUFFER_DATA_SIZE) {
+                ctx->hint("try to restart with higher value of 'builder-hard-mb' parameter, the message needs more memory");
+                throw RuntimeException(10075, "out of memory for: " + std::string(Ctx::memoryModules[MEMORY_MODULE_BUILDER]) + ", quota: " +
+                                       std::to_string(ctx->memoryModulesHard[MEMORY_MODULE_BUILDER] * MEMORY_CHUNK_SIZE_MB) + "MB reached");
+            }
+        }
+
+        auto nextBuffer = reinterpret_cast<BuilderQueue*>(ctx->getMemoryChunk(MEMORY_MODULE_BUILDER, true));
         nextBuffer->next = nullptr;
         nextBuffer->id = lastBuilderQueue->id + 1;
         nextBuffer->data = reinterpret_cast<uint8_t*>(nextBuffer) + sizeof(struct BuilderQueue);
@@ -688,6 +875,10 @@ namespace OpenLogReplicator {
         maxMessageMb = maxMessageMb_;
     }
 
+    void Builder::setTagFormat(uint64_t newTagFormat) {
+        tagFormat |= newTagFormat;
+    }
+
     void Builder::processBegin(typeXid xid, typeScn scn, typeScn newLwnScn, const std::unordered_map<std::string, std::string>* newAttributes) {
         lastXid = xid;
         commitScn = scn;
@@ -754,7 +945,7 @@ namespace OpenLogReplicator {
                     }
                 }
 
-                if (colLength > 0 || columnFormat >= COLUMN_FORMAT_FULL_INS_DEC || table == nullptr || table->columns[i]->numPk > 0)
+                if (colLength > 0 || columnFormat >= COLUMN_FORMAT_FULL_INS_DEC || table == nullptr || (table->columnFlags[i] & TABLE_COLUMN_PK) != 0)
                     valueSet(VALUE_AFTER, i, redoLogRecord2->data + fieldPos + pos, colLength, 0, dump);
                 pos += colLength;
             }
@@ -826,7 +1017,7 @@ namespace OpenLogReplicator {
                     }
                 }
 
-                if (colLength > 0 || columnFormat >= COLUMN_FORMAT_FULL_INS_DEC || table == nullptr || table->columns[i]->numPk > 0)
+                if (colLength > 0 || columnFormat >= COLUMN_FORMAT_FULL_INS_DEC || table == nullptr || (table->columnFlags[i] & TABLE_COLUMN_PK) != 0)
                     valueSet(VALUE_BEFORE, i, redoLogRecord1->data + fieldPos + pos, colLength, 0, dump);
                 pos += colLength;
             }
@@ -1214,12 +1405,9 @@ namespace OpenLogReplicator {
 
         uint64_t baseMax = valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (valuesSet[base] < mask)
-                    break;
-                if ((valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
+                uint64_t mask = static_cast<uint64_t>(1) << (column & 0x3F);
 
                 // Merge column values
                 if ((valuesMerge[base] & mask) != 0) {
@@ -1269,8 +1457,8 @@ namespace OpenLogReplicator {
 
                 if (values[column][VALUE_BEFORE] == nullptr) {
                     bool guardPresent = false;
-                    if (guardPos != -1 && table->columns[column]->guardSeg != -1 && values[guardPos][VALUE_BEFORE] != nullptr) {
-                        typeCol column2 = table->columns[column]->guardSeg;
+                    if (guardPos != -1 && table->columnGuardSegs[column] != -1 && values[guardPos][VALUE_BEFORE] != nullptr) {
+                        typeCol column2 = table->columnGuardSegs[column];
                         uint8_t* guardData = values[guardPos][VALUE_BEFORE];
                         if (guardData != nullptr && static_cast<int64_t>(column2 / static_cast<typeCol>(8)) < lengths[guardPos][VALUE_BEFORE]) {
                             guardPresent = true;
@@ -1289,8 +1477,8 @@ namespace OpenLogReplicator {
 
                 if (values[column][VALUE_AFTER] == nullptr) {
                     bool guardPresent = false;
-                    if (guardPos != -1 && table->columns[column]->guardSeg != -1 && values[guardPos][VALUE_AFTER] != nullptr) {
-                        typeCol column2 = table->columns[column]->guardSeg;
+                    if (guardPos != -1 && table->columnGuardSegs[column] != -1 && values[guardPos][VALUE_AFTER] != nullptr) {
+                        typeCol column2 = table->columnGuardSegs[column];
                         uint8_t* guardData = values[guardPos][VALUE_AFTER];
                         if (guardData != nullptr && static_cast<int64_t>(column2 / static_cast<typeCol>(8)) < lengths[guardPos][VALUE_AFTER]) {
                             guardPresent = true;
@@ -1316,12 +1504,8 @@ namespace OpenLogReplicator {
 
                 baseMax = valuesMax >> 6;
                 for (uint64_t base = 0; base <= baseMax; ++base) {
-                    auto column = static_cast<typeCol>(base << 6);
-                    for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                        if (valuesSet[base] < mask)
-                            break;
-                        if ((valuesSet[base] & mask) == 0)
-                            continue;
+                    for (uint64_t set = valuesSet[base]; set != 0; set &= set - 1) {
+                        auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                         ctx->logTrace(TRACE_DML, "DML: " + std::to_string(column + 1) + ":  B(" +
                                       std::to_string(values[column][VALUE_BEFORE] != nullptr ? lengths[column][VALUE_BEFORE] : -1) + ") A(" +
@@ -1337,12 +1521,8 @@ namespace OpenLogReplicator {
 
                 baseMax = valuesMax >> 6;
                 for (uint64_t base = 0; base <= baseMax; ++base) {
-                    auto column = static_cast<typeCol>(base << 6);
-                    for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                        if (valuesSet[base] < mask)
-                            break;
-                        if ((valuesSet[base] & mask) == 0)
-                            continue;
+                    for (uint64_t set = valuesSet[base]; set != 0; set &= set - 1) {
+                        auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                         ctx->logTrace(TRACE_DML, "DML: " + std::to_string(column + 1) + ":  B(" +
                                       std::to_string(lengths[column][VALUE_BEFORE]) + ") A(" + std::to_string(lengths[column][VALUE_AFTER]) +
@@ -1357,15 +1537,12 @@ namespace OpenLogReplicator {
             if (!compressedBefore && !compressedAfter) {
                 baseMax = valuesMax >> 6;
                 for (uint64_t base = 0; base <= baseMax; ++base) {
-                    auto column = static_cast<typeCol>(base << 6);
-                    for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                        if (valuesSet[base] < mask)
-                            break;
-                        if ((valuesSet[base] & mask) == 0)
-                            continue;
+                    for (uint64_t set = valuesSet[base]; set != 0; set &= set - 1) {
+                        auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
+                        uint64_t mask = static_cast<uint64_t>(1) << (column & 0x3F);
 
                         if (table != nullptr && columnFormat < COLUMN_FORMAT_FULL_UPD) {
-                            if (table->columns[column]->numPk == 0) {
+                            if ((table->columnFlags[column] & TABLE_COLUMN_PK) == 0) {
                                 // Remove unchanged column values - only for tables with a defined primary key
                                 if (values[column][VALUE_BEFORE] != nullptr && lengths[column][VALUE_BEFORE] == lengths[column][VALUE_AFTER] &&
                                         values[column][VALUE_AFTER] != nullptr) {
@@ -1450,13 +1627,10 @@ namespace OpenLogReplicator {
                     // Remove null values from insert if not PK
                     baseMax = valuesMax >> 6;
                     for (uint64_t base = 0; base <= baseMax; ++base) {
-                        auto column = static_cast<typeCol>(base << 6);
-                        for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                            if (valuesSet[base] < mask)
-                                break;
-                            if ((valuesSet[base] & mask) == 0)
-                                continue;
-                            if (table->columns[column]->numPk > 0)
+                        for (uint64_t set = valuesSet[base]; set != 0; set &= set - 1) {
+                            auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
+                            uint64_t mask = static_cast<uint64_t>(1) << (column & 0x3F);
+                            if ((table->columnFlags[column] & TABLE_COLUMN_PK) != 0)
                                 continue;
 
                             if (values[column][VALUE_AFTER] == nullptr || lengths[column][VALUE_AFTER] == 0) {
@@ -1505,13 +1679,10 @@ namespace OpenLogReplicator {
                     // Remove null values from delete if not PK
                     baseMax = valuesMax >> 6;
                     for (uint64_t base = 0; base <= baseMax; ++base) {
-                        auto column = static_cast<typeCol>(base << 6);
-                        for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                            if (valuesSet[base] < mask)
-                                break;
-                            if ((valuesSet[base] & mask) == 0)
-                                continue;
-                            if (table->columns[column]->numPk > 0)
+                        for (uint64_t set = valuesSet[base]; set != 0; set &= set - 1) {
+                            auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
+                            uint64_t mask = static_cast<uint64_t>(1) << (column & 0x3F);
+                            if ((table->columnFlags[column] & TABLE_COLUMN_PK) != 0)
                                 continue;
 
                             if (values[column][VALUE_BEFORE] == nullptr || lengths[column][VALUE_BEFORE] == 0) {
@@ -1754,10 +1925,28 @@ namespace OpenLogReplicator {
         return true;
     }
 
-    void Builder::releaseBuffers(uint64_t maxId) {
+    uint64_t Builder::addWriter() {
+        std::unique_lock<std::mutex> lck(mtx);
+        writersQueueId.push_back(0);
+        writersNotify.push_back(nullptr);
+        return writersQueueId.size() - 1;
+    }
+
+    void Builder::setWriterNotify(uint64_t writerId, Writer* writer) {
+        std::unique_lock<std::mutex> lck(mtx);
+        writersNotify[writerId] = writer;
+    }
+
+    void Builder::releaseBuffers(uint64_t writerId, uint64_t maxId) {
         BuilderQueue* builderQueue = nullptr;
         {
             std::unique_lock<std::mutex> lck(mtx);
+            writersQueueId[writerId] = maxId;
+            // Buffers are released when confirmed by all writers
+            for (uint64_t writerQueueId : writersQueueId)
+                if (writerQueueId < maxId)
+                    maxId = writerQueueId;
+
             builderQueue = firstBuilderQueue;
             while (firstBuilderQueue->id < maxId) {
                 firstBuilderQueue = firstBuilderQueue->next;
@@ -1768,25 +1957,48 @@ namespace OpenLogReplicator {
         if (builderQueue != nullptr) {
             while (builderQueue->id < maxId) {
                 BuilderQueue* nextBuffer = builderQueue->next;
-                ctx->freeMemoryChunk("builder", reinterpret_cast<uint8_t*>(builderQueue), true);
+                ctx->freeMemoryChunk(MEMORY_MODULE_BUILDER, reinterpret_cast<uint8_t*>(builderQueue), true);
                 builderQueue = nextBuffer;
             }
         }
     }
 
-    void Builder::sleepForWriterWork(uint64_t queueSize, uint64_t nanoseconds) {
+    // The writer passes the sequence seen at the previous call, new data committed since then returns immediately.
+    // The timeout is just for the writer to confirm messages and write checkpoints when there is no new data.
+    void Builder::sleepForWriterWork(uint64_t& workSeq, uint64_t queueSize, uint64_t timeUs) {
         if (ctx->trace & TRACE_SLEEP)
             ctx->logTrace(TRACE_SLEEP, "Builder:sleepForWriterWork");
 
         std::unique_lock<std::mutex> lck(mtx);
-        if (queueSize > 0)
-            condNoWriterWork.wait_for(lck, std::chrono::nanoseconds(nanoseconds));
-        else
-            condNoWriterWork.wait_for(lck, std::chrono::seconds(5));
+        if (workSeq == writerWorkSeq) {
+            if (queueSize > 0)
+                condNoWriterWork.wait_for(lck, std::chrono::microseconds(timeUs), [&] { return workSeq != writerWorkSeq; });
+            else
+                condNoWriterWork.wait_for(lck, std::chrono::seconds(5), [&] { return workSeq != writerWorkSeq; });
+        }
+        workSeq = writerWorkSeq;
     }
 
-    void Builder::wakeUp() {
+    // For writers waiting in their own way: returns true when new data was committed since the previous call
+    bool Builder::checkWriterWork(uint64_t& workSeq) {
         std::unique_lock<std::mutex> lck(mtx);
+        if (workSeq == writerWorkSeq)
+            return false;
+        workSeq = writerWorkSeq;
+        return true;
+    }
+
+    // Called with mtx held, the sequence is increased before writers are notified
+    void Builder::notifyWriters() {
+        ++writerWorkSeq;
         condNoWriterWork.notify_all();
+        for (Writer* writer : writersNotify)
+            if (writer != nullptr)
+                writer->notifyWork();
+    }
+
+    void Builder::wakeUp() {
+        std::unique_lock<std::mutex> lck(mtx);
+        notifyWriters();
     }
 }
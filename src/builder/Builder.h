@@ -24,6 +24,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <mutex>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "../common/Ctx.h"
 #include "../common/LobCtx.h"
@@ -46,10 +47,30 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #define OUTPUT_BUFFER_MESSAGE_ALLOCATED         0x0001
 #define OUTPUT_BUFFER_MESSAGE_CONFIRMED         0x0002
 #define OUTPUT_BUFFER_MESSAGE_CHECKPOINT        0x0004
+#define OUTPUT_TAG_TABLE                        0x0001
+#define OUTPUT_TAG_KEY                          0x0002
 #define VALUE_BUFFER_MIN                        1048576
 #define VALUE_BUFFER_MAX                        4294967296
+#define VALUE_BUFFER_STREAM                     1048576
 #define BUFFER_START_UNDEFINED                  0xFFFFFFFFFFFFFFFF
 
+#define BUILDER_DECODER_SKIP                    0
+#define BUILDER_DECODER_RAW_DATA                1
+#define BUILDER_DECODER_STRING                  2
+#define BUILDER_DECODER_NUMBER                  3
+#define BUILDER_DECODER_BLOB                    4
+#define BUILDER_DECODER_CLOB                    5
+#define BUILDER_DECODER_DATE                    6
+#define BUILDER_DECODER_RAW                     7
+#define BUILDER_DECODER_FLOAT                   8
+#define BUILDER_DECODER_DOUBLE                  9
+#define BUILDER_DECODER_TIMESTAMP_TZ            10
+#define BUILDER_DECODER_INTERVAL_YTM            11
+#define BUILDER_DECODER_INTERVAL_DTS            12
+#define BUILDER_DECODER_UROWID                  13
+#define BUILDER_DECODER_UNKNOWN                 14
+#define BUILDER_DECODERS                        15
+
 #define XML_PROLOG_RGUID                        0x04
 #define XML_PROLOG_DOCID                        0x08
 #define XML_PROLOG_PATHID                       0x10
@@ -65,10 +86,12 @@ namespace OpenLogReplicator {
     class Ctx;
     class CharacterSet;
     class Locales;
+    class OracleColumn;
     class OracleTable;
     class Builder;
     class Metadata;
     class SystemTransaction;
+    class Writer;
 
     struct BuilderQueue {
         uint64_t id;
@@ -83,6 +106,7 @@ namespace OpenLogReplicator {
         uint64_t id;
         uint64_t queueId;
         uint64_t length;
+        uint64_t tagSize;
         typeScn scn;
         typeSeq sequence;
         typeScn lwnScn;
@@ -125,6 +149,8 @@ namespace OpenLogReplicator {
         uint64_t valueBufferLength;
         char* valueBufferOld;
         uint64_t valueLengthOld;
+        const std::string* lobStreamColumn;
+        bool lobStreaming;
         std::unordered_set<OracleTable*> tables;
         typeScn commitScn;
         typeXid lastXid;
@@ -140,6 +166,7 @@ namespace OpenLogReplicator {
         uint64_t id;
         uint64_t num;
         uint64_t maxMessageMb;      // Maximum message size able to handle by writer
+        uint64_t tagFormat;         // Routing information requested by writer
         bool newTran;
         bool compressedBefore;
         bool compressedAfter;
@@ -149,11 +176,53 @@ namespace OpenLogReplicator {
 
         std::mutex mtx;
         std::condition_variable condNoWriterWork;
+        // Increased on every notification of the writers, so a notification sent before a writer starts waiting is not lost
+        uint64_t writerWorkSeq;
+        // Id of the first buffer still used by every writer attached to the builder
+        std::vector<uint64_t> writersQueueId;
+        // Writers which wait for new data in their own way and are notified directly
+        std::vector<Writer*> writersNotify;
 
         double decodeFloat(const uint8_t* data);
         long double decodeDouble(const uint8_t* data);
         void builderRotate(bool copy);
+        void notifyWriters();
+        bool lobStreamEnd(const std::string& columnName, bool lobValid, bool isClob, uint64_t offset);
         void processValue(LobCtx* lobCtx, OracleTable* table, typeCol col, const uint8_t* data, uint64_t length, uint64_t offset, bool after, bool compressed);
+        [[nodiscard]] uint8_t hiddenColumnFlags() const;
+        void prepareDecoders(OracleTable* table);
+
+        typedef void (Builder::*ColumnDecoder)(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data,
+                                               uint64_t length, uint64_t offset, bool after);
+        static const ColumnDecoder columnDecoders[BUILDER_DECODERS];
+        void decodeColumnSkip(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data, uint64_t length,
+                              uint64_t offset, bool after);
+        void decodeColumnRaw(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data, uint64_t length,
+                             uint64_t offset, bool after);
+        void decodeColumnString(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data, uint64_t length,
+                                uint64_t offset, bool after);
+        void decodeColumnNumber(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data, uint64_t length,
+                                uint64_t offset, bool after);
+        void decodeColumnBlob(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data, uint64_t length,
+                              uint64_t offset, bool after);
+        void decodeColumnClob(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data, uint64_t length,
+                              uint64_t offset, bool after);
+        void decodeColumnDate(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data, uint64_t length,
+                              uint64_t offset, bool after);
+        void decodeColumnFloat(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data, uint64_t length,
+                               uint64_t offset, bool after);
+        void decodeColumnDouble(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data, uint64_t length,
+                                uint64_t offset, bool after);
+        void decodeColumnTimestampTz(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data,
+                                     uint64_t length, uint64_t offset, bool after);
+        void decodeColumnIntervalYtm(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data,
+                                     uint64_t length, uint64_t offset, bool after);
+        void decodeColumnIntervalDts(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data,
+                                     uint64_t length, uint64_t offset, bool after);
+        void decodeColumnUrowid(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data, uint64_t length,
+                                uint64_t offset, bool after);
+        void decodeColumnUnknown(LobCtx* lobCtx, OracleTable* table, OracleColumn* column, CharacterSet* characterSet, const uint8_t* data, uint64_t length,
+                                 uint64_t offset, bool after);
 
         void valuesRelease() {
             for (uint64_t i = 0; i < mergesMax; ++i)
@@ -162,12 +231,9 @@ namespace OpenLogReplicator {
 
             uint64_t baseMax = valuesMax >> 6;
             for (uint64_t base = 0; base <= baseMax; ++base) {
-                auto column = static_cast<typeCol>(base << 6);
-                for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                    if (valuesSet[base] < mask)
-                        break;
-                    if ((valuesSet[base] & mask) == 0)
-                        continue;
+                for (uint64_t set = valuesSet[base]; set != 0; set &= set - 1) {
+                    auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
+                    uint64_t mask = static_cast<uint64_t>(1) << (column & 0x3F);
 
                     valuesSet[base] &= ~mask;
                     values[column][VALUE_BEFORE] = nullptr;
@@ -255,6 +321,7 @@ namespace OpenLogReplicator {
             msg->lwnIdx = lwnIdx++;
             msg->sequence = sequence;
             msg->length = 0;
+            msg->tagSize = 0;
             msg->id = id++;
             msg->obj = obj;
             msg->pos = 0;
@@ -276,7 +343,7 @@ namespace OpenLogReplicator {
             if (force || flushBuffer == 0 || unconfirmedLength > flushBuffer) {
                 {
                     std::unique_lock<std::mutex> lck(mtx);
-                    condNoWriterWork.notify_all();
+                    notifyWriters();
                 }
                 unconfirmedLength = 0;
             }
@@ -504,6 +571,19 @@ namespace OpenLogReplicator {
                        reinterpret_cast<const void*>(data), length);
                 valueLength += length;
             };
+
+            // Pass the part decoded so far to the output, partial characters stay in prevChars
+            if (lobStreamColumn != nullptr && valueLength >= VALUE_BUFFER_STREAM)
+                lobStreamFlush(isClob);
+        }
+
+        void lobStreamFlush(bool isClob) {
+            if (!lobStreaming) {
+                columnStreamBegin(*lobStreamColumn);
+                lobStreaming = true;
+            }
+            columnStreamAppend(reinterpret_cast<const uint8_t*>(valueBuffer), valueLength, isClob);
+            valueLength = 0;
         }
 
         bool parseLob(LobCtx* lobCtx, const uint8_t* data, uint64_t length, uint64_t charsetId, typeObj obj, uint64_t offset, bool isClob, bool isSystem) {
@@ -531,7 +611,9 @@ namespace OpenLogReplicator {
                     return true;
                 }
                 LobData* lobData = lobsIt->second;
-                valueBufferCheck(static_cast<uint64_t>(lobData->pageSize) * static_cast<uint64_t>(lobData->sizePages) + lobData->sizeRest, offset);
+                if (lobStreamColumn == nullptr)
+                    valueBufferCheck(static_cast<uint64_t>(lobData->pageSize) * static_cast<uint64_t>(lobData->sizePages) + lobData->sizeRest,
+                                     offset);
 
                 uint32_t pageNo = 0;
                 for (auto indexMapIt: lobData->indexMap) {
@@ -1005,7 +1087,15 @@ namespace OpenLogReplicator {
 
         void parseString(const uint8_t* data, uint64_t length, uint64_t charsetId, uint64_t offset, bool appendData, bool hasPrev, bool hasNext,
                          bool isSystem) {
-            CharacterSet* characterSet = locales->characterMap[charsetId];
+            CharacterSet* characterSet = nullptr;
+            auto characterMapIt = locales->characterMap.find(charsetId);
+            if (characterMapIt != locales->characterMap.end())
+                characterSet = characterMapIt->second;
+            parseString(data, length, characterSet, charsetId, offset, appendData, hasPrev, hasNext, isSystem);
+        }
+
+        void parseString(const uint8_t* data, uint64_t length, CharacterSet* characterSet, uint64_t charsetId, uint64_t offset, bool appendData,
+                         bool hasPrev, bool hasNext, bool isSystem) {
             if (characterSet == nullptr && (charFormat & CHAR_FORMAT_NOMAPPING) == 0)
                 throw RedoLogException(50010, "can't find character set map for id = " + std::to_string(charsetId) + " at offset: " +
                                        std::to_string(offset));
@@ -1149,6 +1239,10 @@ namespace OpenLogReplicator {
         virtual void columnString(const std::string& columnName) = 0;
         virtual void columnNumber(const std::string& columnName, uint64_t precision, uint64_t scale) = 0;
         virtual void columnRaw(const std::string& columnName, const uint8_t* data, uint64_t length) = 0;
+        virtual bool columnStreamable() const = 0;
+        virtual void columnStreamBegin(const std::string& columnName) = 0;
+        virtual void columnStreamAppend(const uint8_t* data, uint64_t length, bool isClob) = 0;
+        virtual void columnStreamEnd() = 0;
         virtual void columnRowId(const std::string& columnName, typeRowId rowId) = 0;
         virtual void columnTimestamp(const std::string& columnName, struct tm &epochTime, uint64_t fraction) = 0;
         virtual void columnTimestampTz(const std::string& columnName, struct tm &epochTime, uint64_t fraction, const char* tz) = 0;
@@ -1180,6 +1274,7 @@ namespace OpenLogReplicator {
         [[nodiscard]] uint64_t builderSize() const;
         [[nodiscard]] uint64_t getMaxMessageMb() const;
         void setMaxMessageMb(uint64_t maxMessageMb);
+        void setTagFormat(uint64_t newTagFormat);
         void processBegin(typeXid xid, typeScn scn, typeScn newLwnScn, const std::unordered_map<std::string, std::string>* newAttributes);
         void processInsertMultiple(typeScn scn, typeSeq sequence, typeTime time_, LobCtx* lobCtx, RedoLogRecord* redoLogRecord1, RedoLogRecord* redoLogRecord2,
                                    bool system, bool schema, bool dump);
@@ -1191,8 +1286,11 @@ namespace OpenLogReplicator {
         virtual void initialize();
         virtual void processCommit(typeScn scn, typeSeq sequence, typeTime time_) = 0;
         virtual void processCheckpoint(typeScn scn, typeSeq sequence, typeTime time_, uint64_t offset, bool redo) = 0;
-        void releaseBuffers(uint64_t maxId);
-        void sleepForWriterWork(uint64_t queueSize, uint64_t nanoseconds);
+        uint64_t addWriter();
+        void setWriterNotify(uint64_t writerId, Writer* writer);
+        void releaseBuffers(uint64_t writerId, uint64_t maxId);
+        void sleepForWriterWork(uint64_t& workSeq, uint64_t queueSize, uint64_t timeUs);
+        bool checkWriterWork(uint64_t& workSeq);
         void wakeUp();
 
         friend class SystemTransaction;
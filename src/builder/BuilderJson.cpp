@@ -41,17 +41,10 @@ namespace OpenLogReplicator {
 
     void BuilderJson::columnNull(OracleTable* table, typeCol col, bool after) {
         if (table != nullptr && unknownType == UNKNOWN_TYPE_HIDE) {
-            OracleColumn* column = table->columns[col];
-            if (column->guard && !FLAG(REDO_FLAGS_SHOW_GUARD_COLUMNS))
-                return;
-            if (column->nested && !FLAG(REDO_FLAGS_SHOW_NESTED_COLUMNS))
-                return;
-            if (column->hidden && !FLAG(REDO_FLAGS_SHOW_HIDDEN_COLUMNS))
-                return;
-            if (column->unused && !FLAG(REDO_FLAGS_SHOW_UNUSED_COLUMNS))
+            if ((table->columnFlags[col] & hiddenColumnFlags()) != 0)
                 return;
 
-            uint64_t typeNo = table->columns[col]->type;
+            uint64_t typeNo = table->columnTypes[col];
             if (typeNo != SYS_COL_TYPE_VARCHAR
                     && typeNo != SYS_COL_TYPE_NUMBER
                     && typeNo != SYS_COL_TYPE_DATE
@@ -169,6 +162,33 @@ namespace OpenLogReplicator {
         append('"');
     }
 
+    bool BuilderJson::columnStreamable() const {
+        return true;
+    }
+
+    void BuilderJson::columnStreamBegin(const std::string& columnName) {
+        if (hasPreviousColumn)
+            append(',');
+        else
+            hasPreviousColumn = true;
+
+        append('"');
+        appendEscape(columnName);
+        append(R"(":")", sizeof(R"(":")") - 1);
+    }
+
+    void BuilderJson::columnStreamAppend(const uint8_t* data, uint64_t length, bool isClob) {
+        if (isClob)
+            appendEscape(reinterpret_cast<const char*>(data), length);
+        else
+            for (uint64_t j = 0; j < length; ++j)
+                appendHex(*(data + j), 2);
+    }
+
+    void BuilderJson::columnStreamEnd() {
+        append('"');
+    }
+
     void BuilderJson::columnTimestamp(const std::string& columnName, struct tm &epochTime, uint64_t fraction) {
         int64_t val;
         if (hasPreviousColumn)
@@ -846,6 +866,7 @@ namespace OpenLogReplicator {
                 hasPreviousRedo = true;
         } else {
             builderBegin(scn, sequence, obj, 0);
+            appendTag(lobCtx, table, offset, true, true);
             append('{');
             hasPreviousValue = false;
             appendHeader(scn, time_, false, (dbFormat & DB_FORMAT_ADD_DML) != 0, true);
@@ -886,6 +907,7 @@ namespace OpenLogReplicator {
                 hasPreviousRedo = true;
         } else {
             builderBegin(scn, sequence, obj, 0);
+            appendTag(lobCtx, table, offset, true, false);
             append('{');
             hasPreviousValue = false;
             appendHeader(scn, time_, false, (dbFormat & DB_FORMAT_ADD_DML) != 0, true);
@@ -927,6 +949,7 @@ namespace OpenLogReplicator {
                 hasPreviousRedo = true;
         } else {
             builderBegin(scn, sequence, obj, 0);
+            appendTag(lobCtx, table, offset, true, false);
             append('{');
             hasPreviousValue = false;
             appendHeader(scn, time_, false, (dbFormat & DB_FORMAT_ADD_DML) != 0, true);
@@ -968,6 +991,7 @@ namespace OpenLogReplicator {
                 hasPreviousRedo = true;
         } else {
             builderBegin(scn, sequence, obj, 0);
+            appendTag(nullptr, table, 0, false, false);
             append('{');
             hasPreviousValue = false;
             appendHeader(scn, time_, false, (dbFormat & DB_FORMAT_ADD_DDL) != 0, true);
@@ -35,6 +35,10 @@ namespace OpenLogReplicator {
         void columnString(const std::string& columnName) override;
         void columnNumber(const std::string& columnName, uint64_t precision, uint64_t scale) override;
         void columnRaw(const std::string& columnName, const uint8_t* data, uint64_t length) override;
+        bool columnStreamable() const override;
+        void columnStreamBegin(const std::string& columnName) override;
+        void columnStreamAppend(const uint8_t* data, uint64_t length, bool isClob) override;
+        void columnStreamEnd() override;
         void columnRowId(const std::string& columnName, typeRowId rowId);
         void columnTimestamp(const std::string& columnName, struct tm& epochTime, uint64_t fraction) override;
         void columnTimestampTz(const std::string& columnName, struct tm& epochTime, uint64_t fraction, const char* tz) override;
@@ -154,12 +158,8 @@ namespace OpenLogReplicator {
             } else {
                 uint64_t baseMax = valuesMax >> 6;
                 for (uint64_t base = 0; base <= baseMax; ++base) {
-                    auto column = static_cast<typeCol>(base << 6);
-                    for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                        if (valuesSet[base] < mask)
-                            break;
-                        if ((valuesSet[base] & mask) == 0)
-                            continue;
+                    for (uint64_t set = valuesSet[base]; set != 0; set &= set - 1) {
+                        auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                         if (values[column][VALUE_AFTER] != nullptr) {
                             if (lengths[column][VALUE_AFTER] > 0)
@@ -191,12 +191,8 @@ namespace OpenLogReplicator {
             } else {
                 uint64_t baseMax = valuesMax >> 6;
                 for (uint64_t base = 0; base <= baseMax; ++base) {
-                    auto column = static_cast<typeCol>(base << 6);
-                    for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                        if (valuesSet[base] < mask)
-                            break;
-                        if ((valuesSet[base] & mask) == 0)
-                            continue;
+                    for (uint64_t set = valuesSet[base]; set != 0; set &= set - 1) {
+                        auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                         if (values[column][VALUE_BEFORE] != nullptr) {
                             if (lengths[column][VALUE_BEFORE] > 0)
@@ -211,6 +207,34 @@ namespace OpenLogReplicator {
             append('}');
         }
 
+        void appendTag(LobCtx* lobCtx, OracleTable* table, uint64_t offset, bool key, bool after) {
+            if (tagFormat == 0 || table == nullptr)
+                return;
+
+            // Tag precedes the message: owner, table name and the primary key, separated by zero bytes
+            append(table->owner);
+            append('\0');
+            append(table->name);
+            append('\0');
+
+            if (key && (tagFormat & OUTPUT_TAG_KEY) != 0 && !table->pk.empty()) {
+                uint64_t type = after ? VALUE_AFTER : VALUE_BEFORE;
+                append('{');
+                hasPreviousColumn = false;
+                for (typeCol column: table->pk) {
+                    if (values[column][type] == nullptr)
+                        continue;
+                    if (lengths[column][type] > 0)
+                        processValue(lobCtx, table, column, values[column][type], lengths[column][type], offset, after,
+                                     after ? compressedAfter : compressedBefore);
+                    else
+                        columnNull(table, column, after);
+                }
+                append('}');
+            }
+            msg->tagSize = messageLength;
+        }
+
         static time_t tmToEpoch(struct tm*);
         void processInsert(typeScn scn, typeSeq sequence, typeTime time_, LobCtx* lobCtx, OracleTable* table, typeObj obj, typeDataObj dataObj, typeDba bdba,
                            typeSlot slot, typeXid xid, uint64_t offset) override;
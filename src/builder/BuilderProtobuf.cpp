@@ -51,19 +51,10 @@ namespace OpenLogReplicator {
 
     void BuilderProtobuf::columnNull(OracleTable* table, typeCol col, bool after) {
         if (table != nullptr && unknownType == UNKNOWN_TYPE_HIDE) {
-            OracleColumn* column = table->columns[col];
-            if (column->storedAsLob)
-                return;
-            if (column->guard && !FLAG(REDO_FLAGS_SHOW_GUARD_COLUMNS))
-                return;
-            if (column->nested && !FLAG(REDO_FLAGS_SHOW_NESTED_COLUMNS))
-                return;
-            if (column->hidden && !FLAG(REDO_FLAGS_SHOW_HIDDEN_COLUMNS))
-                return;
-            if (column->unused && !FLAG(REDO_FLAGS_SHOW_UNUSED_COLUMNS))
+            if ((table->columnFlags[col] & (hiddenColumnFlags() | TABLE_COLUMN_STORED_AS_LOB)) != 0)
                 return;
 
-            uint64_t typeNo = table->columns[col]->type;
+            uint64_t typeNo = table->columnTypes[col];
             if (typeNo != SYS_COL_TYPE_VARCHAR
                     && typeNo != SYS_COL_TYPE_NUMBER
                     && typeNo != SYS_COL_TYPE_DATE
@@ -138,6 +129,21 @@ namespace OpenLogReplicator {
         // TODO: implement
     }
 
+    bool BuilderProtobuf::columnStreamable() const {
+        // Message is built as a whole, value has to be complete
+        return false;
+    }
+
+    void BuilderProtobuf::columnStreamBegin(const std::string& columnName __attribute__((unused))) {
+    }
+
+    void BuilderProtobuf::columnStreamAppend(const uint8_t* data __attribute__((unused)), uint64_t length __attribute__((unused)),
+                                             bool isClob __attribute__((unused))) {
+    }
+
+    void BuilderProtobuf::columnStreamEnd() {
+    }
+
     void BuilderProtobuf::columnTimestamp(const std::string& columnName, struct tm& epochTime __attribute__((unused)), uint64_t fraction __attribute__((unused))) {
         valuePB->set_name(columnName);
         // TODO: implement
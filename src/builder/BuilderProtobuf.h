@@ -38,6 +38,10 @@ namespace OpenLogReplicator {
         void columnString(const std::string& columnName) override;
         void columnNumber(const std::string& columnName, uint64_t precision, uint64_t scale) override;
         void columnRaw(const std::string& columnName, const uint8_t* data, uint64_t length) override;
+        bool columnStreamable() const override;
+        void columnStreamBegin(const std::string& columnName) override;
+        void columnStreamAppend(const uint8_t* data, uint64_t length, bool isClob) override;
+        void columnStreamEnd() override;
         void columnRowId(const std::string& columnName, typeRowId rowId);
         void columnTimestamp(const std::string& columnName, struct tm& epochTime, uint64_t fraction) override;
         void columnTimestampTz(const std::string& columnName, struct tm& epochTime, uint64_t fraction, const char* tz) override;
@@ -64,12 +68,8 @@ namespace OpenLogReplicator {
             } else {
                 uint64_t baseMax = valuesMax >> 6;
                 for (uint64_t base = 0; base <= baseMax; ++base) {
-                    auto column = static_cast<typeCol>(base << 6);
-                    for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                        if (valuesSet[base] < mask)
-                            break;
-                        if ((valuesSet[base] & mask) == 0)
-                            continue;
+                    for (uint64_t set = valuesSet[base]; set != 0; set &= set - 1) {
+                        auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                         if (values[column][VALUE_AFTER] != nullptr) {
                             if (lengths[column][VALUE_AFTER] > 0) {
@@ -107,12 +107,8 @@ namespace OpenLogReplicator {
             } else {
                 uint64_t baseMax = valuesMax >> 6;
                 for (uint64_t base = 0; base <= baseMax; ++base) {
-                    auto column = static_cast<typeCol>(base << 6);
-                    for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                        if (valuesSet[base] < mask)
-                            break;
-                        if ((valuesSet[base] & mask) == 0)
-                            continue;
+                    for (uint64_t set = valuesSet[base]; set != 0; set &= set - 1) {
+                        auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                         if (values[column][VALUE_BEFORE] != nullptr) {
                             if (lengths[column][VALUE_BEFORE] > 0) {
@@ -36,7 +36,6 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "../common/SysUser.h"
 #include "../metadata/Metadata.h"
 #include "../metadata/Schema.h"
-#include "../metadata/SchemaElement.h"
 #include "Builder.h"
 #include "SystemTransaction.h"
 
@@ -66,82 +65,82 @@ namespace OpenLogReplicator {
 
     SystemTransaction::~SystemTransaction() {
         if (sysCColTmp != nullptr) {
-            delete sysCColTmp;
+            metadata->schema->arena.destroy(sysCColTmp);
             sysCColTmp = nullptr;
         }
 
         if (sysCColTmp != nullptr) {
-            delete sysCColTmp;
+            metadata->schema->arena.destroy(sysCColTmp);
             sysCColTmp = nullptr;
         }
 
         if (sysCDefTmp != nullptr) {
-            delete sysCDefTmp;
+            metadata->schema->arena.destroy(sysCDefTmp);
             sysCDefTmp = nullptr;
         }
 
         if (sysColTmp != nullptr) {
-            delete sysColTmp;
+            metadata->schema->arena.destroy(sysColTmp);
             sysColTmp = nullptr;
         }
 
         if (sysDeferredStgTmp != nullptr) {
-            delete sysDeferredStgTmp;
+            metadata->schema->arena.destroy(sysDeferredStgTmp);
             sysDeferredStgTmp = nullptr;
         }
 
         if (sysEColTmp != nullptr) {
-            delete sysEColTmp;
+            metadata->schema->arena.destroy(sysEColTmp);
             sysEColTmp = nullptr;
         }
 
         if (sysLobTmp != nullptr) {
-            delete sysLobTmp;
+            metadata->schema->arena.destroy(sysLobTmp);
             sysLobTmp = nullptr;
         }
 
         if (sysLobCompPartTmp != nullptr) {
-            delete sysLobCompPartTmp;
+            metadata->schema->arena.destroy(sysLobCompPartTmp);
             sysLobCompPartTmp = nullptr;
         }
 
         if (sysLobFragTmp != nullptr) {
-            delete sysLobFragTmp;
+            metadata->schema->arena.destroy(sysLobFragTmp);
             sysLobFragTmp = nullptr;
         }
 
         if (sysObjTmp != nullptr) {
-            delete sysObjTmp;
+            metadata->schema->arena.destroy(sysObjTmp);
             sysObjTmp = nullptr;
         }
 
         if (sysTabTmp != nullptr) {
-            delete sysTabTmp;
+            metadata->schema->arena.destroy(sysTabTmp);
             sysTabTmp = nullptr;
         }
 
         if (sysTabComPartTmp != nullptr) {
-            delete sysTabComPartTmp;
+            metadata->schema->arena.destroy(sysTabComPartTmp);
             sysTabComPartTmp = nullptr;
         }
 
         if (sysTabPartTmp != nullptr) {
-            delete sysTabPartTmp;
+            metadata->schema->arena.destroy(sysTabPartTmp);
             sysTabPartTmp = nullptr;
         }
 
         if (sysTabSubPartTmp != nullptr) {
-            delete sysTabSubPartTmp;
+            metadata->schema->arena.destroy(sysTabSubPartTmp);
             sysTabSubPartTmp = nullptr;
         }
 
         if (sysTsTmp != nullptr) {
-            delete sysTsTmp;
+            metadata->schema->arena.destroy(sysTsTmp);
             sysTsTmp = nullptr;
         }
 
         if (sysUserTmp != nullptr) {
-            delete sysUserTmp;
+            metadata->schema->arena.destroy(sysUserTmp);
             sysUserTmp = nullptr;
         }
     }
@@ -332,18 +331,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.CCOL$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysCColDrop(sysCCol);
-            delete sysCCol;
+            metadata->schema->arena.destroy(sysCCol);
         }
-        sysCColTmp = new SysCCol(rowId, 0, 0, 0, 0, 0);
+        sysCColTmp = metadata->schema->arena.create<SysCCol>(rowId, 0, 0, 0, 0, 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "CON#") {
                     updateNumber32u(sysCColTmp->con, 0, column, table, offset);
@@ -368,18 +363,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.CDEF$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysCDefDrop(sysCDef);
-            delete sysCDef;
+            metadata->schema->arena.destroy(sysCDef);
         }
-        sysCDefTmp = new SysCDef(rowId, 0, 0, 0);
+        sysCDefTmp = metadata->schema->arena.create<SysCDef>(rowId, 0, 0, 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "CON#") {
                     updateNumber32u(sysCDefTmp->con, 0, column, table, offset);
@@ -402,19 +393,15 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.COL$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysColDrop(sysCol);
-            delete sysCol;
+            metadata->schema->arena.destroy(sysCol);
         }
-        sysColTmp = new SysCol(rowId, 0, 0, 0, 0, "", 0, 0, -1, -1,
-                               0, 0, 0, 0, 0);
+        sysColTmp = metadata->schema->arena.create<SysCol>(rowId, 0, 0, 0, 0, "", 0, 0, -1, -1,
+                                                           0, 0, 0, 0, 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysColTmp->obj, 0, column, table, offset);
@@ -457,18 +444,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.DEFERRED_STG$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysDeferredStgDrop(sysDeferredStg);
-            delete sysDeferredStg;
+            metadata->schema->arena.destroy(sysDeferredStg);
         }
-        sysDeferredStgTmp = new SysDeferredStg(rowId, 0, 0, 0);
+        sysDeferredStgTmp = metadata->schema->arena.create<SysDeferredStg>(rowId, 0, 0, 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysDeferredStgTmp->obj, 0, column, table, offset);
@@ -489,18 +472,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.ECOL$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysEColDrop(sysECol);
-            delete sysECol;
+            metadata->schema->arena.destroy(sysECol);
         }
-        sysEColTmp = new SysECol(rowId, 0, 0, -1);
+        sysEColTmp = metadata->schema->arena.create<SysECol>(rowId, 0, 0, -1);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "TABOBJ#") {
                     updateNumber32u(sysEColTmp->tabObj, 0, column, table, offset);
@@ -523,18 +502,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.LOB$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysLobDrop(sysLob);
-            delete sysLob;
+            metadata->schema->arena.destroy(sysLob);
         }
-        sysLobTmp = new SysLob(rowId, 0, 0, 0, 0, 0);
+        sysLobTmp = metadata->schema->arena.create<SysLob>(rowId, 0, 0, 0, 0, 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysLobTmp->obj, 0, column, table, offset);
@@ -561,18 +536,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.LOBCOMPPART$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysLobCompPartDrop(sysLobCompPart);
-            delete sysLobCompPart;
+            metadata->schema->arena.destroy(sysLobCompPart);
         }
-        sysLobCompPartTmp = new SysLobCompPart(rowId, 0, 0);
+        sysLobCompPartTmp = metadata->schema->arena.create<SysLobCompPart>(rowId, 0, 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "PARTOBJ#") {
                     updateNumber32u(sysLobCompPartTmp->partObj, 0, column, table, offset);
@@ -593,18 +564,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.LOBFRAG$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysLobFragDrop(sysLobFrag);
-            delete sysLobFrag;
+            metadata->schema->arena.destroy(sysLobFrag);
         }
-        sysLobFragTmp = new SysLobFrag(rowId, 0, 0, 0);
+        sysLobFragTmp = metadata->schema->arena.create<SysLobFrag>(rowId, 0, 0, 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "FRAGOBJ#") {
                     updateNumber32u(sysLobFragTmp->fragObj, 0, column, table, offset);
@@ -627,18 +594,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.OBJ$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysObjDrop(sysObj);
-            delete sysObj;
+            metadata->schema->arena.destroy(sysObj);
         }
-        sysObjTmp = new SysObj(rowId, 0, 0, 0, 0, "", 0, 0, false);
+        sysObjTmp = metadata->schema->arena.create<SysObj>(rowId, 0, 0, 0, 0, "", 0, 0, false);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OWNER#") {
                     updateNumber32u(sysObjTmp->owner, 0, column, table, offset);
@@ -667,18 +630,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.TAB$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysTabDrop(sysTab);
-            delete sysTab;
+            metadata->schema->arena.destroy(sysTab);
         }
-        sysTabTmp = new SysTab(rowId, 0, 0, 0, 0, 0, 0, 0, 0);
+        sysTabTmp = metadata->schema->arena.create<SysTab>(rowId, 0, 0, 0, 0, 0, 0, 0, 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysTabTmp->obj, 0, column, table, offset);
@@ -707,18 +666,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.TABCOMPART$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysTabComPartDrop(sysTabComPart);
-            delete sysTabComPart;
+            metadata->schema->arena.destroy(sysTabComPart);
         }
-        sysTabComPartTmp = new SysTabComPart(rowId, 0, 0, 0);
+        sysTabComPartTmp = metadata->schema->arena.create<SysTabComPart>(rowId, 0, 0, 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysTabComPartTmp->obj, 0, column, table, offset);
@@ -741,18 +696,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.TABPART$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysTabPartDrop(sysTabPart);
-            delete sysTabPart;
+            metadata->schema->arena.destroy(sysTabPart);
         }
-        sysTabPartTmp = new SysTabPart(rowId, 0, 0, 0);
+        sysTabPartTmp = metadata->schema->arena.create<SysTabPart>(rowId, 0, 0, 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysTabPartTmp->obj, 0, column, table, offset);
@@ -775,18 +726,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.TABSUBPART$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysTabSubPartDrop(sysTabSubPart);
-            delete sysTabSubPart;
+            metadata->schema->arena.destroy(sysTabSubPart);
         }
-        sysTabSubPartTmp = new SysTabSubPart(rowId, 0, 0, 0);
+        sysTabSubPartTmp = metadata->schema->arena.create<SysTabSubPart>(rowId, 0, 0, 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysTabSubPartTmp->obj, 0, column, table, offset);
@@ -809,18 +756,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.TS$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysTsDrop(sysTs);
-            delete sysTs;
+            metadata->schema->arena.destroy(sysTs);
         }
-        sysTsTmp = new SysTs(rowId, 0, "", 0);
+        sysTsTmp = metadata->schema->arena.create<SysTs>(rowId, 0, "", 0);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "TS#") {
                     updateNumber32u(sysTsTmp->ts, 0, column, table, offset);
@@ -843,18 +786,14 @@ namespace OpenLogReplicator {
                 throw RuntimeException(50022, "ddl: duplicate SYS.USER$: (rowid: " + rowId.toString() + ") for insert at offset: " +
                                        std::to_string(offset));
             metadata->schema->dictSysUserDrop(sysUser);
-            delete sysUser;
+            metadata->schema->arena.destroy(sysUser);
         }
-        sysUserTmp = new SysUser(rowId, 0, "", 0, 0, false);
+        sysUserTmp = metadata->schema->arena.create<SysUser>(rowId, 0, "", 0, 0, false);
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "USER#") {
                     updateNumber32u(sysUserTmp->user, 0, column, table, offset);
@@ -950,17 +889,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.CCOL$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysCColTmp = new SysCCol(rowId, 0, 0, 0, 0, 0);
+            sysCColTmp = metadata->schema->arena.create<SysCCol>(rowId, 0, 0, 0, 0, 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "CON#") {
                     updateNumber32u(sysCColTmp->con, 0, column, table, offset);
@@ -988,17 +923,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.CDEF$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysCDefTmp = new SysCDef(rowId, 0, 0, 0);
+            sysCDefTmp = metadata->schema->arena.create<SysCDef>(rowId, 0, 0, 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "CON#") {
                     updateNumber32u(sysCDefTmp->con, 0, column, table, offset);
@@ -1024,18 +955,14 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.COL$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysColTmp = new SysCol(rowId, 0, 0, 0, 0, "", 0, 0, -1, -1,
-                                   0, 0, 0, 0, 0);
+            sysColTmp = metadata->schema->arena.create<SysCol>(rowId, 0, 0, 0, 0, "", 0, 0, -1, -1,
+                                                               0, 0, 0, 0, 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysColTmp->obj, 0, column, table, offset);
@@ -1081,17 +1008,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.DEFERRED_STG$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysDeferredStgTmp = new SysDeferredStg(rowId, 0, 0, 0);
+            sysDeferredStgTmp = metadata->schema->arena.create<SysDeferredStg>(rowId, 0, 0, 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysDeferredStgTmp->obj, 0, column, table, offset);
@@ -1115,17 +1038,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.ECOL$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysEColTmp = new SysECol(rowId, 0, 0, -1);
+            sysEColTmp = metadata->schema->arena.create<SysECol>(rowId, 0, 0, -1);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "TABOBJ#") {
                     updateNumber32u(sysEColTmp->tabObj, 0, column, table, offset);
@@ -1151,17 +1070,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.LOB$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysLobTmp = new SysLob(rowId, 0, 0, 0, 0, 0);
+            sysLobTmp = metadata->schema->arena.create<SysLob>(rowId, 0, 0, 0, 0, 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysLobTmp->obj, 0, column, table, offset);
@@ -1191,17 +1106,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.LOBCOMPPART$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysLobCompPartTmp = new SysLobCompPart(rowId, 0, 0);
+            sysLobCompPartTmp = metadata->schema->arena.create<SysLobCompPart>(rowId, 0, 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "PARTOBJ#") {
                     updateNumber32u(sysLobCompPartTmp->partObj, 0, column, table, offset);
@@ -1225,17 +1136,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.LOBFRAG$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysLobFragTmp = new SysLobFrag(rowId, 0, 0, 0);
+            sysLobFragTmp = metadata->schema->arena.create<SysLobFrag>(rowId, 0, 0, 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "FRAGOBJ#") {
                     updateNumber32u(sysLobFragTmp->fragObj, 0, column, table, offset);
@@ -1261,17 +1168,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.OBJ$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysObjTmp = new SysObj(rowId, 0, 0, 0, 0, "", 0, 0, false);
+            sysObjTmp = metadata->schema->arena.create<SysObj>(rowId, 0, 0, 0, 0, "", 0, 0, false);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OWNER#") {
                     updateNumber32u(sysObjTmp->owner, 0, column, table, offset);
@@ -1303,17 +1206,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.TAB$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysTabTmp = new SysTab(rowId, 0, 0, 0, 0, 0, 0, 0, 0);
+            sysTabTmp = metadata->schema->arena.create<SysTab>(rowId, 0, 0, 0, 0, 0, 0, 0, 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysTabTmp->obj, 0, column, table, offset);
@@ -1345,17 +1244,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.TABCOMPART$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysTabComPartTmp = new SysTabComPart(rowId, 0, 0, 0);
+            sysTabComPartTmp = metadata->schema->arena.create<SysTabComPart>(rowId, 0, 0, 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysTabComPartTmp->obj, 0, column, table, offset);
@@ -1381,17 +1276,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.TABPART$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysTabPartTmp = new SysTabPart(rowId, 0, 0, 0);
+            sysTabPartTmp = metadata->schema->arena.create<SysTabPart>(rowId, 0, 0, 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysTabPartTmp->obj, 0, column, table, offset);
@@ -1416,17 +1307,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.TABSUBPART$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysTabSubPartTmp = new SysTabSubPart(rowId, 0, 0, 0);
+            sysTabSubPartTmp = metadata->schema->arena.create<SysTabSubPart>(rowId, 0, 0, 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "OBJ#") {
                     updateNumber32u(sysTabSubPartTmp->obj, 0, column, table, offset);
@@ -1452,17 +1339,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.TS$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysTsTmp = new SysTs(rowId, 0, "", 0);
+            sysTsTmp = metadata->schema->arena.create<SysTs>(rowId, 0, "", 0);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "TS#") {
                     updateNumber32u(sysTsTmp->ts, 0, column, table, offset);
@@ -1488,17 +1371,13 @@ namespace OpenLogReplicator {
                     ctx->logTrace(TRACE_SYSTEM, "missing SYS.USER$: (rowid: " + rowId.toString() + ") for update");
                 return;
             }
-            sysUserTmp = new SysUser(rowId, 0, "", 0, 0, false);
+            sysUserTmp = metadata->schema->arena.create<SysUser>(rowId, 0, "", 0, 0, false);
         }
 
         uint64_t baseMax = builder->valuesMax >> 6;
         for (uint64_t base = 0; base <= baseMax; ++base) {
-            auto column = static_cast<typeCol>(base << 6);
-            for (uint64_t mask = 1; mask != 0; mask <<= 1, ++column) {
-                if (builder->valuesSet[base] < mask)
-                    break;
-                if ((builder->valuesSet[base] & mask) == 0)
-                    continue;
+            for (uint64_t set = builder->valuesSet[base]; set != 0; set &= set - 1) {
+                auto column = static_cast<typeCol>((base << 6) | __builtin_ctzll(set));
 
                 if (table->columns[column]->name == "USER#") {
                     updateNumber32u(sysUserTmp->user, 0, column, table, offset);
@@ -1596,7 +1475,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysCColDrop(sysCColTmp);
         metadata->schema->sysCColSetTouched.erase(sysCColTmp);
-        delete sysCColTmp;
+        metadata->schema->arena.destroy(sysCColTmp);
         sysCColTmp = nullptr;
     }
 
@@ -1612,7 +1491,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysCDefDrop(sysCDefTmp);
         metadata->schema->sysCDefSetTouched.erase(sysCDefTmp);
-        delete sysCDefTmp;
+        metadata->schema->arena.destroy(sysCDefTmp);
         sysCDefTmp = nullptr;
     }
 
@@ -1628,7 +1507,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysColDrop(sysColTmp);
         metadata->schema->sysColSetTouched.erase(sysColTmp);
-        delete sysColTmp;
+        metadata->schema->arena.destroy(sysColTmp);
         sysColTmp = nullptr;
     }
 
@@ -1644,7 +1523,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysDeferredStgDrop(sysDeferredStgTmp);
         metadata->schema->sysDeferredStgSetTouched.erase(sysDeferredStgTmp);
-        delete sysDeferredStgTmp;
+        metadata->schema->arena.destroy(sysDeferredStgTmp);
         sysDeferredStgTmp = nullptr;
     }
 
@@ -1660,7 +1539,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysEColDrop(sysEColTmp);
         metadata->schema->sysEColSetTouched.erase(sysEColTmp);
-        delete sysEColTmp;
+        metadata->schema->arena.destroy(sysEColTmp);
         sysEColTmp = nullptr;
     }
 
@@ -1676,7 +1555,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysLobDrop(sysLobTmp);
         metadata->schema->sysLobSetTouched.erase(sysLobTmp);
-        delete sysLobTmp;
+        metadata->schema->arena.destroy(sysLobTmp);
         sysLobTmp = nullptr;
     }
 
@@ -1692,7 +1571,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysLobCompPartDrop(sysLobCompPartTmp);
         metadata->schema->sysLobCompPartSetTouched.erase(sysLobCompPartTmp);
-        delete sysLobCompPartTmp;
+        metadata->schema->arena.destroy(sysLobCompPartTmp);
         sysLobCompPartTmp = nullptr;
     }
 
@@ -1708,7 +1587,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysLobFragDrop(sysLobFragTmp);
         metadata->schema->sysLobFragSetTouched.erase(sysLobFragTmp);
-        delete sysLobFragTmp;
+        metadata->schema->arena.destroy(sysLobFragTmp);
         sysLobFragTmp = nullptr;
     }
 
@@ -1724,7 +1603,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysObjDrop(sysObjTmp);
         metadata->schema->sysObjSetTouched.erase(sysObjTmp);
-        delete sysObjTmp;
+        metadata->schema->arena.destroy(sysObjTmp);
         sysObjTmp = nullptr;
     }
 
@@ -1740,7 +1619,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysTabDrop(sysTabTmp);
         metadata->schema->sysTabSetTouched.erase(sysTabTmp);
-        delete sysTabTmp;
+        metadata->schema->arena.destroy(sysTabTmp);
         sysTabTmp = nullptr;
     }
 
@@ -1756,7 +1635,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysTabComPartDrop(sysTabComPartTmp);
         metadata->schema->sysTabComPartSetTouched.erase(sysTabComPartTmp);
-        delete sysTabComPartTmp;
+        metadata->schema->arena.destroy(sysTabComPartTmp);
         sysTabComPartTmp = nullptr;
     }
 
@@ -1772,7 +1651,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysTabPartDrop(sysTabPartTmp);
         metadata->schema->sysTabPartSetTouched.erase(sysTabPartTmp);
-        delete sysTabPartTmp;
+        metadata->schema->arena.destroy(sysTabPartTmp);
         sysTabPartTmp = nullptr;
     }
 
@@ -1788,7 +1667,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysTabSubPartDrop(sysTabSubPartTmp);
         metadata->schema->sysTabSubPartSetTouched.erase(sysTabSubPartTmp);
-        delete sysTabSubPartTmp;
+        metadata->schema->arena.destroy(sysTabSubPartTmp);
         sysTabSubPartTmp = nullptr;
     }
 
@@ -1803,7 +1682,7 @@ namespace OpenLogReplicator {
         }
 
         metadata->schema->dictSysTsDrop(sysTsTmp);
-        delete sysTsTmp;
+        metadata->schema->arena.destroy(sysTsTmp);
         sysTsTmp = nullptr;
     }
 
@@ -1819,7 +1698,7 @@ namespace OpenLogReplicator {
 
         metadata->schema->dictSysUserDrop(sysUserTmp);
         metadata->schema->sysUserSetTouched.erase(sysUserTmp);
-        delete sysUserTmp;
+        metadata->schema->arena.destroy(sysUserTmp);
         sysUserTmp = nullptr;
     }
 
@@ -1905,10 +1784,8 @@ namespace OpenLogReplicator {
         metadata->schema->scn = scn;
         metadata->schema->dropUnusedMetadata(metadata->users, msgsDropped);
 
-        for (SchemaElement* element: metadata->schemaElements)
-            metadata->schema->buildMaps(element->owner, element->table, element->keys, element->keysStr, element->options,
-                                        msgsUpdated, metadata->suppLogDbPrimary, metadata->suppLogDbAll,
-                                        metadata->defaultCharacterMapId, metadata->defaultCharacterNcharMapId);
+        metadata->schema->buildMaps(metadata->schemaMatcher, msgsUpdated, metadata->suppLogDbPrimary, metadata->suppLogDbAll,
+                                    metadata->defaultCharacterMapId, metadata->defaultCharacterNcharMapId);
         metadata->schema->resetTouched();
 
         for (const auto& msg: msgsDropped) {
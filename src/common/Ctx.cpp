@@ -22,9 +22,15 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <cstdlib>
 #include <csignal>
 #include <execinfo.h>
+#include <cstring>
 #include <iostream>
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
 #include <set>
 #include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 #include "Ctx.h"
@@ -60,16 +66,31 @@ namespace OpenLogReplicator {
             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
+    const char* Ctx::memoryModules[MEMORY_MODULES_NUM] = {"builder", "parser", "reader", "transaction"};
+    const char* Ctx::threadRoles[THREAD_ROLES] = {"reader", "parser", "checkpoint", "writer"};
+
     typeIntX typeIntX::BASE10[TYPE_INTX_DIGITS][10];
 
+    // Memory chunk cache of the calling thread
+    thread_local Ctx* threadMemoryCacheCtx = nullptr;
+    thread_local MemoryCache* threadMemoryCache = nullptr;
+
     Ctx::Ctx() :
             bigEndian(false),
             memoryMinMb(0),
             memoryMaxMb(0),
             memoryChunks(nullptr),
+            memoryChunksNext(nullptr),
+            memoryChunksSlots(0),
+            memoryFreeHead(0),
+            memoryEmptyHead(0),
+            memoryWaiters(0),
+            memoryPool(nullptr),
+            memoryPoolSize(0),
+            memoryHugePages(MEMORY_HUGE_PAGES_NONE),
             memoryChunksMin(0),
             memoryChunksAllocated(0),
-            memoryChunksFree(0),
+            memoryChunksUsed(0),
             memoryChunksMax(0),
             memoryChunksHWM(0),
             memoryChunksReusable(0),
@@ -86,6 +107,8 @@ namespace OpenLogReplicator {
             checkpointIntervalMb(500),
             checkpointKeep(100),
             schemaForceInterval(20),
+            schemaDelta(0),
+            lazyTables(0),
             redoReadSleepUs(50000),
             redoVerifyDelayUs(0),
             archReadSleepUs(10000000),
@@ -93,6 +116,9 @@ namespace OpenLogReplicator {
             refreshIntervalUs(10000000),
             pollIntervalUs(100000),
             queueSize(65536),
+            numaNodeReader(NUMA_NODE_NONE),
+            numaNodeParser(NUMA_NODE_NONE),
+            numaNodeWriter(NUMA_NODE_NONE),
             dumpPath("."),
             stopLogSwitches(0),
             stopCheckpoints(0),
@@ -117,21 +143,62 @@ namespace OpenLogReplicator {
             write64(write64Little),
             writeScn(writeScnLittle) {
         mainThread = pthread_self();
+
+        for (uint64_t module = 0; module < MEMORY_MODULES_NUM; ++module) {
+            memoryModulesAllocated[module] = 0;
+            memoryModulesHWM[module] = 0;
+            memoryModulesReleased[module] = 0;
+            memoryModulesSoft[module] = 0;
+            memoryModulesHard[module] = 0;
+        }
+
+        for (uint64_t role = 0; role < THREAD_ROLES; ++role)
+            threadPriority[role] = THREAD_PRIORITY_NONE;
     }
 
     Ctx::~Ctx() {
         lobIdToXidMap.clear();
 
-        while (memoryChunksAllocated > 0) {
-            --memoryChunksAllocated;
-            free(memoryChunks[memoryChunksAllocated]);
-            memoryChunks[memoryChunksAllocated] = nullptr;
+        // All threads are finished, chunks left in their caches are free
+        for (MemoryCache* cache : memoryCaches) {
+            for (auto& cacheChunk : cache->chunks) {
+                uint8_t* chunk = cacheChunk.exchange(nullptr);
+                if (chunk != nullptr) {
+                    if (!memoryPoolChunk(chunk))
+                        free(chunk);
+                    --memoryChunksAllocated;
+                }
+            }
+            delete cache;
+        }
+        memoryCaches.clear();
+        if (threadMemoryCacheCtx == this) {
+            threadMemoryCacheCtx = nullptr;
+            threadMemoryCache = nullptr;
         }
 
         if (memoryChunks != nullptr) {
+            int64_t slot;
+            while ((slot = memoryPop(memoryFreeHead, memoryChunksNext)) >= 0) {
+                if (!memoryPoolChunk(memoryChunks[slot]))
+                    free(memoryChunks[slot]);
+                memoryChunks[slot] = nullptr;
+                --memoryChunksAllocated;
+            }
+
             delete[] memoryChunks;
             memoryChunks = nullptr;
         }
+
+        if (memoryChunksNext != nullptr) {
+            delete[] memoryChunksNext;
+            memoryChunksNext = nullptr;
+        }
+
+        if (memoryPool != nullptr) {
+            munmap(memoryPool, memoryPoolSize);
+            memoryPool = nullptr;
+        }
     }
 
     void Ctx::setBigEndian() {
@@ -554,7 +621,8 @@ namespace OpenLogReplicator {
         return ret.GetString();
     }
 
-    void Ctx::initialize(uint64_t newMemoryMinMb, uint64_t newMemoryMaxMb, uint64_t newReadBufferMax) {
+    void Ctx::initialize(uint64_t newMemoryMinMb, uint64_t newMemoryMaxMb, uint64_t newReadBufferMax, uint64_t newMemoryHugePages) {
+        memoryHugePages = newMemoryHugePages;
         memoryMinMb = newMemoryMinMb;
         memoryMaxMb = newMemoryMaxMb;
         memoryChunksMin = (memoryMinMb / MEMORY_CHUNK_SIZE_MB);
@@ -563,18 +631,157 @@ namespace OpenLogReplicator {
         buffersFree = newReadBufferMax;
         bufferSizeMax = readBufferMax * MEMORY_CHUNK_SIZE;
 
-        memoryChunks = new uint8_t*[memoryMaxMb / MEMORY_CHUNK_SIZE_MB];
-        for (uint64_t i = 0; i < memoryChunksMin; ++i) {
-            memoryChunks[i] = reinterpret_cast<uint8_t*>(aligned_alloc(MEMORY_ALIGNMENT, MEMORY_CHUNK_SIZE));
-            if (memoryChunks[i] == nullptr)
+        memoryChunksSlots = memoryMaxMb / MEMORY_CHUNK_SIZE_MB;
+        memoryChunks = new uint8_t*[memoryChunksSlots];
+        memoryChunksNext = new std::atomic<uint32_t>[memoryChunksSlots];
+        for (uint64_t i = 0; i < memoryChunksSlots; ++i) {
+            memoryChunks[i] = nullptr;
+            memoryChunksNext[i] = 0;
+        }
+
+        if (memoryHugePages != MEMORY_HUGE_PAGES_NONE)
+            memoryReservePool();
+
+        for (uint64_t i = memoryChunksSlots; i > memoryChunksMin; --i)
+            memoryPush(memoryEmptyHead, memoryChunksNext, i - 1);
+        for (uint64_t i = memoryChunksMin; i > 0; --i) {
+            if (memoryPool != nullptr)
+                memoryChunks[i - 1] = memoryPool + (i - 1) * MEMORY_CHUNK_SIZE;
+            else
+                memoryChunks[i - 1] = reinterpret_cast<uint8_t*>(aligned_alloc(MEMORY_ALIGNMENT, MEMORY_CHUNK_SIZE));
+            if (memoryChunks[i - 1] == nullptr)
                 throw RuntimeException(10016, "couldn't allocate " + std::to_string(MEMORY_CHUNK_SIZE_MB) +
                                        " bytes memory for: memory chunks#2");
             ++memoryChunksAllocated;
-            ++memoryChunksFree;
+            memoryPush(memoryFreeHead, memoryChunksNext, i - 1);
         }
         memoryChunksHWM = static_cast<uint64_t>(memoryChunksMin);
     }
 
+    void Ctx::memoryReservePool() {
+        uint64_t pageSize = 2 * 1024 * 1024;
+        if (memoryHugePages == MEMORY_HUGE_PAGES_1GB)
+            pageSize = 1024 * 1024 * 1024;
+        memoryPoolSize = ((memoryChunksSlots * MEMORY_CHUNK_SIZE + pageSize - 1) / pageSize) * pageSize;
+
+        void* pool = MAP_FAILED;
+        if (memoryHugePages == MEMORY_HUGE_PAGES_2MB || memoryHugePages == MEMORY_HUGE_PAGES_1GB) {
+            int pageFlag = (memoryHugePages == MEMORY_HUGE_PAGES_1GB ? 30 : 21) << MAP_HUGE_SHIFT;
+            pool = mmap(nullptr, memoryPoolSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | pageFlag, -1, 0);
+            if (pool == MAP_FAILED) {
+                warning(60038, "huge pages of " + std::to_string(pageSize / 1024 / 1024) + " MB not available (" + strerror(errno) +
+                        "), using transparent huge pages");
+                hint("reserve huge pages with vm.nr_hugepages or hugepagesz/hugepages kernel parameters");
+                memoryHugePages = MEMORY_HUGE_PAGES_TRANSPARENT;
+                pageSize = 2 * 1024 * 1024;
+                memoryPoolSize = ((memoryChunksSlots * MEMORY_CHUNK_SIZE + pageSize - 1) / pageSize) * pageSize;
+            }
+        }
+
+        if (pool == MAP_FAILED) {
+            // Align the pool to the huge page size by trimming the ends of a bigger mapping
+            uint64_t mapSize = memoryPoolSize + pageSize;
+            pool = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (pool == MAP_FAILED)
+                throw RuntimeException(10016, "couldn't allocate " + std::to_string(memoryPoolSize / 1024 / 1024) +
+                                       " bytes memory for: memory pool");
+
+            uint64_t head = (pageSize - (reinterpret_cast<uint64_t>(pool) % pageSize)) % pageSize;
+            if (head > 0)
+                munmap(pool, head);
+            munmap(reinterpret_cast<uint8_t*>(pool) + head + memoryPoolSize, pageSize - head);
+            pool = reinterpret_cast<uint8_t*>(pool) + head;
+
+            if (madvise(pool, memoryPoolSize, MADV_HUGEPAGE) != 0)
+                warning(60038, "transparent huge pages not available (" + std::string(strerror(errno)) + "), using regular pages");
+        }
+
+        memoryPool = reinterpret_cast<uint8_t*>(pool);
+        info(0, "memory pool of " + std::to_string(memoryPoolSize / 1024 / 1024) + " MB reserved");
+    }
+
+    bool Ctx::memoryPoolChunk(const uint8_t* chunk) const {
+        return memoryPool != nullptr && chunk >= memoryPool && chunk < memoryPool + memoryChunksSlots * MEMORY_CHUNK_SIZE;
+    }
+
+    void Ctx::bindNumaNode(int64_t node, uint64_t role) {
+        if (node == NUMA_NODE_NONE)
+            return;
+
+        std::string cpuListName("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::ifstream cpuListFile(cpuListName);
+        std::string cpuList;
+        cpu_set_t cpuSet;
+        if (!cpuListFile.good() || !std::getline(cpuListFile, cpuList) || !parseCpuList(cpuList, cpuSet)) {
+            warning(60039, "NUMA node: " + std::to_string(node) + " not available for " + threadRoles[role] + " thread");
+            return;
+        }
+
+        // CPUs defined for the role explicitly take precedence over the CPUs of the node
+        if (threadCpus[role].empty() && pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0) {
+            warning(60039, "NUMA node: " + std::to_string(node) + " - can't set CPU affinity for " + threadRoles[role] + " thread");
+            return;
+        }
+
+        // Memory touched first by the thread comes from the node
+        uint64_t nodeMask[(NUMA_NODE_MAX + 64) / 64] = {};
+        nodeMask[node / 64] = 1ULL << (node % 64);
+        if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, nodeMask, NUMA_NODE_MAX + 1) != 0) {
+            warning(60039, "NUMA node: " + std::to_string(node) + " - can't set memory policy for " + threadRoles[role] + " thread: " + strerror(errno));
+            return;
+        }
+
+        info(0, std::string(threadRoles[role]) + " thread bound to NUMA node: " + std::to_string(node));
+    }
+
+    // List of ranges like: 0-3,8-11
+    bool Ctx::parseCpuList(const std::string& cpuList, cpu_set_t& cpuSet) {
+        CPU_ZERO(&cpuSet);
+        const char* pos = cpuList.c_str();
+        while (true) {
+            if (*pos < '0' || *pos > '9')
+                return false;
+            char* end;
+            uint64_t first = strtoull(pos, &end, 10);
+            uint64_t last = first;
+            if (*end == '-') {
+                pos = end + 1;
+                if (*pos < '0' || *pos > '9')
+                    return false;
+                last = strtoull(pos, &end, 10);
+            }
+            if (first > last || last >= CPU_SETSIZE)
+                return false;
+            for (uint64_t cpu = first; cpu <= last; ++cpu)
+                CPU_SET(cpu, &cpuSet);
+
+            if (*end == 0)
+                return true;
+            if (*end != ',')
+                return false;
+            pos = end + 1;
+        }
+    }
+
+    std::string Ctx::cpuListString(const cpu_set_t& cpuSet) {
+        std::string cpuList;
+        for (uint64_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &cpuSet))
+                continue;
+            uint64_t last = cpu;
+            while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, &cpuSet))
+                ++last;
+
+            if (!cpuList.empty())
+                cpuList += ",";
+            cpuList += std::to_string(cpu);
+            if (last > cpu)
+                cpuList += "-" + std::to_string(last);
+            cpu = last;
+        }
+        return cpuList;
+    }
+
     void Ctx::wakeAllOutOfMemory() {
         std::unique_lock<std::mutex> lck(memoryMtx);
         condOutOfMemory.notify_all();
@@ -585,69 +792,287 @@ namespace OpenLogReplicator {
     }
 
     uint64_t Ctx::getFreeMemory() {
-        return memoryChunksFree * MEMORY_CHUNK_SIZE_MB;
+        uint64_t used = memoryChunksUsed;
+        uint64_t allocated = memoryChunksAllocated;
+        if (allocated < used)
+            return 0;
+        return (allocated - used) * MEMORY_CHUNK_SIZE_MB;
     }
 
     uint64_t Ctx::getAllocatedMemory() const {
         return memoryChunksAllocated * MEMORY_CHUNK_SIZE_MB;
     }
 
-    uint8_t* Ctx::getMemoryChunk(const char* module, bool reusable) {
+    void Ctx::memoryPush(std::atomic<uint64_t>& head, std::atomic<uint32_t>* next, uint64_t slot) {
+        uint64_t oldHead = head.load();
+        uint64_t newHead;
+        do {
+            next[slot].store(static_cast<uint32_t>(oldHead & 0xFFFFFFFF), std::memory_order_relaxed);
+            newHead = (((oldHead >> 32) + 1) << 32) | (slot + 1);
+        } while (!head.compare_exchange_weak(oldHead, newHead));
+    }
+
+    int64_t Ctx::memoryPop(std::atomic<uint64_t>& head, std::atomic<uint32_t>* next) {
+        uint64_t oldHead = head.load();
+        uint64_t newHead;
+        do {
+            if ((oldHead & 0xFFFFFFFF) == 0)
+                return -1;
+            // The change counter makes the swap fail if the slot was taken and returned meanwhile
+            newHead = (((oldHead >> 32) + 1) << 32) | next[(oldHead & 0xFFFFFFFF) - 1].load(std::memory_order_relaxed);
+        } while (!head.compare_exchange_weak(oldHead, newHead));
+        return static_cast<int64_t>(oldHead & 0xFFFFFFFF) - 1;
+    }
+
+    uint8_t* Ctx::memoryPopChunk() {
+        int64_t slot = memoryPop(memoryFreeHead, memoryChunksNext);
+        if (slot < 0)
+            return nullptr;
+
+        uint8_t* chunk = memoryChunks[slot];
+        // Slots of the pool belong to their chunks
+        if (!memoryPoolChunk(chunk)) {
+            memoryChunks[slot] = nullptr;
+            memoryPush(memoryEmptyHead, memoryChunksNext, slot);
+        }
+        return chunk;
+    }
+
+    void Ctx::memoryPushChunk(uint8_t* chunk) {
+        // Chunks from the pool are never returned to the system, just not counted as allocated
+        if (memoryPoolChunk(chunk)) {
+            uint64_t slot = (chunk - memoryPool) / MEMORY_CHUNK_SIZE;
+            if (memoryChunksAllocated <= memoryChunksUsed + memoryChunksMin) {
+                memoryChunks[slot] = chunk;
+                memoryPush(memoryFreeHead, memoryChunksNext, slot);
+            } else {
+                --memoryChunksAllocated;
+                memoryPush(memoryEmptyHead, memoryChunksNext, slot);
+            }
+            return;
+        }
+
+        // Keep memoryChunksMin reserved
+        int64_t slot = -1;
+        if (memoryChunksAllocated <= memoryChunksUsed + memoryChunksMin)
+            slot = memoryPop(memoryEmptyHead, memoryChunksNext);
+        if (slot < 0) {
+            free(chunk);
+            --memoryChunksAllocated;
+            return;
+        }
+
+        memoryChunks[slot] = chunk;
+        memoryPush(memoryFreeHead, memoryChunksNext, slot);
+    }
+
+    MemoryCache* Ctx::memoryCache() {
+        if (threadMemoryCacheCtx == this)
+            return threadMemoryCache;
+
+        auto cache = new MemoryCache;
+        for (auto& cacheChunk : cache->chunks)
+            cacheChunk = nullptr;
+        {
+            std::unique_lock<std::mutex> lck(memoryMtx);
+            memoryCaches.push_back(cache);
+        }
+        threadMemoryCacheCtx = this;
+        threadMemoryCache = cache;
+        return cache;
+    }
+
+    void Ctx::memoryDrainCache(MemoryCache* cache) {
+        for (auto& cacheChunk : cache->chunks) {
+            uint8_t* chunk = cacheChunk.exchange(nullptr);
+            if (chunk != nullptr)
+                memoryPushChunk(chunk);
+        }
+    }
+
+    uint8_t* Ctx::memoryAllocateChunk(uint64_t module) {
+        uint64_t allocated = memoryChunksAllocated;
+        do {
+            if (allocated >= memoryChunksMax && !softShutdown)
+                return nullptr;
+        } while (!memoryChunksAllocated.compare_exchange_weak(allocated, allocated + 1));
+
+        uint8_t* chunk = nullptr;
+        if (memoryPool != nullptr) {
+            int64_t slot = memoryPop(memoryEmptyHead, memoryChunksNext);
+            if (slot >= 0)
+                chunk = memoryPool + slot * MEMORY_CHUNK_SIZE;
+        }
+        // Beyond the pool only during shutdown
+        if (chunk == nullptr)
+            chunk = reinterpret_cast<uint8_t*>(aligned_alloc(MEMORY_ALIGNMENT, MEMORY_CHUNK_SIZE));
+        if (chunk == nullptr) {
+            --memoryChunksAllocated;
+            throw RuntimeException(10016, "couldn't allocate " + std::to_string(MEMORY_CHUNK_SIZE_MB) + " bytes memory for: " + memoryModules[module]);
+        }
+
+        uint64_t hwm = memoryChunksHWM;
+        while (allocated + 1 > hwm && !memoryChunksHWM.compare_exchange_weak(hwm, allocated + 1));
+        return chunk;
+    }
+
+    uint64_t Ctx::getModuleMemory(uint64_t module) const {
+        return memoryModulesAllocated[module] * MEMORY_CHUNK_SIZE_MB;
+    }
+
+    uint64_t Ctx::getModuleMaxUsedMemory(uint64_t module) const {
+        return memoryModulesHWM[module] * MEMORY_CHUNK_SIZE_MB;
+    }
+
+    void Ctx::memoryWaitForModule(uint64_t module, uint64_t limit) {
         std::unique_lock<std::mutex> lck(memoryMtx);
+        ++memoryWaiters;
+        uint64_t released = memoryModulesReleased[module];
+        uint64_t stalledWaits = 0;
+        while (memoryModulesAllocated[module] >= limit && !softShutdown) {
+            if (trace & TRACE_SLEEP)
+                logTrace(TRACE_SLEEP, "Ctx:memoryWaitForModule " + std::string(memoryModules[module]) + " " +
+                         std::to_string(memoryModulesAllocated[module] * MEMORY_CHUNK_SIZE_MB) + "MB");
+            condOutOfMemory.wait_for(lck, std::chrono::seconds(1));
+
+            // Report once when no chunk of the module is released for a longer time, again only after the next release
+            if (memoryModulesReleased[module] != released) {
+                released = memoryModulesReleased[module];
+                stalledWaits = 0;
+            } else if (++stalledWaits == MEMORY_STALL_WAITS)
+                warning(60043, "memory for: " + std::string(memoryModules[module]) + " not released for " + std::to_string(MEMORY_STALL_WAITS) +
+                        " s, quota: " + std::to_string(limit * MEMORY_CHUNK_SIZE_MB) + "MB reached, waiting");
+        }
+        --memoryWaiters;
+    }
 
-        if (memoryChunksFree == 0) {
-            while (memoryChunksAllocated == memoryChunksMax && !softShutdown) {
-                if (memoryChunksReusable > 1) {
-                    warning(10067, "out of memory, but there are reusable memory chunks, trying to reuse some memory");
-
-                    if (trace & TRACE_SLEEP)
-                        logTrace(TRACE_SLEEP, "Ctx:getMemoryChunk");
-                    condOutOfMemory.wait(lck);
-                } else {
-                    hint("try to restart with higher value of 'memory-max-mb' parameter or if big transaction - add to 'skip-xid' list; "
-                         "transaction would be skipped");
-                    throw RuntimeException(10017, "out of memory");
-                }
+    void Ctx::throttleModule(uint64_t module) {
+        if (memoryModulesSoft[module] == 0 || memoryModulesAllocated[module] < memoryModulesSoft[module])
+            return;
+
+        memoryWaitForModule(module, memoryModulesSoft[module]);
+    }
+
+    uint8_t* Ctx::getMemoryChunk(uint64_t module, bool reusable) {
+        uint8_t* chunk = nullptr;
+
+        // Chunks of reusable modules are released by other threads - wait for them, others can't grow more
+        if (memoryModulesHard[module] != 0 && memoryModulesAllocated[module] >= memoryModulesHard[module]) {
+            if (!reusable) {
+                hint("try to restart with higher value of '" + std::string(memoryModules[module]) + "-hard-mb' parameter");
+                throw RuntimeException(10075, "out of memory for: " + std::string(memoryModules[module]) + ", quota: " +
+                                       std::to_string(memoryModulesHard[module] * MEMORY_CHUNK_SIZE_MB) + "MB reached");
             }
+            memoryWaitForModule(module, memoryModulesHard[module]);
+        }
 
-            if (memoryChunksFree == 0) {
-                memoryChunks[0] = reinterpret_cast<uint8_t*>(aligned_alloc(MEMORY_ALIGNMENT, MEMORY_CHUNK_SIZE));
-                if (memoryChunks[0] == nullptr) {
-                    throw RuntimeException(10016, "couldn't allocate " + std::to_string(MEMORY_CHUNK_SIZE_MB) +
-                                           " bytes memory for: " + module);
+        // Fast path: chunk freed earlier by this thread or a free chunk from the shared stack
+        MemoryCache* cache = memoryCache();
+        for (auto& cacheChunk : cache->chunks) {
+            if (cacheChunk.load(std::memory_order_relaxed) == nullptr)
+                continue;
+            chunk = cacheChunk.exchange(nullptr);
+            if (chunk != nullptr)
+                break;
+        }
+        if (chunk == nullptr)
+            chunk = memoryPopChunk();
+        if (chunk == nullptr)
+            chunk = memoryAllocateChunk(module);
+
+        // Out of memory: take chunks kept by other threads, then wait for some to be freed
+        if (chunk == nullptr) {
+            std::unique_lock<std::mutex> lck(memoryMtx);
+            ++memoryWaiters;
+
+            try {
+                while (true) {
+                    for (MemoryCache* otherCache : memoryCaches)
+                        memoryDrainCache(otherCache);
+
+                    chunk = memoryPopChunk();
+                    if (chunk == nullptr)
+                        chunk = memoryAllocateChunk(module);
+                    if (chunk != nullptr)
+                        break;
+
+                    if (memoryChunksReusable > 1) {
+                        warning(10067, "out of memory, but there are reusable memory chunks, trying to reuse some memory");
+
+                        if (trace & TRACE_SLEEP)
+                            logTrace(TRACE_SLEEP, "Ctx:getMemoryChunk");
+                        condOutOfMemory.wait(lck);
+                    } else {
+                        hint("try to restart with higher value of 'memory-max-mb' parameter or if big transaction - add to 'skip-xid' list; "
+                             "transaction would be skipped");
+                        throw RuntimeException(10017, "out of memory");
+                    }
                 }
-                ++memoryChunksFree;
-                ++memoryChunksAllocated;
+            } catch (RuntimeException& ex) {
+                --memoryWaiters;
+                throw;
             }
-
-            if (memoryChunksAllocated > memoryChunksHWM)
-                memoryChunksHWM = static_cast<uint64_t>(memoryChunksAllocated);
+            --memoryWaiters;
         }
 
-        --memoryChunksFree;
+        ++memoryChunksUsed;
         if (reusable)
             ++memoryChunksReusable;
-        return memoryChunks[memoryChunksFree];
+        uint64_t moduleAllocated = ++memoryModulesAllocated[module];
+        uint64_t moduleHWM = memoryModulesHWM[module];
+        while (moduleAllocated > moduleHWM && !memoryModulesHWM[module].compare_exchange_weak(moduleHWM, moduleAllocated));
+        return chunk;
     }
 
-    void Ctx::freeMemoryChunk(const char* module, uint8_t* chunk, bool reusable) {
-        std::unique_lock<std::mutex> lck(memoryMtx);
-
-        if (memoryChunksFree == memoryChunksAllocated)
-            throw RuntimeException(50001, "trying to free unknown memory block for: " + std::string(module));
-
-        // Keep memoryChunksMin reserved
-        if (memoryChunksFree >= memoryChunksMin) {
-            free(chunk);
-            --memoryChunksAllocated;
-        } else {
-            memoryChunks[memoryChunksFree] = chunk;
-            ++memoryChunksFree;
+    void Ctx::freeMemoryChunk(uint64_t module, uint8_t* chunk, bool reusable) {
+        if (memoryModulesAllocated[module].fetch_sub(1) == 0) {
+            ++memoryModulesAllocated[module];
+            throw RuntimeException(50001, "trying to free unknown memory block for: " + std::string(memoryModules[module]));
         }
+        --memoryChunksUsed;
         if (reusable)
             --memoryChunksReusable;
 
-        condOutOfMemory.notify_all();
+        // Keep the chunk for the next allocation of this thread unless somebody is waiting for memory
+        bool cached = false;
+        if (memoryWaiters == 0) {
+            MemoryCache* cache = memoryCache();
+            for (auto& cacheChunk : cache->chunks) {
+                if (cacheChunk.load(std::memory_order_relaxed) != nullptr)
+                    continue;
+                cacheChunk.store(chunk);
+                cached = true;
+                break;
+            }
+        }
+        if (!cached)
+            memoryPushChunk(chunk);
+
+        if (memoryWaiters > 0) {
+            std::unique_lock<std::mutex> lck(memoryMtx);
+            ++memoryModulesReleased[module];
+            condOutOfMemory.notify_all();
+        }
+    }
+
+    void Ctx::releaseMemoryCache() {
+        if (threadMemoryCacheCtx != this)
+            return;
+
+        {
+            std::unique_lock<std::mutex> lck(memoryMtx);
+            memoryDrainCache(threadMemoryCache);
+            for (auto it = memoryCaches.begin(); it != memoryCaches.end(); ++it) {
+                if (*it == threadMemoryCache) {
+                    memoryCaches.erase(it);
+                    break;
+                }
+            }
+            delete threadMemoryCache;
+            condOutOfMemory.notify_all();
+        }
+        threadMemoryCacheCtx = nullptr;
+        threadMemoryCache = nullptr;
     }
 
     void Ctx::stopHard() {
@@ -756,12 +1181,50 @@ namespace OpenLogReplicator {
     void Ctx::spawnThread(Thread* thread) {
         logTrace(TRACE_THREADS, "spawn: " + thread->alias);
 
-        if (pthread_create(&thread->pthread, nullptr, &Thread::runStatic, reinterpret_cast<void*>(thread)))
+        // CPUs and real-time priority are set before the thread starts, so it never runs on other CPUs
+        bool scheduling = !threadCpus[thread->role].empty() || threadPriority[thread->role] != THREAD_PRIORITY_NONE;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        if (!threadCpus[thread->role].empty()) {
+            cpu_set_t cpuSet;
+            if (parseCpuList(threadCpus[thread->role], cpuSet))
+                pthread_attr_setaffinity_np(&attr, sizeof(cpuSet), &cpuSet);
+        }
+        if (threadPriority[thread->role] != THREAD_PRIORITY_NONE) {
+            sched_param param = {};
+            param.sched_priority = static_cast<int>(threadPriority[thread->role]);
+            pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+            pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+            pthread_attr_setschedparam(&attr, &param);
+        }
+
+        int ret = pthread_create(&thread->pthread, &attr, &Thread::runStatic, reinterpret_cast<void*>(thread));
+        pthread_attr_destroy(&attr);
+        if (ret != 0 && scheduling) {
+            warning(60042, "can't set CPUs: " + (threadCpus[thread->role].empty() ? "all" : threadCpus[thread->role]) + ", priority: " +
+                    std::to_string(threadPriority[thread->role]) + " for thread: " + thread->threadName + " (" + strerror(ret) + "), using defaults");
+            ret = pthread_create(&thread->pthread, nullptr, &Thread::runStatic, reinterpret_cast<void*>(thread));
+            scheduling = false;
+        }
+        if (ret != 0)
             throw RuntimeException(10013, "spawning thread: " + thread->alias);
         {
             std::unique_lock<std::mutex> lck(mtx);
             threads.insert(thread);
         }
+
+        if (scheduling) {
+            cpu_set_t cpuSet;
+            int policy;
+            sched_param param = {};
+            std::string cpus("?");
+            if (pthread_getaffinity_np(thread->pthread, sizeof(cpuSet), &cpuSet) == 0)
+                cpus = cpuListString(cpuSet);
+            std::string priority("?");
+            if (pthread_getschedparam(thread->pthread, &policy, &param) == 0)
+                priority = (policy == SCHED_FIFO ? "fifo " + std::to_string(param.sched_priority) : "default");
+            info(0, "thread: " + thread->threadName + " runs on CPUs: " + cpus + ", priority: " + priority);
+        }
     }
 
     void Ctx::finishThread(Thread* thread) {
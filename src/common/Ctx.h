@@ -23,9 +23,11 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <mutex>
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
+#include <sched.h>
 #include <set>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "typeLobId.h"
 #include "typeXid.h"
@@ -41,6 +43,31 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #define MEMORY_CHUNK_SIZE_MB                    1
 #define MEMORY_CHUNK_SIZE                       (MEMORY_CHUNK_SIZE_MB*1024*1024)
 #define MEMORY_CHUNK_MIN_MB                     16
+#define MEMORY_CACHE_CHUNKS                     4
+#define MEMORY_STALL_WAITS                      30
+
+#define MEMORY_MODULE_BUILDER                   0
+#define MEMORY_MODULE_PARSER                    1
+#define MEMORY_MODULE_READER                    2
+#define MEMORY_MODULE_TRANSACTIONS              3
+#define MEMORY_MODULES_NUM                      4
+
+#define MEMORY_HUGE_PAGES_NONE                  0
+#define MEMORY_HUGE_PAGES_TRANSPARENT           1
+#define MEMORY_HUGE_PAGES_2MB                   2
+#define MEMORY_HUGE_PAGES_1GB                   3
+
+#define NUMA_NODE_NONE                          (-1)
+#define NUMA_NODE_MAX                           1023
+
+#define THREAD_ROLE_READER                      0
+#define THREAD_ROLE_PARSER                      1
+#define THREAD_ROLE_CHECKPOINT                  2
+#define THREAD_ROLE_WRITER                      3
+#define THREAD_ROLES                            4
+
+#define THREAD_PRIORITY_NONE                    0
+#define THREAD_PRIORITY_MAX                     99
 
 #define OLR_LOCALES_TIMESTAMP                   0
 #define OLR_LOCALES_MOCK                        1
@@ -102,19 +129,40 @@ extern uint64_t OLR_LOCALES;
 namespace OpenLogReplicator {
     class Thread;
 
+    // Chunks freed by a thread and kept for its next allocation, other threads may only take them away
+    struct MemoryCache {
+        std::atomic<uint8_t*> chunks[MEMORY_CACHE_CHUNKS];
+    };
+
     class Ctx final {
     protected:
         bool bigEndian;
         std::atomic<uint64_t> memoryMinMb;
         std::atomic<uint64_t> memoryMaxMb;
 
+        // Free chunks are kept in slots of memoryChunks linked in a lock-free stack, unused slots are linked in another one,
+        // the head holds a change counter in the upper 32 bits and slot index + 1 in the lower 32 bits
         std::atomic<uint8_t**> memoryChunks;
+        std::atomic<uint32_t>* memoryChunksNext;
+        uint64_t memoryChunksSlots;
+        std::atomic<uint64_t> memoryFreeHead;
+        std::atomic<uint64_t> memoryEmptyHead;
+        std::atomic<uint64_t> memoryWaiters;
+        std::vector<MemoryCache*> memoryCaches;
+        // Memory reserved at startup for all chunks, slot i uses the chunk at memoryPool + i * MEMORY_CHUNK_SIZE
+        uint8_t* memoryPool;
+        uint64_t memoryPoolSize;
+        uint64_t memoryHugePages;
         std::atomic<uint64_t> memoryChunksMin;
         std::atomic<uint64_t> memoryChunksAllocated;
-        std::atomic<uint64_t> memoryChunksFree;
+        std::atomic<uint64_t> memoryChunksUsed;
         std::atomic<uint64_t> memoryChunksMax;
         std::atomic<uint64_t> memoryChunksHWM;
         std::atomic<uint64_t> memoryChunksReusable;
+        std::atomic<uint64_t> memoryModulesAllocated[MEMORY_MODULES_NUM];
+        std::atomic<uint64_t> memoryModulesHWM[MEMORY_MODULES_NUM];
+        // Chunks freed while somebody waits for memory, protected by memoryMtx
+        uint64_t memoryModulesReleased[MEMORY_MODULES_NUM];
 
         std::condition_variable condMainLoop;
         std::condition_variable condOutOfMemory;
@@ -123,11 +171,24 @@ namespace OpenLogReplicator {
         std::set<Thread*> threads;
         pthread_t mainThread;
 
+        static void memoryPush(std::atomic<uint64_t>& head, std::atomic<uint32_t>* next, uint64_t slot);
+        static int64_t memoryPop(std::atomic<uint64_t>& head, std::atomic<uint32_t>* next);
+        uint8_t* memoryPopChunk();
+        void memoryPushChunk(uint8_t* chunk);
+        MemoryCache* memoryCache();
+        void memoryDrainCache(MemoryCache* cache);
+        uint8_t* memoryAllocateChunk(uint64_t module);
+        void memoryWaitForModule(uint64_t module, uint64_t limit);
+        void memoryReservePool();
+        [[nodiscard]] bool memoryPoolChunk(const uint8_t* chunk) const;
+
     public:
         static const char map10[11];
         static const char map16[17];
         static const char map64[65];
         static const char map64R[256];
+        static const char* memoryModules[MEMORY_MODULES_NUM];
+        static const char* threadRoles[THREAD_ROLES];
 
         bool version12;
         std::atomic<uint64_t> version;                   // Compatibility level of redo logs
@@ -139,6 +200,9 @@ namespace OpenLogReplicator {
         void setBigEndian();
         [[nodiscard]] bool isBigEndian() const;
 
+        // Memory quotas of modules in chunks, 0 - no quota
+        uint64_t memoryModulesSoft[MEMORY_MODULES_NUM];
+        uint64_t memoryModulesHard[MEMORY_MODULES_NUM];
         // Disk read buffers
         std::atomic<uint64_t> readBufferMax;
         std::atomic<uint64_t> buffersFree;
@@ -150,6 +214,9 @@ namespace OpenLogReplicator {
         uint64_t checkpointIntervalMb;
         uint64_t checkpointKeep;
         uint64_t schemaForceInterval;
+        uint64_t schemaDelta;
+        // Filter
+        uint64_t lazyTables;
         // Reader
         uint64_t redoReadSleepUs;
         uint64_t redoVerifyDelayUs;
@@ -159,6 +226,13 @@ namespace OpenLogReplicator {
         // Writer
         uint64_t pollIntervalUs;
         uint64_t queueSize;
+        // NUMA nodes for threads
+        int64_t numaNodeReader;
+        int64_t numaNodeParser;
+        int64_t numaNodeWriter;
+        // Scheduling of threads
+        std::string threadCpus[THREAD_ROLES];
+        int64_t threadPriority[THREAD_ROLES];
         // Transaction buffer
         std::string dumpPath;
         std::string redoCopyPath;
@@ -236,13 +310,20 @@ namespace OpenLogReplicator {
         [[nodiscard]] static const char* getJsonFieldS(const std::string& fileName, uint64_t maxLength, const rapidjson::Value& value, const char* field,
                                                        uint64_t num);
 
-        void initialize(uint64_t newMemoryMinMb, uint64_t newMemoryMaxMb, uint64_t newReadBufferMax);
+        void initialize(uint64_t newMemoryMinMb, uint64_t newMemoryMaxMb, uint64_t newReadBufferMax, uint64_t newMemoryHugePages);
+        void bindNumaNode(int64_t node, uint64_t role);
+        [[nodiscard]] static bool parseCpuList(const std::string& cpuList, cpu_set_t& cpuSet);
+        [[nodiscard]] static std::string cpuListString(const cpu_set_t& cpuSet);
         void wakeAllOutOfMemory();
         [[nodiscard]] uint64_t getMaxUsedMemory() const;
         [[nodiscard]] uint64_t getAllocatedMemory() const;
         [[nodiscard]] uint64_t getFreeMemory();
-        [[nodiscard]] uint8_t* getMemoryChunk(const char* module, bool reusable);
-        void freeMemoryChunk(const char* module, uint8_t* chunk, bool reusable);
+        [[nodiscard]] uint64_t getModuleMemory(uint64_t module) const;
+        [[nodiscard]] uint64_t getModuleMaxUsedMemory(uint64_t module) const;
+        [[nodiscard]] uint8_t* getMemoryChunk(uint64_t module, bool reusable);
+        void freeMemoryChunk(uint64_t module, uint8_t* chunk, bool reusable);
+        void throttleModule(uint64_t module);
+        void releaseMemoryCache();
         void stopHard();
         void stopSoft();
         void mainLoop();
@@ -0,0 +1,205 @@
+/* Header for memory arenas with fixed size blocks
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <new>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef MEMORY_POOL_H_
+#define MEMORY_POOL_H_
+
+#define MEMORY_POOL_CHUNK_SIZE                  (1024 * 1024)
+#define MEMORY_POOL_ALIGNMENT                   8
+#define MEMORY_ARENA_MAX_BLOCK                  256
+#define MEMORY_ARENA_POOLS                      (MEMORY_ARENA_MAX_BLOCK / MEMORY_POOL_ALIGNMENT)
+
+namespace OpenLogReplicator {
+    // Blocks of one size carved from large chunks without per-block allocation overhead, freed blocks are reused.
+    // When the last block is returned, all chunks but one are released - the kept one serves short-lived objects without new allocation.
+    class MemoryPool final {
+    protected:
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        uint64_t size;
+        FreeBlock* freeBlocks;
+        std::vector<char*> chunks;
+        uint64_t chunkPos;
+        uint64_t used;
+
+    public:
+        explicit MemoryPool(uint64_t newSize) :
+                size(newSize),
+                freeBlocks(nullptr),
+                chunkPos(MEMORY_POOL_CHUNK_SIZE),
+                used(0) {
+        }
+
+        ~MemoryPool() {
+            for (char* chunk : chunks)
+                ::operator delete(chunk);
+            chunks.clear();
+        }
+
+        void* allocate() {
+            ++used;
+            if (freeBlocks != nullptr) {
+                FreeBlock* block = freeBlocks;
+                freeBlocks = block->next;
+                return block;
+            }
+
+            if (chunkPos + size > MEMORY_POOL_CHUNK_SIZE) {
+                chunks.push_back(static_cast<char*>(::operator new(MEMORY_POOL_CHUNK_SIZE)));
+                chunkPos = 0;
+            }
+            void* block = chunks.back() + chunkPos;
+            chunkPos += size;
+            return block;
+        }
+
+        void deallocate(void* ptr) {
+            auto block = static_cast<FreeBlock*>(ptr);
+            block->next = freeBlocks;
+            freeBlocks = block;
+
+            if (--used > 0)
+                return;
+
+            for (uint64_t i = 1; i < chunks.size(); ++i)
+                ::operator delete(chunks[i]);
+            chunks.resize(1);
+            freeBlocks = nullptr;
+            chunkPos = 0;
+        }
+    };
+
+    // Pools for all small block sizes of one owner. There is no locking: the owner serializes all allocations and releases,
+    // the schema does it with the schema mutex. Larger blocks (like buckets of hash maps) are allocated regularly.
+    class MemoryArena final {
+    protected:
+        MemoryPool* pools[MEMORY_ARENA_POOLS];
+
+    public:
+        MemoryArena() :
+                pools{} {
+        }
+
+        ~MemoryArena() {
+            for (MemoryPool*& pool : pools) {
+                delete pool;
+                pool = nullptr;
+            }
+        }
+
+        MemoryArena(const MemoryArena&) = delete;
+        MemoryArena& operator=(const MemoryArena&) = delete;
+
+        void* allocate(uint64_t size) {
+            if (size == 0 || size > MEMORY_ARENA_MAX_BLOCK)
+                return ::operator new(size);
+
+            uint64_t num = (size - 1) / MEMORY_POOL_ALIGNMENT;
+            if (pools[num] == nullptr)
+                pools[num] = new MemoryPool((num + 1) * MEMORY_POOL_ALIGNMENT);
+            return pools[num]->allocate();
+        }
+
+        void deallocate(void* ptr, uint64_t size) {
+            if (size == 0 || size > MEMORY_ARENA_MAX_BLOCK) {
+                ::operator delete(ptr);
+                return;
+            }
+
+            pools[(size - 1) / MEMORY_POOL_ALIGNMENT]->deallocate(ptr);
+        }
+
+        // Blocks are packed tighter than malloc() does, which is enough for the types kept in the arena
+        template<class T, class... Args>
+        T* create(Args&&... args) {
+            static_assert(alignof(T) <= MEMORY_POOL_ALIGNMENT);
+            void* ptr = allocate(sizeof(T));
+            try {
+                return new(ptr) T(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(ptr, sizeof(T));
+                throw;
+            }
+        }
+
+        template<class T>
+        void destroy(T* ptr) {
+            if (ptr == nullptr)
+                return;
+            ptr->~T();
+            deallocate(ptr, sizeof(T));
+        }
+    };
+
+    // Allocator for containers kept in an arena, the containers must be created with the arena
+    template<class T>
+    class PoolAllocator {
+    public:
+        typedef T value_type;
+
+        MemoryArena* arena;
+
+        PoolAllocator(MemoryArena* newArena) noexcept :
+                arena(newArena) {
+        }
+
+        template<class U>
+        PoolAllocator(const PoolAllocator<U>& other) noexcept :
+                arena(other.arena) {
+        }
+
+        T* allocate(size_t n) {
+            static_assert(alignof(T) <= MEMORY_POOL_ALIGNMENT);
+            return static_cast<T*>(arena->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, size_t n) {
+            arena->deallocate(ptr, n * sizeof(T));
+        }
+
+        template<class U>
+        bool operator==(const PoolAllocator<U>& other) const noexcept {
+            return arena == other.arena;
+        }
+
+        template<class U>
+        bool operator!=(const PoolAllocator<U>& other) const noexcept {
+            return arena != other.arena;
+        }
+    };
+
+    template<class K, class V>
+    using PoolMap = std::map<K, V, std::less<K>, PoolAllocator<std::pair<const K, V>>>;
+
+    template<class K, class V>
+    using PoolUnorderedMap = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, PoolAllocator<std::pair<const K, V>>>;
+}
+
+#endif
@@ -118,6 +118,7 @@ PROTOBUF_CONSTEXPR RedoRequest::RedoRequest(
   , /*decltype(_impl_.seq_)*/uint64_t{0u}
   , /*decltype(_impl_.c_scn_)*/uint64_t{0u}
   , /*decltype(_impl_.c_idx_)*/uint64_t{0u}
+  , /*decltype(_impl_.window_)*/uint64_t{0u}
   , /*decltype(_impl_.code_)*/0
   , /*decltype(_impl_.tm_val_)*/{}
   , /*decltype(_impl_._oneof_case_)*/{}} {}
@@ -143,16 +144,18 @@ struct RedoResponse_AttributesEntry_DoNotUseDefaultTypeInternal {
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 RedoResponse_AttributesEntry_DoNotUseDefaultTypeInternal _RedoResponse_AttributesEntry_DoNotUse_default_instance_;
 PROTOBUF_CONSTEXPR RedoResponse::RedoResponse(
     ::_pbi::ConstantInitialized): _impl_{
-    /*decltype(_impl_.payload_)*/{}
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.payload_)*/{}
   , /*decltype(_impl_.attributes_)*/{::_pbi::ConstantInitialized()}
   , /*decltype(_impl_.db_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.c_scn_)*/uint64_t{0u}
   , /*decltype(_impl_.c_idx_)*/uint64_t{0u}
+  , /*decltype(_impl_.window_)*/uint64_t{0u}
   , /*decltype(_impl_.code_)*/0
   , /*decltype(_impl_.scn_val_)*/{}
   , /*decltype(_impl_.tm_val_)*/{}
   , /*decltype(_impl_.xid_val_)*/{}
-  , /*decltype(_impl_._cached_size_)*/{}
   , /*decltype(_impl_._oneof_case_)*/{}} {}
 struct RedoResponseDefaultTypeInternal {
   PROTOBUF_CONSTEXPR RedoResponseDefaultTypeInternal()
@@ -247,6 +250,7 @@ const uint32_t TableStruct_OraProtoBuf_2eproto::offsets[] PROTOBUF_SECTION_VARIA
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoRequest, _impl_.schema_),
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoRequest, _impl_.c_scn_),
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoRequest, _impl_.c_idx_),
+  PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoRequest, _impl_.window_),
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoRequest, _impl_.tm_val_),
   ~0u,
   ~0u,
@@ -257,6 +261,7 @@ const uint32_t TableStruct_OraProtoBuf_2eproto::offsets[] PROTOBUF_SECTION_VARIA
   ~0u,
   1,
   2,
+  3,
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse_AttributesEntry_DoNotUse, _has_bits_),
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse_AttributesEntry_DoNotUse, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -267,7 +272,7 @@ const uint32_t TableStruct_OraProtoBuf_2eproto::offsets[] PROTOBUF_SECTION_VARIA
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse_AttributesEntry_DoNotUse, value_),
   0,
   1,
-  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse, _impl_._has_bits_),
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse, _internal_metadata_),
   ~0u,  // no _extensions_
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse, _impl_._oneof_case_[0]),
@@ -285,9 +290,23 @@ const uint32_t TableStruct_OraProtoBuf_2eproto::offsets[] PROTOBUF_SECTION_VARIA
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse, _impl_.c_scn_),
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse, _impl_.c_idx_),
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse, _impl_.attributes_),
+  PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse, _impl_.window_),
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse, _impl_.scn_val_),
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse, _impl_.tm_val_),
   PROTOBUF_FIELD_OFFSET(::OpenLogReplicator::pb::RedoResponse, _impl_.xid_val_),
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  0,
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, -1, sizeof(::OpenLogReplicator::pb::Value)},
@@ -295,9 +314,9 @@ static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protode
   { 25, -1, -1, sizeof(::OpenLogReplicator::pb::Schema)},
   { 38, -1, -1, sizeof(::OpenLogReplicator::pb::Payload)},
   { 54, -1, -1, sizeof(::OpenLogReplicator::pb::SchemaRequest)},
-  { 62, 78, -1, sizeof(::OpenLogReplicator::pb::RedoRequest)},
-  { 87, 95, -1, sizeof(::OpenLogReplicator::pb::RedoResponse_AttributesEntry_DoNotUse)},
-  { 97, -1, -1, sizeof(::OpenLogReplicator::pb::RedoResponse)},
+  { 62, 79, -1, sizeof(::OpenLogReplicator::pb::RedoRequest)},
+  { 89, 97, -1, sizeof(::OpenLogReplicator::pb::RedoResponse_AttributesEntry_DoNotUse)},
+  { 99, 121, -1, sizeof(::OpenLogReplicator::pb::RedoResponse)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
@@ -331,47 +350,49 @@ const char descriptor_table_protodef_OraProtoBuf_2eproto[] PROTOBUF_SECTION_VARI
   "OpenLogReplicator.pb.Value\022\013\n\003ddl\030\006 \001(\t\022"
   "\013\n\003seq\030\007 \001(\r\022\016\n\006offset\030\010 \001(\004\022\014\n\004redo\030\t \001"
   "(\010\022\013\n\003num\030\n \001(\004\"-\n\rSchemaRequest\022\014\n\004mask"
-  "\030\001 \001(\t\022\016\n\006filter\030\002 \001(\t\"\232\002\n\013RedoRequest\022/"
+  "\030\001 \001(\t\022\016\n\006filter\030\002 \001(\t\"\272\002\n\013RedoRequest\022/"
   "\n\004code\030\001 \001(\0162!.OpenLogReplicator.pb.Requ"
   "estCode\022\025\n\rdatabase_name\030\002 \001(\t\022\r\n\003scn\030\003 "
   "\001(\004H\000\022\r\n\003tms\030\004 \001(\tH\000\022\020\n\006tm_rel\030\005 \001(\003H\000\022\020"
   "\n\003seq\030\006 \001(\004H\001\210\001\001\0223\n\006schema\030\007 \003(\0132#.OpenL"
   "ogReplicator.pb.SchemaRequest\022\022\n\005c_scn\030\010"
-  " \001(\004H\002\210\001\001\022\022\n\005c_idx\030\t \001(\004H\003\210\001\001B\010\n\006tm_valB"
-  "\006\n\004_seqB\010\n\006_c_scnB\010\n\006_c_idx\"\220\003\n\014RedoResp"
-  "onse\0220\n\004code\030\001 \001(\0162\".OpenLogReplicator.p"
-  "b.ResponseCode\022\r\n\003scn\030\002 \001(\004H\000\022\016\n\004scns\030\003 "
-  "\001(\tH\000\022\014\n\002tm\030\004 \001(\004H\001\022\r\n\003tms\030\005 \001(\tH\001\022\r\n\003xi"
-  "d\030\006 \001(\tH\002\022\016\n\004xidn\030\007 \001(\004H\002\022\n\n\002db\030\010 \001(\t\022.\n"
-  "\007payload\030\t \003(\0132\035.OpenLogReplicator.pb.Pa"
-  "yload\022\r\n\005c_scn\030\n \001(\004\022\r\n\005c_idx\030\013 \001(\004\022F\n\na"
-  "ttributes\030\014 \003(\01322.OpenLogReplicator.pb.R"
-  "edoResponse.AttributesEntry\0321\n\017Attribute"
-  "sEntry\022\013\n\003key\030\001 \001(\t\022\r\n\005value\030\002 \001(\t:\0028\001B\t"
-  "\n\007scn_valB\010\n\006tm_valB\t\n\007xid_val*S\n\002Op\022\t\n\005"
-  "BEGIN\020\000\022\n\n\006COMMIT\020\001\022\n\n\006INSERT\020\002\022\n\n\006UPDAT"
-  "E\020\003\022\n\n\006DELETE\020\004\022\007\n\003DDL\020\005\022\t\n\005CHKPT\020\006*\250\002\n\n"
-  "ColumnType\022\013\n\007UNKNOWN\020\000\022\014\n\010VARCHAR2\020\001\022\n\n"
-  "\006NUMBER\020\002\022\010\n\004LONG\020\003\022\010\n\004DATE\020\004\022\007\n\003RAW\020\005\022\014"
-  "\n\010LONG_RAW\020\006\022\010\n\004CHAR\020\007\022\020\n\014BINARY_FLOAT\020\010"
-  "\022\021\n\rBINARY_DOUBLE\020\t\022\010\n\004CLOB\020\n\022\010\n\004BLOB\020\013\022"
-  "\r\n\tTIMESTAMP\020\014\022\025\n\021TIMESTAMP_WITH_TZ\020\r\022\032\n"
-  "\026INTERVAL_YEAR_TO_MONTH\020\016\022\032\n\026INTERVAL_DA"
-  "Y_TO_SECOND\020\017\022\n\n\006UROWID\020\020\022\033\n\027TIMESTAMP_W"
-  "ITH_LOCAL_TZ\020\021*=\n\013RequestCode\022\010\n\004INFO\020\000\022"
-  "\t\n\005START\020\001\022\014\n\010CONTINUE\020\002\022\013\n\007CONFIRM\020\003*\225\001"
-  "\n\014ResponseCode\022\t\n\005READY\020\000\022\020\n\014FAILED_STAR"
-  "T\020\001\022\014\n\010STARTING\020\002\022\023\n\017ALREADY_STARTED\020\003\022\r"
-  "\n\tREPLICATE\020\004\022\013\n\007PAYLOAD\020\005\022\024\n\020INVALID_DA"
-  "TABASE\020\006\022\023\n\017INVALID_COMMAND\020\0072f\n\021OpenLog"
-  "Replicator\022Q\n\004Redo\022!.OpenLogReplicator.p"
-  "b.RedoRequest\032\".OpenLogReplicator.pb.Red"
-  "oResponse(\0010\001B7\n\"io.debezium.connector.o"
-  "racle.protoB\021OpenLogReplicatorb\006proto3"
+  " \001(\004H\002\210\001\001\022\022\n\005c_idx\030\t \001(\004H\003\210\001\001\022\023\n\006window\030"
+  "\n \001(\004H\004\210\001\001B\010\n\006tm_valB\006\n\004_seqB\010\n\006_c_scnB\010"
+  "\n\006_c_idxB\t\n\007_window\"\260\003\n\014RedoResponse\0220\n\004"
+  "code\030\001 \001(\0162\".OpenLogReplicator.pb.Respon"
+  "seCode\022\r\n\003scn\030\002 \001(\004H\000\022\016\n\004scns\030\003 \001(\tH\000\022\014\n"
+  "\002tm\030\004 \001(\004H\001\022\r\n\003tms\030\005 \001(\tH\001\022\r\n\003xid\030\006 \001(\tH"
+  "\002\022\016\n\004xidn\030\007 \001(\004H\002\022\n\n\002db\030\010 \001(\t\022.\n\007payload"
+  "\030\t \003(\0132\035.OpenLogReplicator.pb.Payload\022\r\n"
+  "\005c_scn\030\n \001(\004\022\r\n\005c_idx\030\013 \001(\004\022F\n\nattribute"
+  "s\030\014 \003(\01322.OpenLogReplicator.pb.RedoRespo"
+  "nse.AttributesEntry\022\023\n\006window\030\r \001(\004H\003\210\001\001"
+  "\0321\n\017AttributesEntry\022\013\n\003key\030\001 \001(\t\022\r\n\005valu"
+  "e\030\002 \001(\t:\0028\001B\t\n\007scn_valB\010\n\006tm_valB\t\n\007xid_"
+  "valB\t\n\007_window*S\n\002Op\022\t\n\005BEGIN\020\000\022\n\n\006COMMI"
+  "T\020\001\022\n\n\006INSERT\020\002\022\n\n\006UPDATE\020\003\022\n\n\006DELETE\020\004\022"
+  "\007\n\003DDL\020\005\022\t\n\005CHKPT\020\006*\250\002\n\nColumnType\022\013\n\007UN"
+  "KNOWN\020\000\022\014\n\010VARCHAR2\020\001\022\n\n\006NUMBER\020\002\022\010\n\004LON"
+  "G\020\003\022\010\n\004DATE\020\004\022\007\n\003RAW\020\005\022\014\n\010LONG_RAW\020\006\022\010\n\004"
+  "CHAR\020\007\022\020\n\014BINARY_FLOAT\020\010\022\021\n\rBINARY_DOUBL"
+  "E\020\t\022\010\n\004CLOB\020\n\022\010\n\004BLOB\020\013\022\r\n\tTIMESTAMP\020\014\022\025"
+  "\n\021TIMESTAMP_WITH_TZ\020\r\022\032\n\026INTERVAL_YEAR_T"
+  "O_MONTH\020\016\022\032\n\026INTERVAL_DAY_TO_SECOND\020\017\022\n\n"
+  "\006UROWID\020\020\022\033\n\027TIMESTAMP_WITH_LOCAL_TZ\020\021*="
+  "\n\013RequestCode\022\010\n\004INFO\020\000\022\t\n\005START\020\001\022\014\n\010CO"
+  "NTINUE\020\002\022\013\n\007CONFIRM\020\003*\225\001\n\014ResponseCode\022\t"
+  "\n\005READY\020\000\022\020\n\014FAILED_START\020\001\022\014\n\010STARTING\020"
+  "\002\022\023\n\017ALREADY_STARTED\020\003\022\r\n\tREPLICATE\020\004\022\013\n"
+  "\007PAYLOAD\020\005\022\024\n\020INVALID_DATABASE\020\006\022\023\n\017INVA"
+  "LID_COMMAND\020\0072f\n\021OpenLogReplicator\022Q\n\004Re"
+  "do\022!.OpenLogReplicator.pb.RedoRequest\032\"."
+  "OpenLogReplicator.pb.RedoResponse(\0010\001B7\n"
+  "\"io.debezium.connector.oracle.protoB\021Ope"
+  "nLogReplicatorb\006proto3"
   ;
 static ::_pbi::once_flag descriptor_table_OraProtoBuf_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_OraProtoBuf_2eproto = {
-    false, false, 2238, descriptor_table_protodef_OraProtoBuf_2eproto,
+    false, false, 2302, descriptor_table_protodef_OraProtoBuf_2eproto,
     "OraProtoBuf.proto",
     &descriptor_table_OraProtoBuf_2eproto_once, nullptr, 0, 8,
     schemas, file_default_instances, TableStruct_OraProtoBuf_2eproto::offsets,
@@ -2403,6 +2424,9 @@ class RedoRequest::_Internal {
   static void set_has_c_idx(HasBits* has_bits) {
     (*has_bits)[0] |= 4u;
   }
+  static void set_has_window(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
 };
 
 RedoRequest::RedoRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
@@ -2422,6 +2446,7 @@ RedoRequest::RedoRequest(const RedoRequest& from)
     , decltype(_impl_.seq_){}
     , decltype(_impl_.c_scn_){}
     , decltype(_impl_.c_idx_){}
+    , decltype(_impl_.window_){}
     , decltype(_impl_.code_){}
     , decltype(_impl_.tm_val_){}
     , /*decltype(_impl_._oneof_case_)*/{}};
@@ -2471,6 +2496,7 @@ inline void RedoRequest::SharedCtor(
     , decltype(_impl_.seq_){uint64_t{0u}}
     , decltype(_impl_.c_scn_){uint64_t{0u}}
     , decltype(_impl_.c_idx_){uint64_t{0u}}
+    , decltype(_impl_.window_){uint64_t{0u}}
     , decltype(_impl_.code_){0}
     , decltype(_impl_.tm_val_){}
     , /*decltype(_impl_._oneof_case_)*/{}
@@ -2536,10 +2562,10 @@ void RedoRequest::Clear() {
   _impl_.schema_.Clear();
   _impl_.database_name_.ClearToEmpty();
   cached_has_bits = _impl_._has_bits_[0];
-  if (cached_has_bits & 0x00000007u) {
+  if (cached_has_bits & 0x0000000fu) {
     ::memset(&_impl_.seq_, 0, static_cast<size_t>(
-        reinterpret_cast<char*>(&_impl_.c_idx_) -
-        reinterpret_cast<char*>(&_impl_.seq_)) + sizeof(_impl_.c_idx_));
+        reinterpret_cast<char*>(&_impl_.window_) -
+        reinterpret_cast<char*>(&_impl_.seq_)) + sizeof(_impl_.window_));
   }
   _impl_.code_ = 0;
   clear_tm_val();
@@ -2639,6 +2665,15 @@ const char* RedoRequest::_InternalParse(const char* ptr, ::_pbi::ParseContext* c
         } else
           goto handle_unusual;
         continue;
+      // optional uint64 window = 10;
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 80)) {
+          _Internal::set_has_window(&has_bits);
+          _impl_.window_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -2734,6 +2769,12 @@ uint8_t* RedoRequest::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteUInt64ToArray(9, this->_internal_c_idx(), target);
   }
 
+  // optional uint64 window = 10;
+  if (_internal_has_window()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(10, this->_internal_window(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -2765,7 +2806,7 @@ size_t RedoRequest::ByteSizeLong() const {
   }
 
   cached_has_bits = _impl_._has_bits_[0];
-  if (cached_has_bits & 0x00000007u) {
+  if (cached_has_bits & 0x0000000fu) {
     // optional uint64 seq = 6;
     if (cached_has_bits & 0x00000001u) {
       total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_seq());
@@ -2781,6 +2822,11 @@ size_t RedoRequest::ByteSizeLong() const {
       total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_c_idx());
     }
 
+    // optional uint64 window = 10;
+    if (cached_has_bits & 0x00000008u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_window());
+    }
+
   }
   // .OpenLogReplicator.pb.RequestCode code = 1;
   if (this->_internal_code() != 0) {
@@ -2833,7 +2879,7 @@ void RedoRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PR
     _this->_internal_set_database_name(from._internal_database_name());
   }
   cached_has_bits = from._impl_._has_bits_[0];
-  if (cached_has_bits & 0x00000007u) {
+  if (cached_has_bits & 0x0000000fu) {
     if (cached_has_bits & 0x00000001u) {
       _this->_impl_.seq_ = from._impl_.seq_;
     }
@@ -2843,6 +2889,9 @@ void RedoRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PR
     if (cached_has_bits & 0x00000004u) {
       _this->_impl_.c_idx_ = from._impl_.c_idx_;
     }
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.window_ = from._impl_.window_;
+    }
     _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
   if (from._internal_code() != 0) {
@@ -2924,6 +2973,10 @@ void RedoResponse_AttributesEntry_DoNotUse::MergeFrom(const RedoResponse_Attribu
 
 class RedoResponse::_Internal {
  public:
+  using HasBits = decltype(std::declval<RedoResponse>()._impl_._has_bits_);
+  static void set_has_window(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
 };
 
 RedoResponse::RedoResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
@@ -2939,16 +2992,18 @@ RedoResponse::RedoResponse(const RedoResponse& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
   RedoResponse* const _this = this; (void)_this;
   new (&_impl_) Impl_{
-      decltype(_impl_.payload_){from._impl_.payload_}
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.payload_){from._impl_.payload_}
     , /*decltype(_impl_.attributes_)*/{}
     , decltype(_impl_.db_){}
     , decltype(_impl_.c_scn_){}
     , decltype(_impl_.c_idx_){}
+    , decltype(_impl_.window_){}
     , decltype(_impl_.code_){}
     , decltype(_impl_.scn_val_){}
     , decltype(_impl_.tm_val_){}
     , decltype(_impl_.xid_val_){}
-    , /*decltype(_impl_._cached_size_)*/{}
     , /*decltype(_impl_._oneof_case_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -3014,16 +3069,18 @@ inline void RedoResponse::SharedCtor(
   (void)arena;
   (void)is_message_owned;
   new (&_impl_) Impl_{
-      decltype(_impl_.payload_){arena}
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.payload_){arena}
     , /*decltype(_impl_.attributes_)*/{::_pbi::ArenaInitialized(), arena}
     , decltype(_impl_.db_){}
     , decltype(_impl_.c_scn_){uint64_t{0u}}
     , decltype(_impl_.c_idx_){uint64_t{0u}}
+    , decltype(_impl_.window_){uint64_t{0u}}
     , decltype(_impl_.code_){0}
     , decltype(_impl_.scn_val_){}
     , decltype(_impl_.tm_val_){}
     , decltype(_impl_.xid_val_){}
-    , /*decltype(_impl_._cached_size_)*/{}
     , /*decltype(_impl_._oneof_case_)*/{}
   };
   _impl_.db_.InitDefault();
@@ -3135,16 +3192,20 @@ void RedoResponse::Clear() {
   _impl_.attributes_.Clear();
   _impl_.db_.ClearToEmpty();
   ::memset(&_impl_.c_scn_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&_impl_.code_) -
-      reinterpret_cast<char*>(&_impl_.c_scn_)) + sizeof(_impl_.code_));
+      reinterpret_cast<char*>(&_impl_.c_idx_) -
+      reinterpret_cast<char*>(&_impl_.c_scn_)) + sizeof(_impl_.c_idx_));
+  _impl_.window_ = uint64_t{0u};
+  _impl_.code_ = 0;
   clear_scn_val();
   clear_tm_val();
   clear_xid_val();
+  _impl_._has_bits_.Clear();
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
 const char* RedoResponse::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
 #define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
   while (!ctx->Done(&ptr)) {
     uint32_t tag;
     ptr = ::_pbi::ReadTag(ptr, &tag);
@@ -3264,6 +3325,15 @@ const char* RedoResponse::_InternalParse(const char* ptr, ::_pbi::ParseContext*
         } else
           goto handle_unusual;
         continue;
+      // optional uint64 window = 13;
+      case 13:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 104)) {
+          _Internal::set_has_window(&has_bits);
+          _impl_.window_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -3280,6 +3350,7 @@ const char* RedoResponse::_InternalParse(const char* ptr, ::_pbi::ParseContext*
     CHK_(ptr != nullptr);
   }  // while
 message_done:
+  _impl_._has_bits_.Or(has_bits);
   return ptr;
 failure:
   ptr = nullptr;
@@ -3408,6 +3479,12 @@ uint8_t* RedoResponse::_InternalSerialize(
     }
   }
 
+  // optional uint64 window = 13;
+  if (_internal_has_window()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(13, this->_internal_window(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -3457,6 +3534,12 @@ size_t RedoResponse::ByteSizeLong() const {
     total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_c_idx());
   }
 
+  // optional uint64 window = 13;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_window());
+  }
+
   // .OpenLogReplicator.pb.ResponseCode code = 1;
   if (this->_internal_code() != 0) {
     total_size += 1 +
@@ -3543,6 +3626,9 @@ void RedoResponse::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::P
   if (from._internal_c_idx() != 0) {
     _this->_internal_set_c_idx(from._internal_c_idx());
   }
+  if (from._internal_has_window()) {
+    _this->_internal_set_window(from._internal_window());
+  }
   if (from._internal_code() != 0) {
     _this->_internal_set_code(from._internal_code());
   }
@@ -3604,6 +3690,7 @@ void RedoResponse::InternalSwap(RedoResponse* other) {
   auto* lhs_arena = GetArenaForAllocation();
   auto* rhs_arena = other->GetArenaForAllocation();
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
   _impl_.payload_.InternalSwap(&other->_impl_.payload_);
   _impl_.attributes_.InternalSwap(&other->_impl_.attributes_);
   ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
@@ -1531,6 +1531,7 @@ class RedoRequest final :
     kSeqFieldNumber = 6,
     kCScnFieldNumber = 8,
     kCIdxFieldNumber = 9,
+    kWindowFieldNumber = 10,
     kCodeFieldNumber = 1,
     kScnFieldNumber = 3,
     kTmsFieldNumber = 4,
@@ -1607,6 +1608,19 @@ class RedoRequest final :
   void _internal_set_c_idx(uint64_t value);
   public:
 
+  // optional uint64 window = 10;
+  bool has_window() const;
+  private:
+  bool _internal_has_window() const;
+  public:
+  void clear_window();
+  uint64_t window() const;
+  void set_window(uint64_t value);
+  private:
+  uint64_t _internal_window() const;
+  void _internal_set_window(uint64_t value);
+  public:
+
   // .OpenLogReplicator.pb.RequestCode code = 1;
   void clear_code();
   ::OpenLogReplicator::pb::RequestCode code() const;
@@ -1683,6 +1697,7 @@ class RedoRequest final :
     uint64_t seq_;
     uint64_t c_scn_;
     uint64_t c_idx_;
+    uint64_t window_;
     int code_;
     union TmValUnion {
       constexpr TmValUnion() : _constinit_{} {}
@@ -1874,6 +1889,7 @@ class RedoResponse final :
     kDbFieldNumber = 8,
     kCScnFieldNumber = 10,
     kCIdxFieldNumber = 11,
+    kWindowFieldNumber = 13,
     kCodeFieldNumber = 1,
     kScnFieldNumber = 2,
     kScnsFieldNumber = 3,
@@ -1949,6 +1965,19 @@ class RedoResponse final :
   void _internal_set_c_idx(uint64_t value);
   public:
 
+  // optional uint64 window = 13;
+  bool has_window() const;
+  private:
+  bool _internal_has_window() const;
+  public:
+  void clear_window();
+  uint64_t window() const;
+  void set_window(uint64_t value);
+  private:
+  uint64_t _internal_window() const;
+  void _internal_set_window(uint64_t value);
+  public:
+
   // .OpenLogReplicator.pb.ResponseCode code = 1;
   void clear_code();
   ::OpenLogReplicator::pb::ResponseCode code() const;
@@ -2080,6 +2109,8 @@ class RedoResponse final :
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
     ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::OpenLogReplicator::pb::Payload > payload_;
     ::PROTOBUF_NAMESPACE_ID::internal::MapField<
         RedoResponse_AttributesEntry_DoNotUse,
@@ -2089,6 +2120,7 @@ class RedoResponse final :
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr db_;
     uint64_t c_scn_;
     uint64_t c_idx_;
+    uint64_t window_;
     int code_;
     union ScnValUnion {
       constexpr ScnValUnion() : _constinit_{} {}
@@ -2108,7 +2140,6 @@ class RedoResponse final :
       ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr xid_;
       uint64_t xidn_;
     } xid_val_;
-    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
     uint32_t _oneof_case_[3];
 
   };
@@ -3724,6 +3755,34 @@ inline void RedoRequest::set_c_idx(uint64_t value) {
   // @@protoc_insertion_point(field_set:OpenLogReplicator.pb.RedoRequest.c_idx)
 }
 
+// optional uint64 window = 10;
+inline bool RedoRequest::_internal_has_window() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool RedoRequest::has_window() const {
+  return _internal_has_window();
+}
+inline void RedoRequest::clear_window() {
+  _impl_.window_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline uint64_t RedoRequest::_internal_window() const {
+  return _impl_.window_;
+}
+inline uint64_t RedoRequest::window() const {
+  // @@protoc_insertion_point(field_get:OpenLogReplicator.pb.RedoRequest.window)
+  return _internal_window();
+}
+inline void RedoRequest::_internal_set_window(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.window_ = value;
+}
+inline void RedoRequest::set_window(uint64_t value) {
+  _internal_set_window(value);
+  // @@protoc_insertion_point(field_set:OpenLogReplicator.pb.RedoRequest.window)
+}
+
 inline bool RedoRequest::has_tm_val() const {
   return tm_val_case() != TM_VAL_NOT_SET;
 }
@@ -4263,6 +4322,34 @@ RedoResponse::mutable_attributes() {
   return _internal_mutable_attributes();
 }
 
+// optional uint64 window = 13;
+inline bool RedoResponse::_internal_has_window() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool RedoResponse::has_window() const {
+  return _internal_has_window();
+}
+inline void RedoResponse::clear_window() {
+  _impl_.window_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t RedoResponse::_internal_window() const {
+  return _impl_.window_;
+}
+inline uint64_t RedoResponse::window() const {
+  // @@protoc_insertion_point(field_get:OpenLogReplicator.pb.RedoResponse.window)
+  return _internal_window();
+}
+inline void RedoResponse::_internal_set_window(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.window_ = value;
+}
+inline void RedoResponse::set_window(uint64_t value) {
+  _internal_set_window(value);
+  // @@protoc_insertion_point(field_set:OpenLogReplicator.pb.RedoResponse.window)
+}
+
 inline bool RedoResponse::has_scn_val() const {
   return scn_val_case() != SCN_VAL_NOT_SET;
 }
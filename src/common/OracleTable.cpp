@@ -79,6 +79,9 @@ namespace OpenLogReplicator {
             delete column;
         pk.clear();
         columns.clear();
+        columnFlags.clear();
+        columnTypes.clear();
+        columnGuardSegs.clear();
         tablePartitions.clear();
 
         for (OracleLob* lob: lobs)
@@ -102,7 +105,26 @@ namespace OpenLogReplicator {
         if (column->segCol > maxSegCol)
             maxSegCol = column->segCol;
 
+        uint8_t flags = 0;
+        if (column->numPk > 0)
+            flags |= TABLE_COLUMN_PK;
+        if (column->nullable)
+            flags |= TABLE_COLUMN_NULLABLE;
+        if (column->guard)
+            flags |= TABLE_COLUMN_GUARD;
+        if (column->nested)
+            flags |= TABLE_COLUMN_NESTED;
+        if (column->hidden)
+            flags |= TABLE_COLUMN_HIDDEN;
+        if (column->unused)
+            flags |= TABLE_COLUMN_UNUSED;
+        if (column->storedAsLob)
+            flags |= TABLE_COLUMN_STORED_AS_LOB;
+
         columns.push_back(column);
+        columnFlags.push_back(flags);
+        columnTypes.push_back(static_cast<uint16_t>(column->type));
+        columnGuardSegs.push_back(column->guardSeg);
     }
 
     void OracleTable::addLob(OracleLob* lob) {
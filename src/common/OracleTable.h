@@ -24,10 +24,25 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #ifndef ORACLE_OBJECT_H_
 #define ORACLE_OBJECT_H_
 
+#define TABLE_COLUMN_PK                         0x01
+#define TABLE_COLUMN_NULLABLE                   0x02
+#define TABLE_COLUMN_GUARD                      0x04
+#define TABLE_COLUMN_NESTED                     0x08
+#define TABLE_COLUMN_HIDDEN                     0x10
+#define TABLE_COLUMN_UNUSED                     0x20
+#define TABLE_COLUMN_STORED_AS_LOB              0x40
+
 namespace OpenLogReplicator {
+    class CharacterSet;
     class OracleColumn;
     class OracleLob;
 
+    // Decoding of the column values chosen by the output for the table
+    struct OracleColumnDecoder {
+        uint64_t decoder;
+        CharacterSet* characterSet;
+    };
+
     class OracleTable final {
     public:
         typeObj obj;
@@ -42,6 +57,11 @@ namespace OpenLogReplicator {
         std::string owner;
         std::string name;
         std::vector<OracleColumn*> columns;
+        // Attributes of the columns used for every row, packed in parallel arrays indexed like columns (by segcol# - 1)
+        std::vector<uint8_t> columnFlags;
+        std::vector<uint16_t> columnTypes;
+        std::vector<typeCol> columnGuardSegs;
+        std::vector<OracleColumnDecoder> decoders;
         std::vector<OracleLob*> lobs;
         std::vector<typeObj2> tablePartitions;
         std::vector<typeCol> pk;
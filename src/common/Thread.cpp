@@ -22,10 +22,12 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "Thread.h"
 
 namespace OpenLogReplicator {
-    Thread::Thread(Ctx* newCtx, const std::string& newAlias) :
+    Thread::Thread(Ctx* newCtx, const std::string& newAlias, uint64_t newRole) :
             ctx(newCtx),
             pthread(0),
             alias(newAlias),
+            role(newRole),
+            threadName(std::string("olr-") + Ctx::threadRoles[newRole]),
             finished(false) {
     }
 
@@ -41,7 +43,11 @@ namespace OpenLogReplicator {
 
     void* Thread::runStatic(void* voidThread) {
         Thread* thread = reinterpret_cast<Thread*>(voidThread);
+        // Names longer than 15 characters are not accepted by the system
+        pthread_setname_np(pthread_self(), thread->threadName.substr(0, 15).c_str());
         thread->run();
+        // Chunks cached by the thread are returned to the shared pool
+        thread->ctx->releaseMemoryCache();
         thread->finished = true;
         return nullptr;
     }
@@ -35,9 +35,12 @@ namespace OpenLogReplicator {
         Ctx* ctx;
         pthread_t pthread;
         std::string alias;
+        uint64_t role;
+        // Name visible in the operating system tools
+        std::string threadName;
         std::atomic<bool> finished;
 
-        explicit Thread(Ctx* newCtx, const std::string& newAlias);
+        Thread(Ctx* newCtx, const std::string& newAlias, uint64_t newRole);
         virtual ~Thread();
         virtual void wakeUp();
         static void* runStatic(void* thread);
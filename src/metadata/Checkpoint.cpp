@@ -38,7 +38,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 namespace OpenLogReplicator {
 
     Checkpoint::Checkpoint(Ctx* newCtx, Metadata* newMetadata, const std::string& newAlias, const std::string& newConfigFileName, time_t newConfigFileChange) :
-            Thread(newCtx, newAlias),
+            Thread(newCtx, newAlias, THREAD_ROLE_CHECKPOINT),
             metadata(newMetadata),
             configFileBuffer(nullptr),
             configFileName(newConfigFileName),
@@ -200,15 +200,13 @@ namespace OpenLogReplicator {
                 metadata->schema->touchTable(it.second->obj);
 
             std::list<std::string> msgs;
-            for (SchemaElement* element: metadata->schemaElements) {
-                if (metadata->ctx->logLevel >= LOG_LEVEL_DEBUG)
+            if (metadata->ctx->logLevel >= LOG_LEVEL_DEBUG) {
+                for (SchemaElement* element: metadata->schemaElements)
                     msgs.push_back("- creating table schema for owner: " + element->owner + " table: " + element->table + " options: " +
                                    std::to_string(element->options));
-
-                metadata->schema->buildMaps(element->owner, element->table, element->keys, element->keysStr, element->options, msgs,
-                                            metadata->suppLogDbPrimary, metadata->suppLogDbAll, metadata->defaultCharacterMapId,
-                                            metadata->defaultCharacterNcharMapId);
             }
+            metadata->schema->buildMaps(metadata->schemaMatcher, msgs, metadata->suppLogDbPrimary, metadata->suppLogDbAll,
+                                        metadata->defaultCharacterMapId, metadata->defaultCharacterNcharMapId);
             for (const auto& msg: msgs) {
                 ctx->info(0, "- found: " + msg);
             }
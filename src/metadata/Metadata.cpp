@@ -42,7 +42,10 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "Metadata.h"
 #include "Schema.h"
 #include "SchemaElement.h"
+#include "SchemaMatcher.h"
 #include "Serializer.h"
+#include "SerializerBinary.h"
+#include "SerializerJson.h"
 
 namespace OpenLogReplicator {
     Metadata::Metadata(Ctx* newCtx, Locales* newLocales, const char* newDatabase, typeConId newConId, typeScn newStartScn, typeSeq newStartSequence,
@@ -81,6 +84,9 @@ namespace OpenLogReplicator {
             nextScn(ZERO_SCN),
             clientScn(ZERO_SCN),
             clientIdx(0),
+            writers(0),
+            writersCheckpointRead(0),
+            writersCheckpointFound(false),
             checkpoints(0),
             checkpointScn(ZERO_SCN),
             lastCheckpointScn(ZERO_SCN),
@@ -94,7 +100,8 @@ namespace OpenLogReplicator {
             minSequence(ZERO_SEQ),
             minOffset(0),
             minXid(),
-            schemaInterval(0) {
+            schemaInterval(0),
+            schemaMatcher(new SchemaMatcher()) {
     }
 
     Metadata::~Metadata() {
@@ -119,6 +126,11 @@ namespace OpenLogReplicator {
 
         purgeRedoLogs();
 
+        if (schemaMatcher != nullptr) {
+            delete schemaMatcher;
+            schemaMatcher = nullptr;
+        }
+
         for (SchemaElement* element : schemaElements)
             delete element;
         schemaElements.clear();
@@ -236,6 +248,17 @@ namespace OpenLogReplicator {
         return false;
     }
 
+    bool Metadata::deserialize(const std::string& ss, const std::string& name, std::list<std::string>& msgs, bool loadMetadata, bool loadSchema) {
+        // Checkpoints written in any format can be read, the next checkpoint is written in the configured one
+        if (SerializerBinary::isBinary(ss)) {
+            SerializerBinary serializerBinary;
+            return serializerBinary.deserialize(this, ss, name, msgs, loadMetadata, loadSchema);
+        }
+
+        SerializerJson serializerJson;
+        return serializerJson.deserialize(this, ss, name, msgs, loadMetadata, loadSchema);
+    }
+
     SchemaElement* Metadata::addElement(const char* owner, const char* table, typeOptions options) {
         if (!Ctx::checkNameCase(owner))
             throw ConfigurationException(30003, "owner '" + std::string(owner) +
@@ -280,6 +303,86 @@ namespace OpenLogReplicator {
         for (SchemaElement* element : newSchemaElements)
             schemaElements.push_back(element);
         newSchemaElements.clear();
+        schemaMatcher->build(schemaElements);
+    }
+
+    uint64_t Metadata::addWriter() {
+        std::unique_lock<std::mutex> lck(mtxCheckpoint);
+
+        writersClientScn.push_back(ZERO_SCN);
+        writersClientIdx.push_back(0);
+        return writers++;
+    }
+
+    void Metadata::updateClientPosition() {
+        clientScn = ZERO_SCN;
+        clientIdx = 0;
+        for (uint64_t writerId = 0; writerId < writers; ++writerId) {
+            // A writer without a position treats all data as new
+            if (writersClientScn[writerId] == ZERO_SCN) {
+                clientScn = ZERO_SCN;
+                clientIdx = 0;
+                return;
+            }
+
+            if (writersClientScn[writerId] < clientScn || (writersClientScn[writerId] == clientScn && writersClientIdx[writerId] < clientIdx)) {
+                clientScn = writersClientScn[writerId];
+                clientIdx = writersClientIdx[writerId];
+            }
+        }
+    }
+
+    void Metadata::setWriterCheckpoint(uint64_t writerId, bool found, typeResetlogs newResetlogs, typeActivation newActivation, typeScn newClientScn,
+                                       typeIdx newClientIdx) {
+        std::unique_lock<std::mutex> lck(mtxCheckpoint);
+
+        if (found) {
+            writersClientScn[writerId] = newClientScn;
+            writersClientIdx[writerId] = newClientIdx;
+        }
+
+        // Continue from the oldest position confirmed by any writer
+        if (found && (!writersCheckpointFound || newClientScn < clientScn || (newClientScn == clientScn && newClientIdx < clientIdx))) {
+            resetlogs = newResetlogs;
+            activation = newActivation;
+            clientScn = newClientScn;
+            clientIdx = newClientIdx;
+            startScn = newClientScn;
+            startSequence = ZERO_SEQ;
+            startTime.clear();
+            startTimeRel = 0;
+            writersCheckpointFound = true;
+        }
+
+        ++writersCheckpointRead;
+        if (writersCheckpointRead < writers)
+            return;
+
+        if (writersCheckpointFound) {
+            ctx->info(0, "checkpoint - all confirmed till scn: " + std::to_string(clientScn) + ", idx: " + std::to_string(clientIdx));
+            status = METADATA_STATUS_REPLICATE;
+            condReplicator.notify_all();
+        }
+        updateClientPosition();
+        condWriter.notify_all();
+    }
+
+    void Metadata::setWriterClient(uint64_t writerId, typeScn newClientScn, typeIdx newClientIdx) {
+        std::unique_lock<std::mutex> lck(mtxCheckpoint);
+
+        writersClientScn[writerId] = newClientScn;
+        writersClientIdx[writerId] = newClientIdx;
+        updateClientPosition();
+    }
+
+    void Metadata::waitForWriters() {
+        std::unique_lock<std::mutex> lck(mtxCheckpoint);
+
+        while (writersCheckpointRead < writers && !ctx->hardShutdown) {
+            if (ctx->trace & TRACE_SLEEP)
+                ctx->logTrace(TRACE_SLEEP, "Metadata:waitForWriters");
+            condWriter.wait(lck);
+        }
     }
 
     void Metadata::waitForWriter() {
@@ -302,6 +405,16 @@ namespace OpenLogReplicator {
         }
     }
 
+    void Metadata::waitForReplication(uint64_t timeUs) {
+        std::unique_lock<std::mutex> lck(mtxCheckpoint);
+
+        if (status != METADATA_STATUS_REPLICATE && !ctx->hardShutdown) {
+            if (ctx->trace & TRACE_SLEEP)
+                ctx->logTrace(TRACE_SLEEP, "Metadata:waitForReplication");
+            condWriter.wait_for(lck, std::chrono::microseconds(timeUs));
+        }
+    }
+
     void Metadata::setStatusReady() {
         std::unique_lock<std::mutex> lck(mtxCheckpoint);
 
@@ -351,9 +464,13 @@ namespace OpenLogReplicator {
 
     void Metadata::writeCheckpoint(bool force) {
         std::ostringstream ss;
+        uint64_t schemaMode = SERIALIZER_SCHEMA_FULL;
 
         {
-            std::unique_lock<std::mutex> lck(mtxCheckpoint);
+            // The schema lock is held longer, while the schema is serialized
+            std::unique_lock<std::mutex> lckSchema(mtxSchema, std::defer_lock);
+            std::unique_lock<std::mutex> lck(mtxCheckpoint, std::defer_lock);
+            std::lock(lckSchema, lck);
             if (!allowedCheckpoints)
                 return;
 
@@ -367,17 +484,21 @@ namespace OpenLogReplicator {
                 return;
 
             // Schema did not change
-            bool storeSchema = true;
             if (schema->refScn != ZERO_SCN && schema->refScn >= schema->scn) {
                 if (schemaInterval < ctx->schemaForceInterval) {
-                    storeSchema = false;
+                    schemaMode = SERIALIZER_SCHEMA_NONE;
                     ++schemaInterval;
                 } else
                     schemaInterval = 0;
+
+            // Schema changed, store just the changes until the full schema is forced again
+            } else if (ctx->schemaDelta && schema->refScn != ZERO_SCN && schemaInterval < ctx->schemaForceInterval) {
+                schemaMode = SERIALIZER_SCHEMA_DELTA;
+                ++schemaInterval;
             } else
                 schemaInterval = 0;
 
-            serializer->serialize(this, ss, storeSchema);
+            serializer->serialize(this, ss, schemaMode);
 
             lastCheckpointScn = checkpointScn;
             lastSequence = sequence;
@@ -386,7 +507,15 @@ namespace OpenLogReplicator {
             lastCheckpointBytes = checkpointBytes;
             ++checkpoints;
             checkpointScnList.insert(checkpointScn);
-            checkpointSchemaMap.insert_or_assign(checkpointScn, storeSchema);
+            checkpointSchemaMap.insert_or_assign(checkpointScn, schemaMode == SERIALIZER_SCHEMA_FULL);
+            lck.unlock();
+
+            // Parser checkpoints and writer confirmations don't wait for the schema, only DDL transactions do
+            serializer->serializeSchema(this, ss, schemaMode);
+            if (schemaMode != SERIALIZER_SCHEMA_NONE) {
+                schema->refScn = lastCheckpointScn;
+                schema->resetDelta();
+            }
         }
 
         std::string checkpointName = database + "-chkpt-" + std::to_string(lastCheckpointScn);
@@ -395,9 +524,21 @@ namespace OpenLogReplicator {
             ctx->logTrace(TRACE_CHECKPOINT, "write scn: " + std::to_string(lastCheckpointScn) + " time: " +
                           std::to_string(lastCheckpointTime.getVal()) + " seq: " + std::to_string(lastSequence) + " offset: " +
                           std::to_string(lastCheckpointOffset) + " name: " + checkpointName);
+        if (ctx->trace & TRACE_CHECKPOINT) {
+            std::string memoryUsage;
+            for (uint64_t module = 0; module < MEMORY_MODULES_NUM; ++module)
+                memoryUsage += " " + std::string(Ctx::memoryModules[module]) + ": " + std::to_string(ctx->getModuleMemory(module)) + "/" +
+                        std::to_string(ctx->getModuleMaxUsedMemory(module)) + "MB";
+            ctx->logTrace(TRACE_CHECKPOINT, "memory used/max:" + memoryUsage);
+        }
 
-        if (!stateWrite(checkpointName, lastCheckpointScn, ss))
+        if (!stateWrite(checkpointName, lastCheckpointScn, ss)) {
             ctx->warning(60018, "file: " + checkpointName + " - couldn't write checkpoint");
+
+            // Changes since the previous checkpoint are lost, the next one has to contain the full schema
+            std::unique_lock<std::mutex> lckSchema(mtxSchema);
+            schema->refScn = ZERO_SCN;
+        }
     }
 
     void Metadata::readCheckpoints() {
@@ -424,8 +565,10 @@ namespace OpenLogReplicator {
             if (ctx->trace & TRACE_CHECKPOINT)
                 ctx->logTrace(TRACE_CHECKPOINT, "found: " + name + " scn: " + std::to_string(scn));
 
+            // Content is not known without reading the file, it may contain just schema changes that newer checkpoints depend on.
+            // Such files are kept until a checkpoint with the full schema is written again.
             checkpointScnList.insert(scn);
-            checkpointSchemaMap.insert_or_assign(scn, true);
+            checkpointSchemaMap.insert_or_assign(scn, false);
         }
 
         if (startScn != ZERO_SCN)
@@ -460,7 +603,7 @@ namespace OpenLogReplicator {
             sequence = ZERO_SEQ;
             return;
         }
-        if (!serializer->deserialize(this, ss, name1, msgs, true, true)) {
+        if (!deserialize(ss, name1, msgs, true, true)) {
             for (const auto& msg : msgs) {
                 ctx->info(0, msg);
             }
@@ -472,21 +615,31 @@ namespace OpenLogReplicator {
         }
         msgs.clear();
 
-        // Schema missing
-        if (schema->scn == ZERO_SCN) {
+        // Schema missing, follow the references down to the checkpoint with the full schema
+        std::list<typeScn> deltaScns;
+        typeScn schemaScn = scn;
+        while (schema->scn == ZERO_SCN) {
             if (schema->refScn == ZERO_SCN) {
                 ctx->warning(60019, "file: " + name1 + " - load checkpoint failed, reference SCN missing");
                 return;
             }
+            if (schema->refScn >= schemaScn) {
+                ctx->warning(60019, "file: " + name1 + " - load checkpoint failed, invalid reference SCN: " + std::to_string(schema->refScn));
+                return;
+            }
+
+            if (schema->deltaPending)
+                deltaScns.push_front(schemaScn);
+            schemaScn = schema->refScn;
 
             ss.clear();
-            std::string name2(database + "-chkpt-" + std::to_string(schema->refScn));
-            ctx->info(0, "reading schema for " + database + " for scn: " + std::to_string(schema->refScn));
+            std::string name2(database + "-chkpt-" + std::to_string(schemaScn));
+            ctx->info(0, "reading schema for " + database + " for scn: " + std::to_string(schemaScn));
 
             if (!stateRead(name2, CHECKPOINT_SCHEMA_FILE_MAX_SIZE, ss))
                 return;
 
-            if (!serializer->deserialize(this, ss, name2, msgs, false, true)) {
+            if (!deserialize(ss, name2, msgs, false, true)) {
                 for (const auto& msg: msgs) {
                     ctx->info(0, msg);
                 }
@@ -496,6 +649,35 @@ namespace OpenLogReplicator {
             for (const auto& msg: msgs) {
                 ctx->info(0, "- found: " + msg);
             }
+            msgs.clear();
+        }
+
+        // Schema changes stored after the full schema, oldest first
+        for (typeScn deltaScn : deltaScns) {
+            ss.clear();
+            std::string name3(database + "-chkpt-" + std::to_string(deltaScn));
+            ctx->info(0, "applying schema changes for " + database + " for scn: " + std::to_string(deltaScn));
+
+            if (!stateRead(name3, CHECKPOINT_SCHEMA_FILE_MAX_SIZE, ss))
+                return;
+
+            if (!deserialize(ss, name3, msgs, false, true)) {
+                for (const auto& msg: msgs) {
+                    ctx->info(0, msg);
+                }
+                return;
+            }
+
+            for (const auto& msg: msgs) {
+                ctx->info(0, "- found: " + msg);
+            }
+            msgs.clear();
+
+            if (schema->scn == ZERO_SCN) {
+                ctx->warning(60019, "file: " + name3 + " - load checkpoint failed, schema changes don't match SCN: " +
+                             std::to_string(schema->loadedScn));
+                return;
+            }
         }
 
         if (schema->scn != ZERO_SCN)
@@ -568,7 +750,7 @@ namespace OpenLogReplicator {
             return;
         }
 
-        if (!serializer->deserialize(this, ss, name, msgs, false, true)) {
+        if (!deserialize(ss, name, msgs, false, true)) {
             for (const auto& msg: msgs) {
                 ctx->info(0, msg);
             }
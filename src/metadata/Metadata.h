@@ -20,6 +20,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <list>
 #include <mutex>
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
@@ -49,6 +50,7 @@ namespace OpenLogReplicator {
     class RedoLog;
     class Schema;
     class SchemaElement;
+    class SchemaMatcher;
     class Serializer;
     class State;
     class StateDisk;
@@ -58,6 +60,8 @@ namespace OpenLogReplicator {
         std::condition_variable condReplicator;
         std::condition_variable condWriter;
 
+        void updateClientPosition();
+
     public:
         Schema* schema;
         Ctx* ctx;
@@ -113,6 +117,13 @@ namespace OpenLogReplicator {
         typeScn nextScn;
         typeScn clientScn;
         typeIdx clientIdx;
+        // Writers attached to the source, replication starts from the oldest of their checkpoints.
+        // Client positions are kept per writer, clientScn/clientIdx hold the oldest of them.
+        uint64_t writers;
+        std::vector<typeScn> writersClientScn;
+        std::vector<typeIdx> writersClientIdx;
+        uint64_t writersCheckpointRead;
+        bool writersCheckpointFound;
         uint64_t checkpoints;
         typeScn checkpointScn;
         typeScn lastCheckpointScn;
@@ -135,6 +146,7 @@ namespace OpenLogReplicator {
         // Schema information
         std::mutex mtxSchema;
         std::vector<SchemaElement*> schemaElements;
+        SchemaMatcher* schemaMatcher;
         std::set<std::string> users;
 
         Metadata(Ctx* newCtx, Locales* newLocales, const char* newDatabase, typeConId newConId, typeScn newStartScn, typeSeq newStartSequence,
@@ -152,12 +164,19 @@ namespace OpenLogReplicator {
         [[nodiscard]] bool stateDiskRead(const std::string& name, uint64_t maxSize, std::string& in);
         [[nodiscard]] bool stateWrite(const std::string& name, typeScn scn, std::ostringstream& out);
         [[nodiscard]] bool stateDrop(const std::string& name);
+        [[nodiscard]] bool deserialize(const std::string& ss, const std::string& name, std::list<std::string>& msgs, bool loadMetadata, bool loadSchema);
         SchemaElement* addElement(const char* owner, const char* table, typeOptions options);
         void resetElements();
         void commitElements();
 
+        [[nodiscard]] uint64_t addWriter();
+        void setWriterCheckpoint(uint64_t writerId, bool found, typeResetlogs newResetlogs, typeActivation newActivation, typeScn newClientScn,
+                                 typeIdx newClientIdx);
+        void setWriterClient(uint64_t writerId, typeScn newClientScn, typeIdx newClientIdx);
+        void waitForWriters();
         void waitForWriter();
         void waitForReplicator();
+        void waitForReplication(uint64_t timeUs);
         void setStatusReady();
         void setStatusStart();
         void setStatusReplicate();
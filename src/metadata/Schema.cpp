@@ -19,7 +19,6 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 #include <cstring>
 #include <list>
-#include <regex>
 
 #include "../common/Ctx.h"
 #include "../common/DataException.h"
@@ -31,6 +30,8 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "../common/SysTab.h"
 #include "../locales/Locales.h"
 #include "Schema.h"
+#include "SchemaElement.h"
+#include "SchemaMatcher.h"
 
 namespace OpenLogReplicator {
     Schema::Schema(Ctx* newCtx, Locales* newLocales) :
@@ -55,89 +56,141 @@ namespace OpenLogReplicator {
             scn(ZERO_SCN),
             refScn(ZERO_SCN),
             loaded(false),
+            loadedScn(ZERO_SCN),
+            deltaPending(false),
             columnTmp(nullptr),
             lobTmp(nullptr),
-            tableTmp(nullptr) {
+            tableTmp(nullptr),
+            sysCColMapRowId(&arena),
+            sysCColMapRowIdDelta(&arena),
+            sysCColMapKey(&arena),
+            sysCDefMapRowId(&arena),
+            sysCDefMapRowIdDelta(&arena),
+            sysCDefMapKey(&arena),
+            sysCDefMapCon(&arena),
+            sysColMapRowId(&arena),
+            sysColMapRowIdDelta(&arena),
+            sysColMapSeg(&arena),
+            sysDeferredStgMapRowId(&arena),
+            sysDeferredStgMapRowIdDelta(&arena),
+            sysDeferredStgMapObj(&arena),
+            sysEColMapRowId(&arena),
+            sysEColMapRowIdDelta(&arena),
+            sysEColMapKey(&arena),
+            sysLobMapRowId(&arena),
+            sysLobMapRowIdDelta(&arena),
+            sysLobMapLObj(&arena),
+            sysLobMapKey(&arena),
+            sysLobCompPartMapRowId(&arena),
+            sysLobCompPartMapRowIdDelta(&arena),
+            sysLobCompPartMapPartObj(&arena),
+            sysLobCompPartMapKey(&arena),
+            sysLobFragMapRowId(&arena),
+            sysLobFragMapRowIdDelta(&arena),
+            sysLobFragMapKey(&arena),
+            sysObjMapRowId(&arena),
+            sysObjMapRowIdDelta(&arena),
+            sysObjMapName(&arena),
+            sysObjMapObj(&arena),
+            sysTabMapRowId(&arena),
+            sysTabMapRowIdDelta(&arena),
+            sysTabMapObj(&arena),
+            sysTabComPartMapRowId(&arena),
+            sysTabComPartMapRowIdDelta(&arena),
+            sysTabComPartMapObj(&arena),
+            sysTabComPartMapKey(&arena),
+            sysTabPartMapRowId(&arena),
+            sysTabPartMapRowIdDelta(&arena),
+            sysTabPartMapKey(&arena),
+            sysTabSubPartMapRowId(&arena),
+            sysTabSubPartMapRowIdDelta(&arena),
+            sysTabSubPartMapKey(&arena),
+            sysTsMapRowId(&arena),
+            sysTsMapRowIdDelta(&arena),
+            sysTsMapTs(&arena),
+            sysUserMapRowId(&arena),
+            sysUserMapRowIdDelta(&arena),
+            sysUserMapUser(&arena) {
     }
 
     Schema::~Schema() {
         if (sysCColTmp != nullptr) {
-            delete sysCColTmp;
+            arena.destroy(sysCColTmp);
             sysCColTmp = nullptr;
         }
 
         if (sysCColTmp != nullptr) {
-            delete sysCColTmp;
+            arena.destroy(sysCColTmp);
             sysCColTmp = nullptr;
         }
 
         if (sysCDefTmp != nullptr) {
-            delete sysCDefTmp;
+            arena.destroy(sysCDefTmp);
             sysCDefTmp = nullptr;
         }
 
         if (sysColTmp != nullptr) {
-            delete sysColTmp;
+            arena.destroy(sysColTmp);
             sysColTmp = nullptr;
         }
 
         if (sysDeferredStgTmp != nullptr) {
-            delete sysDeferredStgTmp;
+            arena.destroy(sysDeferredStgTmp);
             sysDeferredStgTmp = nullptr;
         }
 
         if (sysEColTmp != nullptr) {
-            delete sysEColTmp;
+            arena.destroy(sysEColTmp);
             sysEColTmp = nullptr;
         }
 
         if (sysLobTmp != nullptr) {
-            delete sysLobTmp;
+            arena.destroy(sysLobTmp);
             sysLobTmp = nullptr;
         }
 
         if (sysLobCompPartTmp != nullptr) {
-            delete sysLobCompPartTmp;
+            arena.destroy(sysLobCompPartTmp);
             sysLobCompPartTmp = nullptr;
         }
 
         if (sysLobFragTmp != nullptr) {
-            delete sysLobFragTmp;
+            arena.destroy(sysLobFragTmp);
             sysLobFragTmp = nullptr;
         }
 
         if (sysObjTmp != nullptr) {
-            delete sysObjTmp;
+            arena.destroy(sysObjTmp);
             sysObjTmp = nullptr;
         }
 
         if (sysTabTmp != nullptr) {
-            delete sysTabTmp;
+            arena.destroy(sysTabTmp);
             sysTabTmp = nullptr;
         }
 
         if (sysTabComPartTmp != nullptr) {
-            delete sysTabComPartTmp;
+            arena.destroy(sysTabComPartTmp);
             sysTabComPartTmp = nullptr;
         }
 
         if (sysTabPartTmp != nullptr) {
-            delete sysTabPartTmp;
+            arena.destroy(sysTabPartTmp);
             sysTabPartTmp = nullptr;
         }
 
         if (sysTabSubPartTmp != nullptr) {
-            delete sysTabSubPartTmp;
+            arena.destroy(sysTabSubPartTmp);
             sysTabSubPartTmp = nullptr;
         }
 
         if (sysTsTmp != nullptr) {
-            delete sysTsTmp;
+            arena.destroy(sysTsTmp);
             sysTsTmp = nullptr;
         }
 
         if (sysUserTmp != nullptr) {
-            delete sysUserTmp;
+            arena.destroy(sysUserTmp);
             sysUserTmp = nullptr;
         }
 
@@ -177,6 +230,9 @@ namespace OpenLogReplicator {
         if (!tablePartitionMap.empty())
             ctx->error(50029, "schema table partition map not empty, left: " + std::to_string(tablePartitionMap.size()) + " at exit");
         tablePartitionMap.clear();
+        tablePendingMap.clear();
+        tablePendingPartitionMap.clear();
+        tableRules.clear();
 
         tablesTouched.clear();
         identifiersTouched.clear();
@@ -188,7 +244,7 @@ namespace OpenLogReplicator {
             auto sysCColMapRowIdIt = sysCColMapRowId.cbegin();
             SysCCol* sysCCol = sysCColMapRowIdIt->second;
             dictSysCColDrop(sysCCol);
-            delete sysCCol;
+            arena.destroy(sysCCol);
         }
         if (!sysCColMapKey.empty())
             ctx->error(50029, "key map SYS.CCOL$ not empty, left: " + std::to_string(sysCColMapKey.size()) + " at exit");
@@ -198,7 +254,7 @@ namespace OpenLogReplicator {
             auto sysCDefMapRowIdIt = sysCDefMapRowId.cbegin();
             SysCDef* sysCDef = sysCDefMapRowIdIt->second;
             dictSysCDefDrop(sysCDef);
-            delete sysCDef;
+            arena.destroy(sysCDef);
         }
         if (!sysCDefMapCon.empty())
             ctx->error(50029, "con# map SYS.CDEF$ not empty, left: " + std::to_string(sysCDefMapCon.size()) + " at exit");
@@ -210,7 +266,7 @@ namespace OpenLogReplicator {
             auto sysColMapRowIdIt = sysColMapRowId.cbegin();
             SysCol* sysCol = sysColMapRowIdIt->second;
             dictSysColDrop(sysCol);
-            delete sysCol;
+            arena.destroy(sysCol);
         }
         if (!sysColMapSeg.empty())
             ctx->error(50029, "seg# map SYS.COL$ not empty, left: " + std::to_string(sysColMapSeg.size()) + " at exit");
@@ -220,7 +276,7 @@ namespace OpenLogReplicator {
             auto sysDeferredStgMapRowIdIt = sysDeferredStgMapRowId.cbegin();
             SysDeferredStg* sysDeferredStg = sysDeferredStgMapRowIdIt->second;
             dictSysDeferredStgDrop(sysDeferredStg);
-            delete sysDeferredStg;
+            arena.destroy(sysDeferredStg);
         }
         if (!sysDeferredStgMapObj.empty())
             ctx->error(50029, "obj map SYS.DEFERRED_STG$ not empty, left: " + std::to_string(sysDeferredStgMapObj.size()) + " at exit");
@@ -230,7 +286,7 @@ namespace OpenLogReplicator {
             auto sysEColMapRowIdIt = sysEColMapRowId.cbegin();
             SysECol* sysECol = sysEColMapRowIdIt->second;
             dictSysEColDrop(sysECol);
-            delete sysECol;
+            arena.destroy(sysECol);
         }
         if (!sysEColMapKey.empty())
             ctx->error(50029, "key map SYS.ECOL$ not empty, left: " + std::to_string(sysEColMapKey.size()) + " at exit");
@@ -240,7 +296,7 @@ namespace OpenLogReplicator {
             auto sysLobMapRowIdIt = sysLobMapRowId.cbegin();
             SysLob* sysLob = sysLobMapRowIdIt->second;
             dictSysLobDrop(sysLob);
-            delete sysLob;
+            arena.destroy(sysLob);
         }
         if (!sysLobMapLObj.empty())
             ctx->error(50029, "lobj# map SYS.LOB$ not empty, left: " + std::to_string(sysLobMapLObj.size()) + " at exit");
@@ -252,7 +308,7 @@ namespace OpenLogReplicator {
             auto sysLobCompPartMapRowIdIt = sysLobCompPartMapRowId.cbegin();
             SysLobCompPart* sysLobCompPart = sysLobCompPartMapRowIdIt->second;
             dictSysLobCompPartDrop(sysLobCompPart);
-            delete sysLobCompPart;
+            arena.destroy(sysLobCompPart);
         }
         if (!sysLobCompPartMapPartObj.empty())
             ctx->error(50029, "partobj# map SYS.LOBCOMPPART$ not empty, left: " + std::to_string(sysLobCompPartMapPartObj.size()) +
@@ -265,7 +321,7 @@ namespace OpenLogReplicator {
             auto sysLobFragMapRowIdIt = sysLobFragMapRowId.cbegin();
             SysLobFrag* sysLobFrag = sysLobFragMapRowIdIt->second;
             dictSysLobFragDrop(sysLobFrag);
-            delete sysLobFrag;
+            arena.destroy(sysLobFrag);
         }
         if (!sysLobFragMapKey.empty())
             ctx->error(50029, "key map SYS.LOBFRAG$ not empty, left: " + std::to_string(sysLobFragMapKey.size()) + " at exit");
@@ -275,7 +331,7 @@ namespace OpenLogReplicator {
             auto sysObjMapRowIdIt = sysObjMapRowId.cbegin();
             SysObj* sysObj = sysObjMapRowIdIt->second;
             dictSysObjDrop(sysObj);
-            delete sysObj;
+            arena.destroy(sysObj);
         }
         if (!sysObjMapName.empty())
             ctx->error(50029, "name map SYS.OBJ$ not empty, left: " + std::to_string(sysObjMapName.size()) + " at exit");
@@ -287,7 +343,7 @@ namespace OpenLogReplicator {
             auto sysTabMapRowIdIt = sysTabMapRowId.cbegin();
             SysTab* sysTab = sysTabMapRowIdIt->second;
             dictSysTabDrop(sysTab);
-            delete sysTab;
+            arena.destroy(sysTab);
         }
         if (!sysTabMapObj.empty())
             ctx->error(50029, "obj# map SYS.TAB$ not empty, left: " + std::to_string(sysTabMapObj.size()) + " at exit");
@@ -297,7 +353,7 @@ namespace OpenLogReplicator {
             auto sysTabComPartMapRowIdIt = sysTabComPartMapRowId.cbegin();
             SysTabComPart* sysTabComPart = sysTabComPartMapRowIdIt->second;
             dictSysTabComPartDrop(sysTabComPart);
-            delete sysTabComPart;
+            arena.destroy(sysTabComPart);
         }
         if (!sysTabComPartMapObj.empty())
             ctx->error(50029, "obj# map SYS.TABCOMPART$ not empty, left: " + std::to_string(sysTabComPartMapObj.size()) + " at exit");
@@ -309,7 +365,7 @@ namespace OpenLogReplicator {
             auto sysTabPartMapRowIdIt = sysTabPartMapRowId.cbegin();
             SysTabPart* sysTabPart = sysTabPartMapRowIdIt->second;
             dictSysTabPartDrop(sysTabPart);
-            delete sysTabPart;
+            arena.destroy(sysTabPart);
         }
         if (!sysTabPartMapKey.empty())
             ctx->error(50029, "key map SYS.TABPART$ not empty, left: " + std::to_string(sysTabPartMapKey.size()) + " at exit");
@@ -319,7 +375,7 @@ namespace OpenLogReplicator {
             auto sysTabSubPartMapRowIdIt = sysTabSubPartMapRowId.cbegin();
             SysTabSubPart* sysTabSubPart = sysTabSubPartMapRowIdIt->second;
             dictSysTabSubPartDrop(sysTabSubPart);
-            delete sysTabSubPart;
+            arena.destroy(sysTabSubPart);
         }
         if (!sysTabSubPartMapKey.empty())
             ctx->error(50029, "key map SYS.TABSUBPART$ not empty, left: " + std::to_string(sysTabSubPartMapKey.size()) + " at exit");
@@ -329,7 +385,7 @@ namespace OpenLogReplicator {
             auto sysTsMapRowIdIt = sysTsMapRowId.cbegin();
             SysTs* sysTs = sysTsMapRowIdIt->second;
             dictSysTsDrop(sysTs);
-            delete sysTs;
+            arena.destroy(sysTs);
         }
         if (!sysTsMapTs.empty())
             ctx->error(50029, "ts# map SYS.TS$ not empty, left: " + std::to_string(sysTsMapTs.size()) + " at exit");
@@ -339,12 +395,13 @@ namespace OpenLogReplicator {
             auto sysUserMapRowIdIt = sysUserMapRowId.cbegin();
             SysUser* sysUser = sysUserMapRowIdIt->second;
             dictSysUserDrop(sysUser);
-            delete sysUser;
+            arena.destroy(sysUser);
         }
         if (!sysUserMapUser.empty())
             ctx->error(50029, "user# map SYS.USER$ not empty, left: " + std::to_string(sysUserMapUser.size()) + " at exit");
 
         resetTouched();
+        resetDelta();
     }
 
     bool Schema::compareSysCCol(Schema* otherSchema, std::string& msgs) {
@@ -724,30 +781,27 @@ namespace OpenLogReplicator {
         return true;
     }
 
-    void Schema::dictSysCColAdd(const char* rowIdStr, typeCon con, typeCol intCol, typeObj obj, uint64_t spare11, uint64_t spare12) {
-        typeRowId rowId(rowIdStr);
+    void Schema::dictSysCColAdd(typeRowId rowId, typeCon con, typeCol intCol, typeObj obj, uint64_t spare11, uint64_t spare12) {
         if (sysCColMapRowId.find(rowId) != sysCColMapRowId.end())
             throw DataException(50023, "duplicate SYS.CCOL$ value: (rowid: " + rowId.toString() + ")");
 
-        sysCColTmp = new SysCCol(rowId, con, intCol, obj, spare11, spare12);
+        sysCColTmp = arena.create<SysCCol>(rowId, con, intCol, obj, spare11, spare12);
         dictSysCColAdd(sysCColTmp);
         sysCColTmp = nullptr;
     }
 
-    void Schema::dictSysCDefAdd(const char* rowIdStr, typeCon con, typeObj obj, typeType type) {
-        typeRowId rowId(rowIdStr);
+    void Schema::dictSysCDefAdd(typeRowId rowId, typeCon con, typeObj obj, typeType type) {
         if (sysCDefMapRowId.find(rowId) != sysCDefMapRowId.end())
             throw DataException(50023, "duplicate SYS.CDEF$ value: (rowid: " + rowId.toString() + ")");
 
-        sysCDefTmp = new SysCDef(rowId, con, obj, type);
+        sysCDefTmp = arena.create<SysCDef>(rowId, con, obj, type);
         dictSysCDefAdd(sysCDefTmp);
         sysCDefTmp = nullptr;
     }
 
-    void Schema::dictSysColAdd(const char* rowIdStr, typeObj obj, typeCol col, typeCol segCol, typeCol intCol, const char* name, typeType type,
+    void Schema::dictSysColAdd(typeRowId rowId, typeObj obj, typeCol col, typeCol segCol, typeCol intCol, const char* name, typeType type,
                                uint64_t length, int64_t precision, int64_t scale, uint64_t charsetForm, uint64_t charsetId, bool null_,
                                uint64_t property1, uint64_t property2) {
-        typeRowId rowId(rowIdStr);
         if (sysColMapRowId.find(rowId) != sysColMapRowId.end())
             throw DataException(50023, "duplicate SYS.COL$ value: (rowid: " + rowId.toString() + ")");
 
@@ -758,66 +812,60 @@ namespace OpenLogReplicator {
         if (segCol > 1000)
             throw DataException(50025, "value of SYS.COL$ too big for SEGCOL# (value: " + std::to_string(segCol) + ")");
 
-        sysColTmp = new SysCol(rowId, obj, col, segCol, intCol, name, type, length,
-                               precision, scale, charsetForm, charsetId, null_, property1,
-                               property2);
+        sysColTmp = arena.create<SysCol>(rowId, obj, col, segCol, intCol, name, type, length,
+                                         precision, scale, charsetForm, charsetId, null_, property1,
+                                         property2);
         dictSysColAdd(sysColTmp);
         sysColTmp = nullptr;
     }
 
-    void Schema::dictSysDeferredStgAdd(const char* rowIdStr, typeObj obj, uint64_t flagsStg1, uint64_t flagsStg2) {
-        typeRowId rowId(rowIdStr);
+    void Schema::dictSysDeferredStgAdd(typeRowId rowId, typeObj obj, uint64_t flagsStg1, uint64_t flagsStg2) {
         if (sysDeferredStgMapRowId.find(rowId) != sysDeferredStgMapRowId.end())
             throw DataException(50023, "duplicate SYS.DEFERRED_STG$ value: (rowid: " + rowId.toString() + ")");
 
-        sysDeferredStgTmp = new SysDeferredStg(rowId, obj, flagsStg1, flagsStg2);
+        sysDeferredStgTmp = arena.create<SysDeferredStg>(rowId, obj, flagsStg1, flagsStg2);
         dictSysDeferredStgAdd(sysDeferredStgTmp);
         sysDeferredStgTmp = nullptr;
     }
 
-    void Schema::dictSysEColAdd(const char* rowIdStr, typeObj tabObj, typeCol colNum, typeCol guardId) {
-        typeRowId rowId(rowIdStr);
+    void Schema::dictSysEColAdd(typeRowId rowId, typeObj tabObj, typeCol colNum, typeCol guardId) {
         if (sysEColMapRowId.find(rowId) != sysEColMapRowId.end())
             throw DataException(50023, "duplicate SYS.ECOL$ value: (rowid: " + rowId.toString() + ")");
 
-        sysEColTmp = new SysECol(rowId, tabObj, colNum, guardId);
+        sysEColTmp = arena.create<SysECol>(rowId, tabObj, colNum, guardId);
         dictSysEColAdd(sysEColTmp);
         sysEColTmp = nullptr;
     }
 
-    void Schema::dictSysLobAdd(const char* rowIdStr, typeObj obj, typeCol col, typeCol intCol, typeObj lObj, typeTs ts) {
-        typeRowId rowId(rowIdStr);
+    void Schema::dictSysLobAdd(typeRowId rowId, typeObj obj, typeCol col, typeCol intCol, typeObj lObj, typeTs ts) {
         if (sysLobMapRowId.find(rowId) != sysLobMapRowId.end())
             throw DataException(50023, "duplicate SYS.LOB$ value: (rowid: " + rowId.toString() + ")");
 
-        sysLobTmp = new SysLob(rowId, obj, col, intCol, lObj, ts);
+        sysLobTmp = arena.create<SysLob>(rowId, obj, col, intCol, lObj, ts);
         dictSysLobAdd(sysLobTmp);
         sysLobTmp = nullptr;
     }
 
-    void Schema::dictSysLobCompPartAdd(const char* rowIdStr, typeObj partObj, typeObj lObj) {
-        typeRowId rowId(rowIdStr);
+    void Schema::dictSysLobCompPartAdd(typeRowId rowId, typeObj partObj, typeObj lObj) {
         if (sysLobCompPartMapRowId.find(rowId) != sysLobCompPartMapRowId.end())
             throw DataException(50023, "duplicate SYS.LOBCOMPPART$ value: (rowid: " + rowId.toString() + ")");
 
-        sysLobCompPartTmp = new SysLobCompPart(rowId, partObj, lObj);
+        sysLobCompPartTmp = arena.create<SysLobCompPart>(rowId, partObj, lObj);
         dictSysLobCompPartAdd(sysLobCompPartTmp);
         sysLobCompPartTmp = nullptr;
     }
 
-    void Schema::dictSysLobFragAdd(const char* rowIdStr, typeObj fragObj, typeObj parentObj, typeTs ts) {
-        typeRowId rowId(rowIdStr);
+    void Schema::dictSysLobFragAdd(typeRowId rowId, typeObj fragObj, typeObj parentObj, typeTs ts) {
         if (sysLobFragMapRowId.find(rowId) != sysLobFragMapRowId.end())
             throw DataException(50023, "duplicate SYS.LOBFRAG$ value: (rowid: " + rowId.toString() + ")");
 
-        sysLobFragTmp = new SysLobFrag(rowId, fragObj, parentObj, ts);
+        sysLobFragTmp = arena.create<SysLobFrag>(rowId, fragObj, parentObj, ts);
         dictSysLobFragAdd(sysLobFragTmp);
         sysLobFragTmp = nullptr;
     }
 
-    bool Schema::dictSysObjAdd(const char* rowIdStr, typeUser owner, typeObj obj, typeDataObj dataObj, typeType type, const char* name,
+    bool Schema::dictSysObjAdd(typeRowId rowId, typeUser owner, typeObj obj, typeDataObj dataObj, typeType type, const char* name,
                                uint64_t flags1, uint64_t flags2, bool single) {
-        typeRowId rowId(rowIdStr);
         auto sysObjMapRowIdIt = sysObjMapRowId.find(rowId);
         if (sysObjMapRowIdIt != sysObjMapRowId.end()) {
             SysObj* sysObj = sysObjMapRowIdIt->second;
@@ -839,69 +887,62 @@ namespace OpenLogReplicator {
         if (strlen(name) > SYS_OBJ_NAME_LENGTH)
             throw DataException(50025, "value of SYS.OBJ$ too long for NAME (value: '" + std::string(name) + "', length: " +
                                 std::to_string(strlen(name)) + ")");
-        sysObjTmp = new SysObj(rowId, owner, obj, dataObj, type, name, flags1, flags2,
-                               single);
+        sysObjTmp = arena.create<SysObj>(rowId, owner, obj, dataObj, type, name, flags1, flags2,
+                                         single);
         dictSysObjAdd(sysObjTmp);
         sysObjTmp = nullptr;
 
         return true;
     }
 
-    void Schema::dictSysTabAdd(const char* rowIdStr, typeObj obj, typeDataObj dataObj, typeTs ts, typeCol cluCols, uint64_t flags1, uint64_t flags2,
+    void Schema::dictSysTabAdd(typeRowId rowId, typeObj obj, typeDataObj dataObj, typeTs ts, typeCol cluCols, uint64_t flags1, uint64_t flags2,
                                uint64_t property1, uint64_t property2) {
-        typeRowId rowId(rowIdStr);
         if (sysTabMapRowId.find(rowId) != sysTabMapRowId.end())
             throw DataException(50023, "duplicate SYS.TAB$ value: (rowid: " + rowId.toString() + ")");
 
-        sysTabTmp = new SysTab(rowId, obj, dataObj, ts, cluCols, flags1, flags2,
-                               property1, property2);
+        sysTabTmp = arena.create<SysTab>(rowId, obj, dataObj, ts, cluCols, flags1, flags2,
+                                         property1, property2);
         dictSysTabAdd(sysTabTmp);
         sysTabTmp = nullptr;
     }
 
-    void Schema::dictSysTabComPartAdd(const char* rowIdStr, typeObj obj, typeDataObj dataObj, typeObj bo) {
-        typeRowId rowId(rowIdStr);
+    void Schema::dictSysTabComPartAdd(typeRowId rowId, typeObj obj, typeDataObj dataObj, typeObj bo) {
         if (sysTabComPartMapRowId.find(rowId) != sysTabComPartMapRowId.end())
             throw DataException(50023, "duplicate SYS.TABCOMPART$ value: (rowid: " + rowId.toString() + ")");
 
-        sysTabComPartTmp = new SysTabComPart(rowId, obj, dataObj, bo);
+        sysTabComPartTmp = arena.create<SysTabComPart>(rowId, obj, dataObj, bo);
         dictSysTabComPartAdd(sysTabComPartTmp);
         sysTabComPartTmp = nullptr;
     }
 
-    void Schema::dictSysTabPartAdd(const char* rowIdStr, typeObj obj, typeDataObj dataObj, typeObj bo) {
-        typeRowId rowId(rowIdStr);
+    void Schema::dictSysTabPartAdd(typeRowId rowId, typeObj obj, typeDataObj dataObj, typeObj bo) {
         if (sysTabPartMapRowId.find(rowId) != sysTabPartMapRowId.end())
             throw DataException(50023, "duplicate SYS.TABPART$ value: (rowid: " + rowId.toString() + ")");
 
-        sysTabPartTmp = new SysTabPart(rowId, obj, dataObj, bo);
+        sysTabPartTmp = arena.create<SysTabPart>(rowId, obj, dataObj, bo);
         dictSysTabPartAdd(sysTabPartTmp);
         sysTabPartTmp = nullptr;
     }
 
-    void Schema::dictSysTabSubPartAdd(const char* rowIdStr, typeObj obj, typeDataObj dataObj, typeObj pObj) {
-        typeRowId rowId(rowIdStr);
+    void Schema::dictSysTabSubPartAdd(typeRowId rowId, typeObj obj, typeDataObj dataObj, typeObj pObj) {
         if (sysTabSubPartMapRowId.find(rowId) != sysTabSubPartMapRowId.end())
             throw DataException(50023, "duplicate SYS.TABSUBPART$ value: (rowid: " + rowId.toString() + ")");
 
-        sysTabSubPartTmp = new SysTabSubPart(rowId, obj, dataObj, pObj);
+        sysTabSubPartTmp = arena.create<SysTabSubPart>(rowId, obj, dataObj, pObj);
         dictSysTabSubPartAdd(sysTabSubPartTmp);
         sysTabSubPartTmp = nullptr;
     }
 
-    void Schema::dictSysTsAdd(const char* rowIdStr, typeTs ts, const char* name, uint32_t blockSize) {
-        typeRowId rowId(rowIdStr);
+    void Schema::dictSysTsAdd(typeRowId rowId, typeTs ts, const char* name, uint32_t blockSize) {
         if (sysTsMapRowId.find(rowId) != sysTsMapRowId.end())
             throw DataException(50023, "duplicate SYS.TS$ value: (rowid: " + rowId.toString() + ")");
 
-        sysTsTmp = new SysTs(rowId, ts, name, blockSize);
+        sysTsTmp = arena.create<SysTs>(rowId, ts, name, blockSize);
         dictSysTsAdd(sysTsTmp);
         sysTsTmp = nullptr;
     }
 
-    bool Schema::dictSysUserAdd(const char* rowIdStr, typeUser user, const char* name, uint64_t spare11, uint64_t spare12, bool single) {
-        typeRowId rowId(rowIdStr);
-
+    bool Schema::dictSysUserAdd(typeRowId rowId, typeUser user, const char* name, uint64_t spare11, uint64_t spare12, bool single) {
         auto sysUserMapRowIdIt = sysUserMapRowId.find(rowId);
         if (sysUserMapRowIdIt != sysUserMapRowId.end()) {
             SysUser* sysUser = sysUserMapRowIdIt->second;
@@ -922,7 +963,7 @@ namespace OpenLogReplicator {
         if (strlen(name) > SYS_USER_NAME_LENGTH)
             throw DataException(50025, "value of SYS.USER$ too long for NAME (value: '" + std::string(name) + "', length: " +
                                 std::to_string(strlen(name)) + ")");
-        sysUserTmp = new SysUser(rowId, user, name, spare11, spare12, single);
+        sysUserTmp = arena.create<SysUser>(rowId, user, name, spare11, spare12, single);
         dictSysUserAdd(sysUserTmp);
         sysUserTmp = nullptr;
 
@@ -944,6 +985,8 @@ namespace OpenLogReplicator {
                                 std::to_string(sysCCol->intCol) + ", CON#: " + std::to_string(sysCCol->con) + ")");
 
         sysCColMapRowId.insert_or_assign(sysCCol->rowId, sysCCol);
+        sysCColMapRowIdDelta.insert_or_assign(sysCCol->rowId, sysCCol);
+        deltaDropped[TABLE_SYS_CCOL].erase(sysCCol->rowId);
         sysCColMapKey.insert_or_assign(sysCColKey, sysCCol);
         sysCColSetTouched.insert(sysCCol);
         touchTable(sysCCol->obj);
@@ -968,6 +1011,8 @@ namespace OpenLogReplicator {
             throw DataException(50024, "duplicate SYS.CDEF$ value for unique (CON#: " + std::to_string(sysCDef->con) + ")");
 
         sysCDefMapRowId.insert_or_assign(sysCDef->rowId, sysCDef);
+        sysCDefMapRowIdDelta.insert_or_assign(sysCDef->rowId, sysCDef);
+        deltaDropped[TABLE_SYS_CDEF].erase(sysCDef->rowId);
         sysCDefMapKey.insert_or_assign(sysCDefKey, sysCDef);
         sysCDefMapCon.insert_or_assign(sysCDef->con, sysCDef);
         sysCDefSetTouched.insert(sysCDef);
@@ -999,6 +1044,8 @@ namespace OpenLogReplicator {
                           std::to_string(sysCol->segCol) + ", ROWID: " + sysCol->rowId.toString() + ")");
 
         sysColMapRowId.insert_or_assign(sysCol->rowId, sysCol);
+        sysColMapRowIdDelta.insert_or_assign(sysCol->rowId, sysCol);
+        deltaDropped[TABLE_SYS_COL].erase(sysCol->rowId);
         sysColMapSeg.insert_or_assign(sysColSeg, sysCol);
         sysColSetTouched.insert(sysCol);
         touchTable(sysCol->obj);
@@ -1017,6 +1064,8 @@ namespace OpenLogReplicator {
                                 ")");
 
         sysDeferredStgMapRowId.insert_or_assign(sysDeferredStg->rowId, sysDeferredStg);
+        sysDeferredStgMapRowIdDelta.insert_or_assign(sysDeferredStg->rowId, sysDeferredStg);
+        deltaDropped[TABLE_SYS_DEFERRED_STG].erase(sysDeferredStg->rowId);
         sysDeferredStgMapObj.insert_or_assign(sysDeferredStg->obj, sysDeferredStg);
         sysDeferredStgSetTouched.insert(sysDeferredStg);
         touchTable(sysDeferredStg->obj);
@@ -1037,6 +1086,8 @@ namespace OpenLogReplicator {
                                 std::to_string(sysECol->colNum) + ")");
 
         sysEColMapRowId.insert_or_assign(sysECol->rowId, sysECol);
+        sysEColMapRowIdDelta.insert_or_assign(sysECol->rowId, sysECol);
+        deltaDropped[TABLE_SYS_ECOL].erase(sysECol->rowId);
         sysEColMapKey.insert_or_assign(sysEColKey, sysECol);
         sysEColSetTouched.insert(sysECol);
         touchTable(sysECol->tabObj);
@@ -1063,6 +1114,8 @@ namespace OpenLogReplicator {
             throw DataException(50024, "duplicate SYS.LOB$ value for unique (LOBJ#: " + std::to_string(sysLob->lObj) + ")");
 
         sysLobMapRowId.insert_or_assign(sysLob->rowId, sysLob);
+        sysLobMapRowIdDelta.insert_or_assign(sysLob->rowId, sysLob);
+        deltaDropped[TABLE_SYS_LOB].erase(sysLob->rowId);
         sysLobMapKey.insert_or_assign(sysLobKey, sysLob);
         sysLobMapLObj.insert_or_assign(sysLob->lObj, sysLob);
         sysLobSetTouched.insert(sysLob);
@@ -1088,6 +1141,8 @@ namespace OpenLogReplicator {
                                 std::to_string(sysLobCompPart->partObj) + ")");
 
         sysLobCompPartMapRowId.insert_or_assign(sysLobCompPart->rowId, sysLobCompPart);
+        sysLobCompPartMapRowIdDelta.insert_or_assign(sysLobCompPart->rowId, sysLobCompPart);
+        deltaDropped[TABLE_SYS_LOB_COMP_PART].erase(sysLobCompPart->rowId);
         sysLobCompPartMapKey.insert_or_assign(sysLobCompPartKey, sysLobCompPart);
         sysLobCompPartMapPartObj.insert_or_assign(sysLobCompPart->partObj, sysLobCompPart);
         sysLobCompPartSetTouched.insert(sysLobCompPart);
@@ -1111,6 +1166,8 @@ namespace OpenLogReplicator {
                                 ", PARTOBJ#: " + std::to_string(sysLobFrag->parentObj) + ")");
 
         sysLobFragMapRowId.insert_or_assign(sysLobFrag->rowId, sysLobFrag);
+        sysLobFragMapRowIdDelta.insert_or_assign(sysLobFrag->rowId, sysLobFrag);
+        deltaDropped[TABLE_SYS_LOB_FRAG].erase(sysLobFrag->rowId);
         sysLobFragMapKey.insert_or_assign(sysLobFragKey, sysLobFrag);
         sysLobFragSetTouched.insert(sysLobFrag);
         auto sysLobCompPartMapPartObjIt = sysLobCompPartMapPartObj.find(sysLobFrag->parentObj);
@@ -1146,6 +1203,8 @@ namespace OpenLogReplicator {
             throw DataException(50024, "duplicate SYS.OBJ$ value for unique (OBJ#: " + std::to_string(sysObj->obj) + ")");
 
         sysObjMapRowId.insert_or_assign(sysObj->rowId, sysObj);
+        sysObjMapRowIdDelta.insert_or_assign(sysObj->rowId, sysObj);
+        deltaDropped[TABLE_SYS_OBJ].erase(sysObj->rowId);
         sysObjMapName.insert_or_assign(sysObjNameKey, sysObj);
         sysObjMapObj.insert_or_assign(sysObj->obj, sysObj);
         sysObjSetTouched.insert(sysObj);
@@ -1167,6 +1226,8 @@ namespace OpenLogReplicator {
             throw DataException(50024, "duplicate SYS.TAB$ value for unique (OBJ#: " + std::to_string(sysTab->obj) + ")");
 
         sysTabMapRowId.insert_or_assign(sysTab->rowId, sysTab);
+        sysTabMapRowIdDelta.insert_or_assign(sysTab->rowId, sysTab);
+        deltaDropped[TABLE_SYS_TAB].erase(sysTab->rowId);
         sysTabMapObj.insert_or_assign(sysTab->obj, sysTab);
         sysTabSetTouched.insert(sysTab);
         touchTable(sysTab->obj);
@@ -1191,6 +1252,8 @@ namespace OpenLogReplicator {
             throw DataException(50024, "duplicate SYS.TABCOMPART$ value for unique (OBJ#: " + std::to_string(sysTabComPart->obj) + ")");
 
         sysTabComPartMapRowId.insert_or_assign(sysTabComPart->rowId, sysTabComPart);
+        sysTabComPartMapRowIdDelta.insert_or_assign(sysTabComPart->rowId, sysTabComPart);
+        deltaDropped[TABLE_SYS_TABCOMPART].erase(sysTabComPart->rowId);
         sysTabComPartMapKey.insert_or_assign(sysTabComPartKey, sysTabComPart);
         sysTabComPartMapObj.insert_or_assign(sysTabComPart->obj, sysTabComPart);
         sysTabComPartSetTouched.insert(sysTabComPart);
@@ -1212,6 +1275,8 @@ namespace OpenLogReplicator {
                                 std::to_string(sysTabPart->obj) + ")");
 
         sysTabPartMapRowId.insert_or_assign(sysTabPart->rowId, sysTabPart);
+        sysTabPartMapRowIdDelta.insert_or_assign(sysTabPart->rowId, sysTabPart);
+        deltaDropped[TABLE_SYS_TABPART].erase(sysTabPart->rowId);
         sysTabPartMapKey.insert_or_assign(sysTabPartKey, sysTabPart);
         sysTabPartSetTouched.insert(sysTabPart);
         touchTable(sysTabPart->bo);
@@ -1232,6 +1297,8 @@ namespace OpenLogReplicator {
                                 ", OBJ#: " + std::to_string(sysTabSubPart->obj) + ")");
 
         sysTabSubPartMapRowId.insert_or_assign(sysTabSubPart->rowId, sysTabSubPart);
+        sysTabSubPartMapRowIdDelta.insert_or_assign(sysTabSubPart->rowId, sysTabSubPart);
+        deltaDropped[TABLE_SYS_TABSUBPART].erase(sysTabSubPart->rowId);
         sysTabSubPartMapKey.insert_or_assign(sysTabSubPartKey, sysTabSubPart);
         sysTabSubPartSetTouched.insert(sysTabSubPart);
         auto sysObjMapObjIt = sysObjMapObj.find(sysTabSubPart->obj);
@@ -1252,6 +1319,8 @@ namespace OpenLogReplicator {
             throw DataException(50024, "duplicate SYS.TS$ value for unique (TS#: " + std::to_string(sysTs->ts) + ")");
 
         sysTsMapRowId.insert_or_assign(sysTs->rowId, sysTs);
+        sysTsMapRowIdDelta.insert_or_assign(sysTs->rowId, sysTs);
+        deltaDropped[TABLE_SYS_TS].erase(sysTs->rowId);
         sysTsMapTs.insert_or_assign(sysTs->ts, sysTs);
         touched = true;
     }
@@ -1268,6 +1337,8 @@ namespace OpenLogReplicator {
             throw DataException(50024, "duplicate SYS.USER$ value for unique (USER#: " + std::to_string(sysUser->user) + ")");
 
         sysUserMapRowId.insert_or_assign(sysUser->rowId, sysUser);
+        sysUserMapRowIdDelta.insert_or_assign(sysUser->rowId, sysUser);
+        deltaDropped[TABLE_SYS_USER].erase(sysUser->rowId);
         sysUserMapUser.insert_or_assign(sysUser->user, sysUser);
         sysUserSetTouched.insert(sysUser);
         touched = true;
@@ -1284,6 +1355,8 @@ namespace OpenLogReplicator {
         if (sysCColMapRowIdIt == sysCColMapRowId.end())
             return;
         sysCColMapRowId.erase(sysCColMapRowIdIt);
+        sysCColMapRowIdDelta.erase(sysCCol->rowId);
+        deltaDropped[TABLE_SYS_CCOL].insert(sysCCol->rowId);
 
         SysCColKey sysCColKey(sysCCol->obj, sysCCol->intCol, sysCCol->con);
         auto sysCColMapKeyIt = sysCColMapKey.find(sysCColKey);
@@ -1307,6 +1380,8 @@ namespace OpenLogReplicator {
         if (sysCDefMapRowIdIt == sysCDefMapRowId.end())
             return;
         sysCDefMapRowId.erase(sysCDefMapRowIdIt);
+        sysCDefMapRowIdDelta.erase(sysCDef->rowId);
+        deltaDropped[TABLE_SYS_CDEF].insert(sysCDef->rowId);
 
         SysCDefKey sysCDefKey(sysCDef->obj, sysCDef->con);
         auto sysCDefMapKeyIt = sysCDefMapKey.find(sysCDefKey);
@@ -1346,6 +1421,8 @@ namespace OpenLogReplicator {
         if (sysColMapRowIdIt == sysColMapRowId.end())
             return;
         sysColMapRowId.erase(sysColMapRowIdIt);
+        sysColMapRowIdDelta.erase(sysCol->rowId);
+        deltaDropped[TABLE_SYS_COL].insert(sysCol->rowId);
 
         SysColSeg sysColSeg(sysCol->obj, sysCol->segCol, sysCol->rowId);
         auto sysColMapSegIt = sysColMapSeg.find(sysColSeg);
@@ -1368,6 +1445,8 @@ namespace OpenLogReplicator {
         if (sysDeferredStgMapRowIdIt == sysDeferredStgMapRowId.end())
             return;
         sysDeferredStgMapRowId.erase(sysDeferredStgMapRowIdIt);
+        sysDeferredStgMapRowIdDelta.erase(sysDeferredStg->rowId);
+        deltaDropped[TABLE_SYS_DEFERRED_STG].insert(sysDeferredStg->rowId);
 
         auto sysDeferredStgMapObjIt = sysDeferredStgMapObj.find(sysDeferredStg->obj);
         if (sysDeferredStgMapObjIt != sysDeferredStgMapObj.end())
@@ -1389,6 +1468,8 @@ namespace OpenLogReplicator {
         if (sysEColMapRowIdIt == sysEColMapRowId.end())
             return;
         sysEColMapRowId.erase(sysEColMapRowIdIt);
+        sysEColMapRowIdDelta.erase(sysECol->rowId);
+        deltaDropped[TABLE_SYS_ECOL].insert(sysECol->rowId);
 
         SysEColKey sysEColKey(sysECol->tabObj, sysECol->colNum);
         auto sysEColMapKeyIt = sysEColMapKey.find(sysEColKey);
@@ -1414,6 +1495,8 @@ namespace OpenLogReplicator {
         if (sysLobMapRowIdIt == sysLobMapRowId.end())
             return;
         sysLobMapRowId.erase(sysLobMapRowIdIt);
+        sysLobMapRowIdDelta.erase(sysLob->rowId);
+        deltaDropped[TABLE_SYS_LOB].insert(sysLob->rowId);
 
         SysLobKey sysLobKey(sysLob->obj, sysLob->intCol);
         auto sysLobMapKeyIt = sysLobMapKey.find(sysLobKey);
@@ -1442,6 +1525,8 @@ namespace OpenLogReplicator {
         if (sysLobCompPartMapRowIdIt == sysLobCompPartMapRowId.end())
             return;
         sysLobCompPartMapRowId.erase(sysLobCompPartMapRowIdIt);
+        sysLobCompPartMapRowIdDelta.erase(sysLobCompPart->rowId);
+        deltaDropped[TABLE_SYS_LOB_COMP_PART].insert(sysLobCompPart->rowId);
 
         SysLobCompPartKey sysLobCompPartKey(sysLobCompPart->lObj, sysLobCompPart->partObj);
         auto sysLobCompPartMapKeyIt = sysLobCompPartMapKey.find(sysLobCompPartKey);
@@ -1473,6 +1558,8 @@ namespace OpenLogReplicator {
         if (sysLobFragMapRowIdIt == sysLobFragMapRowId.end())
             return;
         sysLobFragMapRowId.erase(sysLobFragMapRowIdIt);
+        sysLobFragMapRowIdDelta.erase(sysLobFrag->rowId);
+        deltaDropped[TABLE_SYS_LOB_FRAG].insert(sysLobFrag->rowId);
 
         auto sysLobMapLObjIt = sysLobMapLObj.find(sysLobFrag->parentObj);
         if (sysLobMapLObjIt != sysLobMapLObj.end())
@@ -1508,6 +1595,8 @@ namespace OpenLogReplicator {
         if (sysObjMapRowIdIt == sysObjMapRowId.end())
             return;
         sysObjMapRowId.erase(sysObjMapRowIdIt);
+        sysObjMapRowIdDelta.erase(sysObj->rowId);
+        deltaDropped[TABLE_SYS_OBJ].insert(sysObj->rowId);
 
         SysObjNameKey sysObjNameKey(sysObj->owner, sysObj->name.c_str(), sysObj->obj, sysObj->dataObj);
         auto sysObjMapNameIt = sysObjMapName.find(sysObjNameKey);
@@ -1539,6 +1628,8 @@ namespace OpenLogReplicator {
         if (sysTabMapRowIdIt == sysTabMapRowId.end())
             return;
         sysTabMapRowId.erase(sysTabMapRowIdIt);
+        sysTabMapRowIdDelta.erase(sysTab->rowId);
+        deltaDropped[TABLE_SYS_TAB].insert(sysTab->rowId);
 
         auto sysTabMapObjIt = sysTabMapObj.find(sysTab->obj);
         if (sysTabMapObjIt != sysTabMapObj.end())
@@ -1560,6 +1651,8 @@ namespace OpenLogReplicator {
         if (sysTabComPartMapRowIdIt == sysTabComPartMapRowId.end())
             return;
         sysTabComPartMapRowId.erase(sysTabComPartMapRowIdIt);
+        sysTabComPartMapRowIdDelta.erase(sysTabComPart->rowId);
+        deltaDropped[TABLE_SYS_TABCOMPART].insert(sysTabComPart->rowId);
 
         SysTabComPartKey sysTabComPartKey(sysTabComPart->bo, sysTabComPart->obj);
         auto sysTabComPartMapKeyIt = sysTabComPartMapKey.find(sysTabComPartKey);
@@ -1589,6 +1682,8 @@ namespace OpenLogReplicator {
         if (sysTabPartMapRowIdIt == sysTabPartMapRowId.end())
             return;
         sysTabPartMapRowId.erase(sysTabPartMapRowIdIt);
+        sysTabPartMapRowIdDelta.erase(sysTabPart->rowId);
+        deltaDropped[TABLE_SYS_TABPART].insert(sysTabPart->rowId);
 
         SysTabPartKey sysTabPartKey(sysTabPart->bo, sysTabPart->obj);
         auto sysTabPartMapKeyIt = sysTabPartMapKey.find(sysTabPartKey);
@@ -1612,6 +1707,8 @@ namespace OpenLogReplicator {
         if (sysTabSubPartMapRowIdIt == sysTabSubPartMapRowId.end())
             return;
         sysTabSubPartMapRowId.erase(sysTabSubPartMapRowIdIt);
+        sysTabSubPartMapRowIdDelta.erase(sysTabSubPart->rowId);
+        deltaDropped[TABLE_SYS_TABSUBPART].insert(sysTabSubPart->rowId);
 
         SysTabSubPartKey sysTabSubPartKey(sysTabSubPart->pObj, sysTabSubPart->obj);
         auto sysTabSubPartMapKeyIt = sysTabSubPartMapKey.find(sysTabSubPartKey);
@@ -1637,6 +1734,8 @@ namespace OpenLogReplicator {
         if (sysTsMapRowIdIt == sysTsMapRowId.end())
             return;
         sysTsMapRowId.erase(sysTsMapRowIdIt);
+        sysTsMapRowIdDelta.erase(sysTs->rowId);
+        deltaDropped[TABLE_SYS_TS].insert(sysTs->rowId);
 
         auto sysTsMapTsIt = sysTsMapTs.find(sysTs->ts);
         if (sysTsMapTsIt != sysTsMapTs.end())
@@ -1656,6 +1755,8 @@ namespace OpenLogReplicator {
         if (sysUserMapRowIdIt == sysUserMapRowId.end())
             return;
         sysUserMapRowId.erase(sysUserMapRowIdIt);
+        sysUserMapRowIdDelta.erase(sysUser->rowId);
+        deltaDropped[TABLE_SYS_USER].insert(sysUser->rowId);
 
         auto sysUserMapUserIt = sysUserMapUser.find(sysUser->user);
         if (sysUserMapUserIt != sysUserMapUser.end())
@@ -1806,6 +1907,10 @@ namespace OpenLogReplicator {
         if (tablePartitionMapIt != tablePartitionMap.end())
             return tablePartitionMapIt->second;
 
+        auto tablePendingPartitionMapIt = tablePendingPartitionMap.find(obj);
+        if (tablePendingPartitionMapIt != tablePendingPartitionMap.end())
+            return buildTablePending(tablePendingPartitionMapIt->second);
+
         return nullptr;
     }
 
@@ -1932,13 +2037,17 @@ namespace OpenLogReplicator {
         }
         tablesTouched.clear();
 
+        // Tables not built yet are registered again with the current partitions
+        for (typeObj obj : identifiersTouched)
+            removeTablePending(obj);
+
         // SYS.USER$
         for (auto sysUser : sysUserSetTouched) {
             if (users.find(sysUser->name) != users.end())
                 continue;
 
             dictSysUserDrop(sysUser);
-            delete sysUser;
+            arena.destroy(sysUser);
         }
 
         // SYS.OBJ$
@@ -1951,7 +2060,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysObjDrop(sysObj);
-            delete sysObj;
+            arena.destroy(sysObj);
         }
 
         // SYS.CCOL$
@@ -1960,7 +2069,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysCColDrop(sysCCol);
-            delete sysCCol;
+            arena.destroy(sysCCol);
         }
 
         // SYS.CDEF$
@@ -1969,7 +2078,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysCDefDrop(sysCDef);
-            delete sysCDef;
+            arena.destroy(sysCDef);
         }
 
         // SYS.COL$
@@ -1978,7 +2087,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysColDrop(sysCol);
-            delete sysCol;
+            arena.destroy(sysCol);
         }
 
         // SYS.DEFERRED_STG$
@@ -1987,7 +2096,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysDeferredStgDrop(sysDeferredStg);
-            delete sysDeferredStg;
+            arena.destroy(sysDeferredStg);
         }
 
         // SYS.ECOL$
@@ -1996,7 +2105,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysEColDrop(sysECol);
-            delete sysECol;
+            arena.destroy(sysECol);
         }
 
         // SYS.LOB$
@@ -2005,7 +2114,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysLobDrop(sysLob);
-            delete sysLob;
+            arena.destroy(sysLob);
         }
 
         // SYS.LOBCOMPPART$
@@ -2014,7 +2123,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysLobCompPartDrop(sysLobCompPart);
-            delete sysLobCompPart;
+            arena.destroy(sysLobCompPart);
         }
 
         // SYS.LOBFRAG$
@@ -2025,7 +2134,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysLobFragDrop(sysLobFrag);
-            delete sysLobFrag;
+            arena.destroy(sysLobFrag);
         }
 
         // SYS.TAB$
@@ -2034,7 +2143,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysTabDrop(sysTab);
-            delete sysTab;
+            arena.destroy(sysTab);
         }
 
         // SYS.TABCOMPART$
@@ -2043,7 +2152,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysTabComPartDrop(sysTabComPart);
-            delete sysTabComPart;
+            arena.destroy(sysTabComPart);
         }
 
         // SYS.TABPART$
@@ -2052,7 +2161,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysTabPartDrop(sysTabPart);
-            delete sysTabPart;
+            arena.destroy(sysTabPart);
         }
 
         // SYS.TABSUBPART$
@@ -2061,7 +2170,7 @@ namespace OpenLogReplicator {
                 continue;
 
             dictSysTabSubPartDrop(sysTabSubPart);
-            delete sysTabSubPart;
+            arena.destroy(sysTabSubPart);
         }
     }
 
@@ -2085,38 +2194,211 @@ namespace OpenLogReplicator {
         touched = false;
     }
 
-    void Schema::buildMaps(const std::string& owner, const std::string& table, const std::vector<std::string>& keys, const std::string& keysStr,
-                           typeOptions options, std::list<std::string>& msgs, bool suppLogDbPrimary, bool suppLogDbAll,
-                           uint64_t defaultCharacterMapId, uint64_t defaultCharacterNcharMapId) {
-        uint64_t tabCnt = 0;
-        std::regex regexOwner(owner);
-        std::regex regexTable(table);
-        char sysLobConstraintName[26] = "SYS_LOB0000000000C00000$$";
+    void Schema::resetDelta() {
+        sysCColMapRowIdDelta.clear();
+        sysCDefMapRowIdDelta.clear();
+        sysColMapRowIdDelta.clear();
+        sysDeferredStgMapRowIdDelta.clear();
+        sysEColMapRowIdDelta.clear();
+        sysLobMapRowIdDelta.clear();
+        sysLobCompPartMapRowIdDelta.clear();
+        sysLobFragMapRowIdDelta.clear();
+        sysObjMapRowIdDelta.clear();
+        sysTabMapRowIdDelta.clear();
+        sysTabComPartMapRowIdDelta.clear();
+        sysTabPartMapRowIdDelta.clear();
+        sysTabSubPartMapRowIdDelta.clear();
+        sysTsMapRowIdDelta.clear();
+        sysUserMapRowIdDelta.clear();
+        for (auto& dropped : deltaDropped)
+            dropped.clear();
+    }
+
+    void Schema::dictSysDropRowId(uint64_t table, typeRowId rowId) {
+        switch (table) {
+            case TABLE_SYS_CCOL: {
+                SysCCol* sysCCol = dictSysCColFind(rowId);
+                if (sysCCol == nullptr)
+                    return;
+                dictSysCColDrop(sysCCol);
+                sysCColSetTouched.erase(sysCCol);
+                arena.destroy(sysCCol);
+                break;
+            }
+
+            case TABLE_SYS_CDEF: {
+                SysCDef* sysCDef = dictSysCDefFind(rowId);
+                if (sysCDef == nullptr)
+                    return;
+                dictSysCDefDrop(sysCDef);
+                sysCDefSetTouched.erase(sysCDef);
+                arena.destroy(sysCDef);
+                break;
+            }
+
+            case TABLE_SYS_COL: {
+                SysCol* sysCol = dictSysColFind(rowId);
+                if (sysCol == nullptr)
+                    return;
+                dictSysColDrop(sysCol);
+                sysColSetTouched.erase(sysCol);
+                arena.destroy(sysCol);
+                break;
+            }
+
+            case TABLE_SYS_DEFERRED_STG: {
+                SysDeferredStg* sysDeferredStg = dictSysDeferredStgFind(rowId);
+                if (sysDeferredStg == nullptr)
+                    return;
+                dictSysDeferredStgDrop(sysDeferredStg);
+                sysDeferredStgSetTouched.erase(sysDeferredStg);
+                arena.destroy(sysDeferredStg);
+                break;
+            }
+
+            case TABLE_SYS_ECOL: {
+                SysECol* sysECol = dictSysEColFind(rowId);
+                if (sysECol == nullptr)
+                    return;
+                dictSysEColDrop(sysECol);
+                sysEColSetTouched.erase(sysECol);
+                arena.destroy(sysECol);
+                break;
+            }
+
+            case TABLE_SYS_LOB: {
+                SysLob* sysLob = dictSysLobFind(rowId);
+                if (sysLob == nullptr)
+                    return;
+                dictSysLobDrop(sysLob);
+                sysLobSetTouched.erase(sysLob);
+                arena.destroy(sysLob);
+                break;
+            }
+
+            case TABLE_SYS_LOB_COMP_PART: {
+                SysLobCompPart* sysLobCompPart = dictSysLobCompPartFind(rowId);
+                if (sysLobCompPart == nullptr)
+                    return;
+                dictSysLobCompPartDrop(sysLobCompPart);
+                sysLobCompPartSetTouched.erase(sysLobCompPart);
+                arena.destroy(sysLobCompPart);
+                break;
+            }
+
+            case TABLE_SYS_LOB_FRAG: {
+                SysLobFrag* sysLobFrag = dictSysLobFragFind(rowId);
+                if (sysLobFrag == nullptr)
+                    return;
+                dictSysLobFragDrop(sysLobFrag);
+                sysLobFragSetTouched.erase(sysLobFrag);
+                arena.destroy(sysLobFrag);
+                break;
+            }
+
+            case TABLE_SYS_OBJ: {
+                SysObj* sysObj = dictSysObjFind(rowId);
+                if (sysObj == nullptr)
+                    return;
+                dictSysObjDrop(sysObj);
+                sysObjSetTouched.erase(sysObj);
+                arena.destroy(sysObj);
+                break;
+            }
+
+            case TABLE_SYS_TAB: {
+                SysTab* sysTab = dictSysTabFind(rowId);
+                if (sysTab == nullptr)
+                    return;
+                dictSysTabDrop(sysTab);
+                sysTabSetTouched.erase(sysTab);
+                arena.destroy(sysTab);
+                break;
+            }
+
+            case TABLE_SYS_TABCOMPART: {
+                SysTabComPart* sysTabComPart = dictSysTabComPartFind(rowId);
+                if (sysTabComPart == nullptr)
+                    return;
+                dictSysTabComPartDrop(sysTabComPart);
+                sysTabComPartSetTouched.erase(sysTabComPart);
+                arena.destroy(sysTabComPart);
+                break;
+            }
+
+            case TABLE_SYS_TABPART: {
+                SysTabPart* sysTabPart = dictSysTabPartFind(rowId);
+                if (sysTabPart == nullptr)
+                    return;
+                dictSysTabPartDrop(sysTabPart);
+                sysTabPartSetTouched.erase(sysTabPart);
+                arena.destroy(sysTabPart);
+                break;
+            }
+
+            case TABLE_SYS_TABSUBPART: {
+                SysTabSubPart* sysTabSubPart = dictSysTabSubPartFind(rowId);
+                if (sysTabSubPart == nullptr)
+                    return;
+                dictSysTabSubPartDrop(sysTabSubPart);
+                sysTabSubPartSetTouched.erase(sysTabSubPart);
+                arena.destroy(sysTabSubPart);
+                break;
+            }
+
+            case TABLE_SYS_TS: {
+                SysTs* sysTs = dictSysTsFind(rowId);
+                if (sysTs == nullptr)
+                    return;
+                dictSysTsDrop(sysTs);
+                arena.destroy(sysTs);
+                break;
+            }
+
+            case TABLE_SYS_USER: {
+                SysUser* sysUser = dictSysUserFind(rowId);
+                if (sysUser == nullptr)
+                    return;
+                dictSysUserDrop(sysUser);
+                sysUserSetTouched.erase(sysUser);
+                arena.destroy(sysUser);
+                break;
+            }
+        }
+    }
 
+    void Schema::buildMaps(SchemaMatcher* matcher, std::list<std::string>& msgs, bool suppLogDbPrimary, bool suppLogDbAll,
+                           uint64_t defaultCharacterMapId, uint64_t defaultCharacterNcharMapId) {
         for (auto obj: identifiersTouched) {
             auto sysObjMapObjTouchedIt = sysObjMapObj.find(obj);
             if (sysObjMapObjTouchedIt == sysObjMapObj.end())
                 continue;
             SysObj* sysObj = sysObjMapObjTouchedIt->second;
 
-            if (sysObj->isDropped() || !sysObj->isTable() || !regex_match(sysObj->name, regexTable))
+            if (sysObj->isDropped() || !sysObj->isTable())
                 continue;
 
+            // The first schema element which matches the object is used
             SysUser* sysUser = nullptr;
+            SchemaElement* element = nullptr;
             auto sysUserMapUserIt = sysUserMapUser.find(sysObj->owner);
             if (sysUserMapUserIt == sysUserMapUser.end()) {
                 if (!FLAG(REDO_FLAGS_ADAPTIVE_SCHEMA))
                     continue;
+                element = matcher->matchAnyOwner(sysObj->name);
+                if (element == nullptr)
+                    continue;
                 sysUserAdaptive.name = "USER_" + std::to_string(sysObj->obj);
                 sysUser = &sysUserAdaptive;
             } else {
                 sysUser = sysUserMapUserIt->second;
-                if (!regex_match(sysUser->name, regexOwner))
+                element = matcher->match(sysUser->name, sysObj->name);
+                if (element == nullptr)
                     continue;
             }
 
             // Table already added with another rule
-            if (tableMap.find(sysObj->obj) != tableMap.end()) {
+            if (tableMap.find(sysObj->obj) != tableMap.end() || tablePendingMap.find(sysObj->obj) != tablePendingMap.end()) {
                 if (ctx->logLevel >= LOG_LEVEL_DEBUG)
                     msgs.push_back(sysUser->name + "." + sysObj->name + " (obj: " + std::to_string(sysObj->obj) + ") - already added (skipped)");
                 continue;
@@ -2175,223 +2457,268 @@ namespace OpenLogReplicator {
                 continue;
             }
 
-            typeCol keysCnt = 0;
-            bool suppLogTablePrimary = false;
-            bool suppLogTableAll = false;
-            bool supLogColMissing = false;
+            // Tables with LOBs are built at once as LOB data may precede the first change of the table
+            if (ctx->lazyTables && (element->options & OPTIONS_SYSTEM_TABLE) == 0) {
+                SysLobKey sysLobKeyFirst(sysObj->obj, 0);
+                auto sysLobMapKeyIt = sysLobMapKey.upper_bound(sysLobKeyFirst);
+                if (sysLobMapKeyIt == sysLobMapKey.end() || sysLobMapKeyIt->first.obj != sysObj->obj) {
+                    addTablePending(sysObj, sysTab, getTableRule(element->keys, element->keysStr, element->options, suppLogDbPrimary, suppLogDbAll,
+                                                                 defaultCharacterMapId, defaultCharacterNcharMapId));
+                    if (ctx->logLevel >= LOG_LEVEL_DEBUG)
+                        msgs.push_back(sysUser->name + "." + sysObj->name + " (obj: " + std::to_string(sysObj->obj) + ") - built at first use");
+                    continue;
+                }
+            }
+
+            buildTable(sysObj, sysTab, sysUser, element->keys, element->keysStr, element->options, msgs, suppLogDbPrimary, suppLogDbAll,
+                       defaultCharacterMapId, defaultCharacterNcharMapId);
+        }
+    }
 
-            tableTmp = new OracleTable(sysObj->obj, sysTab->dataObj, sysObj->owner, sysTab->cluCols,
-                                       options, sysUser->name, sysObj->name);
-            ++tabCnt;
+    OracleTable* Schema::buildTable(SysObj* sysObj, SysTab* sysTab, SysUser* sysUser, const std::vector<std::string>& keys, const std::string& keysStr,
+                                    typeOptions options, std::list<std::string>& msgs, bool suppLogDbPrimary, bool suppLogDbAll,
+                                    uint64_t defaultCharacterMapId, uint64_t defaultCharacterNcharMapId) {
+        char sysLobConstraintName[26] = "SYS_LOB0000000000C00000$$";
+        typeCol keysCnt = 0;
+        bool suppLogTablePrimary = false;
+        bool suppLogTableAll = false;
+        bool supLogColMissing = false;
+
+        tableTmp = new OracleTable(sysObj->obj, sysTab->dataObj, sysObj->owner, sysTab->cluCols,
+                                   options, sysUser->name, sysObj->name);
+
+        uint64_t lobPartitions = 0;
+        uint64_t lobIndexes = 0;
+        std::ostringstream lobIndexesList;
+        std::ostringstream lobList;
+        uint64_t tablePartitions = 0;
+
+        if (sysTab->isPartitioned()) {
+            SysTabPartKey sysTabPartKey(sysObj->obj, 0);
+            for (auto sysTabPartMapKeyIt = sysTabPartMapKey.upper_bound(sysTabPartKey);
+                 sysTabPartMapKeyIt != sysTabPartMapKey.end() && sysTabPartMapKeyIt->first.bo == sysObj->obj; ++sysTabPartMapKeyIt) {
+
+                SysTabPart* sysTabPart = sysTabPartMapKeyIt->second;
+                tableTmp->addTablePartition(sysTabPart->obj, sysTabPart->dataObj);
+                ++tablePartitions;
+            }
 
-            uint64_t lobPartitions = 0;
-            uint64_t lobIndexes = 0;
-            std::ostringstream lobIndexesList;
-            std::ostringstream lobList;
-            uint64_t tablePartitions = 0;
+            SysTabComPartKey sysTabComPartKey(sysObj->obj, 0);
+            for (auto sysTabComPartMapKeyIt = sysTabComPartMapKey.upper_bound(sysTabComPartKey);
+                 sysTabComPartMapKeyIt != sysTabComPartMapKey.end() && sysTabComPartMapKeyIt->first.bo == sysObj->obj; ++sysTabComPartMapKeyIt) {
 
-            if (sysTab->isPartitioned()) {
-                SysTabPartKey sysTabPartKey(sysObj->obj, 0);
-                for (auto sysTabPartMapKeyIt = sysTabPartMapKey.upper_bound(sysTabPartKey);
-                     sysTabPartMapKeyIt != sysTabPartMapKey.end() && sysTabPartMapKeyIt->first.bo == sysObj->obj; ++sysTabPartMapKeyIt) {
+                SysTabSubPartKey sysTabSubPartKeyFirst(sysTabComPartMapKeyIt->second->obj, 0);
+                for (auto sysTabSubPartMapKeyIt = sysTabSubPartMapKey.upper_bound(sysTabSubPartKeyFirst);
+                     sysTabSubPartMapKeyIt != sysTabSubPartMapKey.end() && sysTabSubPartMapKeyIt->first.pObj == sysTabComPartMapKeyIt->second->obj;
+                            ++sysTabSubPartMapKeyIt) {
 
-                    SysTabPart* sysTabPart = sysTabPartMapKeyIt->second;
-                    tableTmp->addTablePartition(sysTabPart->obj, sysTabPart->dataObj);
+                    SysTabSubPart* sysTabSubPart = sysTabSubPartMapKeyIt->second;
+                    tableTmp->addTablePartition(sysTabSubPart->obj, sysTabSubPart->dataObj);
                     ++tablePartitions;
                 }
+            }
+        }
 
-                SysTabComPartKey sysTabComPartKey(sysObj->obj, 0);
-                for (auto sysTabComPartMapKeyIt = sysTabComPartMapKey.upper_bound(sysTabComPartKey);
-                     sysTabComPartMapKeyIt != sysTabComPartMapKey.end() && sysTabComPartMapKeyIt->first.bo == sysObj->obj; ++sysTabComPartMapKeyIt) {
-
-                    SysTabSubPartKey sysTabSubPartKeyFirst(sysTabComPartMapKeyIt->second->obj, 0);
-                    for (auto sysTabSubPartMapKeyIt = sysTabSubPartMapKey.upper_bound(sysTabSubPartKeyFirst);
-                         sysTabSubPartMapKeyIt != sysTabSubPartMapKey.end() && sysTabSubPartMapKeyIt->first.pObj == sysTabComPartMapKeyIt->second->obj;
-                                ++sysTabSubPartMapKeyIt) {
+        if (!DISABLE_CHECKS(DISABLE_CHECKS_SUPPLEMENTAL_LOG) && (options & OPTIONS_SYSTEM_TABLE) == 0 &&
+            !suppLogDbAll && !sysUser->isSuppLogAll()) {
 
-                        SysTabSubPart* sysTabSubPart = sysTabSubPartMapKeyIt->second;
-                        tableTmp->addTablePartition(sysTabSubPart->obj, sysTabSubPart->dataObj);
-                        ++tablePartitions;
-                    }
-                }
+            SysCDefKey sysCDefKeyFirst(sysObj->obj, 0);
+            for (auto sysCDefMapKeyIt = sysCDefMapKey.upper_bound(sysCDefKeyFirst);
+                 sysCDefMapKeyIt != sysCDefMapKey.end() && sysCDefMapKeyIt->first.obj == sysObj->obj;
+                 ++sysCDefMapKeyIt) {
+                SysCDef* sysCDef = sysCDefMapKeyIt->second;
+                if (sysCDef->isSupplementalLogPK())
+                    suppLogTablePrimary = true;
+                else if (sysCDef->isSupplementalLogAll())
+                    suppLogTableAll = true;
             }
+        }
 
-            if (!DISABLE_CHECKS(DISABLE_CHECKS_SUPPLEMENTAL_LOG) && (options & OPTIONS_SYSTEM_TABLE) == 0 &&
-                !suppLogDbAll && !sysUser->isSuppLogAll()) {
+        typeRowId rowId;
+        SysColSeg sysColSegFirst(sysObj->obj, 0, rowId);
+        for (auto sysColMapSegIt = sysColMapSeg.upper_bound(sysColSegFirst); sysColMapSegIt != sysColMapSeg.end() &&
+                sysColMapSegIt->first.obj == sysObj->obj; ++sysColMapSegIt) {
+            SysCol* sysCol = sysColMapSegIt->second;
+            if (sysCol->segCol == 0)
+                continue;
 
-                SysCDefKey sysCDefKeyFirst(sysObj->obj, 0);
-                for (auto sysCDefMapKeyIt = sysCDefMapKey.upper_bound(sysCDefKeyFirst);
-                     sysCDefMapKeyIt != sysCDefMapKey.end() && sysCDefMapKeyIt->first.obj == sysObj->obj;
-                     ++sysCDefMapKeyIt) {
-                    SysCDef* sysCDef = sysCDefMapKeyIt->second;
-                    if (sysCDef->isSupplementalLogPK())
-                        suppLogTablePrimary = true;
-                    else if (sysCDef->isSupplementalLogAll())
-                        suppLogTableAll = true;
-                }
-            }
+            uint64_t charmapId = 0;
+            typeCol numPk = 0;
+            typeCol numSup = 0;
+            typeCol guardSeg = -1;
 
-            typeRowId rowId;
-            SysColSeg sysColSegFirst(sysObj->obj, 0, rowId);
-            for (auto sysColMapSegIt = sysColMapSeg.upper_bound(sysColSegFirst); sysColMapSegIt != sysColMapSeg.end() &&
-                    sysColMapSegIt->first.obj == sysObj->obj; ++sysColMapSegIt) {
-                SysCol* sysCol = sysColMapSegIt->second;
-                if (sysCol->segCol == 0)
-                    continue;
+            SysEColKey sysEColKey(sysObj->obj, sysCol->segCol);
+            auto sysEColIt = sysEColMapKey.find(sysEColKey);
+            if (sysEColIt != sysEColMapKey.end())
+                guardSeg = sysEColIt->second->guardId;
 
-                uint64_t charmapId = 0;
-                typeCol numPk = 0;
-                typeCol numSup = 0;
-                typeCol guardSeg = -1;
-
-                SysEColKey sysEColKey(sysObj->obj, sysCol->segCol);
-                auto sysEColIt = sysEColMapKey.find(sysEColKey);
-                if (sysEColIt != sysEColMapKey.end())
-                    guardSeg = sysEColIt->second->guardId;
-
-                if (sysCol->charsetForm == 1) {
-                    if (sysCol->type == SYS_COL_TYPE_CLOB) {
-                        charmapId = defaultCharacterNcharMapId;
-                    } else
-                        charmapId = defaultCharacterMapId;
-                } else if (sysCol->charsetForm == 2)
+            if (sysCol->charsetForm == 1) {
+                if (sysCol->type == SYS_COL_TYPE_CLOB) {
                     charmapId = defaultCharacterNcharMapId;
-                else
-                    charmapId = sysCol->charsetId;
-
-                if (sysCol->type == SYS_COL_TYPE_VARCHAR || sysCol->type == SYS_COL_TYPE_CHAR || sysCol->type == SYS_COL_TYPE_CLOB) {
-                    auto characterMapIt = locales->characterMap.find(charmapId);
-                    if (characterMapIt == locales->characterMap.end()) {
-                        ctx->hint("check in database for name: SELECT NLS_CHARSET_NAME(" + std::to_string(charmapId) + ") FROM DUAL;");
-                        throw DataException(50026, "table " + std::string(sysUser->name) + "." + sysObj->name +
-                                            " - unsupported character set id: " + std::to_string(charmapId) + " for column: " + sysCol->name);
-                    }
+                } else
+                    charmapId = defaultCharacterMapId;
+            } else if (sysCol->charsetForm == 2)
+                charmapId = defaultCharacterNcharMapId;
+            else
+                charmapId = sysCol->charsetId;
+
+            if (sysCol->type == SYS_COL_TYPE_VARCHAR || sysCol->type == SYS_COL_TYPE_CHAR || sysCol->type == SYS_COL_TYPE_CLOB) {
+                auto characterMapIt = locales->characterMap.find(charmapId);
+                if (characterMapIt == locales->characterMap.end()) {
+                    ctx->hint("check in database for name: SELECT NLS_CHARSET_NAME(" + std::to_string(charmapId) + ") FROM DUAL;");
+                    throw DataException(50026, "table " + std::string(sysUser->name) + "." + sysObj->name +
+                                        " - unsupported character set id: " + std::to_string(charmapId) + " for column: " + sysCol->name);
                 }
+            }
 
-                SysCColKey sysCColKeyFirst(sysObj->obj, sysCol->intCol, 0);
-                for (auto sysCColMapKeyIt = sysCColMapKey.upper_bound(sysCColKeyFirst);
-                     sysCColMapKeyIt != sysCColMapKey.end() && sysCColMapKeyIt->first.obj == sysObj->obj && sysCColMapKeyIt->first.intCol == sysCol->intCol;
-                     ++sysCColMapKeyIt) {
-                    SysCCol* sysCCol = sysCColMapKeyIt->second;
-
-                    // Count the number of PKs the column is part of
-                    auto sysCDefMapConIt = sysCDefMapCon.find(sysCCol->con);
-                    if (sysCDefMapConIt == sysCDefMapCon.end()) {
-                        ctx->warning(70005, "data in SYS.CDEF$ missing for CON#: " + std::to_string(sysCCol->con));
-                        continue;
-                    }
-                    SysCDef* sysCDef = sysCDefMapConIt->second;
-                    if (sysCDef->isPK())
-                        ++numPk;
+            SysCColKey sysCColKeyFirst(sysObj->obj, sysCol->intCol, 0);
+            for (auto sysCColMapKeyIt = sysCColMapKey.upper_bound(sysCColKeyFirst);
+                 sysCColMapKeyIt != sysCColMapKey.end() && sysCColMapKeyIt->first.obj == sysObj->obj && sysCColMapKeyIt->first.intCol == sysCol->intCol;
+                 ++sysCColMapKeyIt) {
+                SysCCol* sysCCol = sysCColMapKeyIt->second;
 
-                    // Supplemental logging
-                    if (sysCCol->spare1.isZero() && sysCDef->isSupplementalLog())
-                        ++numSup;
+                // Count the number of PKs the column is part of
+                auto sysCDefMapConIt = sysCDefMapCon.find(sysCCol->con);
+                if (sysCDefMapConIt == sysCDefMapCon.end()) {
+                    ctx->warning(70005, "data in SYS.CDEF$ missing for CON#: " + std::to_string(sysCCol->con));
+                    continue;
                 }
+                SysCDef* sysCDef = sysCDefMapConIt->second;
+                if (sysCDef->isPK())
+                    ++numPk;
 
-                // Part of defined primary key
-                if (!keys.empty()) {
-                    // Manually defined pk overlaps with table pk
-                    if (numPk > 0 && (suppLogTablePrimary || sysUser->isSuppLogPrimary() || suppLogDbPrimary))
-                        numSup = 1;
-                    numPk = 0;
-                    for (const auto& key : keys) {
-                        if (strcmp(sysCol->name.c_str(), key.c_str()) == 0) {
-                            numPk = 1;
-                            ++keysCnt;
-                            if (numSup == 0)
-                                supLogColMissing = true;
-                            break;
-                        }
+                // Supplemental logging
+                if (sysCCol->spare1.isZero() && sysCDef->isSupplementalLog())
+                    ++numSup;
+            }
+
+            // Part of defined primary key
+            if (!keys.empty()) {
+                // Manually defined pk overlaps with table pk
+                if (numPk > 0 && (suppLogTablePrimary || sysUser->isSuppLogPrimary() || suppLogDbPrimary))
+                    numSup = 1;
+                numPk = 0;
+                for (const auto& key : keys) {
+                    if (strcmp(sysCol->name.c_str(), key.c_str()) == 0) {
+                        numPk = 1;
+                        ++keysCnt;
+                        if (numSup == 0)
+                            supLogColMissing = true;
+                        break;
                     }
-                } else {
-                    if (numPk > 0 && numSup == 0)
-                        supLogColMissing = true;
                 }
+            } else {
+                if (numPk > 0 && numSup == 0)
+                    supLogColMissing = true;
+            }
 
-                if (ctx->logLevel >= LOG_LEVEL_DEBUG)
-                    msgs.push_back("- col: " + std::to_string(sysCol->segCol) + ": " + sysCol->name + " (pk: " + std::to_string(numPk) + ", S: " +
-                                std::to_string(numSup) + ", G: " + std::to_string(guardSeg) + ")");
-
-                bool xmlType = false;
-                // For system-generated columns, check column name from base column
-                std::string columnName = sysCol->name;
-                if (sysCol->isSystemGenerated()) {
-                    typeRowId rid2(0, 0, 0);
-                    SysColSeg sysColSegFirst2(sysObj->obj - 1, 0, rid2);
-                    for (auto sysColMapSegIt2 = sysColMapSeg.upper_bound(sysColSegFirst); sysColMapSegIt2 != sysColMapSeg.end() &&
-                                                                                   sysColMapSegIt2->first.obj <= sysObj->obj; ++sysColMapSegIt2) {
-                        SysCol* sysCol2 = sysColMapSegIt2->second;
-                        if (sysCol->col == sysCol2->col && sysCol2->segCol == 0) {
-                            columnName = sysCol2->name;
-                            xmlType = true;
-                            break;
-                        }
+            if (ctx->logLevel >= LOG_LEVEL_DEBUG)
+                msgs.push_back("- col: " + std::to_string(sysCol->segCol) + ": " + sysCol->name + " (pk: " + std::to_string(numPk) + ", S: " +
+                            std::to_string(numSup) + ", G: " + std::to_string(guardSeg) + ")");
+
+            bool xmlType = false;
+            // For system-generated columns, check column name from base column
+            std::string columnName = sysCol->name;
+            if (sysCol->isSystemGenerated()) {
+                typeRowId rid2(0, 0, 0);
+                SysColSeg sysColSegFirst2(sysObj->obj - 1, 0, rid2);
+                for (auto sysColMapSegIt2 = sysColMapSeg.upper_bound(sysColSegFirst); sysColMapSegIt2 != sysColMapSeg.end() &&
+                                                                               sysColMapSegIt2->first.obj <= sysObj->obj; ++sysColMapSegIt2) {
+                    SysCol* sysCol2 = sysColMapSegIt2->second;
+                    if (sysCol->col == sysCol2->col && sysCol2->segCol == 0) {
+                        columnName = sysCol2->name;
+                        xmlType = true;
+                        break;
                     }
                 }
+            }
 
-                columnTmp = new OracleColumn(sysCol->col, guardSeg, sysCol->segCol, columnName,
-                                             sysCol->type, sysCol->length, sysCol->precision, sysCol->scale,
-                                             numPk, charmapId, sysCol->isNullable(), sysCol->isHidden(),
-                                             sysCol->isStoredAsLob(), sysCol->isSystemGenerated(),
-                                             sysCol->isNested(), sysCol->isUnused(), sysCol->isAdded(),
-                                             sysCol->isGuard(), xmlType);
+            columnTmp = new OracleColumn(sysCol->col, guardSeg, sysCol->segCol, columnName,
+                                         sysCol->type, sysCol->length, sysCol->precision, sysCol->scale,
+                                         numPk, charmapId, sysCol->isNullable(), sysCol->isHidden(),
+                                         sysCol->isStoredAsLob(), sysCol->isSystemGenerated(),
+                                         sysCol->isNested(), sysCol->isUnused(), sysCol->isAdded(),
+                                         sysCol->isGuard(), xmlType);
 
-                tableTmp->addColumn(columnTmp);
-                columnTmp = nullptr;
-            }
+            tableTmp->addColumn(columnTmp);
+            columnTmp = nullptr;
+        }
 
-            if ((options & OPTIONS_SYSTEM_TABLE) == 0) {
-                SysLobKey sysLobKeyFirst(sysObj->obj, 0);
-                for (auto sysLobMapKeyIt = sysLobMapKey.upper_bound(sysLobKeyFirst);
-                     sysLobMapKeyIt != sysLobMapKey.end() && sysLobMapKeyIt->first.obj == sysObj->obj; ++sysLobMapKeyIt) {
-                    SysLob* sysLob = sysLobMapKeyIt->second;
+        if ((options & OPTIONS_SYSTEM_TABLE) == 0) {
+            SysLobKey sysLobKeyFirst(sysObj->obj, 0);
+            for (auto sysLobMapKeyIt = sysLobMapKey.upper_bound(sysLobKeyFirst);
+                 sysLobMapKeyIt != sysLobMapKey.end() && sysLobMapKeyIt->first.obj == sysObj->obj; ++sysLobMapKeyIt) {
+                SysLob* sysLob = sysLobMapKeyIt->second;
 
-                    auto sysObjMapObjIt = sysObjMapObj.find(sysLob->lObj);
-                    if (sysObjMapObjIt == sysObjMapObj.end())
-                        throw DataException(50027, "table " + std::string(sysUser->name) + "." + sysObj->name + " couldn't find obj for lob " +
-                                            std::to_string(sysLob->lObj));
-                    typeObj lobDataObj = sysObjMapObjIt->second->dataObj;
+                auto sysObjMapObjIt = sysObjMapObj.find(sysLob->lObj);
+                if (sysObjMapObjIt == sysObjMapObj.end())
+                    throw DataException(50027, "table " + std::string(sysUser->name) + "." + sysObj->name + " couldn't find obj for lob " +
+                                        std::to_string(sysLob->lObj));
+                typeObj lobDataObj = sysObjMapObjIt->second->dataObj;
 
-                    if (ctx->logLevel >= LOG_LEVEL_DEBUG)
-                        msgs.push_back("- lob: " + std::to_string(sysLob->col) + ":" + std::to_string(sysLob->intCol) + ":" +
-                                       std::to_string(lobDataObj) + ":" + std::to_string(sysLob->lObj));
-
-                    lobTmp = new OracleLob(tableTmp, sysLob->obj, lobDataObj, sysLob->lObj, sysLob->col,
-                                           sysLob->intCol);
-
-                    // Indexes
-                    std::ostringstream str;
-                    str << "SYS_IL" << std::setw(10) << std::setfill('0') << sysObj->obj << "C" << std::setw(5)
-                        << std::setfill('0') << sysLob->intCol << "$$";
-                    std::string lobIndexName = str.str();
-
-                    SysObjNameKey sysObjNameKeyFirst(sysObj->owner, lobIndexName.c_str(), 0, 0);
-                    for (auto sysObjMapNameIt = sysObjMapName.upper_bound(sysObjNameKeyFirst);
-                            sysObjMapNameIt != sysObjMapName.end() &&
-                            sysObjMapNameIt->first.name == lobIndexName &&
-                            sysObjMapNameIt->first.owner == sysObj->owner; ++sysObjMapNameIt) {
-                        if (sysObjMapNameIt->first.dataObj == 0)
-                            continue;
-
-                        lobTmp->addIndex(sysObjMapNameIt->first.dataObj);
-                        if ((ctx->trace & TRACE_LOB) != 0)
-                            lobIndexesList << " " << std::dec << sysObjMapNameIt->first.dataObj << "/" << sysObjMapNameIt->second->obj;
-                        ++lobIndexes;
-                    }
+                if (ctx->logLevel >= LOG_LEVEL_DEBUG)
+                    msgs.push_back("- lob: " + std::to_string(sysLob->col) + ":" + std::to_string(sysLob->intCol) + ":" +
+                                   std::to_string(lobDataObj) + ":" + std::to_string(sysLob->lObj));
+
+                lobTmp = new OracleLob(tableTmp, sysLob->obj, lobDataObj, sysLob->lObj, sysLob->col,
+                                       sysLob->intCol);
+
+                // Indexes
+                std::ostringstream str;
+                str << "SYS_IL" << std::setw(10) << std::setfill('0') << sysObj->obj << "C" << std::setw(5)
+                    << std::setfill('0') << sysLob->intCol << "$$";
+                std::string lobIndexName = str.str();
+
+                SysObjNameKey sysObjNameKeyFirst(sysObj->owner, lobIndexName.c_str(), 0, 0);
+                for (auto sysObjMapNameIt = sysObjMapName.upper_bound(sysObjNameKeyFirst);
+                        sysObjMapNameIt != sysObjMapName.end() &&
+                        sysObjMapNameIt->first.name == lobIndexName &&
+                        sysObjMapNameIt->first.owner == sysObj->owner; ++sysObjMapNameIt) {
+                    if (sysObjMapNameIt->first.dataObj == 0)
+                        continue;
 
-                    if (lobTmp->lobIndexes.size() == 0) {
-                        ctx->warning(60021, "missing LOB index for LOB (OBJ#: " + std::to_string(sysObj->obj) + ", DATAOBJ#: " +
-                                     std::to_string(sysLob->lObj) + ", COL#: " + std::to_string(sysLob->intCol) + ")");
+                    lobTmp->addIndex(sysObjMapNameIt->first.dataObj);
+                    if ((ctx->trace & TRACE_LOB) != 0)
+                        lobIndexesList << " " << std::dec << sysObjMapNameIt->first.dataObj << "/" << sysObjMapNameIt->second->obj;
+                    ++lobIndexes;
+                }
+
+                if (lobTmp->lobIndexes.size() == 0) {
+                    ctx->warning(60021, "missing LOB index for LOB (OBJ#: " + std::to_string(sysObj->obj) + ", DATAOBJ#: " +
+                                 std::to_string(sysLob->lObj) + ", COL#: " + std::to_string(sysLob->intCol) + ")");
+                }
+
+                // Partitioned lob
+                if (sysTab->isPartitioned()) {
+                    // Partitions
+                    SysLobFragKey sysLobFragKey(sysLob->lObj, 0);
+                    for (auto sysLobFragMapKeyIt = sysLobFragMapKey.upper_bound(sysLobFragKey);
+                            sysLobFragMapKeyIt != sysLobFragMapKey.end() &&
+                            sysLobFragMapKeyIt->first.parentObj == sysLob->lObj; ++sysLobFragMapKeyIt) {
+
+                        SysLobFrag* sysLobFrag = sysLobFragMapKeyIt->second;
+                        auto sysObjMapObjIt2 = sysObjMapObj.find(sysLobFrag->fragObj);
+                        if (sysObjMapObjIt2 == sysObjMapObj.end())
+                            throw DataException(50028, "table " + std::string(sysUser->name) + "." + sysObj->name +
+                                                " couldn't find obj for lob frag " + std::to_string(sysLobFrag->fragObj));
+                        typeObj lobFragDataObj = sysObjMapObjIt2->second->dataObj;
+
+                        lobTmp->addPartition(lobFragDataObj, getLobBlockSize(sysLobFrag->ts));
+                        ++lobPartitions;
                     }
 
-                    // Partitioned lob
-                    if (sysTab->isPartitioned()) {
-                        // Partitions
-                        SysLobFragKey sysLobFragKey(sysLob->lObj, 0);
-                        for (auto sysLobFragMapKeyIt = sysLobFragMapKey.upper_bound(sysLobFragKey);
+                    // Subpartitions
+                    SysLobCompPartKey sysLobCompPartKey(sysLob->lObj, 0);
+                    for (auto sysLobCompPartMapKeyIt = sysLobCompPartMapKey.upper_bound(sysLobCompPartKey);
+                            sysLobCompPartMapKeyIt != sysLobCompPartMapKey.end() &&
+                            sysLobCompPartMapKeyIt->first.lObj == sysLob->lObj; ++sysLobCompPartMapKeyIt) {
+
+                        SysLobCompPart* sysLobCompPart = sysLobCompPartMapKeyIt->second;
+
+                        SysLobFragKey sysLobFragKey2(sysLobCompPart->partObj, 0);
+                        for (auto sysLobFragMapKeyIt = sysLobFragMapKey.upper_bound(sysLobFragKey2);
                                 sysLobFragMapKeyIt != sysLobFragMapKey.end() &&
-                                sysLobFragMapKeyIt->first.parentObj == sysLob->lObj; ++sysLobFragMapKeyIt) {
+                                sysLobFragMapKeyIt->first.parentObj == sysLobCompPart->partObj; ++sysLobFragMapKeyIt) {
 
                             SysLobFrag* sysLobFrag = sysLobFragMapKeyIt->second;
                             auto sysObjMapObjIt2 = sysObjMapObj.find(sysLobFrag->fragObj);
@@ -2403,123 +2730,187 @@ namespace OpenLogReplicator {
                             lobTmp->addPartition(lobFragDataObj, getLobBlockSize(sysLobFrag->ts));
                             ++lobPartitions;
                         }
+                    }
+                }
 
-                        // Subpartitions
-                        SysLobCompPartKey sysLobCompPartKey(sysLob->lObj, 0);
-                        for (auto sysLobCompPartMapKeyIt = sysLobCompPartMapKey.upper_bound(sysLobCompPartKey);
-                                sysLobCompPartMapKeyIt != sysLobCompPartMapKey.end() &&
-                                sysLobCompPartMapKeyIt->first.lObj == sysLob->lObj; ++sysLobCompPartMapKeyIt) {
-
-                            SysLobCompPart* sysLobCompPart = sysLobCompPartMapKeyIt->second;
-
-                            SysLobFragKey sysLobFragKey2(sysLobCompPart->partObj, 0);
-                            for (auto sysLobFragMapKeyIt = sysLobFragMapKey.upper_bound(sysLobFragKey2);
-                                    sysLobFragMapKeyIt != sysLobFragMapKey.end() &&
-                                    sysLobFragMapKeyIt->first.parentObj == sysLobCompPart->partObj; ++sysLobFragMapKeyIt) {
-
-                                SysLobFrag* sysLobFrag = sysLobFragMapKeyIt->second;
-                                auto sysObjMapObjIt2 = sysObjMapObj.find(sysLobFrag->fragObj);
-                                if (sysObjMapObjIt2 == sysObjMapObj.end())
-                                    throw DataException(50028, "table " + std::string(sysUser->name) + "." + sysObj->name +
-                                                        " couldn't find obj for lob frag " + std::to_string(sysLobFrag->fragObj));
-                                typeObj lobFragDataObj = sysObjMapObjIt2->second->dataObj;
-
-                                lobTmp->addPartition(lobFragDataObj, getLobBlockSize(sysLobFrag->ts));
-                                ++lobPartitions;
-                            }
-                        }
+                lobTmp->addPartition(lobTmp->dataObj, getLobBlockSize(sysLob->ts));
+                tableTmp->addLob(lobTmp);
+                if ((ctx->trace & TRACE_LOB) != 0)
+                    lobList << " " << std::dec << lobTmp->obj << "/" << lobTmp->dataObj << "/" << std::dec << lobTmp->lObj;
+                lobTmp = nullptr;
+            }
+
+            // 0123456 7890123456 7 89012 34
+            // SYS_LOB xxxxxxxxxx C yyyyy $$
+            typeObj obj2 = sysObj->obj;
+            for (uint j = 0; j < 10; ++j) {
+                sysLobConstraintName[16 - j] = (obj2 % 10) + '0';
+                obj2 /= 10;
+            }
+
+            SysObjNameKey sysObjNameKeyName(sysObj->owner, sysLobConstraintName, 0, 0);
+            for (auto sysObjMapNameIt = sysObjMapName.upper_bound(sysObjNameKeyName); sysObjMapNameIt != sysObjMapName.end();
+                    ++sysObjMapNameIt) {
+                SysObj* sysObjLob = sysObjMapNameIt->second;
+                const char* colStr = sysObjLob->name.c_str();
+
+                if (sysObjLob->name.length() != 25 || memcmp(colStr, sysLobConstraintName, 18) != 0 || colStr[23] != '$' || colStr[24] != '$')
+                    continue;
+
+                // Decode column id
+                typeCol col = 0;
+                for (uint j = 0; j < 5; ++j) {
+                    col += colStr[18 + j] - '0';
+                    col *= 10;
+                }
+
+                // FIXME: potentially slow for tables with large number of LOB columns
+                OracleLob* oracleLob = nullptr;
+                for (auto lobIt: tableTmp->lobs) {
+                    if (lobIt->intCol == col) {
+                        oracleLob = lobIt;
+                        break;
                     }
+                }
 
-                    lobTmp->addPartition(lobTmp->dataObj, getLobBlockSize(sysLob->ts));
+                if (oracleLob == nullptr) {
+                    lobTmp = new OracleLob(tableTmp, sysObj->obj, 0, 0, col, col);
                     tableTmp->addLob(lobTmp);
-                    if ((ctx->trace & TRACE_LOB) != 0)
-                        lobList << " " << std::dec << lobTmp->obj << "/" << lobTmp->dataObj << "/" << std::dec << lobTmp->lObj;
+                    oracleLob = lobTmp;
                     lobTmp = nullptr;
                 }
 
-                // 0123456 7890123456 7 89012 34
-                // SYS_LOB xxxxxxxxxx C yyyyy $$
-                typeObj obj2 = sysObj->obj;
-                for (uint j = 0; j < 10; ++j) {
-                    sysLobConstraintName[16 - j] = (obj2 % 10) + '0';
-                    obj2 /= 10;
-                }
+                oracleLob->addPartition(sysObjLob->dataObj, getLobBlockSize(sysTab->ts));
+            }
+        }
 
-                SysObjNameKey sysObjNameKeyName(sysObj->owner, sysLobConstraintName, 0, 0);
-                for (auto sysObjMapNameIt = sysObjMapName.upper_bound(sysObjNameKeyName); sysObjMapNameIt != sysObjMapName.end();
-                        ++sysObjMapNameIt) {
-                    SysObj* sysObjLob = sysObjMapNameIt->second;
-                    const char* colStr = sysObjLob->name.c_str();
+        // Check if a table has all listed columns
+        if (static_cast<typeCol>(keys.size()) != keysCnt)
+            throw DataException(10041, "table " + std::string(sysUser->name) + "." + sysObj->name + " - couldn't find all column set (" +
+                                keysStr + ")");
+
+        std::ostringstream ss;
+        ss << sysUser->name << "." << sysObj->name << " (dataobj: " << std::dec << sysTab->dataObj << ", obj: " << std::dec << sysObj->obj <<
+                ", columns: " << std::dec << tableTmp->maxSegCol << ", lobs: " << std::dec << tableTmp->totalLobs << lobList.str() <<
+                ", lob-idx: " << std::dec << lobIndexes << lobIndexesList.str() << ")";
+        if (sysTab->isClustered())
+            ss << ", part of cluster";
+        if (sysTab->isPartitioned())
+            ss << ", partitioned(table: " << std::dec << tablePartitions << ", lob: " << lobPartitions << ")";
+        if (sysTab->isDependencies())
+            ss << ", row dependencies";
+        if (sysTab->isRowMovement())
+            ss << ", row movement enabled";
+
+        if (!DISABLE_CHECKS(DISABLE_CHECKS_SUPPLEMENTAL_LOG) && (options & OPTIONS_SYSTEM_TABLE) == 0) {
+            // Use a default primary key
+            if (keys.empty()) {
+                if (tableTmp->totalPk == 0)
+                    ss << ", primary key missing";
+                else if (!suppLogTablePrimary && !suppLogTableAll && !sysUser->isSuppLogPrimary() && !sysUser->isSuppLogAll() &&
+                         !suppLogDbPrimary && !suppLogDbAll && supLogColMissing)
+                    ss << ", supplemental log missing, try: ALTER TABLE " << sysUser->name << "." << sysObj->name <<
+                            " ADD SUPPLEMENTAL LOG DATA (PRIMARY KEY) COLUMNS;";
+                // User defined primary key
+            } else {
+                if (!suppLogTableAll && !sysUser->isSuppLogAll() && !suppLogDbAll && supLogColMissing)
+                    ss << ", supplemental log missing, try: ALTER TABLE " << sysUser->name << "." << sysObj->name << " ADD SUPPLEMENTAL LOG GROUP GRP" <<
+                            std::dec << sysObj->obj << " (" << keysStr << ") ALWAYS;";
+            }
+        }
+        msgs.push_back(ss.str());
 
-                    if (sysObjLob->name.length() != 25 || memcmp(colStr, sysLobConstraintName, 18) != 0 || colStr[23] != '$' || colStr[24] != '$')
-                        continue;
+        addTableToDict(tableTmp);
+        OracleTable* table = tableTmp;
+        tableTmp = nullptr;
+        return table;
+    }
 
-                    // Decode column id
-                    typeCol col = 0;
-                    for (uint j = 0; j < 5; ++j) {
-                        col += colStr[18 + j] - '0';
-                        col *= 10;
-                    }
+    SchemaTableRule* Schema::getTableRule(const std::vector<std::string>& keys, const std::string& keysStr, typeOptions options, bool suppLogDbPrimary,
+                                          bool suppLogDbAll, uint64_t defaultCharacterMapId, uint64_t defaultCharacterNcharMapId) {
+        for (SchemaTableRule& rule : tableRules) {
+            if (rule.keysStr == keysStr && rule.options == options && rule.suppLogDbPrimary == suppLogDbPrimary && rule.suppLogDbAll == suppLogDbAll &&
+                    rule.defaultCharacterMapId == defaultCharacterMapId && rule.defaultCharacterNcharMapId == defaultCharacterNcharMapId &&
+                    rule.keys == keys)
+                return &rule;
+        }
 
-                    // FIXME: potentially slow for tables with large number of LOB columns
-                    OracleLob* oracleLob = nullptr;
-                    for (auto lobIt: tableTmp->lobs) {
-                        if (lobIt->intCol == col) {
-                            oracleLob = lobIt;
-                            break;
-                        }
-                    }
+        tableRules.push_back({keys, keysStr, options, suppLogDbPrimary, suppLogDbAll, defaultCharacterMapId, defaultCharacterNcharMapId});
+        return &tableRules.back();
+    }
 
-                    if (oracleLob == nullptr) {
-                        lobTmp = new OracleLob(tableTmp, sysObj->obj, 0, 0, col, col);
-                        tableTmp->addLob(lobTmp);
-                        oracleLob = lobTmp;
-                        lobTmp = nullptr;
-                    }
+    void Schema::addTablePending(SysObj* sysObj, SysTab* sysTab, SchemaTableRule* rule) {
+        SchemaTablePending& tablePending = tablePendingMap[sysObj->obj];
+        tablePending.rule = rule;
+        tablePendingPartitionMap.insert_or_assign(sysObj->obj, sysObj->obj);
 
-                    oracleLob->addPartition(sysObjLob->dataObj, getLobBlockSize(sysTab->ts));
-                }
-            }
+        if (!sysTab->isPartitioned())
+            return;
 
-            // Check if a table has all listed columns
-            if (static_cast<typeCol>(keys.size()) != keysCnt)
-                throw DataException(10041, "table " + std::string(sysUser->name) + "." + sysObj->name + " - couldn't find all column set (" +
-                                    keysStr + ")");
+        SysTabPartKey sysTabPartKey(sysObj->obj, 0);
+        for (auto sysTabPartMapKeyIt = sysTabPartMapKey.upper_bound(sysTabPartKey);
+             sysTabPartMapKeyIt != sysTabPartMapKey.end() && sysTabPartMapKeyIt->first.bo == sysObj->obj; ++sysTabPartMapKeyIt) {
+            tablePending.partitions.push_back(sysTabPartMapKeyIt->second->obj);
+            tablePendingPartitionMap.insert_or_assign(sysTabPartMapKeyIt->second->obj, sysObj->obj);
+        }
 
-            std::ostringstream ss;
-            ss << sysUser->name << "." << sysObj->name << " (dataobj: " << std::dec << sysTab->dataObj << ", obj: " << std::dec << sysObj->obj <<
-                    ", columns: " << std::dec << tableTmp->maxSegCol << ", lobs: " << std::dec << tableTmp->totalLobs << lobList.str() <<
-                    ", lob-idx: " << std::dec << lobIndexes << lobIndexesList.str() << ")";
-            if (sysTab->isClustered())
-                ss << ", part of cluster";
-            if (sysTab->isPartitioned())
-                ss << ", partitioned(table: " << std::dec << tablePartitions << ", lob: " << lobPartitions << ")";
-            if (sysTab->isDependencies())
-                ss << ", row dependencies";
-            if (sysTab->isRowMovement())
-                ss << ", row movement enabled";
-
-            if (!DISABLE_CHECKS(DISABLE_CHECKS_SUPPLEMENTAL_LOG) && (options & OPTIONS_SYSTEM_TABLE) == 0) {
-                // Use a default primary key
-                if (keys.empty()) {
-                    if (tableTmp->totalPk == 0)
-                        ss << ", primary key missing";
-                    else if (!suppLogTablePrimary && !suppLogTableAll && !sysUser->isSuppLogPrimary() && !sysUser->isSuppLogAll() &&
-                             !suppLogDbPrimary && !suppLogDbAll && supLogColMissing)
-                        ss << ", supplemental log missing, try: ALTER TABLE " << sysUser->name << "." << sysObj->name <<
-                                " ADD SUPPLEMENTAL LOG DATA (PRIMARY KEY) COLUMNS;";
-                    // User defined primary key
-                } else {
-                    if (!suppLogTableAll && !sysUser->isSuppLogAll() && !suppLogDbAll && supLogColMissing)
-                        ss << ", supplemental log missing, try: ALTER TABLE " << sysUser->name << "." << sysObj->name << " ADD SUPPLEMENTAL LOG GROUP GRP" <<
-                                std::dec << sysObj->obj << " (" << keysStr << ") ALWAYS;";
-                }
+        SysTabComPartKey sysTabComPartKey(sysObj->obj, 0);
+        for (auto sysTabComPartMapKeyIt = sysTabComPartMapKey.upper_bound(sysTabComPartKey);
+             sysTabComPartMapKeyIt != sysTabComPartMapKey.end() && sysTabComPartMapKeyIt->first.bo == sysObj->obj; ++sysTabComPartMapKeyIt) {
+
+            SysTabSubPartKey sysTabSubPartKeyFirst(sysTabComPartMapKeyIt->second->obj, 0);
+            for (auto sysTabSubPartMapKeyIt = sysTabSubPartMapKey.upper_bound(sysTabSubPartKeyFirst);
+                 sysTabSubPartMapKeyIt != sysTabSubPartMapKey.end() && sysTabSubPartMapKeyIt->first.pObj == sysTabComPartMapKeyIt->second->obj;
+                 ++sysTabSubPartMapKeyIt) {
+                tablePending.partitions.push_back(sysTabSubPartMapKeyIt->second->obj);
+                tablePendingPartitionMap.insert_or_assign(sysTabSubPartMapKeyIt->second->obj, sysObj->obj);
             }
-            msgs.push_back(ss.str());
+        }
+    }
 
-            addTableToDict(tableTmp);
-            tableTmp = nullptr;
+    void Schema::removeTablePending(typeObj obj) {
+        auto tablePendingMapIt = tablePendingMap.find(obj);
+        if (tablePendingMapIt == tablePendingMap.end())
+            return;
+
+        for (typeObj partitionObj : tablePendingMapIt->second.partitions)
+            tablePendingPartitionMap.erase(partitionObj);
+        tablePendingPartitionMap.erase(obj);
+        tablePendingMap.erase(tablePendingMapIt);
+    }
+
+    OracleTable* Schema::buildTablePending(typeObj obj) {
+        auto tablePendingMapIt = tablePendingMap.find(obj);
+        if (tablePendingMapIt == tablePendingMap.end())
+            return nullptr;
+        SchemaTableRule* rule = tablePendingMapIt->second.rule;
+        removeTablePending(obj);
+
+        auto sysObjMapObjIt = sysObjMapObj.find(obj);
+        if (sysObjMapObjIt == sysObjMapObj.end())
+            return nullptr;
+        SysObj* sysObj = sysObjMapObjIt->second;
+
+        auto sysTabMapObjIt = sysTabMapObj.find(obj);
+        if (sysTabMapObjIt == sysTabMapObj.end())
+            return nullptr;
+        SysTab* sysTab = sysTabMapObjIt->second;
+
+        SysUser* sysUser = nullptr;
+        auto sysUserMapUserIt = sysUserMapUser.find(sysObj->owner);
+        if (sysUserMapUserIt == sysUserMapUser.end()) {
+            sysUserAdaptive.name = "USER_" + std::to_string(sysObj->obj);
+            sysUser = &sysUserAdaptive;
+        } else
+            sysUser = sysUserMapUserIt->second;
+
+        std::list<std::string> msgs;
+        OracleTable* table = buildTable(sysObj, sysTab, sysUser, rule->keys, rule->keysStr, rule->options, msgs, rule->suppLogDbPrimary,
+                                        rule->suppLogDbAll, rule->defaultCharacterMapId, rule->defaultCharacterNcharMapId);
+        for (const auto& msg: msgs) {
+            ctx->info(0, "created metadata: " + msg);
         }
+        return table;
     }
 
     uint16_t Schema::getLobBlockSize(typeTs ts) {
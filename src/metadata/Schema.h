@@ -25,6 +25,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <unordered_map>
 #include <vector>
 
+#include "../common/MemoryPool.h"
 #include "../common/SysCol.h"
 #include "../common/SysCCol.h"
 #include "../common/SysCDef.h"
@@ -50,11 +51,29 @@ namespace OpenLogReplicator {
     class OracleColumn;
     class OracleLob;
     class OracleTable;
+    class SchemaMatcher;
     class SysColSeg;
     class SysDeferredStg;
     class SysTab;
     class SysUser;
 
+    // Parameters of the filter rule which matched the table
+    struct SchemaTableRule {
+        std::vector<std::string> keys;
+        std::string keysStr;
+        typeOptions options;
+        bool suppLogDbPrimary;
+        bool suppLogDbAll;
+        uint64_t defaultCharacterMapId;
+        uint64_t defaultCharacterNcharMapId;
+    };
+
+    // Table matching the filter which is built at the first use
+    struct SchemaTablePending {
+        SchemaTableRule* rule;
+        std::vector<typeObj> partitions;
+    };
+
     class Schema final {
     protected:
         Ctx* ctx;
@@ -97,16 +116,34 @@ namespace OpenLogReplicator {
         void addTableToDict(OracleTable* table);
         void removeTableFromDict(OracleTable* table);
         uint16_t getLobBlockSize(typeTs ts);
+        [[nodiscard]] SchemaTableRule* getTableRule(const std::vector<std::string>& keys, const std::string& keysStr, typeOptions options,
+                                                    bool suppLogDbPrimary, bool suppLogDbAll, uint64_t defaultCharacterMapId,
+                                                    uint64_t defaultCharacterNcharMapId);
+        void addTablePending(SysObj* sysObj, SysTab* sysTab, SchemaTableRule* rule);
+        void removeTablePending(typeObj obj);
+        [[nodiscard]] OracleTable* buildTablePending(typeObj obj);
+        OracleTable* buildTable(SysObj* sysObj, SysTab* sysTab, SysUser* sysUser, const std::vector<std::string>& keys, const std::string& keysStr,
+                                typeOptions options, std::list<std::string>& msgs, bool suppLogDbPrimary, bool suppLogDbAll, uint64_t defaultCharacterMapId,
+                                uint64_t defaultCharacterNcharMapId);
 
     public:
+        // Dictionary records and nodes of their maps, declared first to be released last
+        MemoryArena arena;
         typeScn scn;
         typeScn refScn;
         bool loaded;
+        // Checkpoint which the schema was loaded from, and rows changed since the last checkpoint with schema
+        typeScn loadedScn;
+        bool deltaPending;
+        std::set<typeRowId> deltaDropped[TABLE_SYS_USER + 1];
 
         std::unordered_map<typeDataObj, OracleLob*> lobPartitionMap;
         std::unordered_map<typeDataObj, OracleLob*> lobIndexMap;
         std::unordered_map<typeObj, OracleTable*> tableMap;
         std::unordered_map<typeObj, OracleTable*> tablePartitionMap;
+        std::list<SchemaTableRule> tableRules;
+        std::unordered_map<typeObj, SchemaTablePending> tablePendingMap;
+        std::unordered_map<typeObj, typeObj> tablePendingPartitionMap;
         OracleColumn* columnTmp;
         OracleLob* lobTmp;
         OracleTable* tableTmp;
@@ -115,82 +152,97 @@ namespace OpenLogReplicator {
         bool touched;
 
         // SYS.CCOL$
-        std::map<typeRowId, SysCCol*> sysCColMapRowId;
-        std::map<SysCColKey, SysCCol*> sysCColMapKey;
+        PoolMap<typeRowId, SysCCol*> sysCColMapRowId;
+        PoolMap<typeRowId, SysCCol*> sysCColMapRowIdDelta;
+        PoolMap<SysCColKey, SysCCol*> sysCColMapKey;
         std::set<SysCCol*> sysCColSetTouched;
 
         // SYS.CDEF$
-        std::map<typeRowId, SysCDef*> sysCDefMapRowId;
-        std::map<SysCDefKey, SysCDef*> sysCDefMapKey;
-        std::unordered_map<typeCon, SysCDef*> sysCDefMapCon;
+        PoolMap<typeRowId, SysCDef*> sysCDefMapRowId;
+        PoolMap<typeRowId, SysCDef*> sysCDefMapRowIdDelta;
+        PoolMap<SysCDefKey, SysCDef*> sysCDefMapKey;
+        PoolUnorderedMap<typeCon, SysCDef*> sysCDefMapCon;
         std::set<SysCDef*> sysCDefSetTouched;
 
         // SYS.COL$
-        std::map<typeRowId, SysCol*> sysColMapRowId;
-        std::map<SysColSeg, SysCol*> sysColMapSeg;
+        PoolMap<typeRowId, SysCol*> sysColMapRowId;
+        PoolMap<typeRowId, SysCol*> sysColMapRowIdDelta;
+        PoolMap<SysColSeg, SysCol*> sysColMapSeg;
         std::set<SysCol*> sysColSetTouched;
 
         // SYS.DEFERRED_STG$
-        std::map<typeRowId, SysDeferredStg*> sysDeferredStgMapRowId;
-        std::unordered_map<typeObj, SysDeferredStg*> sysDeferredStgMapObj;
+        PoolMap<typeRowId, SysDeferredStg*> sysDeferredStgMapRowId;
+        PoolMap<typeRowId, SysDeferredStg*> sysDeferredStgMapRowIdDelta;
+        PoolUnorderedMap<typeObj, SysDeferredStg*> sysDeferredStgMapObj;
         std::set<SysDeferredStg*> sysDeferredStgSetTouched;
 
         // SYS.ECOL$
-        std::map<typeRowId, SysECol*> sysEColMapRowId;
-        std::unordered_map<SysEColKey, SysECol*> sysEColMapKey;
+        PoolMap<typeRowId, SysECol*> sysEColMapRowId;
+        PoolMap<typeRowId, SysECol*> sysEColMapRowIdDelta;
+        PoolUnorderedMap<SysEColKey, SysECol*> sysEColMapKey;
         std::set<SysECol*> sysEColSetTouched;
 
         // SYS.LOB$
-        std::map<typeRowId, SysLob*> sysLobMapRowId;
-        std::unordered_map<typeObj, SysLob*> sysLobMapLObj;
-        std::map<SysLobKey, SysLob*> sysLobMapKey;
+        PoolMap<typeRowId, SysLob*> sysLobMapRowId;
+        PoolMap<typeRowId, SysLob*> sysLobMapRowIdDelta;
+        PoolUnorderedMap<typeObj, SysLob*> sysLobMapLObj;
+        PoolMap<SysLobKey, SysLob*> sysLobMapKey;
         std::set<SysLob*> sysLobSetTouched;
 
         // SYS.LOBCOMPPART$
-        std::map<typeRowId, SysLobCompPart*> sysLobCompPartMapRowId;
-        std::unordered_map<typeObj, SysLobCompPart*> sysLobCompPartMapPartObj;
-        std::map<SysLobCompPartKey, SysLobCompPart*> sysLobCompPartMapKey;
+        PoolMap<typeRowId, SysLobCompPart*> sysLobCompPartMapRowId;
+        PoolMap<typeRowId, SysLobCompPart*> sysLobCompPartMapRowIdDelta;
+        PoolUnorderedMap<typeObj, SysLobCompPart*> sysLobCompPartMapPartObj;
+        PoolMap<SysLobCompPartKey, SysLobCompPart*> sysLobCompPartMapKey;
         std::set<SysLobCompPart*> sysLobCompPartSetTouched;
 
         // SYS.LOBFRAG$
-        std::map<typeRowId, SysLobFrag*> sysLobFragMapRowId;
-        std::map<SysLobFragKey, SysLobFrag*> sysLobFragMapKey;
+        PoolMap<typeRowId, SysLobFrag*> sysLobFragMapRowId;
+        PoolMap<typeRowId, SysLobFrag*> sysLobFragMapRowIdDelta;
+        PoolMap<SysLobFragKey, SysLobFrag*> sysLobFragMapKey;
         std::set<SysLobFrag*> sysLobFragSetTouched;
 
         // SYS.OBJ$
-        std::map<typeRowId, SysObj*> sysObjMapRowId;
-        std::map<SysObjNameKey, SysObj*> sysObjMapName;
-        std::unordered_map<typeObj, SysObj*> sysObjMapObj;
+        PoolMap<typeRowId, SysObj*> sysObjMapRowId;
+        PoolMap<typeRowId, SysObj*> sysObjMapRowIdDelta;
+        PoolMap<SysObjNameKey, SysObj*> sysObjMapName;
+        PoolUnorderedMap<typeObj, SysObj*> sysObjMapObj;
         std::set<SysObj*> sysObjSetTouched;
 
         // SYS.TAB$
-        std::map<typeRowId, SysTab*> sysTabMapRowId;
-        std::unordered_map<typeObj, SysTab*> sysTabMapObj;
+        PoolMap<typeRowId, SysTab*> sysTabMapRowId;
+        PoolMap<typeRowId, SysTab*> sysTabMapRowIdDelta;
+        PoolUnorderedMap<typeObj, SysTab*> sysTabMapObj;
         std::set<SysTab*> sysTabSetTouched;
 
         // SYS.TABCOMPART$
-        std::map<typeRowId, SysTabComPart*> sysTabComPartMapRowId;
-        std::unordered_map<typeObj, SysTabComPart*> sysTabComPartMapObj;
-        std::map<SysTabComPartKey, SysTabComPart*> sysTabComPartMapKey;
+        PoolMap<typeRowId, SysTabComPart*> sysTabComPartMapRowId;
+        PoolMap<typeRowId, SysTabComPart*> sysTabComPartMapRowIdDelta;
+        PoolUnorderedMap<typeObj, SysTabComPart*> sysTabComPartMapObj;
+        PoolMap<SysTabComPartKey, SysTabComPart*> sysTabComPartMapKey;
         std::set<SysTabComPart*> sysTabComPartSetTouched;
 
         // SYS.TABPART$
-        std::map<typeRowId, SysTabPart*> sysTabPartMapRowId;
-        std::map<SysTabPartKey, SysTabPart*> sysTabPartMapKey;
+        PoolMap<typeRowId, SysTabPart*> sysTabPartMapRowId;
+        PoolMap<typeRowId, SysTabPart*> sysTabPartMapRowIdDelta;
+        PoolMap<SysTabPartKey, SysTabPart*> sysTabPartMapKey;
         std::set<SysTabPart*> sysTabPartSetTouched;
 
         // SYS.TABSUBPART$
-        std::map<typeRowId, SysTabSubPart*> sysTabSubPartMapRowId;
-        std::map<SysTabSubPartKey, SysTabSubPart*> sysTabSubPartMapKey;
+        PoolMap<typeRowId, SysTabSubPart*> sysTabSubPartMapRowId;
+        PoolMap<typeRowId, SysTabSubPart*> sysTabSubPartMapRowIdDelta;
+        PoolMap<SysTabSubPartKey, SysTabSubPart*> sysTabSubPartMapKey;
         std::set<SysTabSubPart*> sysTabSubPartSetTouched;
 
         // SYS.TS$
-        std::map<typeRowId, SysTs*> sysTsMapRowId;
-        std::unordered_map<typeTs, SysTs*> sysTsMapTs;
+        PoolMap<typeRowId, SysTs*> sysTsMapRowId;
+        PoolMap<typeRowId, SysTs*> sysTsMapRowIdDelta;
+        PoolUnorderedMap<typeTs, SysTs*> sysTsMapTs;
 
         // SYS.USER$
-        std::map<typeRowId, SysUser*> sysUserMapRowId;
-        std::unordered_map<typeUser, SysUser*> sysUserMapUser;
+        PoolMap<typeRowId, SysUser*> sysUserMapRowId;
+        PoolMap<typeRowId, SysUser*> sysUserMapRowIdDelta;
+        PoolUnorderedMap<typeUser, SysUser*> sysUserMapUser;
         std::set<SysUser*> sysUserSetTouched;
 
         Schema(Ctx* newCtx, Locales* newLocales);
@@ -199,24 +251,24 @@ namespace OpenLogReplicator {
         void purgeMetadata();
         void purgeDicts();
         [[nodiscard]] bool compare(Schema* otherSchema, std::string& msgs);
-        void dictSysCColAdd(const char* rowIdStr, typeCon con, typeCol intCol, typeObj obj, uint64_t spare11, uint64_t spare12);
-        void dictSysCDefAdd(const char* rowIdStr, typeCon con, typeObj obj, typeType type);
-        void dictSysColAdd(const char* rowIdStr, typeObj obj, typeCol col, typeCol segCol, typeCol intCol, const char* name, typeType type, uint64_t length,
+        void dictSysCColAdd(typeRowId rowId, typeCon con, typeCol intCol, typeObj obj, uint64_t spare11, uint64_t spare12);
+        void dictSysCDefAdd(typeRowId rowId, typeCon con, typeObj obj, typeType type);
+        void dictSysColAdd(typeRowId rowId, typeObj obj, typeCol col, typeCol segCol, typeCol intCol, const char* name, typeType type, uint64_t length,
                            int64_t precision, int64_t scale, uint64_t charsetForm, uint64_t charsetId, bool null_, uint64_t property1, uint64_t property2);
-        void dictSysDeferredStgAdd(const char* rowIdStr, typeObj obj, uint64_t flagsStg1, uint64_t flagsStg2);
-        void dictSysEColAdd(const char* rowIdStr, typeObj tabObj, typeCol colNum, typeCol guardId);
-        void dictSysLobAdd(const char* rowIdStr, typeObj obj, typeCol col, typeCol intCol, typeObj lObj, typeTs ts);
-        void dictSysLobCompPartAdd(const char* rowIdStr, typeObj partObj, typeObj lObj);
-        void dictSysLobFragAdd(const char* rowIdStr, typeObj fragObj, typeObj parentObj, typeTs ts);
-        bool dictSysObjAdd(const char* rowIdStr, typeUser owner, typeObj obj, typeDataObj dataObj, typeType type, const char* name, uint64_t flags1,
+        void dictSysDeferredStgAdd(typeRowId rowId, typeObj obj, uint64_t flagsStg1, uint64_t flagsStg2);
+        void dictSysEColAdd(typeRowId rowId, typeObj tabObj, typeCol colNum, typeCol guardId);
+        void dictSysLobAdd(typeRowId rowId, typeObj obj, typeCol col, typeCol intCol, typeObj lObj, typeTs ts);
+        void dictSysLobCompPartAdd(typeRowId rowId, typeObj partObj, typeObj lObj);
+        void dictSysLobFragAdd(typeRowId rowId, typeObj fragObj, typeObj parentObj, typeTs ts);
+        bool dictSysObjAdd(typeRowId rowId, typeUser owner, typeObj obj, typeDataObj dataObj, typeType type, const char* name, uint64_t flags1,
                            uint64_t flags2, bool single);
-        void dictSysTabAdd(const char* rowIdStr, typeObj obj, typeDataObj dataObj, typeTs ts, typeCol cluCols, uint64_t flags1, uint64_t flags2,
+        void dictSysTabAdd(typeRowId rowId, typeObj obj, typeDataObj dataObj, typeTs ts, typeCol cluCols, uint64_t flags1, uint64_t flags2,
                            uint64_t property1, uint64_t property2);
-        void dictSysTabComPartAdd(const char* rowIdStr, typeObj obj, typeDataObj dataObj, typeObj bo);
-        void dictSysTabPartAdd(const char* rowIdStr, typeObj obj, typeDataObj dataObj, typeObj bo);
-        void dictSysTabSubPartAdd(const char* rowIdStr, typeObj obj, typeDataObj dataObj, typeObj pObj);
-        void dictSysTsAdd(const char* rowIdStr, typeTs ts, const char* name, uint32_t blockSize);
-        bool dictSysUserAdd(const char* rowIdStr, typeUser user, const char* name, uint64_t spare11, uint64_t spare12, bool single);
+        void dictSysTabComPartAdd(typeRowId rowId, typeObj obj, typeDataObj dataObj, typeObj bo);
+        void dictSysTabPartAdd(typeRowId rowId, typeObj obj, typeDataObj dataObj, typeObj bo);
+        void dictSysTabSubPartAdd(typeRowId rowId, typeObj obj, typeDataObj dataObj, typeObj pObj);
+        void dictSysTsAdd(typeRowId rowId, typeTs ts, const char* name, uint32_t blockSize);
+        bool dictSysUserAdd(typeRowId rowId, typeUser user, const char* name, uint64_t spare11, uint64_t spare12, bool single);
 
         void dictSysCColAdd(SysCCol* sysCCol);
         void dictSysCDefAdd(SysCDef* sysCDef);
@@ -272,10 +324,11 @@ namespace OpenLogReplicator {
         [[nodiscard]] OracleLob* checkLobDict(typeDataObj dataObj);
         [[nodiscard]] OracleLob* checkLobIndexDict(typeDataObj dataObj);
         void dropUnusedMetadata(const std::set<std::string>& users, std::list<std::string>& msgs);
-        void buildMaps(const std::string& owner, const std::string& table, const std::vector<std::string>& keys, const std::string& keysStr,
-                       typeOptions options, std::list<std::string>& msgs, bool suppLogDbPrimary, bool suppLogDbAll, uint64_t defaultCharacterMapId,
-                       uint64_t defaultCharacterNcharMapId);
+        void buildMaps(SchemaMatcher* matcher, std::list<std::string>& msgs, bool suppLogDbPrimary, bool suppLogDbAll,
+                       uint64_t defaultCharacterMapId, uint64_t defaultCharacterNcharMapId);
         void resetTouched();
+        void resetDelta();
+        void dictSysDropRowId(uint64_t table, typeRowId rowId);
     };
 }
 
@@ -0,0 +1,149 @@
+/* Matching of objects against schema elements
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <cstring>
+
+#include "SchemaElement.h"
+#include "SchemaMatcher.h"
+
+namespace OpenLogReplicator {
+    SchemaMatcher::SchemaMatcher() {
+    }
+
+    SchemaMatcher::~SchemaMatcher() {
+        clear();
+    }
+
+    // A pattern without special characters (escaped ones are allowed) matches just one name
+    bool SchemaMatcher::isLiteral(const std::string& pattern, std::string& name) {
+        name.clear();
+        for (uint64_t i = 0; i < pattern.length(); ++i) {
+            char c = pattern[i];
+            if (c == '\\') {
+                if (i + 1 == pattern.length() || isalnum(static_cast<unsigned char>(pattern[i + 1])))
+                    return false;
+                name.push_back(pattern[++i]);
+            } else if (strchr("^$.*+?()[]{}|", c) != nullptr)
+                return false;
+            else
+                name.push_back(c);
+        }
+        return true;
+    }
+
+    bool SchemaMatcher::matchTable(const SchemaMatcherRule& rule, const std::string& table) const {
+        if (rule.tableRegex == nullptr)
+            return rule.table == table;
+        return regex_match(table, *rule.tableRegex);
+    }
+
+    void SchemaMatcher::build(const std::vector<SchemaElement*>& elements) {
+        clear();
+
+        for (SchemaElement* element : elements) {
+            uint64_t num = rules.size();
+            SchemaMatcherRule rule{element, "", "", nullptr, nullptr};
+            if (!isLiteral(element->owner, rule.owner))
+                rule.ownerRegex = new std::regex(element->owner);
+            if (!isLiteral(element->table, rule.table))
+                rule.tableRegex = new std::regex(element->table);
+            rules.push_back(rule);
+
+            if (rule.ownerRegex != nullptr) {
+                ownerRules.push_back(num);
+                continue;
+            }
+
+            SchemaMatcherOwner& owner = owners[rule.owner];
+            if (rule.tableRegex != nullptr)
+                owner.tableRules.push_back(num);
+            else if (owner.tables.find(rule.table) == owner.tables.end())
+                owner.tables.insert_or_assign(rule.table, num);
+        }
+    }
+
+    void SchemaMatcher::clear() {
+        for (SchemaMatcherRule& rule : rules) {
+            if (rule.ownerRegex != nullptr) {
+                delete rule.ownerRegex;
+                rule.ownerRegex = nullptr;
+            }
+
+            if (rule.tableRegex != nullptr) {
+                delete rule.tableRegex;
+                rule.tableRegex = nullptr;
+            }
+        }
+        rules.clear();
+        owners.clear();
+        ownerRules.clear();
+        ownerRulesMatched.clear();
+    }
+
+    SchemaElement* SchemaMatcher::match(const std::string& owner, const std::string& table) {
+        uint64_t found = rules.size();
+
+        auto ownersIt = owners.find(owner);
+        if (ownersIt != owners.end()) {
+            auto tablesIt = ownersIt->second.tables.find(table);
+            if (tablesIt != ownersIt->second.tables.end())
+                found = tablesIt->second;
+
+            for (uint64_t num : ownersIt->second.tableRules) {
+                if (num >= found)
+                    break;
+                if (matchTable(rules[num], table)) {
+                    found = num;
+                    break;
+                }
+            }
+        }
+
+        auto ownerRulesMatchedIt = ownerRulesMatched.find(owner);
+        if (ownerRulesMatchedIt == ownerRulesMatched.end()) {
+            std::vector<uint64_t> matched;
+            for (uint64_t num : ownerRules) {
+                if (regex_match(owner, *rules[num].ownerRegex))
+                    matched.push_back(num);
+            }
+            ownerRulesMatchedIt = ownerRulesMatched.insert_or_assign(owner, matched).first;
+        }
+
+        for (uint64_t num : ownerRulesMatchedIt->second) {
+            if (num >= found)
+                break;
+            if (matchTable(rules[num], table)) {
+                found = num;
+                break;
+            }
+        }
+
+        if (found == rules.size())
+            return nullptr;
+        return rules[found].element;
+    }
+
+    SchemaElement* SchemaMatcher::matchAnyOwner(const std::string& table) {
+        for (const SchemaMatcherRule& rule : rules) {
+            if (matchTable(rule, table))
+                return rule.element;
+        }
+        return nullptr;
+    }
+}
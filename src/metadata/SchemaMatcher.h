@@ -0,0 +1,71 @@
+/* Header for SchemaMatcher class
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/types.h"
+
+#ifndef SCHEMA_MATCHER_H_
+#define SCHEMA_MATCHER_H_
+
+namespace OpenLogReplicator {
+    class SchemaElement;
+
+    // Compiled owner and table pattern of one schema element, regex is null for a literal name
+    struct SchemaMatcherRule {
+        SchemaElement* element;
+        std::string owner;
+        std::string table;
+        std::regex* ownerRegex;
+        std::regex* tableRegex;
+    };
+
+    // Rules with a literal owner name
+    struct SchemaMatcherOwner {
+        std::unordered_map<std::string, uint64_t> tables;
+        std::vector<uint64_t> tableRules;
+    };
+
+    class SchemaMatcher final {
+    protected:
+        // All rules are in the order of schema elements, the first matching element is used
+        std::vector<SchemaMatcherRule> rules;
+        std::unordered_map<std::string, SchemaMatcherOwner> owners;
+        std::vector<uint64_t> ownerRules;
+        // Owner patterns are checked once per user, there are few users compared to objects
+        std::unordered_map<std::string, std::vector<uint64_t>> ownerRulesMatched;
+
+        [[nodiscard]] static bool isLiteral(const std::string& pattern, std::string& name);
+        [[nodiscard]] bool matchTable(const SchemaMatcherRule& rule, const std::string& table) const;
+
+    public:
+        SchemaMatcher();
+        ~SchemaMatcher();
+
+        void build(const std::vector<SchemaElement*>& elements);
+        void clear();
+        [[nodiscard]] SchemaElement* match(const std::string& owner, const std::string& table);
+        [[nodiscard]] SchemaElement* matchAnyOwner(const std::string& table);
+    };
+}
+
+#endif
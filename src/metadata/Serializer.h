@@ -26,6 +26,10 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #ifndef SERIALIZER_H_
 #define SERIALIZER_H_
 
+#define SERIALIZER_SCHEMA_NONE                  0
+#define SERIALIZER_SCHEMA_FULL                  1
+#define SERIALIZER_SCHEMA_DELTA                 2
+
 namespace OpenLogReplicator {
     class Metadata;
 
@@ -36,7 +40,9 @@ namespace OpenLogReplicator {
 
         [[nodiscard]] virtual bool deserialize(Metadata* metadata, const std::string& ss, const std::string& fileName, std::list<std::string>& msgs,
                                                bool loadMetadata, bool storeSchema) = 0;
-        virtual void serialize(Metadata* metadata, std::ostringstream& ss, bool noSchema) = 0;
+        // Checkpoint position, followed by the schema part which may be serialized later holding only the schema lock
+        virtual void serialize(Metadata* metadata, std::ostringstream& ss, uint64_t schemaMode) = 0;
+        virtual void serializeSchema(Metadata* metadata, std::ostringstream& ss, uint64_t schemaMode) = 0;
     };
 }
 
@@ -0,0 +1,760 @@
+/* Base class for serialization of metadata to binary format
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include "../common/Ctx.h"
+#include "../common/OracleIncarnation.h"
+#include "../common/SysCCol.h"
+#include "../common/SysCDef.h"
+#include "../common/SysCol.h"
+#include "../common/SysDeferredStg.h"
+#include "../common/SysECol.h"
+#include "../common/SysLob.h"
+#include "../common/SysLobCompPart.h"
+#include "../common/SysLobFrag.h"
+#include "../common/SysObj.h"
+#include "../common/SysTab.h"
+#include "../common/SysTabComPart.h"
+#include "../common/SysTabPart.h"
+#include "../common/SysTabSubPart.h"
+#include "../common/SysTs.h"
+#include "../common/SysUser.h"
+#include "RedoLog.h"
+#include "Metadata.h"
+#include "Schema.h"
+#include "SchemaElement.h"
+#include "SerializerBinary.h"
+
+namespace OpenLogReplicator {
+
+    SerializerBinary::SerializerBinary() :
+            Serializer() {
+    }
+
+    SerializerBinary::~SerializerBinary() = default;
+
+    void SerializerBinary::serialize(Metadata* metadata, std::ostringstream& ss, uint64_t schemaMode) {
+        // Assuming the caller holds the checkpoint lock
+        std::string out;
+
+        uint32_t flags = 0;
+        if (schemaMode != SERIALIZER_SCHEMA_NONE)
+            flags |= SERIALIZER_BINARY_FLAG_SCHEMA;
+        if (schemaMode == SERIALIZER_SCHEMA_DELTA)
+            flags |= SERIALIZER_BINARY_FLAG_DELTA;
+        if (metadata->minSequence != ZERO_SEQ)
+            flags |= SERIALIZER_BINARY_FLAG_MIN_TRAN;
+        if (metadata->ctx->isBigEndian())
+            flags |= SERIALIZER_BINARY_FLAG_BIG_ENDIAN;
+
+        out.append(SERIALIZER_BINARY_MAGIC, SERIALIZER_BINARY_MAGIC_LENGTH);
+        write32(out, SERIALIZER_BINARY_VERSION);
+        write32(out, flags);
+        // Total length, filled at the end
+        write64(out, 0);
+
+        writeString(out, metadata->database);
+        write64(out, metadata->checkpointScn);
+        write32(out, metadata->resetlogs);
+        write32(out, metadata->activation);
+        write32(out, metadata->checkpointTime.getVal());
+        write32(out, metadata->checkpointSequence);
+        write64(out, metadata->checkpointOffset);
+        if (metadata->minSequence != ZERO_SEQ) {
+            write32(out, metadata->minSequence);
+            write64(out, metadata->minOffset);
+            write64(out, metadata->minXid.getData());
+        }
+        writeString(out, metadata->context);
+        write16(out, static_cast<uint16_t>(metadata->conId));
+        writeString(out, metadata->conName);
+        writeString(out, metadata->dbRecoveryFileDest);
+        writeString(out, metadata->dbBlockChecksum);
+        writeString(out, metadata->logArchiveDest);
+        writeString(out, metadata->logArchiveFormat);
+        writeString(out, metadata->nlsCharacterSet);
+        writeString(out, metadata->nlsNcharCharacterSet);
+        write16(out, (metadata->suppLogDbPrimary ? 1 : 0) | (metadata->suppLogDbAll ? 2 : 0));
+
+        uint64_t start = beginSection(out);
+        uint64_t count = 0;
+        for (RedoLog* redoLog: metadata->redoLogs) {
+            if (redoLog->group == 0)
+                continue;
+            write64(out, redoLog->group);
+            writeString(out, redoLog->path);
+            ++count;
+        }
+        endSection(out, start, count);
+
+        start = beginSection(out);
+        for (OracleIncarnation* oi : metadata->oracleIncarnations) {
+            write32(out, oi->incarnation);
+            write64(out, oi->resetlogsScn);
+            write64(out, oi->priorResetlogsScn);
+            writeString(out, oi->status);
+            write32(out, oi->resetlogs);
+            write32(out, oi->priorIncarnation);
+        }
+        endSection(out, start, metadata->oracleIncarnations.size());
+
+        start = beginSection(out);
+        for (const std::string& user: metadata->users)
+            writeString(out, user);
+        endSection(out, start, metadata->users.size());
+        ss.write(out.data(), static_cast<std::streamsize>(out.length()));
+    }
+
+    void SerializerBinary::serializeSchema(Metadata* metadata, std::ostringstream& ss, uint64_t schemaMode) {
+        // Assuming the caller holds the schema lock
+        std::string out;
+        uint64_t start;
+        Schema* schema = metadata->schema;
+        bool delta = (schemaMode == SERIALIZER_SCHEMA_DELTA);
+        if (schemaMode == SERIALIZER_SCHEMA_FULL)
+            out.reserve(schema->sysObjMapRowId.size() * 64 + schema->sysColMapRowId.size() * 96);
+
+        // Schema did not change since the last checkpoint file
+        if (schemaMode == SERIALIZER_SCHEMA_NONE) {
+            write64(out, schema->refScn);
+        } else {
+            write64(out, schema->scn);
+            if (delta) {
+                // Only rows changed since the checkpoint file with the previous schema, rows to remove are listed first
+                write64(out, schema->refScn);
+                writeDropped(out, schema->sysCColMapRowIdDelta, schema->deltaDropped[TABLE_SYS_CCOL]);
+                writeDropped(out, schema->sysCDefMapRowIdDelta, schema->deltaDropped[TABLE_SYS_CDEF]);
+                writeDropped(out, schema->sysColMapRowIdDelta, schema->deltaDropped[TABLE_SYS_COL]);
+                writeDropped(out, schema->sysDeferredStgMapRowIdDelta, schema->deltaDropped[TABLE_SYS_DEFERRED_STG]);
+                writeDropped(out, schema->sysEColMapRowIdDelta, schema->deltaDropped[TABLE_SYS_ECOL]);
+                writeDropped(out, schema->sysLobMapRowIdDelta, schema->deltaDropped[TABLE_SYS_LOB]);
+                writeDropped(out, schema->sysLobCompPartMapRowIdDelta, schema->deltaDropped[TABLE_SYS_LOB_COMP_PART]);
+                writeDropped(out, schema->sysLobFragMapRowIdDelta, schema->deltaDropped[TABLE_SYS_LOB_FRAG]);
+                writeDropped(out, schema->sysObjMapRowIdDelta, schema->deltaDropped[TABLE_SYS_OBJ]);
+                writeDropped(out, schema->sysTabMapRowIdDelta, schema->deltaDropped[TABLE_SYS_TAB]);
+                writeDropped(out, schema->sysTabPartMapRowIdDelta, schema->deltaDropped[TABLE_SYS_TABPART]);
+                writeDropped(out, schema->sysTabComPartMapRowIdDelta, schema->deltaDropped[TABLE_SYS_TABCOMPART]);
+                writeDropped(out, schema->sysTabSubPartMapRowIdDelta, schema->deltaDropped[TABLE_SYS_TABSUBPART]);
+                writeDropped(out, schema->sysTsMapRowIdDelta, schema->deltaDropped[TABLE_SYS_TS]);
+                writeDropped(out, schema->sysUserMapRowIdDelta, schema->deltaDropped[TABLE_SYS_USER]);
+            }
+
+            // Sections in the order of loading
+            start = beginSection(out);
+            for (auto sysUserMapRowIdIt : (delta ? schema->sysUserMapRowIdDelta : schema->sysUserMapRowId)) {
+                SysUser* sysUser = sysUserMapRowIdIt.second;
+                writeRowId(out, sysUser->rowId);
+                write32(out, sysUser->user);
+                writeString(out, sysUser->name);
+                writeIntX(out, sysUser->spare1);
+                out.push_back(sysUser->single ? 1 : 0);
+            }
+            endSection(out, start, (delta ? schema->sysUserMapRowIdDelta : schema->sysUserMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysObjMapRowIdIt : (delta ? schema->sysObjMapRowIdDelta : schema->sysObjMapRowId)) {
+                SysObj* sysObj = sysObjMapRowIdIt.second;
+                writeRowId(out, sysObj->rowId);
+                write32(out, sysObj->owner);
+                write32(out, sysObj->obj);
+                write32(out, sysObj->dataObj);
+                write16(out, sysObj->type);
+                writeString(out, sysObj->name);
+                writeIntX(out, sysObj->flags);
+                out.push_back(sysObj->single ? 1 : 0);
+            }
+            endSection(out, start, (delta ? schema->sysObjMapRowIdDelta : schema->sysObjMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysColMapRowIdIt : (delta ? schema->sysColMapRowIdDelta : schema->sysColMapRowId)) {
+                SysCol* sysCol = sysColMapRowIdIt.second;
+                writeRowId(out, sysCol->rowId);
+                write32(out, sysCol->obj);
+                write16(out, static_cast<uint16_t>(sysCol->col));
+                write16(out, static_cast<uint16_t>(sysCol->segCol));
+                write16(out, static_cast<uint16_t>(sysCol->intCol));
+                writeString(out, sysCol->name);
+                write16(out, sysCol->type);
+                write64(out, sysCol->length);
+                write64(out, static_cast<uint64_t>(sysCol->precision));
+                write64(out, static_cast<uint64_t>(sysCol->scale));
+                write64(out, sysCol->charsetForm);
+                write64(out, sysCol->charsetId);
+                write64(out, static_cast<uint64_t>(sysCol->null_));
+                writeIntX(out, sysCol->property);
+            }
+            endSection(out, start, (delta ? schema->sysColMapRowIdDelta : schema->sysColMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysCColMapRowIdIt : (delta ? schema->sysCColMapRowIdDelta : schema->sysCColMapRowId)) {
+                SysCCol* sysCCol = sysCColMapRowIdIt.second;
+                writeRowId(out, sysCCol->rowId);
+                write32(out, sysCCol->con);
+                write16(out, static_cast<uint16_t>(sysCCol->intCol));
+                write32(out, sysCCol->obj);
+                writeIntX(out, sysCCol->spare1);
+            }
+            endSection(out, start, (delta ? schema->sysCColMapRowIdDelta : schema->sysCColMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysCDefMapRowIdIt : (delta ? schema->sysCDefMapRowIdDelta : schema->sysCDefMapRowId)) {
+                SysCDef* sysCDef = sysCDefMapRowIdIt.second;
+                writeRowId(out, sysCDef->rowId);
+                write32(out, sysCDef->con);
+                write32(out, sysCDef->obj);
+                write16(out, sysCDef->type);
+            }
+            endSection(out, start, (delta ? schema->sysCDefMapRowIdDelta : schema->sysCDefMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysDeferredStgMapRowIdIt : (delta ? schema->sysDeferredStgMapRowIdDelta : schema->sysDeferredStgMapRowId)) {
+                SysDeferredStg* sysDeferredStg = sysDeferredStgMapRowIdIt.second;
+                writeRowId(out, sysDeferredStg->rowId);
+                write32(out, sysDeferredStg->obj);
+                writeIntX(out, sysDeferredStg->flagsStg);
+            }
+            endSection(out, start, (delta ? schema->sysDeferredStgMapRowIdDelta : schema->sysDeferredStgMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysEColMapRowIdIt : (delta ? schema->sysEColMapRowIdDelta : schema->sysEColMapRowId)) {
+                SysECol* sysECol = sysEColMapRowIdIt.second;
+                writeRowId(out, sysECol->rowId);
+                write32(out, sysECol->tabObj);
+                write16(out, static_cast<uint16_t>(sysECol->colNum));
+                write16(out, static_cast<uint16_t>(sysECol->guardId));
+            }
+            endSection(out, start, (delta ? schema->sysEColMapRowIdDelta : schema->sysEColMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysLobMapRowIdIt : (delta ? schema->sysLobMapRowIdDelta : schema->sysLobMapRowId)) {
+                SysLob* sysLob = sysLobMapRowIdIt.second;
+                writeRowId(out, sysLob->rowId);
+                write32(out, sysLob->obj);
+                write16(out, static_cast<uint16_t>(sysLob->col));
+                write16(out, static_cast<uint16_t>(sysLob->intCol));
+                write32(out, sysLob->lObj);
+                write32(out, sysLob->ts);
+            }
+            endSection(out, start, (delta ? schema->sysLobMapRowIdDelta : schema->sysLobMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysLobCompPartMapRowIdIt : (delta ? schema->sysLobCompPartMapRowIdDelta : schema->sysLobCompPartMapRowId)) {
+                SysLobCompPart* sysLobCompPart = sysLobCompPartMapRowIdIt.second;
+                writeRowId(out, sysLobCompPart->rowId);
+                write32(out, sysLobCompPart->partObj);
+                write32(out, sysLobCompPart->lObj);
+            }
+            endSection(out, start, (delta ? schema->sysLobCompPartMapRowIdDelta : schema->sysLobCompPartMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysLobFragMapRowIdIt : (delta ? schema->sysLobFragMapRowIdDelta : schema->sysLobFragMapRowId)) {
+                SysLobFrag* sysLobFrag = sysLobFragMapRowIdIt.second;
+                writeRowId(out, sysLobFrag->rowId);
+                write32(out, sysLobFrag->fragObj);
+                write32(out, sysLobFrag->parentObj);
+                write32(out, sysLobFrag->ts);
+            }
+            endSection(out, start, (delta ? schema->sysLobFragMapRowIdDelta : schema->sysLobFragMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysTabMapRowIdIt : (delta ? schema->sysTabMapRowIdDelta : schema->sysTabMapRowId)) {
+                SysTab* sysTab = sysTabMapRowIdIt.second;
+                writeRowId(out, sysTab->rowId);
+                write32(out, sysTab->obj);
+                write32(out, sysTab->dataObj);
+                write32(out, sysTab->ts);
+                write16(out, static_cast<uint16_t>(sysTab->cluCols));
+                writeIntX(out, sysTab->flags);
+                writeIntX(out, sysTab->property);
+            }
+            endSection(out, start, (delta ? schema->sysTabMapRowIdDelta : schema->sysTabMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysTabPartMapRowIdIt : (delta ? schema->sysTabPartMapRowIdDelta : schema->sysTabPartMapRowId)) {
+                SysTabPart* sysTabPart = sysTabPartMapRowIdIt.second;
+                writeRowId(out, sysTabPart->rowId);
+                write32(out, sysTabPart->obj);
+                write32(out, sysTabPart->dataObj);
+                write32(out, sysTabPart->bo);
+            }
+            endSection(out, start, (delta ? schema->sysTabPartMapRowIdDelta : schema->sysTabPartMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysTabComPartMapRowIdIt : (delta ? schema->sysTabComPartMapRowIdDelta : schema->sysTabComPartMapRowId)) {
+                SysTabComPart* sysTabComPart = sysTabComPartMapRowIdIt.second;
+                writeRowId(out, sysTabComPart->rowId);
+                write32(out, sysTabComPart->obj);
+                write32(out, sysTabComPart->dataObj);
+                write32(out, sysTabComPart->bo);
+            }
+            endSection(out, start, (delta ? schema->sysTabComPartMapRowIdDelta : schema->sysTabComPartMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysTabSubPartMapRowIdIt : (delta ? schema->sysTabSubPartMapRowIdDelta : schema->sysTabSubPartMapRowId)) {
+                SysTabSubPart* sysTabSubPart = sysTabSubPartMapRowIdIt.second;
+                writeRowId(out, sysTabSubPart->rowId);
+                write32(out, sysTabSubPart->obj);
+                write32(out, sysTabSubPart->dataObj);
+                write32(out, sysTabSubPart->pObj);
+            }
+            endSection(out, start, (delta ? schema->sysTabSubPartMapRowIdDelta : schema->sysTabSubPartMapRowId).size());
+
+            start = beginSection(out);
+            for (auto sysTsMapRowIdIt : (delta ? schema->sysTsMapRowIdDelta : schema->sysTsMapRowId)) {
+                SysTs* sysTs = sysTsMapRowIdIt.second;
+                writeRowId(out, sysTs->rowId);
+                write32(out, sysTs->ts);
+                writeString(out, sysTs->name);
+                write32(out, sysTs->blockSize);
+            }
+            endSection(out, start, (delta ? schema->sysTsMapRowIdDelta : schema->sysTsMapRowId).size());
+        }
+
+        ss.write(out.data(), static_cast<std::streamsize>(out.length()));
+
+        // Total length in the header
+        uint64_t length = ss.tellp();
+        char buffer[8];
+        for (uint64_t i = 0; i < sizeof(buffer); ++i)
+            buffer[i] = static_cast<char>((length >> (i * 8)) & 0xFF);
+        ss.seekp(SERIALIZER_BINARY_MAGIC_LENGTH + 8);
+        ss.write(buffer, sizeof(buffer));
+        ss.seekp(0, std::ios_base::end);
+    }
+
+    bool SerializerBinary::deserialize(Metadata* metadata, const std::string& ss, const std::string& fileName, std::list<std::string>& msgs,
+                                       bool loadMetadata, bool loadSchema) {
+        try {
+            if (!isBinary(ss) || ss.length() < SERIALIZER_BINARY_HEADER_LENGTH)
+                throw DataException(20009, "file: " + fileName + " - binary checkpoint invalid header");
+
+            uint64_t pos = SERIALIZER_BINARY_MAGIC_LENGTH;
+            uint32_t version = read32(ss, pos, fileName);
+            if (version != SERIALIZER_BINARY_VERSION)
+                throw DataException(20009, "file: " + fileName + " - binary checkpoint unsupported version: " + std::to_string(version));
+            uint32_t flags = read32(ss, pos, fileName);
+            uint64_t length = read64(ss, pos, fileName);
+            if (length != ss.length())
+                throw DataException(20009, "file: " + fileName + " - binary checkpoint truncated at offset: " + std::to_string(ss.length()));
+
+            std::string database;
+            readString(ss, pos, JSON_PARAMETER_LENGTH, fileName, database);
+            typeScn scn = read64(ss, pos, fileName);
+            typeResetlogs resetlogs = read32(ss, pos, fileName);
+            typeActivation activation = read32(ss, pos, fileName);
+            read32(ss, pos, fileName);
+            typeSeq sequence = read32(ss, pos, fileName);
+            uint64_t offset = read64(ss, pos, fileName);
+            if ((flags & SERIALIZER_BINARY_FLAG_MIN_TRAN) != 0) {
+                sequence = read32(ss, pos, fileName);
+                offset = read64(ss, pos, fileName);
+                read64(ss, pos, fileName);
+            }
+
+            std::string context;
+            std::string conName;
+            std::string dbRecoveryFileDest;
+            std::string dbBlockChecksum;
+            std::string logArchiveDest;
+            std::string logArchiveFormat;
+            std::string nlsCharacterSet;
+            std::string nlsNcharCharacterSet;
+            readString(ss, pos, VCONTEXT_LENGTH, fileName, context);
+            auto conId = static_cast<typeConId>(read16(ss, pos, fileName));
+            readString(ss, pos, VCONTEXT_LENGTH, fileName, conName);
+            readString(ss, pos, VPARAMETER_LENGTH, fileName, dbRecoveryFileDest);
+            readString(ss, pos, VPARAMETER_LENGTH, fileName, dbBlockChecksum);
+            readString(ss, pos, VPARAMETER_LENGTH, fileName, logArchiveDest);
+            readString(ss, pos, VPARAMETER_LENGTH, fileName, logArchiveFormat);
+            readString(ss, pos, VPROPERTY_LENGTH, fileName, nlsCharacterSet);
+            readString(ss, pos, VPROPERTY_LENGTH, fileName, nlsNcharCharacterSet);
+            uint16_t suppLog = read16(ss, pos, fileName);
+
+            {
+                std::unique_lock<std::mutex> lckCheckpoint(metadata->mtxCheckpoint);
+                std::unique_lock<std::mutex> lckSchema(metadata->mtxSchema);
+
+                uint64_t end;
+                uint64_t count = readSection(ss, pos, fileName, end);
+                if (loadMetadata) {
+                    metadata->checkpointScn = scn;
+                    metadata->sequence = sequence;
+                    metadata->offset = offset;
+
+                    if ((metadata->offset & 511) != 0)
+                        throw DataException(20006, "file: " + fileName + " - invalid offset: " + std::to_string(metadata->offset) +
+                                            " is not a multiplication of 512");
+
+                    metadata->minSequence = ZERO_SEQ;
+                    metadata->minOffset = 0;
+                    metadata->minXid = 0;
+                    metadata->lastCheckpointScn = ZERO_SCN;
+                    metadata->lastSequence = ZERO_SEQ;
+                    metadata->lastCheckpointOffset = 0;
+                    metadata->lastCheckpointTime = 0;
+                    metadata->lastCheckpointBytes = 0;
+
+                    if (!metadata->onlineData) {
+                        // Database metadata
+                        metadata->database = database;
+                        metadata->resetlogs = resetlogs;
+                        metadata->activation = activation;
+                        if ((flags & SERIALIZER_BINARY_FLAG_BIG_ENDIAN) != 0)
+                            metadata->ctx->setBigEndian();
+                        metadata->context = context;
+                        metadata->conId = conId;
+                        metadata->conName = conName;
+                        metadata->dbRecoveryFileDest = dbRecoveryFileDest;
+                        metadata->dbBlockChecksum = dbBlockChecksum;
+                        if (!metadata->logArchiveFormatCustom)
+                            metadata->logArchiveFormat = logArchiveFormat;
+                        metadata->logArchiveDest = logArchiveDest;
+                        metadata->nlsCharacterSet = nlsCharacterSet;
+                        metadata->nlsNcharCharacterSet = nlsNcharCharacterSet;
+                        metadata->setNlsCharset(metadata->nlsCharacterSet, metadata->nlsNcharCharacterSet);
+                        metadata->suppLogDbPrimary = (suppLog & 1) != 0;
+                        metadata->suppLogDbAll = (suppLog & 2) != 0;
+
+                        std::string path;
+                        for (uint64_t i = 0; i < count; ++i) {
+                            auto group = static_cast<int64_t>(read64(ss, pos, fileName));
+                            readString(ss, pos, MAX_PATH_LENGTH, fileName, path);
+                            auto redoLog = new RedoLog(group, path.c_str());
+                            metadata->redoLogs.insert(redoLog);
+                        }
+                        checkSection(pos, end, fileName);
+
+                        count = readSection(ss, pos, fileName, end);
+                        std::string status;
+                        for (uint64_t i = 0; i < count; ++i) {
+                            uint32_t incarnation = read32(ss, pos, fileName);
+                            typeScn resetlogsScn = read64(ss, pos, fileName);
+                            typeScn priorResetlogsScn = read64(ss, pos, fileName);
+                            readString(ss, pos, 128, fileName, status);
+                            typeResetlogs incarnationResetlogs = read32(ss, pos, fileName);
+                            uint32_t priorIncarnation = read32(ss, pos, fileName);
+
+                            auto oi = new OracleIncarnation(incarnation, resetlogsScn, priorResetlogsScn,
+                                                            status.c_str(), incarnationResetlogs, priorIncarnation);
+                            metadata->oracleIncarnations.insert(oi);
+
+                            if (oi->current)
+                                metadata->oracleIncarnationCurrent = oi;
+                            else
+                                metadata->oracleIncarnationCurrent = nullptr;
+                        }
+                        checkSection(pos, end, fileName);
+                    } else {
+                        pos = end;
+                        readSection(ss, pos, fileName, end);
+                        pos = end;
+                    }
+
+                    count = readSection(ss, pos, fileName, end);
+                    if ((metadata->ctx->flags & REDO_FLAGS_ADAPTIVE_SCHEMA) == 0) {
+                        std::set<std::string> users;
+                        std::string user;
+                        for (uint64_t i = 0; i < count; ++i) {
+                            readString(ss, pos, SYS_USER_NAME_LENGTH, fileName, user);
+                            users.insert(user);
+                        }
+                        checkSection(pos, end, fileName);
+
+                        for (auto& metadataUser : metadata->users) {
+                            if (users.find(metadataUser) == users.end())
+                                throw DataException(20007, "file: " + fileName + " - " + metadataUser + " is missing");
+                        }
+                        for (auto& metadataUser : users) {
+                            if (metadata->users.find(metadataUser) == metadata->users.end())
+                                throw DataException(20007, "file: " + fileName + " - " + metadataUser + " is redundant");
+                        }
+                    }
+                    pos = end;
+                } else {
+                    // Online redo logs, incarnations and users
+                    pos = end;
+                    readSection(ss, pos, fileName, end);
+                    pos = end;
+                    readSection(ss, pos, fileName, end);
+                    pos = end;
+                }
+
+                if (loadSchema) {
+                    // Schema referenced to other checkpoint file
+                    metadata->schema->deltaPending = false;
+                    if ((flags & SERIALIZER_BINARY_FLAG_SCHEMA) == 0) {
+                        metadata->schema->scn = ZERO_SCN;
+                        metadata->schema->refScn = read64(ss, pos, fileName);
+
+                    } else {
+                        typeScn schemaScn = read64(ss, pos, fileName);
+                        typeScn baseScn = ZERO_SCN;
+                        if ((flags & SERIALIZER_BINARY_FLAG_DELTA) != 0)
+                            baseScn = read64(ss, pos, fileName);
+
+                        // Schema changes which can be applied only on top of the base schema
+                        if (baseScn != ZERO_SCN && metadata->schema->loadedScn != baseScn) {
+                            metadata->schema->scn = ZERO_SCN;
+                            metadata->schema->refScn = baseScn;
+                            metadata->schema->deltaPending = true;
+                        } else {
+                            metadata->schema->scn = schemaScn;
+                            metadata->schema->refScn = ZERO_SCN;
+                            metadata->schema->loadedScn = scn;
+                            if (baseScn != ZERO_SCN)
+                                deserializeDelta(metadata->schema, ss, pos, fileName);
+                            deserializeSchema(metadata->schema, ss, pos, fileName);
+
+                            // Tables affected by the changes are created again
+                            if (baseScn != ZERO_SCN) {
+                                std::list<std::string> msgsDropped;
+                                metadata->schema->dropUnusedMetadata(metadata->users, msgsDropped);
+                            }
+                        }
+                    }
+
+                    if (metadata->ctx->logLevel >= LOG_LEVEL_DEBUG) {
+                        for (SchemaElement* element: metadata->schemaElements)
+                            msgs.push_back("- creating table schema for owner: " + element->owner + " table: " + element->table + " options: " +
+                                           std::to_string(element->options));
+                    }
+                    metadata->schema->buildMaps(metadata->schemaMatcher, msgs, metadata->suppLogDbPrimary, metadata->suppLogDbAll,
+                                                metadata->defaultCharacterMapId, metadata->defaultCharacterNcharMapId);
+
+                    metadata->schema->resetTouched();
+                    metadata->schema->resetDelta();
+                    metadata->schema->loaded = true;
+                    return true;
+                }
+            }
+        } catch (DataException& ex) {
+            metadata->ctx->error(ex.code, ex.msg);
+            return false;
+        }
+        return true;
+    }
+
+    void SerializerBinary::deserializeDelta(Schema* schema, const std::string& ss, uint64_t& pos, const std::string& fileName) {
+        for (uint64_t table = TABLE_SYS_CCOL; table <= TABLE_SYS_USER; ++table) {
+            uint64_t end;
+            uint64_t count = readSection(ss, pos, fileName, end);
+            for (uint64_t i = 0; i < count; ++i)
+                schema->dictSysDropRowId(table, readRowId(ss, pos, fileName));
+            checkSection(pos, end, fileName);
+        }
+    }
+
+    void SerializerBinary::deserializeSchema(Schema* schema, const std::string& ss, uint64_t& pos, const std::string& fileName) {
+        uint64_t end;
+        std::string name;
+
+        uint64_t count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeUser user = read32(ss, pos, fileName);
+            readString(ss, pos, SYS_USER_NAME_LENGTH, fileName, name);
+            uint64_t spare11 = read64(ss, pos, fileName);
+            uint64_t spare12 = read64(ss, pos, fileName);
+            checkLength(ss, pos, 1, fileName);
+            bool single = ss[pos++] != 0;
+
+            schema->dictSysUserAdd(rowId, user, name.c_str(), spare11, spare12, single);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeUser owner = read32(ss, pos, fileName);
+            typeObj obj = read32(ss, pos, fileName);
+            typeDataObj dataObj = read32(ss, pos, fileName);
+            typeType type = read16(ss, pos, fileName);
+            readString(ss, pos, SYS_OBJ_NAME_LENGTH, fileName, name);
+            uint64_t flags1 = read64(ss, pos, fileName);
+            uint64_t flags2 = read64(ss, pos, fileName);
+            checkLength(ss, pos, 1, fileName);
+            bool single = ss[pos++] != 0;
+
+            schema->dictSysObjAdd(rowId, owner, obj, dataObj, type, name.c_str(), flags1, flags2, single);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeObj obj = read32(ss, pos, fileName);
+            auto col = static_cast<typeCol>(read16(ss, pos, fileName));
+            auto segCol = static_cast<typeCol>(read16(ss, pos, fileName));
+            auto intCol = static_cast<typeCol>(read16(ss, pos, fileName));
+            readString(ss, pos, SYS_COL_NAME_LENGTH, fileName, name);
+            typeType type = read16(ss, pos, fileName);
+            uint64_t length = read64(ss, pos, fileName);
+            auto precision = static_cast<int64_t>(read64(ss, pos, fileName));
+            auto scale = static_cast<int64_t>(read64(ss, pos, fileName));
+            uint64_t charsetForm = read64(ss, pos, fileName);
+            uint64_t charsetId = read64(ss, pos, fileName);
+            auto null_ = static_cast<int64_t>(read64(ss, pos, fileName));
+            uint64_t property1 = read64(ss, pos, fileName);
+            uint64_t property2 = read64(ss, pos, fileName);
+
+            schema->dictSysColAdd(rowId, obj, col, segCol, intCol, name.c_str(), type, length, precision, scale, charsetForm, charsetId,
+                                  null_ != 0, property1, property2);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeCon con = read32(ss, pos, fileName);
+            auto intCol = static_cast<typeCol>(read16(ss, pos, fileName));
+            typeObj obj = read32(ss, pos, fileName);
+            uint64_t spare11 = read64(ss, pos, fileName);
+            uint64_t spare12 = read64(ss, pos, fileName);
+
+            schema->dictSysCColAdd(rowId, con, intCol, obj, spare11, spare12);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeCon con = read32(ss, pos, fileName);
+            typeObj obj = read32(ss, pos, fileName);
+            typeType type = read16(ss, pos, fileName);
+
+            schema->dictSysCDefAdd(rowId, con, obj, type);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeObj obj = read32(ss, pos, fileName);
+            uint64_t flagsStg1 = read64(ss, pos, fileName);
+            uint64_t flagsStg2 = read64(ss, pos, fileName);
+
+            schema->dictSysDeferredStgAdd(rowId, obj, flagsStg1, flagsStg2);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeObj tabObj = read32(ss, pos, fileName);
+            auto colNum = static_cast<typeCol>(read16(ss, pos, fileName));
+            auto guardId = static_cast<typeCol>(read16(ss, pos, fileName));
+
+            schema->dictSysEColAdd(rowId, tabObj, colNum, guardId);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeObj obj = read32(ss, pos, fileName);
+            auto col = static_cast<typeCol>(read16(ss, pos, fileName));
+            auto intCol = static_cast<typeCol>(read16(ss, pos, fileName));
+            typeObj lObj = read32(ss, pos, fileName);
+            typeTs ts = read32(ss, pos, fileName);
+
+            schema->dictSysLobAdd(rowId, obj, col, intCol, lObj, ts);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeObj partObj = read32(ss, pos, fileName);
+            typeObj lObj = read32(ss, pos, fileName);
+
+            schema->dictSysLobCompPartAdd(rowId, partObj, lObj);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeObj fragObj = read32(ss, pos, fileName);
+            typeObj parentObj = read32(ss, pos, fileName);
+            typeTs ts = read32(ss, pos, fileName);
+
+            schema->dictSysLobFragAdd(rowId, fragObj, parentObj, ts);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeObj obj = read32(ss, pos, fileName);
+            typeDataObj dataObj = read32(ss, pos, fileName);
+            typeTs ts = read32(ss, pos, fileName);
+            auto cluCols = static_cast<typeCol>(read16(ss, pos, fileName));
+            uint64_t flags1 = read64(ss, pos, fileName);
+            uint64_t flags2 = read64(ss, pos, fileName);
+            uint64_t property1 = read64(ss, pos, fileName);
+            uint64_t property2 = read64(ss, pos, fileName);
+
+            schema->dictSysTabAdd(rowId, obj, dataObj, ts, cluCols, flags1, flags2, property1, property2);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeObj obj = read32(ss, pos, fileName);
+            typeDataObj dataObj = read32(ss, pos, fileName);
+            typeObj bo = read32(ss, pos, fileName);
+
+            schema->dictSysTabPartAdd(rowId, obj, dataObj, bo);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeObj obj = read32(ss, pos, fileName);
+            typeDataObj dataObj = read32(ss, pos, fileName);
+            typeObj bo = read32(ss, pos, fileName);
+
+            schema->dictSysTabComPartAdd(rowId, obj, dataObj, bo);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeObj obj = read32(ss, pos, fileName);
+            typeDataObj dataObj = read32(ss, pos, fileName);
+            typeObj pObj = read32(ss, pos, fileName);
+
+            schema->dictSysTabSubPartAdd(rowId, obj, dataObj, pObj);
+        }
+        checkSection(pos, end, fileName);
+
+        count = readSection(ss, pos, fileName, end);
+        for (uint64_t i = 0; i < count; ++i) {
+            typeRowId rowId = readRowId(ss, pos, fileName);
+            typeTs ts = read32(ss, pos, fileName);
+            readString(ss, pos, SYS_TS_NAME_LENGTH, fileName, name);
+            uint32_t blockSize = read32(ss, pos, fileName);
+
+            schema->dictSysTsAdd(rowId, ts, name.c_str(), blockSize);
+        }
+        checkSection(pos, end, fileName);
+    }
+}
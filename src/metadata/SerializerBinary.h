@@ -0,0 +1,184 @@
+/* Header for SerializerBinary class
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+
+#include "../common/DataException.h"
+#include "../common/MemoryPool.h"
+#include "../common/typeIntX.h"
+#include "../common/typeRowId.h"
+#include "Serializer.h"
+
+#ifndef SERIALIZER_BINARY_H_
+#define SERIALIZER_BINARY_H_
+
+#define SERIALIZER_BINARY_MAGIC                 "OLRCHKPT"
+#define SERIALIZER_BINARY_MAGIC_LENGTH          8
+#define SERIALIZER_BINARY_VERSION               1
+#define SERIALIZER_BINARY_HEADER_LENGTH         24
+#define SERIALIZER_BINARY_FLAG_SCHEMA           0x0001
+#define SERIALIZER_BINARY_FLAG_MIN_TRAN         0x0002
+#define SERIALIZER_BINARY_FLAG_BIG_ENDIAN       0x0004
+#define SERIALIZER_BINARY_FLAG_DELTA            0x0008
+
+namespace OpenLogReplicator {
+    class Schema;
+
+    class SerializerBinary final : public Serializer {
+    protected:
+        // All numbers are stored little-endian, strings are prefixed with 32-bit length
+        static void write16(std::string& out, uint16_t value) {
+            char buffer[2] = {static_cast<char>(value & 0xFF), static_cast<char>(value >> 8)};
+            out.append(buffer, sizeof(buffer));
+        }
+
+        static void write32(std::string& out, uint32_t value) {
+            char buffer[4];
+            for (uint64_t i = 0; i < sizeof(buffer); ++i)
+                buffer[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+            out.append(buffer, sizeof(buffer));
+        }
+
+        static void write64(std::string& out, uint64_t value) {
+            char buffer[8];
+            for (uint64_t i = 0; i < sizeof(buffer); ++i)
+                buffer[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+            out.append(buffer, sizeof(buffer));
+        }
+
+        static void writeString(std::string& out, const std::string& value) {
+            write32(out, value.length());
+            out.append(value);
+        }
+
+        static void writeRowId(std::string& out, const typeRowId& rowId) {
+            write32(out, rowId.dataObj);
+            write32(out, rowId.dba);
+            write16(out, rowId.slot);
+        }
+
+        static void writeIntX(std::string& out, const typeIntX& value) {
+            write64(out, value.getData(0));
+            write64(out, value.getData(1));
+        }
+
+        static uint64_t beginSection(std::string& out) {
+            // Element count and length in bytes, filled by endSection()
+            uint64_t start = out.length();
+            out.append(16, '\0');
+            return start;
+        }
+
+        static void endSection(std::string& out, uint64_t start, uint64_t count) {
+            uint64_t length = out.length() - start - 16;
+            for (uint64_t i = 0; i < 8; ++i) {
+                out[start + i] = static_cast<char>((count >> (i * 8)) & 0xFF);
+                out[start + 8 + i] = static_cast<char>((length >> (i * 8)) & 0xFF);
+            }
+        }
+
+        // Rows to remove before a delta is applied, changed rows are replaced as a whole
+        template<class T>
+        static void writeDropped(std::string& out, const PoolMap<typeRowId, T*>& changed, const std::set<typeRowId>& dropped) {
+            uint64_t start = beginSection(out);
+            for (const auto& changedIt : changed)
+                writeRowId(out, changedIt.first);
+            for (const typeRowId& rowId : dropped)
+                writeRowId(out, rowId);
+            endSection(out, start, changed.size() + dropped.size());
+        }
+
+        static void checkLength(const std::string& in, uint64_t pos, uint64_t length, const std::string& fileName) {
+            if (pos + length > in.length())
+                throw DataException(20009, "file: " + fileName + " - binary checkpoint truncated at offset: " + std::to_string(pos));
+        }
+
+        static uint16_t read16(const std::string& in, uint64_t& pos, const std::string& fileName) {
+            checkLength(in, pos, 2, fileName);
+            auto data = reinterpret_cast<const uint8_t*>(in.data() + pos);
+            pos += 2;
+            return static_cast<uint16_t>(data[0]) | (static_cast<uint16_t>(data[1]) << 8);
+        }
+
+        static uint32_t read32(const std::string& in, uint64_t& pos, const std::string& fileName) {
+            checkLength(in, pos, 4, fileName);
+            auto data = reinterpret_cast<const uint8_t*>(in.data() + pos);
+            pos += 4;
+            return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) | (static_cast<uint32_t>(data[2]) << 16) |
+                    (static_cast<uint32_t>(data[3]) << 24);
+        }
+
+        static uint64_t read64(const std::string& in, uint64_t& pos, const std::string& fileName) {
+            uint64_t low = read32(in, pos, fileName);
+            uint64_t high = read32(in, pos, fileName);
+            return low | (high << 32);
+        }
+
+        static void readString(const std::string& in, uint64_t& pos, uint64_t maxLength, const std::string& fileName, std::string& value) {
+            uint32_t length = read32(in, pos, fileName);
+            if (length > maxLength)
+                throw DataException(20009, "file: " + fileName + " - binary checkpoint string too long: " + std::to_string(length) +
+                                    " at offset: " + std::to_string(pos));
+            checkLength(in, pos, length, fileName);
+            value.assign(in.data() + pos, length);
+            pos += length;
+        }
+
+        static typeRowId readRowId(const std::string& in, uint64_t& pos, const std::string& fileName) {
+            typeDataObj dataObj = read32(in, pos, fileName);
+            typeDba dba = read32(in, pos, fileName);
+            typeSlot slot = read16(in, pos, fileName);
+            return typeRowId(dataObj, dba, slot);
+        }
+
+        static uint64_t readSection(const std::string& in, uint64_t& pos, const std::string& fileName, uint64_t& end) {
+            uint64_t count = read64(in, pos, fileName);
+            uint64_t length = read64(in, pos, fileName);
+            checkLength(in, pos, length, fileName);
+            end = pos + length;
+            return count;
+        }
+
+        static void checkSection(uint64_t pos, uint64_t end, const std::string& fileName) {
+            if (pos != end)
+                throw DataException(20009, "file: " + fileName + " - binary checkpoint section length mismatch at offset: " + std::to_string(pos));
+        }
+
+        void deserializeSchema(Schema* schema, const std::string& ss, uint64_t& pos, const std::string& fileName);
+        void deserializeDelta(Schema* schema, const std::string& ss, uint64_t& pos, const std::string& fileName);
+
+    public:
+        SerializerBinary();
+        ~SerializerBinary() override;
+
+        static bool isBinary(const std::string& ss) {
+            return ss.length() >= SERIALIZER_BINARY_MAGIC_LENGTH && memcmp(ss.data(), SERIALIZER_BINARY_MAGIC, SERIALIZER_BINARY_MAGIC_LENGTH) == 0;
+        }
+
+        [[nodiscard]] bool deserialize(Metadata* metadata, const std::string& ss, const std::string& fileName, std::list<std::string>& msgs,
+                                       bool loadMetadata, bool storeSchema) override;
+        void serialize(Metadata* metadata, std::ostringstream& ss, uint64_t schemaMode) override;
+        void serializeSchema(Metadata* metadata, std::ostringstream& ss, uint64_t schemaMode) override;
+    };
+}
+
+#endif
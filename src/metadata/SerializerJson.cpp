@@ -42,6 +42,9 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "SerializerJson.h"
 
 namespace OpenLogReplicator {
+    const char* SerializerJson::sysTables[TABLE_SYS_USER + 1] = {"", "sys-ccol", "sys-cdef", "sys-col", "sys-deferredstg", "sys-ecol", "sys-lob",
+                                                                 "sys-lob-comp-part", "sys-lob-frag", "sys-obj", "sys-tab", "sys-tabpart",
+                                                                 "sys-tabcompart", "sys-tabsubpart", "sys-ts", "sys-user"};
 
     SerializerJson::SerializerJson() :
             Serializer() {
@@ -49,8 +52,8 @@ namespace OpenLogReplicator {
 
     SerializerJson::~SerializerJson() = default;
 
-    void SerializerJson::serialize(Metadata* metadata, std::ostringstream& ss, bool storeSchema) {
-        // Assuming the caller holds all locks
+    void SerializerJson::serialize(Metadata* metadata, std::ostringstream& ss, uint64_t schemaMode __attribute__((unused))) {
+        // Assuming the caller holds the checkpoint lock
         ss << R"({"database":")";
         Ctx::writeEscapeValue(ss, metadata->database);
         ss << R"(","scn":)" << std::dec << metadata->checkpointScn <<
@@ -136,20 +139,29 @@ namespace OpenLogReplicator {
         }
 
         ss << "]," SERIALIZER_ENDL;
+    }
+
+    void SerializerJson::serializeSchema(Metadata* metadata, std::ostringstream& ss, uint64_t schemaMode) {
+        // Assuming the caller holds the schema lock
+        bool hasPrev;
 
         // Schema did not change since the last checkpoint file
-        if (!storeSchema) {
+        if (schemaMode == SERIALIZER_SCHEMA_NONE) {
             ss << R"("schema-ref-scn":)" << metadata->schema->refScn << "}";
             return;
         }
 
-        metadata->schema->refScn = metadata->checkpointScn;
+        // Only rows changed since the checkpoint file with the previous schema
+        bool delta = (schemaMode == SERIALIZER_SCHEMA_DELTA);
+        if (delta)
+            ss << R"("schema-base-scn":)" << metadata->schema->refScn << ",";
+
         ss << R"("schema-scn":)" << metadata->schema->scn << "," SERIALIZER_ENDL;
 
         // SYS.CCOL$
         ss << R"("sys-ccol":[)";
         hasPrev = false;
-        for (auto sysCColMapRowIdIt : metadata->schema->sysCColMapRowId) {
+        for (auto sysCColMapRowIdIt : (delta ? metadata->schema->sysCColMapRowIdDelta : metadata->schema->sysCColMapRowId)) {
             SysCCol* sysCCol = sysCColMapRowIdIt.second;
 
             if (hasPrev)
@@ -167,7 +179,7 @@ namespace OpenLogReplicator {
         // SYS.CDEF$
         ss << "]," SERIALIZER_ENDL << R"("sys-cdef":[)";
         hasPrev = false;
-        for (auto sysCDefMapRowIdIt : metadata->schema->sysCDefMapRowId) {
+        for (auto sysCDefMapRowIdIt : (delta ? metadata->schema->sysCDefMapRowIdDelta : metadata->schema->sysCDefMapRowId)) {
             SysCDef* sysCDef = sysCDefMapRowIdIt.second;
 
             if (hasPrev)
@@ -184,7 +196,7 @@ namespace OpenLogReplicator {
         // SYS.COL$
         ss << "]," SERIALIZER_ENDL << R"("sys-col":[)";
         hasPrev = false;
-        for (auto sysColMapRowIdIt : metadata->schema->sysColMapRowId) {
+        for (auto sysColMapRowIdIt : (delta ? metadata->schema->sysColMapRowIdDelta : metadata->schema->sysColMapRowId)) {
             SysCol* sysCol = sysColMapRowIdIt.second;
 
             if (hasPrev)
@@ -212,7 +224,7 @@ namespace OpenLogReplicator {
         // SYS.DEFERRED_STG$
         ss << "]," SERIALIZER_ENDL << R"("sys-deferredstg":[)";
         hasPrev = false;
-        for (auto sysDeferredStgMapRowIdIt : metadata->schema->sysDeferredStgMapRowId) {
+        for (auto sysDeferredStgMapRowIdIt : (delta ? metadata->schema->sysDeferredStgMapRowIdDelta : metadata->schema->sysDeferredStgMapRowId)) {
             SysDeferredStg* sysDeferredStg = sysDeferredStgMapRowIdIt.second;
 
             if (hasPrev)
@@ -228,7 +240,7 @@ namespace OpenLogReplicator {
         // SYS.ECOL$
         ss << "]," SERIALIZER_ENDL << R"("sys-ecol":[)";
         hasPrev = false;
-        for (auto sysEColMapRowIdIt : metadata->schema->sysEColMapRowId) {
+        for (auto sysEColMapRowIdIt : (delta ? metadata->schema->sysEColMapRowIdDelta : metadata->schema->sysEColMapRowId)) {
             SysECol* sysECol = sysEColMapRowIdIt.second;
 
             if (hasPrev)
@@ -245,7 +257,7 @@ namespace OpenLogReplicator {
         // SYS.LOB$
         ss << "]," SERIALIZER_ENDL << R"("sys-lob":[)";
         hasPrev = false;
-        for (auto sysLobMapRowIdIt : metadata->schema->sysLobMapRowId) {
+        for (auto sysLobMapRowIdIt : (delta ? metadata->schema->sysLobMapRowIdDelta : metadata->schema->sysLobMapRowId)) {
             SysLob* sysLob = sysLobMapRowIdIt.second;
 
             if (hasPrev)
@@ -264,7 +276,7 @@ namespace OpenLogReplicator {
         // SYS.LOBCOMPPART$
         ss << "]," SERIALIZER_ENDL << R"("sys-lob-comp-part":[)";
         hasPrev = false;
-        for (auto sysLobCompPartMapRowIdIt : metadata->schema->sysLobCompPartMapRowId) {
+        for (auto sysLobCompPartMapRowIdIt : (delta ? metadata->schema->sysLobCompPartMapRowIdDelta : metadata->schema->sysLobCompPartMapRowId)) {
             SysLobCompPart* sysLobCompPart = sysLobCompPartMapRowIdIt.second;
 
             if (hasPrev)
@@ -280,7 +292,7 @@ namespace OpenLogReplicator {
         // SYS.LOBFRAG$
         ss << "]," SERIALIZER_ENDL << R"("sys-lob-frag":[)";
         hasPrev = false;
-        for (auto sysLobFragMapRowIdIt : metadata->schema->sysLobFragMapRowId) {
+        for (auto sysLobFragMapRowIdIt : (delta ? metadata->schema->sysLobFragMapRowIdDelta : metadata->schema->sysLobFragMapRowId)) {
             SysLobFrag* sysLobFrag = sysLobFragMapRowIdIt.second;
 
             if (hasPrev)
@@ -297,7 +309,7 @@ namespace OpenLogReplicator {
         // SYS.OBJ$
         ss << "]," SERIALIZER_ENDL << R"("sys-obj":[)";
         hasPrev = false;
-        for (auto sysObjMapRowIdIt : metadata->schema->sysObjMapRowId) {
+        for (auto sysObjMapRowIdIt : (delta ? metadata->schema->sysObjMapRowIdDelta : metadata->schema->sysObjMapRowId)) {
             SysObj* sysObj = sysObjMapRowIdIt.second;
 
             if (hasPrev)
@@ -319,7 +331,7 @@ namespace OpenLogReplicator {
         // SYS.TAB$
         ss << "]," SERIALIZER_ENDL << R"("sys-tab":[)";
         hasPrev = false;
-        for (auto sysTabMapRowIdIt : metadata->schema->sysTabMapRowId) {
+        for (auto sysTabMapRowIdIt : (delta ? metadata->schema->sysTabMapRowIdDelta : metadata->schema->sysTabMapRowId)) {
             SysTab* sysTab = sysTabMapRowIdIt.second;
 
             if (hasPrev)
@@ -339,7 +351,7 @@ namespace OpenLogReplicator {
         // SYS.TABCOMPART$
         ss << "]," SERIALIZER_ENDL << R"("sys-tabcompart":[)";
         hasPrev = false;
-        for (auto sysTabComPartMapRowIdIt : metadata->schema->sysTabComPartMapRowId) {
+        for (auto sysTabComPartMapRowIdIt : (delta ? metadata->schema->sysTabComPartMapRowIdDelta : metadata->schema->sysTabComPartMapRowId)) {
             SysTabComPart* sysTabComPart = sysTabComPartMapRowIdIt.second;
 
             if (hasPrev)
@@ -356,7 +368,7 @@ namespace OpenLogReplicator {
         // SYS.TABPART$
         ss << "]," SERIALIZER_ENDL << R"("sys-tabpart":[)";
         hasPrev = false;
-        for (auto sysTabPartMapRowIdIt : metadata->schema->sysTabPartMapRowId) {
+        for (auto sysTabPartMapRowIdIt : (delta ? metadata->schema->sysTabPartMapRowIdDelta : metadata->schema->sysTabPartMapRowId)) {
             SysTabPart* sysTabPart = sysTabPartMapRowIdIt.second;
 
             if (hasPrev)
@@ -373,7 +385,7 @@ namespace OpenLogReplicator {
         // SYS.TABSUBPART$
         ss << "]," SERIALIZER_ENDL << R"("sys-tabsubpart":[)";
         hasPrev = false;
-        for (auto sysTabSubPartMapRowIdIt : metadata->schema->sysTabSubPartMapRowId) {
+        for (auto sysTabSubPartMapRowIdIt : (delta ? metadata->schema->sysTabSubPartMapRowIdDelta : metadata->schema->sysTabSubPartMapRowId)) {
             SysTabSubPart* sysTabSubPart = sysTabSubPartMapRowIdIt.second;
 
             if (hasPrev)
@@ -390,7 +402,7 @@ namespace OpenLogReplicator {
         // SYS.TS$
         ss << "]," SERIALIZER_ENDL << R"("sys-ts":[)";
         hasPrev = false;
-        for (auto sysTsMapRowIdIt : metadata->schema->sysTsMapRowId) {
+        for (auto sysTsMapRowIdIt : (delta ? metadata->schema->sysTsMapRowIdDelta : metadata->schema->sysTsMapRowId)) {
             SysTs* sysTs = sysTsMapRowIdIt.second;
 
             if (hasPrev)
@@ -408,7 +420,7 @@ namespace OpenLogReplicator {
         // SYS.USER$
         ss << "]," SERIALIZER_ENDL << R"("sys-user":[)";
         hasPrev = false;
-        for (auto sysUserMapRowIdIt : metadata->schema->sysUserMapRowId) {
+        for (auto sysUserMapRowIdIt : (delta ? metadata->schema->sysUserMapRowIdDelta : metadata->schema->sysUserMapRowId)) {
             SysUser* sysUser = sysUserMapRowIdIt.second;
 
             if (hasPrev)
@@ -423,8 +435,25 @@ namespace OpenLogReplicator {
             ss << R"(","spare1":)" << std::dec << sysUser->spare1.toString() <<
                     R"(,"single":)" << std::dec << static_cast<uint64_t>(sysUser->single) << "}";
         }
+        ss << "]";
+
+        if (delta) {
+            for (uint64_t table = TABLE_SYS_CCOL; table <= TABLE_SYS_USER; ++table) {
+                ss << "," SERIALIZER_ENDL << R"(")" << sysTables[table] << R"(-dropped":[)";
+                hasPrev = false;
+                for (typeRowId rowId : metadata->schema->deltaDropped[table]) {
+                    if (hasPrev)
+                        ss << ",";
+                    else
+                        hasPrev = true;
+
+                    ss << R"(")" << rowId << R"(")";
+                }
+                ss << "]";
+            }
+        }
 
-        ss << "]}";
+        ss << "}";
     }
 
     bool SerializerJson::deserialize(Metadata* metadata, const std::string& ss, const std::string& fileName, std::list<std::string>& msgs, bool loadMetadata,
@@ -540,14 +569,27 @@ namespace OpenLogReplicator {
                 }
 
                 if (loadSchema) {
+                    bool delta = document.HasMember("schema-base-scn");
+                    metadata->schema->deltaPending = false;
+
                     // Schema referenced to other checkpoint file
                     if (document.HasMember("schema-ref-scn")) {
                         metadata->schema->scn = ZERO_SCN;
                         metadata->schema->refScn = Ctx::getJsonFieldU64(fileName, document, "schema-ref-scn");
 
+                    // Schema changes which can be applied only on top of the base schema
+                    } else if (delta && metadata->schema->loadedScn != Ctx::getJsonFieldU64(fileName, document, "schema-base-scn")) {
+                        metadata->schema->scn = ZERO_SCN;
+                        metadata->schema->refScn = Ctx::getJsonFieldU64(fileName, document, "schema-base-scn");
+                        metadata->schema->deltaPending = true;
+
                     } else {
                         metadata->schema->scn = Ctx::getJsonFieldU64(fileName, document, "schema-scn");
                         metadata->schema->refScn = ZERO_SCN;
+                        metadata->schema->loadedScn = Ctx::getJsonFieldU64(fileName, document, "scn");
+
+                        if (delta)
+                            deserializeDelta(metadata, fileName, document);
 
                         deserializeSysUser(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-user"));
                         deserializeSysObj(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-obj"));
@@ -564,19 +606,24 @@ namespace OpenLogReplicator {
                         deserializeSysTabComPart(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-tabcompart"));
                         deserializeSysTabSubPart(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-tabsubpart"));
                         deserializeSysTs(metadata, fileName, Ctx::getJsonFieldA(fileName, document, "sys-ts"));
+
+                        // Tables affected by the changes are created again
+                        if (delta) {
+                            std::list<std::string> msgsDropped;
+                            metadata->schema->dropUnusedMetadata(metadata->users, msgsDropped);
+                        }
                     }
 
-                    for (SchemaElement* element: metadata->schemaElements) {
-                        if (metadata->ctx->logLevel >= LOG_LEVEL_DEBUG)
+                    if (metadata->ctx->logLevel >= LOG_LEVEL_DEBUG) {
+                        for (SchemaElement* element: metadata->schemaElements)
                             msgs.push_back("- creating table schema for owner: " + element->owner + " table: " + element->table + " options: " +
                                            std::to_string(element->options));
-
-                        metadata->schema->buildMaps(element->owner, element->table, element->keys, element->keysStr, element->options, msgs,
-                                                    metadata->suppLogDbPrimary, metadata->suppLogDbAll, metadata->defaultCharacterMapId,
-                                                    metadata->defaultCharacterNcharMapId);
                     }
+                    metadata->schema->buildMaps(metadata->schemaMatcher, msgs, metadata->suppLogDbPrimary, metadata->suppLogDbAll,
+                                                metadata->defaultCharacterMapId, metadata->defaultCharacterNcharMapId);
 
                     metadata->schema->resetTouched();
+                    metadata->schema->resetDelta();
                     metadata->schema->loaded = true;
                     return true;
                 }
@@ -588,6 +635,20 @@ namespace OpenLogReplicator {
         return true;
     }
 
+    void SerializerJson::deserializeDelta(Metadata* metadata, const std::string& fileName, const rapidjson::Value& document) {
+        for (uint64_t table = TABLE_SYS_CCOL; table <= TABLE_SYS_USER; ++table) {
+            // Changed rows replace the previous version
+            const rapidjson::Value& sysJson = Ctx::getJsonFieldA(fileName, document, sysTables[table]);
+            for (rapidjson::SizeType i = 0; i < sysJson.Size(); ++i)
+                metadata->schema->dictSysDropRowId(table, typeRowId(Ctx::getJsonFieldS(fileName, ROWID_LENGTH, sysJson[i], "row-id")));
+
+            std::string droppedName(std::string(sysTables[table]) + "-dropped");
+            const rapidjson::Value& droppedJson = Ctx::getJsonFieldA(fileName, document, droppedName.c_str());
+            for (rapidjson::SizeType i = 0; i < droppedJson.Size(); ++i)
+                metadata->schema->dictSysDropRowId(table, typeRowId(Ctx::getJsonFieldS(fileName, ROWID_LENGTH, droppedJson, droppedName.c_str(), i)));
+        }
+    }
+
     void SerializerJson::deserializeSysCCol(Metadata* metadata, const std::string& fileName, const rapidjson::Value& sysCColJson) {
         for (rapidjson::SizeType i = 0; i < sysCColJson.Size(); ++i) {
             const char* rowId = Ctx::getJsonFieldS(fileName, ROWID_LENGTH, sysCColJson[i], "row-id");
@@ -600,7 +661,7 @@ namespace OpenLogReplicator {
             uint64_t spare11 = Ctx::getJsonFieldU64(fileName, spare1Json, "spare1", 0);
             uint64_t spare12 = Ctx::getJsonFieldU64(fileName, spare1Json, "spare1", 1);
 
-            metadata->schema->dictSysCColAdd(rowId, con, intCol, obj, spare11, spare12);
+            metadata->schema->dictSysCColAdd(typeRowId(rowId), con, intCol, obj, spare11, spare12);
         }
     }
 
@@ -611,7 +672,7 @@ namespace OpenLogReplicator {
             typeObj obj = Ctx::getJsonFieldU32(fileName, sysCDefJson[i], "obj");
             typeType type = Ctx::getJsonFieldU16(fileName, sysCDefJson[i], "type");
 
-            metadata->schema->dictSysCDefAdd(rowId, con, obj, type);
+            metadata->schema->dictSysCDefAdd(typeRowId(rowId), con, obj, type);
         }
     }
 
@@ -636,7 +697,7 @@ namespace OpenLogReplicator {
             uint64_t property1 = Ctx::getJsonFieldU64(fileName, propertyJson, "property", 0);
             uint64_t property2 = Ctx::getJsonFieldU64(fileName, propertyJson, "property", 1);
 
-            metadata->schema->dictSysColAdd(rowId, obj, col, segCol, intCol, name_, type, length, precision, scale, charsetForm, charsetId,
+            metadata->schema->dictSysColAdd(typeRowId(rowId), obj, col, segCol, intCol, name_, type, length, precision, scale, charsetForm, charsetId,
                                             null_ != 0, property1, property2);
         }
     }
@@ -652,7 +713,7 @@ namespace OpenLogReplicator {
             uint64_t flagsStg1 = Ctx::getJsonFieldU64(fileName, flagsStgJson, "flags-stg", 0);
             uint64_t flagsStg2 = Ctx::getJsonFieldU64(fileName, flagsStgJson, "flags-stg", 1);
 
-            metadata->schema->dictSysDeferredStgAdd(rowId, obj, flagsStg1, flagsStg2);
+            metadata->schema->dictSysDeferredStgAdd(typeRowId(rowId), obj, flagsStg1, flagsStg2);
         }
     }
 
@@ -663,7 +724,7 @@ namespace OpenLogReplicator {
             typeCol colNum = Ctx::getJsonFieldI16(fileName, sysEColJson[i], "col-num");
             typeCol guardId = Ctx::getJsonFieldI16(fileName, sysEColJson[i], "guard-id");
 
-            metadata->schema->dictSysEColAdd(rowId, obj, colNum, guardId);
+            metadata->schema->dictSysEColAdd(typeRowId(rowId), obj, colNum, guardId);
         }
     }
 
@@ -676,7 +737,7 @@ namespace OpenLogReplicator {
             typeObj lObj = Ctx::getJsonFieldU32(fileName, sysLobJson[i], "l-obj");
             uint32_t ts = Ctx::getJsonFieldU32(fileName, sysLobJson[i], "ts");
 
-            metadata->schema->dictSysLobAdd(rowId, obj, col, intCol, lObj, ts);
+            metadata->schema->dictSysLobAdd(typeRowId(rowId), obj, col, intCol, lObj, ts);
         }
     }
 
@@ -686,7 +747,7 @@ namespace OpenLogReplicator {
             typeObj partObj = Ctx::getJsonFieldU32(fileName, sysLobCompPartJson[i], "part-obj");
             typeObj lObj = Ctx::getJsonFieldU32(fileName, sysLobCompPartJson[i], "l-obj");
 
-            metadata->schema->dictSysLobCompPartAdd(rowId, partObj, lObj);
+            metadata->schema->dictSysLobCompPartAdd(typeRowId(rowId), partObj, lObj);
         }
     }
 
@@ -697,7 +758,7 @@ namespace OpenLogReplicator {
             typeObj parentObj = Ctx::getJsonFieldU32(fileName, sysLobFragJson[i], "parent-obj");
             uint32_t ts = Ctx::getJsonFieldU32(fileName, sysLobFragJson[i], "ts");
 
-            metadata->schema->dictSysLobFragAdd(rowId, fragObj, parentObj, ts);
+            metadata->schema->dictSysLobFragAdd(typeRowId(rowId), fragObj, parentObj, ts);
         }
     }
 
@@ -717,7 +778,7 @@ namespace OpenLogReplicator {
             uint64_t flags2 = Ctx::getJsonFieldU64(fileName, flagsJson, "flags", 1);
             uint64_t single = Ctx::getJsonFieldU64(fileName, sysObjJson[i], "single");
 
-            metadata->schema->dictSysObjAdd(rowId, owner, obj, dataObj, type, name_, flags1, flags2, single != 0u);
+            metadata->schema->dictSysObjAdd(typeRowId(rowId), owner, obj, dataObj, type, name_, flags1, flags2, single != 0u);
         }
     }
 
@@ -744,7 +805,7 @@ namespace OpenLogReplicator {
             uint64_t property1 = Ctx::getJsonFieldU64(fileName, propertyJson, "property", 0);
             uint64_t property2 = Ctx::getJsonFieldU64(fileName, propertyJson, "property", 1);
 
-            metadata->schema->dictSysTabAdd(rowId, obj, dataObj, ts, cluCols, flags1, flags2, property1, property2);
+            metadata->schema->dictSysTabAdd(typeRowId(rowId), obj, dataObj, ts, cluCols, flags1, flags2, property1, property2);
         }
     }
 
@@ -755,7 +816,7 @@ namespace OpenLogReplicator {
             typeDataObj dataObj = Ctx::getJsonFieldU32(fileName, sysTabComPartJson[i], "data-obj");
             typeObj bo = Ctx::getJsonFieldU32(fileName, sysTabComPartJson[i], "bo");
 
-            metadata->schema->dictSysTabComPartAdd(rowId, obj, dataObj, bo);
+            metadata->schema->dictSysTabComPartAdd(typeRowId(rowId), obj, dataObj, bo);
         }
     }
 
@@ -766,7 +827,7 @@ namespace OpenLogReplicator {
             typeDataObj dataObj = Ctx::getJsonFieldU32(fileName, sysTabPartJson[i], "data-obj");
             typeObj bo = Ctx::getJsonFieldU32(fileName, sysTabPartJson[i], "bo");
 
-            metadata->schema->dictSysTabPartAdd(rowId, obj, dataObj, bo);
+            metadata->schema->dictSysTabPartAdd(typeRowId(rowId), obj, dataObj, bo);
         }
     }
 
@@ -777,7 +838,7 @@ namespace OpenLogReplicator {
             typeDataObj dataObj = Ctx::getJsonFieldU32(fileName, sysTabSubPartJson[i], "data-obj");
             typeObj pObj = Ctx::getJsonFieldU32(fileName, sysTabSubPartJson[i], "p-obj");
 
-            metadata->schema->dictSysTabSubPartAdd(rowId, obj, dataObj, pObj);
+            metadata->schema->dictSysTabSubPartAdd(typeRowId(rowId), obj, dataObj, pObj);
         }
     }
 
@@ -788,7 +849,7 @@ namespace OpenLogReplicator {
             const char* name_ = Ctx::getJsonFieldS(fileName, SYS_TS_NAME_LENGTH, sysTsJson[i], "name");
             uint32_t blockSize = Ctx::getJsonFieldU32(fileName, sysTsJson[i], "block-size");
 
-            metadata->schema->dictSysTsAdd(rowId, ts, name_, blockSize);
+            metadata->schema->dictSysTsAdd(typeRowId(rowId), ts, name_, blockSize);
         }
     }
 
@@ -805,7 +866,7 @@ namespace OpenLogReplicator {
             uint64_t spare12 = Ctx::getJsonFieldU64(fileName, spare1Json, "spare1", 1);
             uint64_t single = Ctx::getJsonFieldU64(fileName, sysUserJson[i], "single");
 
-            metadata->schema->dictSysUserAdd(rowId, user, name_, spare11, spare12, single != 0u);
+            metadata->schema->dictSysUserAdd(typeRowId(rowId), user, name_, spare11, spare12, single != 0u);
         }
     }
 }
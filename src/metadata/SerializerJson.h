@@ -32,6 +32,9 @@ namespace OpenLogReplicator {
 
     class SerializerJson final : public Serializer {
     protected:
+        static const char* sysTables[TABLE_SYS_USER + 1];
+
+        void deserializeDelta(Metadata* metadata, const std::string& fileName, const rapidjson::Value& document);
         void deserializeSysCCol(Metadata* metadata, const std::string& fileName, const rapidjson::Value& sysCColJson);
         void deserializeSysCDef(Metadata* metadata, const std::string& fileName, const rapidjson::Value& sysCDefJson);
         void deserializeSysCol(Metadata* metadata, const std::string& fileName, const rapidjson::Value& sysColJson);
@@ -54,7 +57,8 @@ namespace OpenLogReplicator {
 
         [[nodiscard]] bool deserialize(Metadata* metadata, const std::string& ss, const std::string& fileName, std::list<std::string>& msgs,
                                        bool loadMetadata, bool storeSchema) override;
-        void serialize(Metadata* metadata, std::ostringstream& ss, bool noSchema) override;
+        void serialize(Metadata* metadata, std::ostringstream& ss, uint64_t schemaMode) override;
+        void serializeSchema(Metadata* metadata, std::ostringstream& ss, uint64_t schemaMode) override;
     };
 }
 
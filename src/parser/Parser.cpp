@@ -76,7 +76,7 @@ namespace OpenLogReplicator {
 
         memset(reinterpret_cast<void*>(&zero), 0, sizeof(RedoLogRecord));
 
-        lwnChunks[0] = ctx->getMemoryChunk("parser", false);
+        lwnChunks[0] = ctx->getMemoryChunk(MEMORY_MODULE_PARSER, false);
         auto length = reinterpret_cast<uint64_t*>(lwnChunks[0]);
         *length = sizeof(uint64_t);
         lwnAllocated = 1;
@@ -85,13 +85,13 @@ namespace OpenLogReplicator {
 
     Parser::~Parser() {
         while (lwnAllocated > 0) {
-            ctx->freeMemoryChunk("parser", lwnChunks[--lwnAllocated], false);
+            ctx->freeMemoryChunk(MEMORY_MODULE_PARSER, lwnChunks[--lwnAllocated], false);
         }
     }
 
     void Parser::freeLwn() {
         while (lwnAllocated > 1) {
-            ctx->freeMemoryChunk("parser", lwnChunks[--lwnAllocated], false);
+            ctx->freeMemoryChunk(MEMORY_MODULE_PARSER, lwnChunks[--lwnAllocated], false);
         }
 
         auto length = reinterpret_cast<uint64_t*>(lwnChunks[0]);
@@ -1323,7 +1323,7 @@ namespace OpenLogReplicator {
                                 if (lwnAllocated == MAX_LWN_CHUNKS)
                                     throw RedoLogException(50052, "all " + std::to_string(MAX_LWN_CHUNKS) + " lwn buffers allocated");
 
-                                lwnChunks[lwnAllocated++] = ctx->getMemoryChunk("parser", false);
+                                lwnChunks[lwnAllocated++] = ctx->getMemoryChunk(MEMORY_MODULE_PARSER, false);
                                 if (lwnAllocated > lwnAllocatedMax)
                                     lwnAllocatedMax = lwnAllocated;
                                 length = reinterpret_cast<uint64_t*>(lwnChunks[lwnAllocated - 1]);
@@ -1439,6 +1439,9 @@ namespace OpenLogReplicator {
                     freeLwn();
                     lwnRecords = 0;
                     lwnConfirmedBlock = currentBlock;
+
+                    // Output not yet sent by the writers is over the quota - wait before parsing more
+                    ctx->throttleModule(MEMORY_MODULE_BUILDER);
                 } else if (lwnNumCnt > lwnNumMax)
                     throw RedoLogException(50055, "lwn overflow: " + std::to_string(lwnNumCnt) + "/" + std::to_string(lwnNumMax));
 
@@ -37,7 +37,7 @@ namespace OpenLogReplicator {
                                        "OTHER ERROR"};
 
     Reader::Reader(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, int64_t newGroup, bool newConfiguredBlockSum) :
-        Thread(newCtx, newAlias),
+        Thread(newCtx, newAlias, THREAD_ROLE_READER),
         ctx(newCtx),
         database(newDatabase),
         fileCopyDes(-1),
@@ -72,6 +72,7 @@ namespace OpenLogReplicator {
         status(READER_STATUS_SLEEPING),
         ret(REDO_OK),
         redoBufferList(nullptr) {
+        threadName += "-" + std::to_string(group);
     }
 
     void Reader::initialize() {
@@ -756,6 +757,7 @@ namespace OpenLogReplicator {
             ss << std::this_thread::get_id();
             ctx->logTrace(TRACE_THREADS, "reader (" + ss.str() + ") start");
         }
+        ctx->bindNumaNode(ctx->numaNodeReader, THREAD_ROLE_READER);
 
         try {
             mainLoop();
@@ -782,7 +784,7 @@ namespace OpenLogReplicator {
 
     void Reader::bufferAllocate(uint64_t num) {
         if (redoBufferList[num] == nullptr) {
-            redoBufferList[num] = ctx->getMemoryChunk("reader", false);
+            redoBufferList[num] = ctx->getMemoryChunk(MEMORY_MODULE_READER, false);
             if (ctx->buffersFree == 0)
                 throw RuntimeException(10016, "couldn't allocate " + std::to_string(MEMORY_CHUNK_SIZE) +
                                        " bytes memory for: read buffer");
@@ -793,7 +795,7 @@ namespace OpenLogReplicator {
 
     void Reader::bufferFree(uint64_t num) {
         if (redoBufferList[num] != nullptr) {
-            ctx->freeMemoryChunk("reader", redoBufferList[num], false);
+            ctx->freeMemoryChunk(MEMORY_MODULE_READER, redoBufferList[num], false);
             redoBufferList[num] = nullptr;
             ctx->releaseBuffer();
         }
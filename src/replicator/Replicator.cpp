@@ -42,7 +42,7 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 namespace OpenLogReplicator {
     Replicator::Replicator(Ctx* newCtx, void (*newArchGetLog)(Replicator* replicator), Builder* newBuilder, Metadata* newMetadata,
                            TransactionBuffer* newTransactionBuffer, const std::string& newAlias, const char* newDatabase) :
-            Thread(newCtx, newAlias),
+            Thread(newCtx, newAlias, THREAD_ROLE_PARSER),
             archGetLog(newArchGetLog),
             builder(newBuilder),
             metadata(newMetadata),
@@ -164,6 +164,7 @@ namespace OpenLogReplicator {
             ss << std::this_thread::get_id();
             ctx->logTrace(TRACE_THREADS, "replicator (" + ss.str() + ") start");
         }
+        ctx->bindNumaNode(ctx->numaNodeParser, THREAD_ROLE_PARSER);
 
         try {
             metadata->waitForWriter();
@@ -267,6 +268,9 @@ namespace OpenLogReplicator {
         ctx->replicatorFinished = true;
         ctx->info(0, "Oracle replicator for: " + database + " allocated at most " + std::to_string(ctx->getMaxUsedMemory()) +
                   "MB memory, max disk read buffer: " + std::to_string(ctx->buffersMaxUsed * MEMORY_CHUNK_SIZE_MB) + "MB");
+        for (uint64_t module = 0; module < MEMORY_MODULES_NUM; ++module)
+            ctx->info(0, "memory used by " + std::string(Ctx::memoryModules[module]) + " at most: " +
+                      std::to_string(ctx->getModuleMaxUsedMemory(module)) + "MB");
 
         if (ctx->trace & TRACE_THREADS) {
             std::ostringstream ss;
@@ -918,9 +918,11 @@ namespace OpenLogReplicator {
             readSystemDictionariesMetadata(metadata->schema, metadata->firstDataScn);
 
             for (SchemaElement* element : metadata->schemaElements)
-                createSchemaForTable(metadata->firstDataScn, element->owner, element->table, element->keys,
-                                     element->keysStr, element->options, msgs);
+                createSchemaForTable(metadata->firstDataScn, element->owner, element->table, element->options);
+            metadata->schema->buildMaps(metadata->schemaMatcher, msgs, metadata->suppLogDbPrimary, metadata->suppLogDbAll,
+                                        metadata->defaultCharacterMapId, metadata->defaultCharacterNcharMapId);
             metadata->schema->resetTouched();
+            metadata->schema->resetDelta();
 
             if (metadata->ctx->trace & TRACE_CHECKPOINT)
                 metadata->ctx->logTrace(TRACE_CHECKPOINT, "schema creation completed, allowing checkpoints");
@@ -952,7 +954,7 @@ namespace OpenLogReplicator {
 
             int64_t sysTsRet = sysTsStmt.executeQuery();
             while (sysTsRet) {
-                schema->dictSysTsAdd(sysTsRowid, sysTsTs, sysTsName, sysTsBlockSize);
+                schema->dictSysTsAdd(typeRowId(sysTsRowid), sysTsTs, sysTsName, sysTsBlockSize);
                 sysTsRet = sysTsStmt.next();
             }
         } catch (RuntimeException& ex) {
@@ -998,7 +1000,7 @@ namespace OpenLogReplicator {
 
         int64_t sysCColRet = sysCColStmt.executeQuery();
         while (sysCColRet) {
-            schema->dictSysCColAdd(sysCColRowid, sysCColCon, sysCColIntCol, sysCColObj, sysCColSpare11, sysCColSpare12);
+            schema->dictSysCColAdd(typeRowId(sysCColRowid), sysCColCon, sysCColIntCol, sysCColObj, sysCColSpare11, sysCColSpare12);
             sysCColSpare11 = 0;
             sysCColSpare12 = 0;
             sysCColRet = sysCColStmt.next();
@@ -1035,7 +1037,7 @@ namespace OpenLogReplicator {
 
         int64_t sysCDefRet = sysCDefStmt.executeQuery();
         while (sysCDefRet) {
-            schema->dictSysCDefAdd(sysCDefRowid, sysCDefCon, sysCDefObj, sysCDefType);
+            schema->dictSysCDefAdd(typeRowId(sysCDefRowid), sysCDefCon, sysCDefObj, sysCDefType);
             sysCDefRet = sysCDefStmt.next();
         }
 
@@ -1081,7 +1083,7 @@ namespace OpenLogReplicator {
 
         int64_t sysColRet = sysColStmt.executeQuery();
         while (sysColRet) {
-            schema->dictSysColAdd(sysColRowid, sysColObj, sysColCol, sysColSegCol, sysColIntCol, sysColName,
+            schema->dictSysColAdd(typeRowId(sysColRowid), sysColObj, sysColCol, sysColSegCol, sysColIntCol, sysColName,
                                   sysColType, sysColLength, sysColPrecision, sysColScale, sycColCharsetForm,
                                   sysColCharsetId, sysColNull, sysColProperty1, sysColProperty2);
             sysColPrecision = -1;
@@ -1122,7 +1124,7 @@ namespace OpenLogReplicator {
 
         int64_t sysDeferredStgRet = sysDeferredStgStmt.executeQuery();
         while (sysDeferredStgRet) {
-            schema->dictSysDeferredStgAdd(sysDeferredStgRowid, sysDeferredStgObj, sysDeferredStgFlagsStg1,
+            schema->dictSysDeferredStgAdd(typeRowId(sysDeferredStgRowid), sysDeferredStgObj, sysDeferredStgFlagsStg1,
                                           sysDeferredStgFlagsStg2);
             sysDeferredStgFlagsStg1 = 0;
             sysDeferredStgFlagsStg2 = 0;
@@ -1184,7 +1186,7 @@ namespace OpenLogReplicator {
 
         int64_t sysEColRet = sysEColStmt.executeQuery();
         while (sysEColRet) {
-            schema->dictSysEColAdd(sysEColRowid, sysEColTabObj, sysEColColNum, sysEColGuardId);
+            schema->dictSysEColAdd(typeRowId(sysEColRowid), sysEColTabObj, sysEColColNum, sysEColGuardId);
             sysEColColNum = 0;
             sysEColGuardId = -1;
             sysEColRet = sysEColStmt.next();
@@ -1223,7 +1225,7 @@ namespace OpenLogReplicator {
 
         int64_t sysLobRet = sysLobStmt.executeQuery();
         while (sysLobRet) {
-            schema->dictSysLobAdd(sysLobRowid, sysLobObj, sysLobCol, sysLobIntCol, sysLobLObj, sysLobTs);
+            schema->dictSysLobAdd(typeRowId(sysLobRowid), sysLobObj, sysLobCol, sysLobIntCol, sysLobLObj, sysLobTs);
             sysLobRet = sysLobStmt.next();
         }
 
@@ -1261,7 +1263,7 @@ namespace OpenLogReplicator {
 
         int64_t sysLobCompPartRet = sysLobCompPartStmt.executeQuery();
         while (sysLobCompPartRet) {
-            schema->dictSysLobCompPartAdd(sysLobCompPartRowid, sysLobCompPartPartObj, sysLobCompPartLObj);
+            schema->dictSysLobCompPartAdd(typeRowId(sysLobCompPartRowid), sysLobCompPartPartObj, sysLobCompPartLObj);
             sysLobCompPartRet = sysLobCompPartStmt.next();
         }
 
@@ -1318,7 +1320,7 @@ namespace OpenLogReplicator {
 
         int64_t sysLobFragRet = sysLobFragStmt.executeQuery();
         while (sysLobFragRet) {
-            schema->dictSysLobFragAdd(sysLobFragRowid, sysLobFragFragObj, sysLobFragParentObj, sysLobFragTs);
+            schema->dictSysLobFragAdd(typeRowId(sysLobFragRowid), sysLobFragFragObj, sysLobFragParentObj, sysLobFragTs);
             sysLobFragRet = sysLobFragStmt.next();
         }
 
@@ -1358,7 +1360,7 @@ namespace OpenLogReplicator {
 
         int64_t sysTabRet = sysTabStmt.executeQuery();
         while (sysTabRet) {
-            schema->dictSysTabAdd(sysTabRowid, sysTabObj, sysTabDataObj, sysTabTs, sysTabCluCols, sysTabFlags1,
+            schema->dictSysTabAdd(typeRowId(sysTabRowid), sysTabObj, sysTabDataObj, sysTabTs, sysTabCluCols, sysTabFlags1,
                                   sysTabFlags2, sysTabProperty1, sysTabProperty2);
             sysTabDataObj = 0;
             sysTabCluCols = 0;
@@ -1396,7 +1398,7 @@ namespace OpenLogReplicator {
 
         int64_t sysTabComPartRet = sysTabComPartStmt.executeQuery();
         while (sysTabComPartRet) {
-            schema->dictSysTabComPartAdd(sysTabComPartRowid, sysTabComPartObj, sysTabComPartDataObj, sysTabComPartBo);
+            schema->dictSysTabComPartAdd(typeRowId(sysTabComPartRowid), sysTabComPartObj, sysTabComPartDataObj, sysTabComPartBo);
             sysTabComPartDataObj = 0;
             sysTabComPartRet = sysTabComPartStmt.next();
         }
@@ -1432,7 +1434,7 @@ namespace OpenLogReplicator {
 
         int64_t sysTabPartRet = sysTabPartStmt.executeQuery();
         while (sysTabPartRet) {
-            schema->dictSysTabPartAdd(sysTabPartRowid, sysTabPartObj, sysTabPartDataObj, sysTabPartBo);
+            schema->dictSysTabPartAdd(typeRowId(sysTabPartRowid), sysTabPartObj, sysTabPartDataObj, sysTabPartBo);
             sysTabPartDataObj = 0;
             sysTabPartRet = sysTabPartStmt.next();
         }
@@ -1468,7 +1470,7 @@ namespace OpenLogReplicator {
 
         int64_t sysTabSubPartRet = sysTabSubPartStmt.executeQuery();
         while (sysTabSubPartRet) {
-            schema->dictSysTabSubPartAdd(sysTabSubPartRowid, sysTabSubPartObj, sysTabSubPartDataObj, sysTabSubPartPobj);
+            schema->dictSysTabSubPartAdd(typeRowId(sysTabSubPartRowid), sysTabSubPartObj, sysTabSubPartDataObj, sysTabSubPartPobj);
             sysTabSubPartDataObj = 0;
             sysTabSubPartRet = sysTabSubPartStmt.next();
         }
@@ -1502,7 +1504,7 @@ namespace OpenLogReplicator {
 
             int64_t sysUserRet = sysUserStmt.executeQuery();
             while (sysUserRet) {
-                if (!schema->dictSysUserAdd(sysUserRowid, sysUserUser, sysUserName, sysUserSpare11, sysUserSpare12,
+                if (!schema->dictSysUserAdd(typeRowId(sysUserRowid), sysUserUser, sysUserName, sysUserSpare11, sysUserSpare12,
                         (options & OPTIONS_SYSTEM_TABLE) != 0)) {
                     sysUserSpare11 = 0;
                     sysUserSpare12 = 0;
@@ -1545,7 +1547,7 @@ namespace OpenLogReplicator {
 
                 int64_t sysObjRet = sysObjStmt.executeQuery();
                 while (sysObjRet) {
-                    if (schema->dictSysObjAdd(sysObjRowid, sysObjOwner, sysObjObj, sysObjDataObj, sysObjType, sysObjName,
+                    if (schema->dictSysObjAdd(typeRowId(sysObjRowid), sysObjOwner, sysObjObj, sysObjDataObj, sysObjType, sysObjName,
                                               sysObjFlags1, sysObjFlags2, single)) {
                         if (single)
                             readSystemDictionariesDetails(schema, targetScn, sysUserUser, sysObjObj);
@@ -1572,17 +1574,12 @@ namespace OpenLogReplicator {
         }
     }
 
-    void ReplicatorOnline::createSchemaForTable(typeScn targetScn, const std::string& owner, const std::string& table, const std::vector<std::string>& keys,
-                                                const std::string& keysStr, typeOptions options, std::list<std::string> &msgs) {
+    void ReplicatorOnline::createSchemaForTable(typeScn targetScn, const std::string& owner, const std::string& table, typeOptions options) {
         if (ctx->trace & TRACE_REDO)
             ctx->logTrace(TRACE_REDO, "creating table schema for owner: " + owner + " table: " + table + " options: " +
                           std::to_string(static_cast<uint64_t>(options)));
 
         readSystemDictionaries(metadata->schema, targetScn, owner, table, options);
-
-        metadata->schema->buildMaps(owner, table, keys, keysStr, options, msgs, metadata->suppLogDbPrimary,
-                                    metadata->suppLogDbAll, metadata->defaultCharacterMapId,
-                                    metadata->defaultCharacterNcharMapId);
     }
 
     void ReplicatorOnline::updateOnlineRedoLogData() {
@@ -25,6 +25,10 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #define STATE_H_
 
 #define STATE_TYPE_DISK 0
+#define STATE_TYPE_JOURNAL 1
+
+#define STATE_FORMAT_JSON 0
+#define STATE_FORMAT_BINARY 1
 
 namespace OpenLogReplicator {
     class Ctx;
@@ -29,14 +29,21 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "StateDisk.h"
 
 namespace OpenLogReplicator {
-    StateDisk::StateDisk(Ctx* newCtx, const char* newPath) :
+    StateDisk::StateDisk(Ctx* newCtx, const char* newPath, uint64_t newFormat) :
         State(newCtx),
-        path(newPath) {
+        path(newPath),
+        suffix(newFormat == STATE_FORMAT_BINARY ? STATE_DISK_SUFFIX_BINARY : STATE_DISK_SUFFIX_JSON),
+        suffixOther(newFormat == STATE_FORMAT_BINARY ? STATE_DISK_SUFFIX_JSON : STATE_DISK_SUFFIX_BINARY) {
     }
 
     StateDisk::~StateDisk() {
     }
 
+    bool StateDisk::hasSuffix(const std::string& fileName, const std::string& fileSuffix) const {
+        return fileName.length() >= fileSuffix.length() && fileName.compare(fileName.length() - fileSuffix.length(), fileSuffix.length(),
+                                                                            fileSuffix) == 0;
+    }
+
     void StateDisk::list(std::set<std::string>& namesList) {
         DIR* dir;
         if ((dir = opendir(path.c_str())) == nullptr)
@@ -59,56 +66,77 @@ namespace OpenLogReplicator {
             if (S_ISDIR(fileStat.st_mode))
                 continue;
 
-            std::string suffix(".json");
-            if (fileName.length() < suffix.length() || fileName.substr(fileName.length() - suffix.length(), fileName.length()) != suffix)
-                continue;
-
-            std::string fileBase(fileName.substr(0, fileName.length() - suffix.length()));
-            namesList.insert(fileBase);
+            // Files written in the other format are read as well
+            if (hasSuffix(fileName, suffix))
+                namesList.insert(fileName.substr(0, fileName.length() - suffix.length()));
+            else if (hasSuffix(fileName, suffixOther))
+                namesList.insert(fileName.substr(0, fileName.length() - suffixOther.length()));
         }
         closedir(dir);
     }
 
     bool StateDisk::read(const std::string& name, uint64_t maxSize, std::string& in) {
-        std::string fileName(path + "/" + name + ".json");
+        std::string fileName(path + "/" + name + suffix);
         struct stat fileStat;
         if (stat(fileName.c_str(), &fileStat) != 0) {
-            ctx->warning(60034, "file: " + fileName + " - stat returned: " + strerror(errno));
-            return false;
+            std::string fileNameOther(path + "/" + name + suffixOther);
+            if (stat(fileNameOther.c_str(), &fileStat) != 0) {
+                ctx->warning(60034, "file: " + fileName + " - stat returned: " + strerror(errno));
+                return false;
+            }
+            fileName = fileNameOther;
         }
         if (static_cast<uint64_t>(fileStat.st_size) > maxSize || fileStat.st_size == 0)
             throw RuntimeException(10004, "file: " + fileName + " - wrong size: " + std::to_string(fileStat.st_size));
 
         std::ifstream inputStream;
-        inputStream.open(fileName.c_str(), std::ios::in);
+        inputStream.open(fileName.c_str(), std::ios::in | std::ios::binary);
 
         if (!inputStream.is_open())
             throw RuntimeException(10001, "file: " + fileName + " - open returned: " + strerror(errno));
 
-        in.assign((std::istreambuf_iterator<char>(inputStream)), std::istreambuf_iterator<char>());
+        // Read the whole file at once
+        in.resize(fileStat.st_size);
+        inputStream.read(&in[0], fileStat.st_size);
+        if (inputStream.gcount() != fileStat.st_size)
+            in.resize(inputStream.gcount());
         inputStream.close();
         return true;
     }
 
     void StateDisk::write(const std::string& name, typeScn scn __attribute__((unused)), const std::ostringstream& out) {
-        std::string fileName(path + "/" + name + ".json");
+        std::string fileName(path + "/" + name + suffix);
+        std::string fileNameTmp(fileName + ".tmp");
         std::ofstream outputStream;
 
-        outputStream.open(fileName.c_str(), std::ios::out | std::ios::trunc);
+        // Written to a temporary file first, a crash during write must not leave a truncated checkpoint
+        outputStream.open(fileNameTmp.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
         if (!outputStream.is_open())
-            throw RuntimeException(10006, "file: " + fileName + " - open for write returned: " + strerror(errno));
+            throw RuntimeException(10006, "file: " + fileNameTmp + " - open for write returned: " + strerror(errno));
 
         outputStream << out.str();
         if (outputStream.bad() || outputStream.fail())
-            throw RuntimeException(10007, "file: " + fileName + " - 0 bytes written instead of " +
+            throw RuntimeException(10007, "file: " + fileNameTmp + " - 0 bytes written instead of " +
                                    std::to_string(out.str().length()) + ", code returned: " + strerror(errno));
 
         outputStream.close();
+        if (rename(fileNameTmp.c_str(), fileName.c_str()) != 0)
+            throw RuntimeException(10079, "file: " + fileNameTmp + " - rename to: " + fileName + " returned: " + strerror(errno));
+
+        // A copy written before the format was changed is older, it must not be read instead of this one
+        std::string fileNameOther(path + "/" + name + suffixOther);
+        if (unlink(fileNameOther.c_str()) != 0 && errno != ENOENT)
+            throw RuntimeException(10010, "file: " + fileNameOther + " - unlink returned: " + strerror(errno));
     }
 
     void StateDisk::drop(const std::string& name) {
-        std::string fileName(path + "/" + name + ".json");
-        if (unlink(fileName.c_str()) != 0)
+        std::string fileName(path + "/" + name + suffix);
+        if (unlink(fileName.c_str()) == 0)
+            return;
+
+        // Written before the format was changed
+        std::string fileNameOther(path + "/" + name + suffixOther);
+        if (errno != ENOENT || unlink(fileNameOther.c_str()) != 0)
             throw RuntimeException(10010, "file: " + fileName + " - unlink returned: " + strerror(errno));
     }
 }
@@ -22,13 +22,20 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #ifndef STATE_DISK_H_
 #define STATE_DISK_H_
 
+#define STATE_DISK_SUFFIX_JSON ".json"
+#define STATE_DISK_SUFFIX_BINARY ".bin"
+
 namespace OpenLogReplicator {
     class StateDisk final : public State {
     protected:
         std::string path;
+        std::string suffix;
+        std::string suffixOther;
+
+        [[nodiscard]] bool hasSuffix(const std::string& fileName, const std::string& fileSuffix) const;
 
     public:
-        explicit StateDisk(Ctx* newCtx, const char* newPath);
+        explicit StateDisk(Ctx* newCtx, const char* newPath, uint64_t newFormat);
         ~StateDisk() override;
 
         void list(std::set<std::string>& namesList) override;
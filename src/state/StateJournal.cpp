@@ -0,0 +1,486 @@
+/* Append-only journal of checkpoint records
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "../common/Ctx.h"
+#include "../common/RuntimeException.h"
+#include "StateJournal.h"
+
+namespace OpenLogReplicator {
+    StateJournal::StateJournal(Ctx* newCtx, const char* newPath) :
+        State(newCtx),
+        path(newPath),
+        segment(1),
+        firstSegment(1),
+        segmentOffset(0),
+        fd(-1) {
+    }
+
+    StateJournal::~StateJournal() {
+        if (fd == -1)
+            return;
+
+        // Next startup verifies just the records appended after the index
+        try {
+            writeIndex();
+        } catch (RuntimeException& ex) {
+            ctx->error(ex.code, ex.msg);
+        }
+        close(fd);
+        fd = -1;
+    }
+
+    uint32_t StateJournal::crc32(uint32_t crc, const uint8_t* data, uint64_t length) {
+        static const std::array<uint32_t, 256> table = []() {
+            std::array<uint32_t, 256> values{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t value = i;
+                for (uint64_t bit = 0; bit < 8; ++bit)
+                    value = (value & 1) != 0 ? (value >> 1) ^ 0xEDB88320 : value >> 1;
+                values[i] = value;
+            }
+            return values;
+        }();
+
+        crc = ~crc;
+        for (uint64_t i = 0; i < length; ++i)
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    void StateJournal::write32(uint8_t* buffer, uint32_t value) {
+        for (uint64_t i = 0; i < 4; ++i)
+            buffer[i] = static_cast<uint8_t>((value >> (i * 8)) & 0xFF);
+    }
+
+    void StateJournal::write64(uint8_t* buffer, uint64_t value) {
+        for (uint64_t i = 0; i < 8; ++i)
+            buffer[i] = static_cast<uint8_t>((value >> (i * 8)) & 0xFF);
+    }
+
+    uint32_t StateJournal::read32(const uint8_t* buffer) {
+        return static_cast<uint32_t>(buffer[0]) | (static_cast<uint32_t>(buffer[1]) << 8) | (static_cast<uint32_t>(buffer[2]) << 16) |
+                (static_cast<uint32_t>(buffer[3]) << 24);
+    }
+
+    uint64_t StateJournal::read64(const uint8_t* buffer) {
+        return static_cast<uint64_t>(read32(buffer)) | (static_cast<uint64_t>(read32(buffer + 4)) << 32);
+    }
+
+    std::string StateJournal::segmentName(uint64_t num) const {
+        return path + "/" + STATE_JOURNAL_SEGMENT_PREFIX + std::to_string(num) + STATE_JOURNAL_SEGMENT_SUFFIX;
+    }
+
+    void StateJournal::openSegment(uint64_t num) {
+        std::string fileName(segmentName(num));
+        fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        if (fd == -1)
+            throw RuntimeException(10006, "file: " + fileName + " - open for write returned: " + strerror(errno));
+        segment = num;
+    }
+
+    void StateJournal::syncFile(int fileFd, const std::string& fileName) {
+        if (fdatasync(fileFd) != 0)
+            throw RuntimeException(10068, "file: " + fileName + " - fdatasync returned: " + strerror(errno));
+    }
+
+    bool StateJournal::readIndex(uint64_t& indexSegment, uint64_t& indexOffset) {
+        std::string fileName(path + "/" STATE_JOURNAL_INDEX);
+        int indexFd = open(fileName.c_str(), O_RDONLY);
+        if (indexFd == -1)
+            return false;
+
+        uint8_t buffer[STATE_JOURNAL_INDEX_LENGTH];
+        int64_t bytes = pread(indexFd, buffer, STATE_JOURNAL_INDEX_LENGTH, 0);
+        close(indexFd);
+        if (bytes != STATE_JOURNAL_INDEX_LENGTH || read32(buffer) != STATE_JOURNAL_INDEX_MAGIC ||
+            read32(buffer + 4) != crc32(0, buffer + 8, STATE_JOURNAL_INDEX_LENGTH - 8))
+            return false;
+
+        indexSegment = read64(buffer + 8);
+        indexOffset = read64(buffer + 16);
+        return true;
+    }
+
+    void StateJournal::writeIndex() {
+        uint8_t buffer[STATE_JOURNAL_INDEX_LENGTH];
+        write32(buffer, STATE_JOURNAL_INDEX_MAGIC);
+        write64(buffer + 8, segment);
+        write64(buffer + 16, segmentOffset);
+        write32(buffer + 4, crc32(0, buffer + 8, STATE_JOURNAL_INDEX_LENGTH - 8));
+
+        // Replaced atomically, a torn index would just cause verification of all records
+        std::string fileName(path + "/" STATE_JOURNAL_INDEX);
+        std::string fileNameTmp(fileName + ".tmp");
+        int indexFd = open(fileNameTmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        if (indexFd == -1)
+            throw RuntimeException(10006, "file: " + fileNameTmp + " - open for write returned: " + strerror(errno));
+        int64_t bytes = ::write(indexFd, buffer, STATE_JOURNAL_INDEX_LENGTH);
+        if (bytes != STATE_JOURNAL_INDEX_LENGTH) {
+            std::string msg(strerror(errno));
+            close(indexFd);
+            throw RuntimeException(10007, "file: " + fileNameTmp + " - " + std::to_string(bytes) + " bytes written instead of " +
+                                   std::to_string(STATE_JOURNAL_INDEX_LENGTH) + ", code returned: " + msg);
+        }
+        if (fdatasync(indexFd) != 0) {
+            std::string msg(strerror(errno));
+            close(indexFd);
+            throw RuntimeException(10068, "file: " + fileNameTmp + " - fdatasync returned: " + msg);
+        }
+        close(indexFd);
+        if (rename(fileNameTmp.c_str(), fileName.c_str()) != 0)
+            throw RuntimeException(10079, "file: " + fileNameTmp + " - rename to: " + fileName + " returned: " + strerror(errno));
+    }
+
+    void StateJournal::scanSegment(uint64_t num, bool last, uint64_t indexSegment, uint64_t indexOffset) {
+        std::string fileName(segmentName(num));
+        int segmentFd = open(fileName.c_str(), O_RDONLY);
+        if (segmentFd == -1)
+            throw RuntimeException(10001, "file: " + fileName + " - open returned: " + strerror(errno));
+
+        struct stat fileStat;
+        if (fstat(segmentFd, &fileStat) != 0) {
+            close(segmentFd);
+            throw RuntimeException(10003, "file: " + fileName + " - stat returned: " + strerror(errno));
+        }
+        uint64_t size = fileStat.st_size;
+
+        uint64_t offset = 0;
+        uint8_t header[STATE_JOURNAL_HEADER_LENGTH];
+        std::string data;
+        while (offset + STATE_JOURNAL_HEADER_LENGTH <= size) {
+            if (pread(segmentFd, header, STATE_JOURNAL_HEADER_LENGTH, offset) != STATE_JOURNAL_HEADER_LENGTH || read32(header) != STATE_JOURNAL_MAGIC)
+                break;
+
+            uint64_t nameLength = read32(header + 16);
+            uint64_t payloadLength = read32(header + 20);
+            uint64_t length = STATE_JOURNAL_HEADER_LENGTH + nameLength + payloadLength;
+            if (nameLength == 0 || offset + length > size)
+                break;
+
+            // Records older than the index were already verified
+            bool verify = (num > indexSegment || (num == indexSegment && offset >= indexOffset));
+            uint64_t dataLength = verify ? nameLength + payloadLength : nameLength;
+            data.resize(dataLength);
+            if (pread(segmentFd, &data[0], dataLength, offset + STATE_JOURNAL_HEADER_LENGTH) != static_cast<int64_t>(dataLength))
+                break;
+            if (verify) {
+                uint32_t crc = crc32(0, header, 24);
+                crc = crc32(crc, reinterpret_cast<const uint8_t*>(data.data()), dataLength);
+                if (crc != read32(header + 24))
+                    break;
+            }
+
+            std::string name(data, 0, nameLength);
+            if (header[4] == STATE_JOURNAL_RECORD_WRITE)
+                entries.insert_or_assign(name, StateJournalEntry{num, offset, length, read64(header + 8),
+                                                                 (header[5] & STATE_JOURNAL_FLAG_BLOB) != 0});
+            else if (header[4] == STATE_JOURNAL_RECORD_DROP)
+                entries.erase(name);
+            else
+                break;
+
+            offset += length;
+        }
+        close(segmentFd);
+
+        if (offset != size) {
+            ctx->warning(60041, "file: " + fileName + " - journal record invalid at offset: " + std::to_string(offset) + ", ignoring the rest");
+
+            // Torn write at the end, the next record is appended in its place
+            if (last && truncate(fileName.c_str(), static_cast<off_t>(offset)) != 0)
+                throw RuntimeException(10081, "file: " + fileName + " - truncate to " + std::to_string(offset) + " bytes returned: " +
+                                       strerror(errno));
+        }
+
+        if (last)
+            segmentOffset = offset;
+    }
+
+    void StateJournal::initialize() {
+        uint64_t indexSegment = 0;
+        uint64_t indexOffset = 0;
+        if (!readIndex(indexSegment, indexOffset))
+            ctx->info(0, "journal: " + path + " - index missing, verifying all records");
+
+        DIR* dir;
+        if ((dir = opendir(path.c_str())) == nullptr)
+            throw RuntimeException(10012, "directory: " + path + " - can't read");
+
+        std::set<uint64_t> segments;
+        struct dirent* ent;
+        while ((ent = readdir(dir)) != nullptr) {
+            std::string fileName(ent->d_name);
+            if (fileName.length() <= strlen(STATE_JOURNAL_SEGMENT_PREFIX) + strlen(STATE_JOURNAL_SEGMENT_SUFFIX) ||
+                fileName.compare(0, strlen(STATE_JOURNAL_SEGMENT_PREFIX), STATE_JOURNAL_SEGMENT_PREFIX) != 0)
+                continue;
+
+            uint64_t num = strtoull(fileName.c_str() + strlen(STATE_JOURNAL_SEGMENT_PREFIX), nullptr, 10);
+            if (fileName == std::string(STATE_JOURNAL_SEGMENT_PREFIX) + std::to_string(num) + STATE_JOURNAL_SEGMENT_SUFFIX)
+                segments.insert(num);
+        }
+        closedir(dir);
+
+        if (segments.empty()) {
+            openSegment(1);
+            firstSegment = 1;
+            segmentOffset = 0;
+            return;
+        }
+
+        for (uint64_t num : segments)
+            scanSegment(num, num == *segments.rbegin(), indexSegment, indexOffset);
+
+        firstSegment = *segments.begin();
+        openSegment(*segments.rbegin());
+
+        if (ctx->trace & TRACE_CHECKPOINT)
+            ctx->logTrace(TRACE_CHECKPOINT, "journal: " + path + " segment: " + std::to_string(segment) + " offset: " +
+                          std::to_string(segmentOffset) + " records: " + std::to_string(entries.size()));
+    }
+
+    void StateJournal::append(uint8_t type, uint8_t flags, const std::string& name, typeScn scn, const char* payload, uint64_t payloadLength) {
+        uint64_t length = STATE_JOURNAL_HEADER_LENGTH + name.length() + payloadLength;
+        if (segmentOffset > 0 && segmentOffset + length > STATE_JOURNAL_SEGMENT_SIZE)
+            compact();
+
+        std::string record(length, '\0');
+        auto buffer = reinterpret_cast<uint8_t*>(&record[0]);
+        write32(buffer, STATE_JOURNAL_MAGIC);
+        buffer[4] = type;
+        buffer[5] = flags;
+        write64(buffer + 8, scn);
+        write32(buffer + 16, name.length());
+        write32(buffer + 20, payloadLength);
+        memcpy(buffer + STATE_JOURNAL_HEADER_LENGTH, name.data(), name.length());
+        if (payloadLength > 0)
+            memcpy(buffer + STATE_JOURNAL_HEADER_LENGTH + name.length(), payload, payloadLength);
+        uint32_t crc = crc32(0, buffer, 24);
+        crc = crc32(crc, buffer + STATE_JOURNAL_HEADER_LENGTH, name.length() + payloadLength);
+        write32(buffer + 24, crc);
+
+        int64_t bytes = ::write(fd, buffer, length);
+        if (bytes != static_cast<int64_t>(length)) {
+            std::string msg(strerror(errno));
+            // Don't leave a partial record behind
+            if (ftruncate(fd, static_cast<off_t>(segmentOffset)) != 0)
+                ctx->error(10081, "file: " + segmentName(segment) + " - truncate to " + std::to_string(segmentOffset) + " bytes returned: " +
+                           strerror(errno));
+            throw RuntimeException(10007, "file: " + segmentName(segment) + " - " + std::to_string(bytes) + " bytes written instead of " +
+                                   std::to_string(length) + ", code returned: " + msg);
+        }
+        // The record is durable before the checkpoint is acknowledged
+        syncFile(fd, segmentName(segment));
+
+        if (type == STATE_JOURNAL_RECORD_WRITE)
+            entries.insert_or_assign(name, StateJournalEntry{segment, segmentOffset, length, scn, (flags & STATE_JOURNAL_FLAG_BLOB) != 0});
+        else
+            entries.erase(name);
+        segmentOffset += length;
+    }
+
+    void StateJournal::compact() {
+        // Live records are copied to a new segment, then the old segments are removed
+        uint64_t oldSegment = segment;
+        uint64_t oldSegmentOffset = segmentOffset;
+        close(fd);
+        fd = -1;
+        openSegment(oldSegment + 1);
+
+        // Positions are changed only after the new segment is complete
+        std::vector<uint64_t> offsets;
+        offsets.reserve(entries.size());
+        uint64_t offset = 0;
+        try {
+            std::string record;
+            for (const auto& entryIt : entries) {
+                const StateJournalEntry& entry = entryIt.second;
+                readRecord(entry.segment, entry.offset, entry.length, record);
+
+                int64_t bytes = ::write(fd, record.data(), entry.length);
+                if (bytes != static_cast<int64_t>(entry.length))
+                    throw RuntimeException(10007, "file: " + segmentName(segment) + " - " + std::to_string(bytes) + " bytes written instead of " +
+                                           std::to_string(entry.length) + ", code returned: " + strerror(errno));
+                offsets.push_back(offset);
+                offset += entry.length;
+            }
+            syncFile(fd, segmentName(segment));
+        } catch (RuntimeException& ex) {
+            // A partial copy must not be scanned as the newest segment at the next start, appending continues in the old one
+            std::string fileName(segmentName(segment));
+            close(fd);
+            fd = -1;
+            if (unlink(fileName.c_str()) != 0 && errno != ENOENT) {
+                std::string msg(strerror(errno));
+                ctx->error(ex.code, ex.msg);
+                throw RuntimeException(10010, "file: " + fileName + " - unlink returned: " + msg);
+            }
+            openSegment(oldSegment);
+            segmentOffset = oldSegmentOffset;
+            throw;
+        }
+
+        uint64_t num = 0;
+        for (auto& entryIt : entries) {
+            StateJournalEntry& entry = entryIt.second;
+            entry.segment = segment;
+            entry.offset = offsets[num++];
+        }
+        segmentOffset = offset;
+        writeIndex();
+
+        for (num = firstSegment; num <= oldSegment; ++num) {
+            std::string fileName(segmentName(num));
+            if (unlink(fileName.c_str()) != 0 && errno != ENOENT)
+                throw RuntimeException(10010, "file: " + fileName + " - unlink returned: " + strerror(errno));
+        }
+        firstSegment = segment;
+
+        if (ctx->trace & TRACE_CHECKPOINT)
+            ctx->logTrace(TRACE_CHECKPOINT, "journal: " + path + " compacted to segment: " + std::to_string(segment) + " records: " +
+                          std::to_string(entries.size()) + " bytes: " + std::to_string(segmentOffset));
+    }
+
+    void StateJournal::readRecord(uint64_t num, uint64_t offset, uint64_t length, std::string& record) {
+        std::string fileName(segmentName(num));
+        int segmentFd = open(fileName.c_str(), O_RDONLY);
+        if (segmentFd == -1)
+            throw RuntimeException(10001, "file: " + fileName + " - open returned: " + strerror(errno));
+
+        record.resize(length);
+        int64_t bytes = pread(segmentFd, &record[0], length, offset);
+        close(segmentFd);
+        if (bytes != static_cast<int64_t>(length))
+            throw RuntimeException(10005, "file: " + fileName + " - " + std::to_string(bytes) + " bytes read instead of " + std::to_string(length));
+
+        auto buffer = reinterpret_cast<const uint8_t*>(record.data());
+        uint32_t crc = crc32(0, buffer, 24);
+        crc = crc32(crc, buffer + STATE_JOURNAL_HEADER_LENGTH, length - STATE_JOURNAL_HEADER_LENGTH);
+        if (read32(buffer) != STATE_JOURNAL_MAGIC || crc != read32(buffer + 24))
+            throw RuntimeException(10076, "file: " + fileName + " - checksum mismatch at offset: " + std::to_string(offset));
+    }
+
+    void StateJournal::list(std::set<std::string>& namesList) {
+        std::unique_lock<std::mutex> lck(mtx);
+        for (const auto& entryIt : entries)
+            namesList.insert(entryIt.first);
+    }
+
+    bool StateJournal::read(const std::string& name, uint64_t maxSize, std::string& in) {
+        std::unique_lock<std::mutex> lck(mtx);
+        auto entriesIt = entries.find(name);
+        if (entriesIt == entries.end())
+            return false;
+        const StateJournalEntry& entry = entriesIt->second;
+
+        std::string record;
+        readRecord(entry.segment, entry.offset, entry.length, record);
+        auto buffer = reinterpret_cast<const uint8_t*>(record.data());
+        uint64_t payloadPos = STATE_JOURNAL_HEADER_LENGTH + read32(buffer + 16);
+        uint64_t payloadLength = read32(buffer + 20);
+
+        if (!entry.blob) {
+            if (payloadLength > maxSize || payloadLength == 0)
+                throw RuntimeException(10004, "file: " + segmentName(entry.segment) + " - wrong size: " + std::to_string(payloadLength));
+            in.assign(record, payloadPos, payloadLength);
+            return true;
+        }
+
+        // Blob length and checksum are kept in the record
+        std::string fileName(path + "/" + name + STATE_JOURNAL_BLOB_SUFFIX);
+        uint64_t blobLength = read64(buffer + payloadPos);
+        uint32_t blobCrc = read32(buffer + payloadPos + 8);
+        if (blobLength > maxSize || blobLength == 0)
+            throw RuntimeException(10004, "file: " + fileName + " - wrong size: " + std::to_string(blobLength));
+
+        std::ifstream inputStream;
+        inputStream.open(fileName.c_str(), std::ios::in | std::ios::binary);
+        if (!inputStream.is_open())
+            throw RuntimeException(10001, "file: " + fileName + " - open returned: " + strerror(errno));
+
+        in.resize(blobLength);
+        inputStream.read(&in[0], static_cast<std::streamsize>(blobLength));
+        uint64_t bytes = inputStream.gcount();
+        inputStream.close();
+        if (bytes != blobLength)
+            throw RuntimeException(10005, "file: " + fileName + " - " + std::to_string(bytes) + " bytes read instead of " + std::to_string(blobLength));
+        if (crc32(0, reinterpret_cast<const uint8_t*>(in.data()), blobLength) != blobCrc)
+            throw RuntimeException(10076, "file: " + fileName + " - checksum mismatch at offset: 0");
+        return true;
+    }
+
+    void StateJournal::write(const std::string& name, typeScn scn, const std::ostringstream& out) {
+        std::string data(out.str());
+        std::unique_lock<std::mutex> lck(mtx);
+
+        if (data.length() <= STATE_JOURNAL_INLINE_MAX) {
+            append(STATE_JOURNAL_RECORD_WRITE, 0, name, scn, data.data(), data.length());
+            return;
+        }
+
+        // Checkpoints with schema are kept outside of the journal
+        std::string fileName(path + "/" + name + STATE_JOURNAL_BLOB_SUFFIX);
+        int blobFd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        if (blobFd == -1)
+            throw RuntimeException(10006, "file: " + fileName + " - open for write returned: " + strerror(errno));
+
+        int64_t bytes = ::write(blobFd, data.data(), data.length());
+        if (bytes != static_cast<int64_t>(data.length()) || fdatasync(blobFd) != 0) {
+            std::string msg(strerror(errno));
+            close(blobFd);
+            if (bytes != static_cast<int64_t>(data.length()))
+                throw RuntimeException(10007, "file: " + fileName + " - " + std::to_string(bytes) + " bytes written instead of " +
+                                       std::to_string(data.length()) + ", code returned: " + msg);
+            throw RuntimeException(10068, "file: " + fileName + " - fdatasync returned: " + msg);
+        }
+        close(blobFd);
+
+        uint8_t payload[12];
+        write64(payload, data.length());
+        write32(payload + 8, crc32(0, reinterpret_cast<const uint8_t*>(data.data()), data.length()));
+        append(STATE_JOURNAL_RECORD_WRITE, STATE_JOURNAL_FLAG_BLOB, name, scn, reinterpret_cast<const char*>(payload), sizeof(payload));
+    }
+
+    void StateJournal::drop(const std::string& name) {
+        std::unique_lock<std::mutex> lck(mtx);
+        auto entriesIt = entries.find(name);
+        if (entriesIt == entries.end())
+            return;
+        bool blob = entriesIt->second.blob;
+        typeScn scn = entriesIt->second.scn;
+
+        append(STATE_JOURNAL_RECORD_DROP, 0, name, scn, nullptr, 0);
+
+        if (blob) {
+            std::string fileName(path + "/" + name + STATE_JOURNAL_BLOB_SUFFIX);
+            if (unlink(fileName.c_str()) != 0 && errno != ENOENT)
+                throw RuntimeException(10010, "file: " + fileName + " - unlink returned: " + strerror(errno));
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/* Header for StateJournal class
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "State.h"
+
+#ifndef STATE_JOURNAL_H_
+#define STATE_JOURNAL_H_
+
+#define STATE_JOURNAL_SEGMENT_PREFIX            "journal-"
+#define STATE_JOURNAL_SEGMENT_SUFFIX            ".log"
+#define STATE_JOURNAL_INDEX                     "journal.idx"
+#define STATE_JOURNAL_BLOB_SUFFIX               ".blob"
+#define STATE_JOURNAL_MAGIC                     0x4A524C4F
+#define STATE_JOURNAL_INDEX_MAGIC               0x49524C4F
+#define STATE_JOURNAL_HEADER_LENGTH             32
+#define STATE_JOURNAL_INDEX_LENGTH              24
+#define STATE_JOURNAL_RECORD_WRITE              1
+#define STATE_JOURNAL_RECORD_DROP               2
+#define STATE_JOURNAL_FLAG_BLOB                 0x01
+#define STATE_JOURNAL_SEGMENT_SIZE              (16 * 1024 * 1024)
+#define STATE_JOURNAL_INLINE_MAX                (64 * 1024)
+
+namespace OpenLogReplicator {
+    // Position of the newest record for a name
+    struct StateJournalEntry {
+        uint64_t segment;
+        uint64_t offset;
+        uint64_t length;
+        typeScn scn;
+        bool blob;
+    };
+
+    class StateJournal final : public State {
+    protected:
+        // Records: magic, type, flags, scn, name length, payload length and crc32 of all the rest, followed by name and payload.
+        // Large payloads (checkpoints with schema) are stored in separate files, the record just references them.
+        std::string path;
+        std::mutex mtx;
+        std::map<std::string, StateJournalEntry> entries;
+        uint64_t segment;
+        uint64_t firstSegment;
+        uint64_t segmentOffset;
+        int fd;
+
+        static uint32_t crc32(uint32_t crc, const uint8_t* data, uint64_t length);
+        static void write32(uint8_t* buffer, uint32_t value);
+        static void write64(uint8_t* buffer, uint64_t value);
+        [[nodiscard]] static uint32_t read32(const uint8_t* buffer);
+        [[nodiscard]] static uint64_t read64(const uint8_t* buffer);
+
+        [[nodiscard]] std::string segmentName(uint64_t num) const;
+        void openSegment(uint64_t num);
+        void syncFile(int fileFd, const std::string& fileName);
+        [[nodiscard]] bool readIndex(uint64_t& indexSegment, uint64_t& indexOffset);
+        void writeIndex();
+        void scanSegment(uint64_t num, bool last, uint64_t indexSegment, uint64_t indexOffset);
+        void append(uint8_t type, uint8_t flags, const std::string& name, typeScn scn, const char* payload, uint64_t payloadLength);
+        void compact();
+        void readRecord(uint64_t num, uint64_t offset, uint64_t length, std::string& record);
+
+    public:
+        StateJournal(Ctx* newCtx, const char* newPath);
+        ~StateJournal() override;
+
+        void initialize();
+        void list(std::set<std::string>& namesList) override;
+        [[nodiscard]] bool read(const std::string& name, uint64_t maxSize, std::string& in) override;
+        void write(const std::string& name, typeScn scn, const std::ostringstream& out) override;
+        void drop(const std::string& name) override;
+    };
+}
+
+#endif
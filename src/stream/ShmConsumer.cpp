@@ -0,0 +1,179 @@
+/* Client of shared memory ring
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../common/RuntimeException.h"
+#include "ShmConsumer.h"
+
+namespace OpenLogReplicator {
+    ShmConsumer::ShmConsumer(const std::string& newName) :
+        name(newName),
+        fd(-1),
+        segmentSize(0),
+        header(nullptr),
+        data(nullptr),
+        slot(nullptr),
+        readPos(0),
+        generation(0),
+        lastScn(0),
+        lastIdx(0) {
+    }
+
+    ShmConsumer::~ShmConsumer() {
+        detach();
+    }
+
+    void ShmConsumer::detach() {
+        if (slot != nullptr) {
+            slot->pid.store(0, std::memory_order_release);
+            slot = nullptr;
+        }
+
+        if (header != nullptr) {
+            munmap(reinterpret_cast<void*>(header), segmentSize);
+            header = nullptr;
+            data = nullptr;
+        }
+
+        if (fd != -1) {
+            close(fd);
+            fd = -1;
+        }
+    }
+
+    void ShmConsumer::attach() {
+        fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd == -1)
+            throw RuntimeException(10070, "shared memory: " + name + " - open returned: " + strerror(errno));
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || static_cast<uint64_t>(fileStat.st_size) < sizeof(ShmHeader))
+            throw RuntimeException(10074, "shared memory: " + name + " - invalid segment");
+        segmentSize = fileStat.st_size;
+
+        void* segment = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (segment == MAP_FAILED)
+            throw RuntimeException(10072, "shared memory: " + name + " - mmap returned: " + strerror(errno));
+        header = reinterpret_cast<ShmHeader*>(segment);
+
+        if (header->magic != SHM_MAGIC || header->version != SHM_VERSION || ShmRing::segmentSize(header->dataSize) != segmentSize)
+            throw RuntimeException(10074, "shared memory: " + name + " - invalid segment");
+        std::atomic_thread_fence(std::memory_order_acquire);
+        data = reinterpret_cast<uint8_t*>(segment) + header->dataOffset;
+
+        uint64_t pid = getpid();
+        for (ShmConsumerSlot& consumerSlot : header->consumers) {
+            uint64_t freePid = 0;
+            if (consumerSlot.pid.compare_exchange_strong(freePid, pid)) {
+                slot = &consumerSlot;
+                break;
+            }
+        }
+        if (slot == nullptr)
+            throw RuntimeException(10074, "shared memory: " + name + " - all " + std::to_string(SHM_MAX_CONSUMERS) + " consumer slots are used");
+
+        generation = header->generation.load(std::memory_order_acquire);
+        readFromTail();
+    }
+
+    // Start from the oldest data kept in the ring, the producer only moves the tail forward.
+    // Sequentially consistent: the position is stored before the tail is checked again, the producer does it in reverse order.
+    void ShmConsumer::readFromTail() {
+        do {
+            readPos = header->tailPos.load();
+            slot->confirmedPos.store(readPos);
+        } while (readPos != header->tailPos.load());
+    }
+
+    // The producer restarted: messages not confirmed before are sent again from the new position
+    bool ShmConsumer::restart() {
+        uint64_t currentGeneration = header != nullptr ? header->generation.load(std::memory_order_acquire) : SHM_GENERATION_CLOSED;
+        if (currentGeneration == generation)
+            return true;
+
+        if (currentGeneration != SHM_GENERATION_CLOSED) {
+            generation = currentGeneration;
+            readFromTail();
+            return true;
+        }
+
+        // The segment was replaced, the new one may not be ready yet
+        detach();
+        try {
+            attach();
+        } catch (RuntimeException& ex) {
+            detach();
+            return false;
+        }
+        return true;
+    }
+
+    bool ShmConsumer::receive(const uint8_t*& msg, uint64_t& length, typeScn& scn, typeIdx& idx, uint64_t timeUs) {
+        if (!restart()) {
+            usleep(static_cast<useconds_t>(timeUs < SHM_CONSUMER_RETRY_US ? timeUs : SHM_CONSUMER_RETRY_US));
+            return false;
+        }
+
+        if (readPos == header->writePos.load(std::memory_order_acquire)) {
+            uint32_t writeSeq = header->writeSeq.load(std::memory_order_acquire);
+            if (readPos == header->writePos.load(std::memory_order_acquire)) {
+                ++header->writeWaiters;
+                ShmRing::wait(&header->writeSeq, writeSeq, timeUs);
+                --header->writeWaiters;
+                if (readPos == header->writePos.load(std::memory_order_acquire))
+                    return false;
+            }
+        }
+
+        uint64_t offset = readPos % header->dataSize;
+        if (*reinterpret_cast<uint64_t*>(data + offset) == SHM_RECORD_WRAP) {
+            readPos += header->dataSize - offset;
+            offset = 0;
+        }
+
+        auto record = reinterpret_cast<ShmRecord*>(data + offset);
+        msg = data + offset + sizeof(struct ShmRecord);
+        length = record->length;
+        scn = record->scn;
+        idx = record->idx;
+        lastScn = scn;
+        lastIdx = idx;
+        readPos += sizeof(struct ShmRecord) + ((length + 7) & 0xFFFFFFFFFFFFFFF8);
+        return true;
+    }
+
+    // Confirms all received messages, memory of these messages may be reused after this call
+    void ShmConsumer::confirm() {
+        if (slot == nullptr)
+            return;
+
+        slot->confirmedScn.store(lastScn, std::memory_order_relaxed);
+        slot->confirmedIdx.store(lastIdx, std::memory_order_relaxed);
+        slot->confirmedPos.store(readPos, std::memory_order_release);
+        ++header->confirmSeq;
+        if (header->confirmWaiters > 0)
+            ShmRing::wake(&header->confirmSeq);
+    }
+}
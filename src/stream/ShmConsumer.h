@@ -0,0 +1,56 @@
+/* Header for ShmConsumer class
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include "ShmRing.h"
+
+#ifndef SHM_CONSUMER_H_
+#define SHM_CONSUMER_H_
+
+#define SHM_CONSUMER_RETRY_US       100000
+
+namespace OpenLogReplicator {
+    // Client side of the shared memory writer: messages are read in place and stay valid until confirmed
+    class ShmConsumer final {
+    protected:
+        std::string name;
+        int fd;
+        uint64_t segmentSize;
+        ShmHeader* header;
+        uint8_t* data;
+        ShmConsumerSlot* slot;
+        uint64_t readPos;
+        uint64_t generation;
+        typeScn lastScn;
+        typeIdx lastIdx;
+
+        void detach();
+        void readFromTail();
+        bool restart();
+
+    public:
+        explicit ShmConsumer(const std::string& newName);
+        ~ShmConsumer();
+
+        void attach();
+        bool receive(const uint8_t*& msg, uint64_t& length, typeScn& scn, typeIdx& idx, uint64_t timeUs);
+        void confirm();
+    };
+}
+
+#endif
@@ -0,0 +1,45 @@
+/* Shared memory ring helpers
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "ShmRing.h"
+
+namespace OpenLogReplicator {
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+                  "shared memory ring requires lock-free atomics");
+
+    // Futex is not private - the word is shared between processes
+    void ShmRing::wait(std::atomic<uint32_t>* word, uint32_t value, uint64_t timeUs) {
+        struct timespec timeout;
+        timeout.tv_sec = static_cast<time_t>(timeUs / 1000000);
+        timeout.tv_nsec = static_cast<int64_t>((timeUs % 1000000) * 1000);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, value, &timeout, nullptr, 0);
+    }
+
+    void ShmRing::wake(std::atomic<uint32_t>* word) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+    }
+
+    uint64_t ShmRing::segmentSize(uint64_t dataSize) {
+        return ((sizeof(ShmHeader) + 4095) & ~static_cast<uint64_t>(4095)) + dataSize;
+    }
+}
@@ -0,0 +1,83 @@
+/* Header for shared memory ring layout
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <atomic>
+
+#include "../common/types.h"
+
+#ifndef SHM_RING_H_
+#define SHM_RING_H_
+
+#define SHM_MAGIC                   0x4F4C5253484D5231
+#define SHM_VERSION                 2
+#define SHM_MAX_CONSUMERS           16
+#define SHM_RECORD_WRAP             0xFFFFFFFFFFFFFFFF
+#define SHM_SIZE_MB_DEFAULT         64
+#define SHM_SIZE_MB_MAX             65536
+#define SHM_GENERATION_CLOSED       0xFFFFFFFFFFFFFFFF
+
+namespace OpenLogReplicator {
+    // Shared between processes: only lock-free atomics and plain data, positions are byte offsets counted from the start of the stream
+    struct ShmConsumerSlot {
+        // 0 - slot is free
+        std::atomic<uint64_t> pid;
+        // End of the last confirmed record, the ring may overwrite data before this position
+        std::atomic<uint64_t> confirmedPos;
+        std::atomic<typeScn> confirmedScn;
+        std::atomic<typeIdx> confirmedIdx;
+        uint8_t padding[32];
+    };
+
+    struct ShmHeader {
+        uint64_t magic;
+        uint64_t version;
+        uint64_t dataSize;
+        uint64_t dataOffset;
+        // End of the last published record
+        std::atomic<uint64_t> writePos;
+        // Oldest position still kept in the ring, new consumers start reading from here
+        std::atomic<uint64_t> tailPos;
+        // Futex words: writeSeq changed by the producer on publish, confirmSeq by consumers on confirm and by the producer on new data to send
+        std::atomic<uint32_t> writeSeq;
+        std::atomic<uint32_t> writeWaiters;
+        std::atomic<uint32_t> confirmSeq;
+        std::atomic<uint32_t> confirmWaiters;
+        // Changed when the producer restarts and publishes from a new position, consumers read again from the tail.
+        // SHM_GENERATION_CLOSED - the segment was replaced with a new one, consumers attach again by name.
+        std::atomic<uint64_t> generation;
+        uint8_t padding[8];
+        ShmConsumerSlot consumers[SHM_MAX_CONSUMERS];
+    };
+
+    // Every record starts at 8-byte aligned position, payload is padded to 8 bytes, SHM_RECORD_WRAP length means continue from the ring start
+    struct ShmRecord {
+        uint64_t length;
+        typeScn scn;
+        typeIdx idx;
+    };
+
+    class ShmRing final {
+    public:
+        static void wait(std::atomic<uint32_t>* word, uint32_t value, uint64_t timeUs);
+        static void wake(std::atomic<uint32_t>* word);
+        static uint64_t segmentSize(uint64_t dataSize);
+    };
+}
+
+#endif
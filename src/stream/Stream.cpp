@@ -17,6 +17,9 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <poll.h>
+#include <unistd.h>
+
 #include "../common/Ctx.h"
 #include "Stream.h"
 
@@ -27,4 +30,26 @@ namespace OpenLogReplicator {
     }
 
     Stream::~Stream() = default;
+
+    // Messages may be kept until flush(), the memory must remain valid until then
+    void Stream::queueMessage(const struct iovec* segments, uint64_t segmentsCount, uint64_t length) {
+        if (segmentsCount == 1)
+            sendMessage(segments[0].iov_base, length);
+        else
+            sendMessage(segments, segmentsCount, length);
+    }
+
+    void Stream::flush() {
+    }
+
+    // The event descriptor (-1 for none) wakes up the wait as well as a message
+    void Stream::waitForMessage(uint64_t timeUs, int eventFD) {
+        if (eventFD == -1) {
+            usleep(timeUs);
+            return;
+        }
+
+        struct pollfd item = {eventFD, POLLIN, 0};
+        poll(&item, 1, static_cast<int>(timeUs / 1000));
+    }
 }
@@ -17,6 +17,8 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <sys/uio.h>
+
 #include "../common/types.h"
 
 #ifndef STREAM_H_
@@ -40,6 +42,10 @@ namespace OpenLogReplicator {
         virtual void initializeClient() = 0;
         virtual void initializeServer() = 0;
         virtual void sendMessage(const void* msg, uint64_t length) = 0;
+        virtual void sendMessage(const struct iovec* segments, uint64_t segmentsCount, uint64_t length) = 0;
+        virtual void queueMessage(const struct iovec* segments, uint64_t segmentsCount, uint64_t length);
+        virtual void flush();
+        virtual void waitForMessage(uint64_t timeUs, int eventFD);
         virtual uint64_t receiveMessage(void* msg, uint64_t length) = 0;
         virtual uint64_t receiveMessageNB(void* msg, uint64_t length) = 0;
         [[nodiscard]] virtual bool isConnected() = 0;
@@ -17,10 +17,13 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <algorithm>
 #include <cerrno>
+#include <climits>
 #include <cstring>
 #include <fcntl.h>
 #include <netdb.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
 #include "../common/Ctx.h"
@@ -35,7 +38,8 @@ namespace OpenLogReplicator {
         socketFD(-1),
         serverFD(-1),
         readBufferLen(0),
-        res(nullptr) {
+        res(nullptr),
+        pendingLength(0) {
     }
 
     StreamNetwork::~StreamNetwork() {
@@ -124,10 +128,22 @@ namespace OpenLogReplicator {
         }
     }
 
-    void StreamNetwork::sendMessage(const void* msg, uint64_t length) {
-        uint32_t length32 = length;
-        uint64_t sent = 0;
+    uint64_t StreamNetwork::encodeHeader(uint8_t* header, uint64_t length) {
+        if (length < 0xFFFFFFFF) {
+            // 32-bit length
+            uint32_t length32 = length;
+            memcpy(reinterpret_cast<void*>(header), reinterpret_cast<const void*>(&length32), sizeof(uint32_t));
+            return sizeof(uint32_t);
+        }
+
+        // 64-bit length
+        uint32_t length32 = 0xFFFFFFFF;
+        memcpy(reinterpret_cast<void*>(header), reinterpret_cast<const void*>(&length32), sizeof(uint32_t));
+        memcpy(reinterpret_cast<void*>(header + sizeof(uint32_t)), reinterpret_cast<const void*>(&length), sizeof(uint64_t));
+        return sizeof(uint32_t) + sizeof(uint64_t);
+    }
 
+    void StreamNetwork::sendSegments(struct iovec* segments, uint64_t segmentsCount) {
         if (socketFD == -1)
             throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " + strerror(errno) + " (10)");
 
@@ -136,98 +152,113 @@ namespace OpenLogReplicator {
         FD_ZERO(&wset);
         FD_SET(socketFD, &wset);
 
-        // Header content
-        if (length < 0xFFFFFFFF) {
-            // 32-bit length
-            while (sent < sizeof(uint32_t)) {
-                if (ctx->softShutdown)
-                    return;
-
-                w = wset;
-                // Blocking select
-                select(socketFD + 1, nullptr, &w, nullptr, nullptr);
-                ssize_t r = write(socketFD, (reinterpret_cast<uint8_t*>(&length32)) + sent, sizeof(uint32_t) - sent);
-                if (r <= 0) {
-                   if (r < 0 && (errno == EWOULDBLOCK || errno == EAGAIN))
-                       r = 0;
-                   else {
-                       close(socketFD);
-                       socketFD = -1;
-                       throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " +
-                                              strerror(errno) + " (11)");
-                   }
-                }
-                sent += r;
-            }
-        } else {
-            // 64-bit length
-            length32 = 0xFFFFFFFF;
-            while (sent < sizeof(uint32_t)) {
-                if (ctx->softShutdown)
-                    return;
-
-                w = wset;
-                // Blocking select
-                select(socketFD + 1, nullptr, &w, nullptr, nullptr);
-                ssize_t r = write(socketFD, (reinterpret_cast<uint8_t*>(&length32)) + sent, sizeof(uint32_t) - sent);
-                if (r <= 0) {
-                   if (r < 0 && (errno == EWOULDBLOCK || errno == EAGAIN))
-                       r = 0;
-                   else {
-                       close(socketFD);
-                       socketFD = -1;
-                       throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " +
-                                              strerror(errno) + " (12)");
-                   }
+        while (segmentsCount > 0) {
+            if (ctx->softShutdown)
+                return;
+
+            // More data follows when the list does not fit in one call
+            struct msghdr msgHdr;
+            memset(reinterpret_cast<void*>(&msgHdr), 0, sizeof(msgHdr));
+            msgHdr.msg_iov = segments;
+            msgHdr.msg_iovlen = segmentsCount < IOV_MAX ? segmentsCount : IOV_MAX;
+            ssize_t r = sendmsg(socketFD, &msgHdr, segmentsCount > IOV_MAX ? MSG_MORE : 0);
+            if (r <= 0) {
+                if (r < 0 && (errno == EWOULDBLOCK || errno == EAGAIN)) {
+                    w = wset;
+                    // Blocking select
+                    select(socketFD + 1, nullptr, &w, nullptr, nullptr);
+                    continue;
                 }
-                sent += r;
+
+                close(socketFD);
+                socketFD = -1;
+                pendingSegments.clear();
+                pendingHeaders.clear();
+                pendingLength = 0;
+                throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " + strerror(errno) + " (11)");
             }
 
-            sent = 0;
-            while (sent < sizeof(uint64_t)) {
-                if (ctx->softShutdown)
-                    return;
-
-                w = wset;
-                // Blocking select
-                select(socketFD + 1, nullptr, &w, nullptr, nullptr);
-                ssize_t r = write(socketFD, (reinterpret_cast<uint8_t*>(&length)) + sent, sizeof(uint64_t) - sent);
-                if (r <= 0) {
-                   if (r < 0 && (errno == EWOULDBLOCK || errno == EAGAIN))
-                       r = 0;
-                   else {
-                       close(socketFD);
-                       socketFD = -1;
-                       throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " +
-                                              strerror(errno) + " (13)");
-                   }
-                }
-                sent += r;
+            // Skip fully sent segments, adjust partially sent one
+            uint64_t sent = r;
+            while (segmentsCount > 0 && sent >= segments->iov_len) {
+                sent -= segments->iov_len;
+                ++segments;
+                --segmentsCount;
+            }
+            if (sent > 0) {
+                segments->iov_base = reinterpret_cast<uint8_t*>(segments->iov_base) + sent;
+                segments->iov_len -= sent;
             }
         }
+    }
 
-        sent = 0;
-        // Message content
-        while (sent < length) {
-            if (ctx->softShutdown)
-                return;
+    void StreamNetwork::sendMessage(const void* msg, uint64_t length) {
+        flush();
+
+        uint8_t header[sizeof(uint32_t) + sizeof(uint64_t)];
+        struct iovec messageSegments[2];
+        messageSegments[0].iov_base = header;
+        messageSegments[0].iov_len = encodeHeader(header, length);
+        messageSegments[1].iov_base = const_cast<void*>(msg);
+        messageSegments[1].iov_len = length;
+        sendSegments(messageSegments, 2);
+    }
 
-            w = wset;
-            // Blocking select
-            select(socketFD + 1, nullptr, &w, nullptr, nullptr);
-            ssize_t r = write(socketFD, reinterpret_cast<const char*>(msg) + sent, length - sent);
-            if (r <= 0) {
-               if (r < 0 && (errno == EWOULDBLOCK || errno == EAGAIN))
-                   r = 0;
-               else {
-                   close(socketFD);
-                   socketFD = -1;
-                   throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " +
-                                          strerror(errno) + " (14)");
-               }
-            }
-            sent += r;
+    void StreamNetwork::sendMessage(const struct iovec* segments, uint64_t segmentsCount, uint64_t length) {
+        queueMessage(segments, segmentsCount, length);
+        flush();
+    }
+
+    void StreamNetwork::queueMessage(const struct iovec* segments, uint64_t segmentsCount, uint64_t length) {
+        // Header is a placeholder until flush, the header buffer may be reallocated
+        uint8_t header[sizeof(uint32_t) + sizeof(uint64_t)];
+        uint64_t headerLength = encodeHeader(header, length);
+        pendingHeaders.append(reinterpret_cast<const char*>(header), headerLength);
+        pendingSegments.push_back({nullptr, headerLength});
+        for (uint64_t i = 0; i < segmentsCount; ++i)
+            pendingSegments.push_back(segments[i]);
+        pendingLength += headerLength + length;
+
+        if (pendingLength >= NETWORK_BATCH_BYTES || pendingSegments.size() >= IOV_MAX)
+            flush();
+    }
+
+    void StreamNetwork::flush() {
+        if (pendingSegments.empty())
+            return;
+
+        uint64_t headerOffset = 0;
+        for (struct iovec& segment : pendingSegments) {
+            if (segment.iov_base != nullptr)
+                continue;
+            segment.iov_base = const_cast<char*>(pendingHeaders.c_str()) + headerOffset;
+            headerOffset += segment.iov_len;
         }
+
+        sendSegments(pendingSegments.data(), pendingSegments.size());
+        pendingSegments.clear();
+        pendingHeaders.clear();
+        pendingLength = 0;
+    }
+
+    void StreamNetwork::waitForMessage(uint64_t timeUs, int eventFD) {
+        // Without a client, the server waits for a new connection
+        int fd = socketFD;
+        if (fd == -1)
+            fd = serverFD;
+        if (fd == -1 && eventFD == -1)
+            return;
+
+        fd_set rset;
+        FD_ZERO(&rset);
+        if (fd != -1)
+            FD_SET(fd, &rset);
+        if (eventFD != -1)
+            FD_SET(eventFD, &rset);
+        struct timeval timeout;
+        timeout.tv_sec = timeUs / 1000000;
+        timeout.tv_usec = timeUs % 1000000;
+        select(std::max(fd, eventFD) + 1, &rset, nullptr, nullptr, &timeout);
     }
 
     uint64_t StreamNetwork::receiveMessage(void* msg, uint64_t length) {
@@ -421,6 +452,10 @@ namespace OpenLogReplicator {
             throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " + strerror(errno) + " (18)");
         }
 
+        pendingSegments.clear();
+        pendingHeaders.clear();
+        pendingLength = 0;
+
         int flags = fcntl(socketFD, F_GETFL);
         if (flags < 0)
             throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " + strerror(errno) + " (19)");
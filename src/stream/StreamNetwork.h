@@ -18,12 +18,15 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
 #include <netinet/in.h>
+#include <vector>
 
 #include "Stream.h"
 
 #ifndef STREAM_NETWORK_H_
 #define STREAM_NETWORK_H_
 
+#define NETWORK_BATCH_BYTES         1048576
+
 namespace OpenLogReplicator {
     class StreamNetwork final : public Stream {
     protected:
@@ -35,6 +38,13 @@ namespace OpenLogReplicator {
         uint8_t readBuffer[READ_NETWORK_BUFFER];
         uint64_t readBufferLen;
         struct addrinfo* res;
+        // Messages queued for one batched send
+        std::vector<struct iovec> pendingSegments;
+        std::string pendingHeaders;
+        uint64_t pendingLength;
+
+        static uint64_t encodeHeader(uint8_t* header, uint64_t length);
+        void sendSegments(struct iovec* segments, uint64_t segmentsCount);
 
     public:
         StreamNetwork(Ctx* newCtx, const char* newUri);
@@ -45,6 +55,10 @@ namespace OpenLogReplicator {
         void initializeClient() override;
         void initializeServer() override;
         void sendMessage(const void* msg, uint64_t length) override;
+        void sendMessage(const struct iovec* segments, uint64_t segmentsCount, uint64_t length) override;
+        void queueMessage(const struct iovec* segments, uint64_t segmentsCount, uint64_t length) override;
+        void flush() override;
+        void waitForMessage(uint64_t timeUs, int eventFD) override;
         uint64_t receiveMessage(void* msg, uint64_t length) override;
         uint64_t receiveMessageNB(void* msg, uint64_t length) override;
         [[nodiscard]] bool isConnected() override;
@@ -17,7 +17,7 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
-#include <unistd.h>
+#include <cerrno>
 #include <zmq.h>
 
 #include "../common/Ctx.h"
@@ -29,11 +29,15 @@ namespace OpenLogReplicator {
     StreamZeroMQ::StreamZeroMQ(Ctx* newCtx, const char* newUri) :
         Stream(newCtx, newUri),
         socket(nullptr),
-        context(nullptr) {
+        context(nullptr),
+        framesInFlight(0) {
     }
 
     StreamZeroMQ::~StreamZeroMQ() {
         zmq_close(socket);
+        // Waits until all zero-copy frames are released by ZeroMQ
+        if (framesInFlight > 0 && (ctx->trace & TRACE_WRITER))
+            ctx->logTrace(TRACE_WRITER, "ZeroMQ: waiting for " + std::to_string(framesInFlight) + " frames to be released");
         zmq_ctx_term(context);
     }
 
@@ -62,14 +66,34 @@ namespace OpenLogReplicator {
             throw NetworkException(10064, "ZeroMQ bind to " + uri + " failed, message: " + std::to_string(errno));
     }
 
-    void StreamZeroMQ::sendMessage(const void* msg, uint64_t length) {
+    void StreamZeroMQ::freeFrame(void* data __attribute__((unused)), void* hint) {
+        // Frame memory belongs to the builder and is released when the client confirms the message
+        auto stream = reinterpret_cast<StreamZeroMQ*>(hint);
+        --stream->framesInFlight;
+    }
+
+    void StreamZeroMQ::waitForSocket(short events, uint64_t timeUs) {
+        zmq_pollitem_t item;
+        item.socket = socket;
+        item.fd = 0;
+        item.events = events;
+        item.revents = 0;
+
+        int64_t timeout = timeUs / 1000;
+        if (timeout == 0)
+            timeout = 1;
+        if (zmq_poll(&item, 1, timeout) < 0 && errno != EINTR)
+            throw NetworkException(10054, "network send error");
+    }
+
+    void StreamZeroMQ::sendPart(const void* msg, uint64_t length, int flags) {
         while (!ctx->softShutdown) {
-            int64_t ret = zmq_send(socket, msg, length, ZMQ_NOBLOCK);
+            int64_t ret = zmq_send(socket, msg, length, ZMQ_NOBLOCK | flags);
             if (ret == static_cast<int64_t>(length))
                 return;
 
             if (ret < 0 && errno == EAGAIN) {
-                usleep(ctx->pollIntervalUs);
+                waitForSocket(ZMQ_POLLOUT, ctx->pollIntervalUs);
                 continue;
             }
 
@@ -77,13 +101,95 @@ namespace OpenLogReplicator {
         }
     }
 
+    void StreamZeroMQ::sendFrame(void* data, uint64_t length, int flags) {
+        zmq_msg_t frame;
+        if (zmq_msg_init_data(&frame, data, length, freeFrame, this) != 0)
+            throw NetworkException(10054, "network send error");
+        ++framesInFlight;
+
+        while (!ctx->softShutdown) {
+            // On success ZeroMQ takes ownership of the frame
+            if (zmq_msg_send(&frame, socket, ZMQ_NOBLOCK | flags) == static_cast<int>(length))
+                return;
+
+            if (errno == EAGAIN) {
+                waitForSocket(ZMQ_POLLOUT, ctx->pollIntervalUs);
+                continue;
+            }
+
+            zmq_msg_close(&frame);
+            throw NetworkException(10054, "network send error");
+        }
+        zmq_msg_close(&frame);
+    }
+
+    void StreamZeroMQ::sendMessage(const void* msg, uint64_t length) {
+        sendPart(msg, length, 0);
+    }
+
+    void StreamZeroMQ::sendMessage(const struct iovec* segments, uint64_t segmentsCount, uint64_t length __attribute__((unused))) {
+        // Every segment is sent as a separate frame of one multipart message
+        for (uint64_t i = 0; i < segmentsCount; ++i)
+            sendPart(segments[i].iov_base, segments[i].iov_len, (i + 1 < segmentsCount) ? ZMQ_SNDMORE : 0);
+    }
+
+    void StreamZeroMQ::queueMessage(const struct iovec* segments, uint64_t segmentsCount, uint64_t length __attribute__((unused))) {
+        // Message memory stays valid until confirmation, so frames are sent without copying
+        for (uint64_t i = 0; i < segmentsCount; ++i)
+            sendFrame(segments[i].iov_base, segments[i].iov_len, (i + 1 < segmentsCount) ? ZMQ_SNDMORE : 0);
+    }
+
+    void StreamZeroMQ::waitForMessage(uint64_t timeUs, int eventFD) {
+        if (eventFD == -1) {
+            waitForSocket(ZMQ_POLLIN, timeUs);
+            return;
+        }
+
+        zmq_pollitem_t items[2];
+        items[0].socket = socket;
+        items[0].fd = 0;
+        items[0].events = ZMQ_POLLIN;
+        items[0].revents = 0;
+        items[1].socket = nullptr;
+        items[1].fd = eventFD;
+        items[1].events = ZMQ_POLLIN;
+        items[1].revents = 0;
+
+        int64_t timeout = timeUs / 1000;
+        if (timeout == 0)
+            timeout = 1;
+        if (zmq_poll(items, 2, timeout) < 0 && errno != EINTR)
+            throw NetworkException(10054, "network send error");
+    }
+
+    uint64_t StreamZeroMQ::receiveMoreParts(uint8_t* msg, uint64_t length, uint64_t received) {
+        for (;;) {
+            int more = 0;
+            size_t moreSize = sizeof(more);
+            if (zmq_getsockopt(socket, ZMQ_RCVMORE, &more, &moreSize) != 0)
+                throw NetworkException(10053, "network receive error");
+            if (more == 0)
+                return received;
+
+            if (received >= length)
+                throw NetworkException(10055, "message exceeds buffer size (length: " + std::to_string(received) +
+                                       ", buffer size: " + std::to_string(length) + ")");
+
+            // Remaining frames of a multipart message are already delivered
+            int64_t ret = zmq_recv(socket, msg + received, length - received, 0);
+            if (ret < 0)
+                throw NetworkException(10053, "network receive error");
+            received += ret;
+        }
+    }
+
     uint64_t StreamZeroMQ::receiveMessage(void* msg, uint64_t length) {
         int64_t ret = zmq_recv(socket, msg, length, 0);
 
         if (ret < 0)
             throw NetworkException(10053, "network receive error");
 
-        return ret;
+        return receiveMoreParts(reinterpret_cast<uint8_t*>(msg), length, ret);
     }
 
     uint64_t StreamZeroMQ::receiveMessageNB(void* msg, uint64_t length) {
@@ -94,7 +200,7 @@ namespace OpenLogReplicator {
 
             throw NetworkException(10053, "network receive error");
         }
-        return ret;
+        return receiveMoreParts(reinterpret_cast<uint8_t*>(msg), length, ret);
     }
 
     bool StreamZeroMQ::isConnected() {
@@ -17,6 +17,8 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <atomic>
+
 #include "Stream.h"
 
 #ifndef STREAM_ZERO_MQ_H_
@@ -27,6 +29,13 @@ namespace OpenLogReplicator {
     protected:
         void* socket;
         void* context;
+        std::atomic<uint64_t> framesInFlight;
+
+        static void freeFrame(void* data, void* hint);
+        void waitForSocket(short events, uint64_t timeUs);
+        void sendPart(const void* msg, uint64_t length, int flags);
+        void sendFrame(void* data, uint64_t length, int flags);
+        uint64_t receiveMoreParts(uint8_t* msg, uint64_t length, uint64_t received);
 
     public:
         StreamZeroMQ(Ctx* newCtx, const char* newUri);
@@ -37,6 +46,9 @@ namespace OpenLogReplicator {
         void initializeClient() override;
         void initializeServer() override;
         void sendMessage(const void* msg, uint64_t length) override;
+        void sendMessage(const struct iovec* segments, uint64_t segmentsCount, uint64_t length) override;
+        void queueMessage(const struct iovec* segments, uint64_t segmentsCount, uint64_t length) override;
+        void waitForMessage(uint64_t timeUs, int eventFD) override;
         uint64_t receiveMessage(void* msg, uint64_t length) override;
         uint64_t receiveMessageNB(void* msg, uint64_t length) override;
         [[nodiscard]] bool isConnected() override;
@@ -31,10 +31,14 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 namespace OpenLogReplicator {
     Writer::Writer(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata) :
-            Thread(newCtx, newAlias),
+            Thread(newCtx, newAlias, THREAD_ROLE_WRITER),
             database(newDatabase),
             builder(newBuilder),
             metadata(newMetadata),
+            builderWriterId(0),
+            metadataWriterId(0),
+            clientScn(ZERO_SCN),
+            clientIdx(0),
             builderQueue(nullptr),
             checkpointScn(ZERO_SCN),
             checkpointIdx(0),
@@ -44,9 +48,16 @@ namespace OpenLogReplicator {
             currentQueueSize(0),
             maxQueueSize(0),
             streaming(false),
+            builderWorkSeq(0),
             confirmedScn(ZERO_SCN),
             confirmedIdx(0),
-            queue(nullptr) {
+            queue(nullptr),
+            queueConfirmed(nullptr),
+            queueAllocated(nullptr),
+            queueFirstId(0),
+            confirmRequests(0) {
+        builderWriterId = builder->addWriter();
+        metadataWriterId = metadata->addWriter();
     }
 
     Writer::~Writer() {
@@ -54,61 +65,82 @@ namespace OpenLogReplicator {
             delete[] queue;
             queue = nullptr;
         }
+
+        if (queueConfirmed != nullptr) {
+            delete[] queueConfirmed;
+            queueConfirmed = nullptr;
+        }
+
+        if (queueAllocated != nullptr) {
+            for (uint64_t i = 0; i < ctx->queueSize; ++i)
+                delete[] queueAllocated[i];
+            delete[] queueAllocated;
+            queueAllocated = nullptr;
+        }
     }
 
     void Writer::initialize() {
         if (queue != nullptr)
             return;
         queue = new BuilderMsg*[ctx->queueSize];
+
+        // One bit per queue position
+        uint64_t queueConfirmedSize = (ctx->queueSize + 63) / 64;
+        queueConfirmed = new std::atomic<uint64_t>[queueConfirmedSize];
+        for (uint64_t i = 0; i < queueConfirmedSize; ++i)
+            queueConfirmed[i] = 0;
+
+        queueAllocated = new uint8_t*[ctx->queueSize];
+        for (uint64_t i = 0; i < ctx->queueSize; ++i)
+            queueAllocated[i] = nullptr;
     }
 
     void Writer::createMessage(BuilderMsg* msg) {
         ++sentMessages;
 
-        queue[currentQueueSize++] = msg;
-        if (currentQueueSize > maxQueueSize)
-            maxQueueSize = currentQueueSize;
+        // Message ids are consecutive, the position in the ring is determined by the id
+        if (currentQueueSize == 0)
+            queueFirstId = msg->id;
+        queue[msg->id % ctx->queueSize] = msg;
+
+        uint64_t queueSize = ++currentQueueSize;
+        if (queueSize > maxQueueSize)
+            maxQueueSize = queueSize;
     }
 
-    void Writer::sortQueue() {
-        if (currentQueueSize == 0)
-            return;
+    uint8_t* Writer::allocateMessage(BuilderMsg* msg, uint64_t length) {
+        uint64_t pos = msg->id % ctx->queueSize;
+        delete[] queueAllocated[pos];
+        queueAllocated[pos] = new uint8_t[length];
+        if (queueAllocated[pos] == nullptr)
+            throw RuntimeException(10016, "couldn't allocate " + std::to_string(length) + " bytes memory for: temporary buffer for message");
+        return queueAllocated[pos];
+    }
 
-        BuilderMsg** oldQueue = queue;
-        queue = new BuilderMsg*[ctx->queueSize];
-        uint64_t oldQueueSize = currentQueueSize;
-
-        for (uint64_t newId = 0 ; newId < currentQueueSize; ++newId) {
-            queue[newId] = oldQueue[0];
-            uint64_t i = 0;
-            --oldQueueSize;
-            while (i < oldQueueSize) {
-                if (i * 2 + 2 < oldQueueSize && oldQueue[i * 2 + 2]->id < oldQueue[oldQueueSize]->id) {
-                    if (oldQueue[i * 2 + 1]->id < oldQueue[i * 2 + 2]->id) {
-                        oldQueue[i] = oldQueue[i * 2 + 1];
-                        i = i * 2 + 1;
-                    } else {
-                        oldQueue[i] = oldQueue[i * 2 + 2];
-                        i = i * 2 + 2;
-                    }
-                } else if (i * 2 + 1 < oldQueueSize && oldQueue[i * 2 + 1]->id < oldQueue[oldQueueSize]->id) {
-                    oldQueue[i] = oldQueue[i * 2 + 1];
-                    i = i * 2 + 1;
-                } else
-                    break;
-            }
-            oldQueue[i] = oldQueue[oldQueueSize];
-        }
+    bool Writer::isNewData(typeScn scn, typeIdx idx) const {
+        if (clientScn == ZERO_SCN)
+            return true;
 
-        if (oldQueue != nullptr)
-            delete[] oldQueue;
+        if (clientScn < scn)
+            return true;
+
+        if (clientScn == scn && clientIdx < idx)
+            return true;
+
+        return false;
+    }
+
+    // The name does not depend on the order of targets in the configuration
+    std::string Writer::checkpointName() const {
+        return database + "-" + alias + "-chkpt";
     }
 
     void Writer::resetMessageQueue() {
         for (uint64_t i = 0; i < currentQueueSize; ++i) {
-            BuilderMsg* msg = queue[i];
-            if ((msg->flags & OUTPUT_BUFFER_MESSAGE_ALLOCATED) != 0)
-                delete[] msg->data;
+            uint64_t pos = (queueFirstId + i) % ctx->queueSize;
+            delete[] queueAllocated[pos];
+            queueAllocated[pos] = nullptr;
+            queueConfirmed[pos / 64] &= ~(1ULL << (pos % 64));
         }
         currentQueueSize = 0;
 
@@ -116,56 +148,100 @@ namespace OpenLogReplicator {
     }
 
     void Writer::confirmMessage(BuilderMsg* msg) {
-        std::unique_lock<std::mutex> lck(mtx);
-
         if (msg == nullptr) {
             if (currentQueueSize == 0) {
                 ctx->warning(70007, "trying to confirm an empty message");
                 return;
             }
-            msg = queue[0];
+            msg = queue[queueFirstId % ctx->queueSize];
         }
 
-        msg->flags |= OUTPUT_BUFFER_MESSAGE_CONFIRMED;
-        if (msg->flags & OUTPUT_BUFFER_MESSAGE_ALLOCATED) {
-            delete[] msg->data;
-            msg->flags &= ~OUTPUT_BUFFER_MESSAGE_ALLOCATED;
+        uint64_t pos = msg->id % ctx->queueSize;
+        if (queueAllocated[pos] != nullptr) {
+            delete[] queueAllocated[pos];
+            queueAllocated[pos] = nullptr;
         }
+        queueConfirmed[pos / 64].fetch_or(1ULL << (pos % 64));
+
+        // Only one thread moves the low watermark, others just leave the request
+        if (confirmRequests.fetch_add(1) != 0)
+            return;
 
+        uint64_t requests;
+        do {
+            requests = confirmRequests;
+            advanceConfirmed();
+        } while (confirmRequests.fetch_sub(requests) != requests);
+    }
+
+    void Writer::advanceConfirmed() {
+        uint64_t firstId = queueFirstId;
+        uint64_t queueSize = currentQueueSize;
+        uint64_t confirmed = 0;
+        typeScn newConfirmedScn = confirmedScn;
+        typeIdx newConfirmedIdx = confirmedIdx;
         uint64_t maxId = 0;
-        {
-            while (currentQueueSize > 0 && (queue[0]->flags & OUTPUT_BUFFER_MESSAGE_CONFIRMED) != 0) {
-                maxId = queue[0]->queueId;
-                if (confirmedScn == ZERO_SCN || msg->lwnScn > confirmedScn) {
-                    confirmedScn = msg->lwnScn;
-                    confirmedIdx = msg->lwnIdx;
-                } else if (msg->lwnScn == confirmedScn && msg->lwnIdx > confirmedIdx)
-                    confirmedIdx = msg->lwnIdx;
-
-                if (--currentQueueSize == 0)
-                    break;
 
-                uint64_t i = 0;
-                while (i < currentQueueSize) {
-                    if (i * 2 + 2 < currentQueueSize && queue[i * 2 + 2]->id < queue[currentQueueSize]->id) {
-                        if (queue[i * 2 + 1]->id < queue[i * 2 + 2]->id) {
-                            queue[i] = queue[i * 2 + 1];
-                            i = i * 2 + 1;
-                        } else {
-                            queue[i] = queue[i * 2 + 2];
-                            i = i * 2 + 2;
-                        }
-                    } else if (i * 2 + 1 < currentQueueSize && queue[i * 2 + 1]->id < queue[currentQueueSize]->id) {
-                        queue[i] = queue[i * 2 + 1];
-                        i = i * 2 + 1;
-                    } else
-                        break;
-                }
-                queue[i] = queue[currentQueueSize];
-            }
+        while (confirmed < queueSize) {
+            uint64_t pos = (firstId + confirmed) % ctx->queueSize;
+            uint64_t mask = 1ULL << (pos % 64);
+            if ((queueConfirmed[pos / 64] & mask) == 0)
+                break;
+            queueConfirmed[pos / 64].fetch_and(~mask);
+
+            BuilderMsg* msg = queue[pos];
+            maxId = msg->queueId;
+            if (newConfirmedScn == ZERO_SCN || msg->lwnScn > newConfirmedScn) {
+                newConfirmedScn = msg->lwnScn;
+                newConfirmedIdx = msg->lwnIdx;
+            } else if (msg->lwnScn == newConfirmedScn && msg->lwnIdx > newConfirmedIdx)
+                newConfirmedIdx = msg->lwnIdx;
+            ++confirmed;
+        }
+
+        if (confirmed == 0)
+            return;
+
+        {
+            std::unique_lock<std::mutex> lck(mtx);
+            confirmedScn = newConfirmedScn;
+            confirmedIdx = newConfirmedIdx;
+            queueFirstId = firstId + confirmed;
+            currentQueueSize -= confirmed;
+            condQueue.notify_all();
         }
 
-        builder->releaseBuffers(maxId);
+        builder->releaseBuffers(builderWriterId, maxId);
+    }
+
+    void Writer::flush() {
+    }
+
+    // Writers with a client connection wait for the client, others just for the replicator to start
+    void Writer::waitForClient() {
+        metadata->waitForReplication(ctx->pollIntervalUs);
+    }
+
+    // Writers which receive confirmations in their own thread wait for them in the way the confirmations arrive
+    void Writer::waitForQueue() {
+        std::unique_lock<std::mutex> lck(mtx);
+        condQueue.wait_for(lck, std::chrono::microseconds(ctx->pollIntervalUs),
+                           [&] { return currentQueueSize < ctx->queueSize || ctx->hardShutdown; });
+    }
+
+    // Writers without own events wait for the builder, with messages in flight just for the poll interval to check confirmations
+    void Writer::waitForWork() {
+        builder->sleepForWriterWork(builderWorkSeq, currentQueueSize, ctx->pollIntervalUs);
+    }
+
+    uint64_t Writer::idleWaitUs() const {
+        if (currentQueueSize > 0)
+            return ctx->pollIntervalUs;
+        return WRITER_IDLE_WAIT_US;
+    }
+
+    // Called by the builder thread for writers registered with setWriterNotify() when new data is committed
+    void Writer::notifyWork() {
     }
 
     void Writer::run() {
@@ -176,10 +252,13 @@ namespace OpenLogReplicator {
         }
 
         ctx->info(0, "writer is starting with " + getName());
+        ctx->bindNumaNode(ctx->numaNodeWriter, THREAD_ROLE_WRITER);
 
         try {
             // Before anything, read the latest checkpoint
             readCheckpoint();
+            // Replication starts from the oldest checkpoint of all writers of the source
+            metadata->waitForWriters();
             builderQueue = builder->firstBuilderQueue;
             oldLength = 0;
             currentQueueSize = 0;
@@ -230,7 +309,7 @@ namespace OpenLogReplicator {
 
                 if (ctx->trace & TRACE_WRITER)
                     ctx->logTrace(TRACE_WRITER, "waiting for client");
-                usleep(ctx->pollIntervalUs);
+                waitForClient();
             }
 
             // Get a message to send
@@ -257,7 +336,9 @@ namespace OpenLogReplicator {
 
                 if (ctx->softShutdown && ctx->replicatorFinished)
                     break;
-                builder->sleepForWriterWork(currentQueueSize, ctx->pollIntervalUs);
+                // Nothing more to send at the moment - write out messages gathered so far
+                flush();
+                waitForWork();
             }
 
             // Send the message
@@ -268,11 +349,13 @@ namespace OpenLogReplicator {
 
                 // The queue is full
                 pollQueue();
+                if (currentQueueSize >= ctx->queueSize)
+                    flush();
                 while (currentQueueSize >= ctx->queueSize && !ctx->hardShutdown) {
                     if (ctx->trace & TRACE_WRITER)
                         ctx->logTrace(TRACE_WRITER, "output queue is full (" + std::to_string(currentQueueSize) +
-                                      " elements), sleeping " + std::to_string(ctx->pollIntervalUs) + "us");
-                    usleep(ctx->pollIntervalUs);
+                                      " elements), waiting for confirmations");
+                    waitForQueue();
                     pollQueue();
                 }
 
@@ -288,45 +371,57 @@ namespace OpenLogReplicator {
                     createMessage(msg);
                     // Send the message to the client in one part
                     if (((msg->flags & OUTPUT_BUFFER_MESSAGE_CHECKPOINT) && !FLAG(REDO_FLAGS_SHOW_CHECKPOINT)) ||
-                            !metadata->isNewData(msg->lwnScn, msg->lwnIdx))
+                            !isNewData(msg->lwnScn, msg->lwnIdx))
                         confirmMessage(msg);
-                    else
-                        sendMessage(msg);
+                    else {
+                        tag.assign(reinterpret_cast<const char*>(msg->data), msg->tagSize);
+                        struct iovec segment = {reinterpret_cast<void*>(msg->data + msg->tagSize), msg->length - msg->tagSize};
+                        sendMessage(msg, &segment, 1);
+                    }
                     oldLength += length8;
 
-                // The message is split to many parts - merge & copy
+                // The message is split to many parts - send parts directly from the buffers
                 } else {
-                    msg->data = new uint8_t[msg->length];
-                    if (msg->data == nullptr)
-                        throw RuntimeException(10016, "couldn't allocate " + std::to_string(msg->length) +
-                                               " bytes memory for: temporary buffer for JSON message");
-                    msg->flags |= OUTPUT_BUFFER_MESSAGE_ALLOCATED;
-
-                    uint64_t copied = 0;
-                    while (msg->length > copied) {
-                        uint64_t toCopy = msg->length - copied;
-                        if (toCopy > newLength - oldLength) {
-                            toCopy = newLength - oldLength;
-                            memcpy(reinterpret_cast<void*>(msg->data + copied),
-                                   reinterpret_cast<const void*>(builderQueue->data + oldLength), toCopy);
+                    segments.clear();
+                    uint64_t collected = 0;
+                    while (msg->length > collected) {
+                        uint64_t toCollect = msg->length - collected;
+                        if (toCollect > newLength - oldLength) {
+                            toCollect = newLength - oldLength;
+                            if (toCollect > 0)
+                                segments.push_back({reinterpret_cast<void*>(builderQueue->data + oldLength), toCollect});
                             builderQueue = builderQueue->next;
                             newLength = OUTPUT_BUFFER_DATA_SIZE;
                             oldLength = 0;
                         } else {
-                            memcpy(reinterpret_cast<void*>(msg->data + copied),
-                                   reinterpret_cast<const void*>(builderQueue->data + oldLength), toCopy);
-                            oldLength += (toCopy + 7) & 0xFFFFFFFFFFFFFFF8;
+                            segments.push_back({reinterpret_cast<void*>(builderQueue->data + oldLength), toCollect});
+                            oldLength += (toCollect + 7) & 0xFFFFFFFFFFFFFFF8;
                         }
-                        copied += toCopy;
+                        collected += toCollect;
                     }
 
                     createMessage(msg);
                     // Send only new messages to the client
                     if (((msg->flags & OUTPUT_BUFFER_MESSAGE_CHECKPOINT) && !FLAG(REDO_FLAGS_SHOW_CHECKPOINT)) ||
-                            !metadata->isNewData(msg->lwnScn, msg->lwnIdx))
+                            !isNewData(msg->lwnScn, msg->lwnIdx))
                         confirmMessage(msg);
-                    else
-                        sendMessage(msg);
+                    else {
+                        // Routing tag is not a part of the message content
+                        tag.clear();
+                        auto segmentsIt = segments.begin();
+                        while (tag.length() < msg->tagSize) {
+                            uint64_t toTag = msg->tagSize - tag.length();
+                            if (toTag > segmentsIt->iov_len)
+                                toTag = segmentsIt->iov_len;
+                            tag.append(reinterpret_cast<const char*>(segmentsIt->iov_base), toTag);
+                            segmentsIt->iov_base = reinterpret_cast<uint8_t*>(segmentsIt->iov_base) + toTag;
+                            segmentsIt->iov_len -= toTag;
+                            if (segmentsIt->iov_len == 0)
+                                ++segmentsIt;
+                        }
+                        segments.erase(segments.begin(), segmentsIt);
+                        sendMessage(msg, segments.data(), segments.size());
+                    }
                     break;
                 }
             }
@@ -340,12 +435,21 @@ namespace OpenLogReplicator {
             }
         }
 
+        flush();
         writeCheckpoint(true);
     }
 
     void Writer::writeCheckpoint(bool force) {
+        typeScn currentConfirmedScn;
+        typeIdx currentConfirmedIdx;
+        {
+            std::unique_lock<std::mutex> lck(mtx);
+            currentConfirmedScn = confirmedScn;
+            currentConfirmedIdx = confirmedIdx;
+        }
+
         // Nothing changed
-        if ((checkpointScn == confirmedScn && checkpointIdx == confirmedIdx) || confirmedScn == ZERO_SCN)
+        if ((checkpointScn == currentConfirmedScn && checkpointIdx == currentConfirmedIdx) || currentConfirmedScn == ZERO_SCN)
             return;
 
         // Force first checkpoint
@@ -360,37 +464,44 @@ namespace OpenLogReplicator {
 
         if (ctx->trace & TRACE_CHECKPOINT) {
             if (checkpointScn == ZERO_SCN)
-                ctx->logTrace(TRACE_CHECKPOINT, "writer confirmed scn: " + std::to_string(confirmedScn) + " idx: " +
-                        std::to_string(confirmedIdx));
+                ctx->logTrace(TRACE_CHECKPOINT, "writer confirmed scn: " + std::to_string(currentConfirmedScn) + " idx: " +
+                        std::to_string(currentConfirmedIdx));
             else
-                ctx->logTrace(TRACE_CHECKPOINT, "writer confirmed scn: " + std::to_string(confirmedScn) + " idx: " +
-                        std::to_string(confirmedIdx) + " checkpoint scn: " + std::to_string(checkpointScn) + " idx: " +
+                ctx->logTrace(TRACE_CHECKPOINT, "writer confirmed scn: " + std::to_string(currentConfirmedScn) + " idx: " +
+                        std::to_string(currentConfirmedIdx) + " checkpoint scn: " + std::to_string(checkpointScn) + " idx: " +
                         std::to_string(checkpointIdx));
         }
-        std::string name(database + "-chkpt");
+        std::string name(checkpointName());
         std::ostringstream ss;
         ss << R"({"database":")" << database
-                << R"(","scn":)" << std::dec << confirmedScn
-                << R"(,"idx":)" << std::dec << confirmedIdx
+                << R"(","scn":)" << std::dec << currentConfirmedScn
+                << R"(,"idx":)" << std::dec << currentConfirmedIdx
                 << R"(,"resetlogs":)" << std::dec << metadata->resetlogs
                 << R"(,"activation":)" << std::dec << metadata->activation << "}";
 
-        if (metadata->stateWrite(name, confirmedScn, ss)) {
-            checkpointScn = confirmedScn;
-            checkpointIdx = confirmedIdx;
+        if (metadata->stateWrite(name, currentConfirmedScn, ss)) {
+            checkpointScn = currentConfirmedScn;
+            checkpointIdx = currentConfirmedIdx;
             checkpointTime = now;
         }
     }
 
     void Writer::readCheckpoint() {
         std::ifstream infile;
-        std::string name(database + "-chkpt");
+        std::string name(checkpointName());
 
         // Checkpoint is present - read it
         std::string checkpoint;
         rapidjson::Document document;
-        if (!metadata->stateRead(name, CHECKPOINT_FILE_MAX_SIZE, checkpoint))
-            return;
+        if (!metadata->stateRead(name, CHECKPOINT_FILE_MAX_SIZE, checkpoint)) {
+            // Checkpoint shared by all writers before each writer had its own one, the next write goes to the new name
+            name = database + "-chkpt";
+            if (!metadata->stateRead(name, CHECKPOINT_FILE_MAX_SIZE, checkpoint)) {
+                metadata->setWriterCheckpoint(metadataWriterId, false, 0, 0, ZERO_SCN, 0);
+                return;
+            }
+            ctx->info(0, "checkpoint - writer " + getName() + " starting from legacy checkpoint: " + name);
+        }
 
         if (checkpoint.length() == 0 || document.Parse(checkpoint.c_str()).HasParseError())
             throw DataException(20001, "file: " + name + " offset: " + std::to_string(document.GetErrorOffset()) +
@@ -400,29 +511,30 @@ namespace OpenLogReplicator {
         if (database != databaseJson)
             throw DataException(20001, "file: " + name + " - invalid database name: " + databaseJson);
 
-        metadata->setResetlogs(Ctx::getJsonFieldU32(name, document, "resetlogs"));
-        metadata->setActivation(Ctx::getJsonFieldU32(name, document, "activation"));
+        typeResetlogs checkpointResetlogs = Ctx::getJsonFieldU32(name, document, "resetlogs");
+        typeActivation checkpointActivation = Ctx::getJsonFieldU32(name, document, "activation");
 
         // Started earlier - continue work & ignore default startup parameters
         checkpointScn = Ctx::getJsonFieldU64(name, document, "scn");
-        metadata->clientScn = checkpointScn;
         if (document.HasMember("idx"))
             checkpointIdx = Ctx::getJsonFieldU64(name, document, "idx");
         else
             checkpointIdx = 0;
-        metadata->clientIdx = checkpointIdx;
-        metadata->startScn = checkpointScn;
-        metadata->startSequence = ZERO_SEQ;
-        metadata->startTime.clear();
-        metadata->startTimeRel = 0;
+        clientScn = checkpointScn;
+        clientIdx = checkpointIdx;
 
-        ctx->info(0, "checkpoint - all confirmed till scn: " + std::to_string(checkpointScn) + ", idx: " +
+        ctx->info(0, "checkpoint - writer " + getName() + " confirmed till scn: " + std::to_string(checkpointScn) + ", idx: " +
                 std::to_string(checkpointIdx));
-        metadata->setStatusReplicate();
+        metadata->setWriterCheckpoint(metadataWriterId, true, checkpointResetlogs, checkpointActivation, checkpointScn, checkpointIdx);
     }
 
     void Writer::wakeUp() {
         Thread::wakeUp();
         builder->wakeUp();
+        metadata->wakeUp();
+        {
+            std::unique_lock<std::mutex> lck(mtx);
+            condQueue.notify_all();
+        }
     }
 }
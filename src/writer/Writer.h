@@ -17,12 +17,19 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <sys/uio.h>
+#include <vector>
+
 #include "../common/Thread.h"
 
 #ifndef WRITER_H_
 #define WRITER_H_
 
+#define WRITER_IDLE_WAIT_US         5000000
+
 namespace OpenLogReplicator {
     class Builder;
     struct BuilderMsg;
@@ -34,6 +41,12 @@ namespace OpenLogReplicator {
         std::string database;
         Builder* builder;
         Metadata* metadata;
+        // Position of the writer among the writers reading the same builder
+        uint64_t builderWriterId;
+        uint64_t metadataWriterId;
+        // scn,idx from which this writer sends data
+        typeScn clientScn;
+        typeIdx clientIdx;
         // Information about local checkpoint
         BuilderQueue* builderQueue;
         typeScn checkpointScn;
@@ -41,26 +54,47 @@ namespace OpenLogReplicator {
         time_t checkpointTime;
         uint64_t sentMessages;
         uint64_t oldLength;
-        uint64_t currentQueueSize;
+        std::atomic<uint64_t> currentQueueSize;
         uint64_t maxQueueSize;
         bool streaming;
+        // Last notification of new data from the builder seen by the writer
+        uint64_t builderWorkSeq;
 
         std::mutex mtx;
+        std::condition_variable condQueue;
         // scn,idx confirmed by client
         typeScn confirmedScn;
         typeIdx confirmedIdx;
+        // Ring of sent messages indexed by id % queueSize, oldest not confirmed message is queueFirstId
         BuilderMsg** queue;
+        std::atomic<uint64_t>* queueConfirmed;
+        // Copies of messages gathered from many builder buffers, the builder message is shared with other writers
+        uint8_t** queueAllocated;
+        std::atomic<uint64_t> queueFirstId;
+        std::atomic<uint64_t> confirmRequests;
+        // Parts of a message which spans many builder buffers
+        std::vector<struct iovec> segments;
+        // Routing tag of the message (owner, table, key) - set only when requested from the builder
+        std::string tag;
 
         void createMessage(BuilderMsg* msg);
-        virtual void sendMessage(BuilderMsg* msg) = 0;
+        uint8_t* allocateMessage(BuilderMsg* msg, uint64_t length);
+        bool isNewData(typeScn scn, typeIdx idx) const;
+        std::string checkpointName() const;
+        virtual void sendMessage(BuilderMsg* msg, const struct iovec* msgSegments, uint64_t msgSegmentsCount) = 0;
         virtual std::string getName() const = 0;
         virtual void pollQueue() = 0;
+        virtual void flush();
+        virtual void waitForClient();
+        virtual void waitForQueue();
+        virtual void waitForWork();
+        uint64_t idleWaitUs() const;
         void run() override;
         void mainLoop();
         virtual void writeCheckpoint(bool force);
         void readCheckpoint();
-        void sortQueue();
         void resetMessageQueue();
+        void advanceConfirmed();
 
     public:
         Writer(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata);
@@ -68,6 +102,7 @@ namespace OpenLogReplicator {
 
         virtual void initialize();
         void confirmMessage(BuilderMsg* msg);
+        virtual void notifyWork();
         void wakeUp() override;
     };
 }
@@ -20,10 +20,12 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #define _LARGEFILE_SOURCE
 #define _FILE_OFFSET_BITS 64
 
+#include <climits>
 #include <cstring>
 #include <dirent.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "../builder/Builder.h"
@@ -34,7 +36,8 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 
 namespace OpenLogReplicator {
     WriterFile::WriterFile(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata,
-                           const char* newOutput, const char* newTimestampFormat, uint64_t newMaxFileSize, uint64_t newNewLine, uint64_t newAppend) :
+                           const char* newOutput, const char* newTimestampFormat, uint64_t newMaxFileSize, uint64_t newNewLine, uint64_t newAppend,
+                           uint64_t newWriteBufferFlushSize, uint64_t newWriteSync) :
             Writer(newCtx, newAlias, newDatabase, newBuilder, newMetadata),
             prefixPos(0),
             suffixPos(0),
@@ -50,7 +53,10 @@ namespace OpenLogReplicator {
             append(newAppend),
             lastSequence(ZERO_SEQ),
             newLineMsg(nullptr),
-            warningDisplayed(false) {
+            warningDisplayed(false),
+            writeBufferFlushSize(newWriteBufferFlushSize),
+            writeSync(newWriteSync),
+            fileSegmentsLength(0) {
     }
 
     WriterFile::~WriterFile() {
@@ -207,6 +213,7 @@ namespace OpenLogReplicator {
             fullFileName = pathName + "/" + fileNameMask;
         } else if (mode == WRITER_FILE_MODE_NUM) {
             if (fileSize + length > maxFileSize) {
+                flush();
                 closeFile();
                 ++fileNameNum;
                 fileSize = 0;
@@ -250,11 +257,13 @@ namespace OpenLogReplicator {
             }
 
             if (shouldSwitch) {
+                flush();
                 closeFile();
                 fileSize = 0;
             }
         } else if (mode == WRITER_FILE_MODE_SEQUENCE) {
             if (sequence != lastSequence) {
+                flush();
                 closeFile();
             }
 
@@ -287,28 +296,70 @@ namespace OpenLogReplicator {
         }
     }
 
-    void WriterFile::sendMessage(BuilderMsg* msg) {
+    void WriterFile::writeSegments(const struct iovec* writeSegments, uint64_t writeSegmentsCount, uint64_t length) {
+        uint64_t written = 0;
+        while (writeSegmentsCount > 0) {
+            uint64_t count = writeSegmentsCount;
+            if (count > IOV_MAX)
+                count = IOV_MAX;
+
+            uint64_t toWrite = 0;
+            for (uint64_t i = 0; i < count; ++i)
+                toWrite += writeSegments[i].iov_len;
+
+            int64_t bytesWritten = writev(outputDes, writeSegments, static_cast<int>(count));
+            if (bytesWritten > 0)
+                written += bytesWritten;
+            if (static_cast<uint64_t>(bytesWritten) != toWrite)
+                throw RuntimeException(10007, "file: " + fullFileName + " - " + std::to_string(written) + " bytes written instead of " +
+                                       std::to_string(length) + ", code returned: " + strerror(errno));
+
+            writeSegments += count;
+            writeSegmentsCount -= count;
+        }
+    }
+
+    void WriterFile::sendMessage(BuilderMsg* msg, const struct iovec* msgSegments, uint64_t msgSegmentsCount) {
+        uint64_t length = msg->length - msg->tagSize;
         if (newLine > 0)
-            checkFile(msg->scn, msg->sequence, msg->length + 1);
+            checkFile(msg->scn, msg->sequence, length + 1);
         else
-            checkFile(msg->scn, msg->sequence, msg->length);
+            checkFile(msg->scn, msg->sequence, length);
+
+        // Payload and the new line separator are gathered and written with one call
+        fileSegments.insert(fileSegments.end(), msgSegments, msgSegments + msgSegmentsCount);
+        if (newLine > 0)
+            fileSegments.push_back({const_cast<char*>(newLineMsg), newLine});
+        fileMessages.push_back(msg);
+        fileSegmentsLength += length + newLine;
+        fileSize += length + newLine;
 
-        int64_t bytesWritten = write(outputDes, reinterpret_cast<const char*>(msg->data), msg->length);
-        if (static_cast<uint64_t>(bytesWritten) != msg->length)
-            throw RuntimeException(10007, "file: " + fullFileName + " - " + std::to_string(bytesWritten) + " bytes written instead of " +
-                                   std::to_string(msg->length) + ", code returned: " + strerror(errno));
+        if (fileSegmentsLength >= writeBufferFlushSize || fileSegments.size() >= IOV_MAX)
+            flush();
+    }
+
+    void WriterFile::flush() {
+        if (fileMessages.empty())
+            return;
 
-        fileSize += bytesWritten;
+        writeSegments(fileSegments.data(), fileSegments.size(), fileSegmentsLength);
 
-        if (newLine > 0) {
-            bytesWritten = write(outputDes, newLineMsg, newLine);
-            if (static_cast<uint64_t>(bytesWritten) != newLine)
-                throw RuntimeException(10007, "file: " + fullFileName + " - " + std::to_string(bytesWritten) + " bytes written instead of " +
-                                       std::to_string(msg->length) + ", code returned: " + strerror(errno));
-            fileSize += bytesWritten;
+        // Group commit - the whole batch is durable before any message is confirmed
+        if (writeSync > 0 && outputDes != STDOUT_FILENO) {
+            if (fdatasync(outputDes) != 0)
+                throw RuntimeException(10068, "file: " + fullFileName + " - fdatasync returned: " + strerror(errno));
         }
 
-        confirmMessage(msg);
+        if (ctx->trace & TRACE_WRITER)
+            ctx->logTrace(TRACE_WRITER, "flushed " + std::to_string(fileMessages.size()) + " messages, " +
+                          std::to_string(fileSegmentsLength) + " bytes to: " + fullFileName);
+
+        for (BuilderMsg* msg : fileMessages)
+            confirmMessage(msg);
+
+        fileSegments.clear();
+        fileMessages.clear();
+        fileSegmentsLength = 0;
     }
 
     std::string WriterFile::getName() const {
@@ -49,15 +49,24 @@ namespace OpenLogReplicator {
         typeSeq lastSequence;
         const char* newLineMsg;
         bool warningDisplayed;
+        uint64_t writeBufferFlushSize;
+        uint64_t writeSync;
+        // Messages gathered to be written with one call
+        std::vector<struct iovec> fileSegments;
+        std::vector<BuilderMsg*> fileMessages;
+        uint64_t fileSegmentsLength;
         void closeFile();
         void checkFile(typeScn scn, typeSeq sequence, uint64_t length);
-        void sendMessage(BuilderMsg* msg) override;
+        void writeSegments(const struct iovec* writeSegments, uint64_t writeSegmentsCount, uint64_t length);
+        void sendMessage(BuilderMsg* msg, const struct iovec* msgSegments, uint64_t msgSegmentsCount) override;
         std::string getName() const override;
         void pollQueue() override;
+        void flush() override;
 
     public:
         WriterFile(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata, const char* newOutput,
-                   const char* newTimestampFormat, uint64_t newMaxFileSize, uint64_t newNewLine, uint64_t newAppend);
+                   const char* newTimestampFormat, uint64_t newMaxFileSize, uint64_t newNewLine, uint64_t newAppend, uint64_t newWriteBufferFlushSize,
+                   uint64_t newWriteSync);
         ~WriterFile() override;
 
         void initialize() override;
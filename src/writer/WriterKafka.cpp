@@ -17,6 +17,10 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+
 #include "../builder/Builder.h"
 #include "../common/ConfigurationException.h"
 #include "../common/RuntimeException.h"
@@ -24,21 +28,70 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include "WriterKafka.h"
 
 namespace OpenLogReplicator {
+    WriterKafkaDelivery::WriterKafkaDelivery(Ctx* newCtx, const std::string& newAlias, WriterKafka* newWriter) :
+        Thread(newCtx, newAlias, THREAD_ROLE_WRITER),
+        writer(newWriter) {
+        threadName = "olr-delivery";
+    }
+
+    void WriterKafkaDelivery::run() {
+        if (ctx->trace & TRACE_THREADS) {
+            std::ostringstream ss;
+            ss << std::this_thread::get_id();
+            ctx->logTrace(TRACE_THREADS, "writer delivery (" + ss.str() + ") start");
+        }
+
+        // Delivery reports are processed until the writer thread stops, also on shutdown: a blocked produce call waits for them to free the queue
+        bool purged = false;
+        while (!writer->finished) {
+            if (ctx->hardShutdown && !purged) {
+                writer->purgeQueue();
+                purged = true;
+            }
+            writer->pollEvents();
+        }
+
+        if (ctx->trace & TRACE_THREADS) {
+            std::ostringstream ss;
+            ss << std::this_thread::get_id();
+            ctx->logTrace(TRACE_THREADS, "writer delivery (" + ss.str() + ") stop");
+        }
+    }
+
     WriterKafka::WriterKafka(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata,
-                             const char* newTopic) :
+                             const char* newTopic, uint64_t newKey, uint64_t newBatchSize) :
         Writer(newCtx, newAlias, newDatabase, newBuilder, newMetadata),
         topic(newTopic),
+        key(newKey),
+        batchSize(newBatchSize),
+        batchRkt(nullptr),
+        delivery(nullptr),
+        eventQueue(nullptr),
         rk(nullptr),
         rkt(nullptr),
         conf(nullptr) {
     }
 
     WriterKafka::~WriterKafka() {
+        if (delivery != nullptr) {
+            ctx->finishThread(delivery);
+            delete delivery;
+            delivery = nullptr;
+        }
+
         if (conf != nullptr)
             rd_kafka_conf_destroy(conf);
 
-        if (rkt != nullptr)
-            rd_kafka_topic_destroy(rkt);
+        if (eventQueue != nullptr) {
+            rd_kafka_queue_destroy(eventQueue);
+            eventQueue = nullptr;
+        }
+
+        for (auto& topicHandle : topicHandles)
+            rd_kafka_topic_destroy(topicHandle.second);
+        topicHandles.clear();
+        tableTopics.clear();
+        rkt = nullptr;
 
         rd_kafka_resp_err_t err = rd_kafka_fatal_error(rk, nullptr, 0);
         if (rk != nullptr)
@@ -47,10 +100,14 @@ namespace OpenLogReplicator {
         ctx->info(0, "Kafka producer exit code: " + std::to_string(err));
     }
 
-    void WriterKafka::addProperty(const std::string& key, const std::string& value) {
-        if (properties.find(key) != properties.end())
-            throw ConfigurationException(30009, "Kafka property '" + key + "' is defined multiple times");
-        properties.insert_or_assign(key, value);
+    void WriterKafka::addProperty(const std::string& propertyKey, const std::string& value) {
+        if (properties.find(propertyKey) != properties.end())
+            throw ConfigurationException(30009, "Kafka property '" + propertyKey + "' is defined multiple times");
+        properties.insert_or_assign(propertyKey, value);
+    }
+
+    void WriterKafka::addTopicRoute(const std::string& owner, const std::string& table, const std::string& routeTopic) {
+        topicRoutes.push_back({owner, table, routeTopic});
     }
 
     void WriterKafka::initialize() {
@@ -72,47 +129,89 @@ namespace OpenLogReplicator {
         if (properties.find("group.id") != properties.end())
             properties.insert_or_assign("group.id", "OpenLogReplicator");
 
+        // Messages with the same key go to the same partition, compatible with the Java client
+        if (key != KAFKA_KEY_NONE && properties.find("partitioner") == properties.end())
+            properties.insert_or_assign("partitioner", "murmur2_random");
+
         for (auto& property : properties)
             if (rd_kafka_conf_set(conf, property.first.c_str(), property.second.c_str(), errStr, sizeof(errStr)) != RD_KAFKA_CONF_OK)
                 throw RuntimeException(10059, "Kafka message: " + std::string(errStr));
 
+        // Delivery reports and errors are served as events by a dedicated thread
         rd_kafka_conf_set_opaque(conf, this);
-        rd_kafka_conf_set_dr_msg_cb(conf, dr_msg_cb);
-        rd_kafka_conf_set_error_cb(conf, error_cb);
+        rd_kafka_conf_set_events(conf, RD_KAFKA_EVENT_DR | RD_KAFKA_EVENT_ERROR);
         rd_kafka_conf_set_log_cb(conf, logger_cb);
 
         rk = rd_kafka_new(RD_KAFKA_PRODUCER, conf, errStr, sizeof(errStr));
         if (rk == nullptr)
             throw RuntimeException(10060, "Kafka failed to create producer, message: " + std::string(errStr));
         conf = nullptr;
+        eventQueue = rd_kafka_queue_get_main(rk);
 
         rkt = rd_kafka_topic_new(rk, topic.c_str(), nullptr);
+        if (rkt == nullptr)
+            throw RuntimeException(10069, "Kafka failed to create topic: " + topic + ", message: " + rd_kafka_err2str(rd_kafka_last_error()));
+        topicHandles.insert_or_assign(topic, rkt);
+        batchMessages.reserve(batchSize);
+        batchKeyOffsets.reserve(batchSize);
         streaming = true;
     }
 
-    void WriterKafka::dr_msg_cb(rd_kafka_t* rkCb __attribute__((unused)), const rd_kafka_message_t* rkMessage, void* opaque __attribute__((unused))) {
-        auto msg = reinterpret_cast<BuilderMsg*>(rkMessage->_private);
-        auto writer = reinterpret_cast<Writer*>(opaque);
-        if (rkMessage->err) {
-            writer->ctx->warning(70008, "Kafka: " + std::to_string(msg->id) + " delivery failed: " + rd_kafka_err2str(rkMessage->err));
-        } else {
-            writer->confirmMessage(msg);
-        }
+    void WriterKafka::run() {
+        delivery = new WriterKafkaDelivery(ctx, alias + "-delivery", this);
+        ctx->spawnThread(delivery);
+
+        Writer::run();
     }
 
-    void WriterKafka::error_cb(rd_kafka_t* rkCb, int err, const char* reason, void* opaque) {
-        auto writer = reinterpret_cast<Writer*>(opaque);
+    void WriterKafka::pollEvents() {
+        rd_kafka_event_t* event = rd_kafka_queue_poll(eventQueue, static_cast<int>(ctx->pollIntervalUs / 1000));
+        if (event == nullptr)
+            return;
 
-        writer->ctx->warning(70009, "Kafka: " + std::string(rd_kafka_err2name((rd_kafka_resp_err_t)err)) + ", reason: " + reason);
+        switch (rd_kafka_event_type(event)) {
+            case RD_KAFKA_EVENT_DR: {
+                const rd_kafka_message_t* rkMessage;
+                while ((rkMessage = rd_kafka_event_message_next(event)) != nullptr) {
+                    auto msg = reinterpret_cast<BuilderMsg*>(rkMessage->_private);
+                    if (rkMessage->err == RD_KAFKA_RESP_ERR__PURGE_QUEUE || rkMessage->err == RD_KAFKA_RESP_ERR__PURGE_INFLIGHT)
+                        continue;
+
+                    if (rkMessage->err) {
+                        // Confirmation is sequential, a lost message would block all further ones
+                        ctx->error(10078, "Kafka: message: " + std::to_string(msg->id) + " delivery failed: " + rd_kafka_err2str(rkMessage->err));
+                        ctx->stopHard();
+                    } else
+                        confirmMessage(msg);
+                }
+                break;
+            }
+
+            case RD_KAFKA_EVENT_ERROR: {
+                rd_kafka_resp_err_t err = rd_kafka_event_error(event);
+                ctx->warning(70009, "Kafka: " + std::string(rd_kafka_err2name(err)) + ", reason: " + rd_kafka_event_error_string(event));
+
+                if (rd_kafka_event_error_is_fatal(event)) {
+                    char errStrEvent[512];
+                    rd_kafka_resp_err_t origErr = rd_kafka_fatal_error(rk, errStrEvent, sizeof(errStrEvent));
+                    ctx->error(10057, "Kafka: fatal error: " + std::string(rd_kafka_err2name(origErr)) + ", reason: " + errStrEvent);
+                    ctx->stopHard();
+                }
+                break;
+            }
 
-        if (err != RD_KAFKA_RESP_ERR__FATAL)
-            return;
+            default:
+                break;
+        }
 
-        char errStrCb[512];
-        rd_kafka_resp_err_t orig_err = rd_kafka_fatal_error(rkCb, errStrCb, sizeof(errStrCb));
-        writer->ctx->error(10057, "Kafka: fatal error: " + std::string(rd_kafka_err2name(orig_err)) + ", reason: " + errStrCb);
+        rd_kafka_event_destroy(event);
+    }
 
-        writer->ctx->stopHard();
+    void WriterKafka::purgeQueue() {
+        // Messages not yet sent are dropped on shutdown, so a produce call blocked on a full queue can return
+        rd_kafka_resp_err_t err = rd_kafka_purge(rk, RD_KAFKA_PURGE_F_QUEUE);
+        if (err != RD_KAFKA_RESP_ERR_NO_ERROR)
+            ctx->warning(70009, "Kafka: " + std::string(rd_kafka_err2name(err)) + ", reason: purge of queued messages failed");
     }
 
     void WriterKafka::logger_cb(const rd_kafka_t* rkCb, int level, const char* fac, const char* buf) {
@@ -122,27 +221,129 @@ namespace OpenLogReplicator {
                                   ", fac: " + fac + ", err: " + buf);
     }
 
-    void WriterKafka::sendMessage(BuilderMsg* msg) {
-        msg->ptr = reinterpret_cast<void*>(this);
-        for(;;) {
-            rd_kafka_resp_err_t err = rd_kafka_producev(rk, RD_KAFKA_V_TOPIC(topic.c_str()), RD_KAFKA_V_VALUE(msg->data, msg->length),
-                    RD_KAFKA_V_OPAQUE(msg), RD_KAFKA_V_END);
-            // rd_kafka_resp_err_t err = (rd_kafka_resp_err_t)rd_kafka_produce(rkt, RD_KAFKA_PARTITION_UA, 0, msg->decoder, msg->length, nullptr, 0, msg);
+    rd_kafka_topic_t* WriterKafka::getTopic(const std::string& tableTag) {
+        auto tableTopicsIt = tableTopics.find(tableTag);
+        if (tableTopicsIt != tableTopics.end())
+            return tableTopicsIt->second;
+
+        std::string owner(tableTag.substr(0, tableTag.find('\0')));
+        std::string table(tableTag.substr(owner.length() + 1));
+        std::string topicName(topic);
+        for (const KafkaTopicRoute& topicRoute : topicRoutes) {
+            if ((!topicRoute.owner.empty() && topicRoute.owner != owner) || (!topicRoute.table.empty() && topicRoute.table != table))
+                continue;
+
+            // Expand template: %o - owner, %t - table
+            topicName.clear();
+            for (uint64_t i = 0; i < topicRoute.topic.length(); ++i) {
+                if (topicRoute.topic[i] == '%' && i + 1 < topicRoute.topic.length() && topicRoute.topic[i + 1] == 'o') {
+                    topicName.append(owner);
+                    ++i;
+                } else if (topicRoute.topic[i] == '%' && i + 1 < topicRoute.topic.length() && topicRoute.topic[i + 1] == 't') {
+                    topicName.append(table);
+                    ++i;
+                } else
+                    topicName.push_back(topicRoute.topic[i]);
+            }
+            break;
+        }
+
+        rd_kafka_topic_t* tableRkt;
+        auto topicHandlesIt = topicHandles.find(topicName);
+        if (topicHandlesIt != topicHandles.end())
+            tableRkt = topicHandlesIt->second;
+        else {
+            tableRkt = rd_kafka_topic_new(rk, topicName.c_str(), nullptr);
+            if (tableRkt == nullptr)
+                throw RuntimeException(10069, "Kafka failed to create topic: " + topicName + ", message: " +
+                                       rd_kafka_err2str(rd_kafka_last_error()));
+            topicHandles.insert_or_assign(topicName, tableRkt);
+            ctx->info(0, "Kafka: sending " + owner + "." + table + " to topic: " + topicName);
+        }
+
+        tableTopics.insert_or_assign(tableTag, tableRkt);
+        return tableRkt;
+    }
+
+    void WriterKafka::sendMessage(BuilderMsg* msg, const struct iovec* msgSegments, uint64_t msgSegmentsCount) {
+        void* value = msgSegments[0].iov_base;
+        uint64_t length = msg->length - msg->tagSize;
+
+        // Tag: owner, table name and optional key separated with zero bytes
+        rd_kafka_topic_t* msgRkt = rkt;
+        const char* msgKey = nullptr;
+        uint64_t msgKeyLength = 0;
+        if (msg->tagSize > 0) {
+            uint64_t tableEnd = tag.find('\0', tag.find('\0') + 1);
+            if (tableEnd != std::string::npos) {
+                if (!topicRoutes.empty())
+                    msgRkt = getTopic(tag.substr(0, tableEnd));
+                if (tableEnd + 1 < tag.length()) {
+                    msgKey = tag.c_str() + tableEnd + 1;
+                    msgKeyLength = tag.length() - tableEnd - 1;
+                }
+            }
+        }
 
-            if (err) {
-                ctx->warning(60031, "failed to produce to topic " + topic + ", message: " + rd_kafka_err2str(err));
+        // Kafka message value must be continuous - gather parts to a temporary buffer, released on confirmation
+        if (msgSegmentsCount > 1) {
+            uint8_t* buffer = allocateMessage(msg, length);
+            uint64_t copied = 0;
+            for (uint64_t i = 0; i < msgSegmentsCount; ++i) {
+                memcpy(reinterpret_cast<void*>(buffer + copied), msgSegments[i].iov_base, msgSegments[i].iov_len);
+                copied += msgSegments[i].iov_len;
+            }
+            value = buffer;
+        }
 
-                if (err == RD_KAFKA_RESP_ERR__QUEUE_FULL) {
-                    ctx->warning(60031, "queue, full, sleeping " + std::to_string(ctx->pollIntervalUs / 1000) + " ms, then retrying");
-                    rd_kafka_poll(rk, static_cast<int>((ctx->pollIntervalUs / 1000)));
+        // Messages are produced in batches for a single topic
+        if (batchRkt != msgRkt) {
+            produceBatch();
+            batchRkt = msgRkt;
+        }
+
+        rd_kafka_message_t rkMessage;
+        memset(reinterpret_cast<void*>(&rkMessage), 0, sizeof(rkMessage));
+        rkMessage.payload = value;
+        rkMessage.len = length;
+        rkMessage.key_len = msgKeyLength;
+        rkMessage._private = msg;
+        batchMessages.push_back(rkMessage);
+        // Key pointers are set just before producing since the key buffer may be reallocated
+        batchKeyOffsets.push_back(batchKeys.length());
+        if (msgKeyLength > 0)
+            batchKeys.append(msgKey, msgKeyLength);
+
+        if (batchMessages.size() >= batchSize)
+            produceBatch();
+    }
+
+    void WriterKafka::produceBatch() {
+        if (batchMessages.empty())
+            return;
+
+        for (uint64_t i = 0; i < batchMessages.size(); ++i)
+            if (batchMessages[i].key_len > 0)
+                batchMessages[i].key = const_cast<char*>(batchKeys.c_str()) + batchKeyOffsets[i];
+
+        // Payload is not copied, builder buffers are kept until delivery is confirmed.
+        // A full producer queue blocks the call until the delivery thread drains it, so messages are never accepted out of order.
+        int produced = rd_kafka_produce_batch(batchRkt, RD_KAFKA_PARTITION_UA, RD_KAFKA_MSG_F_BLOCK, batchMessages.data(),
+                                              static_cast<int>(batchMessages.size()));
+        if (static_cast<uint64_t>(produced) != batchMessages.size()) {
+            for (uint64_t i = 0; i < batchMessages.size(); ++i) {
+                if (batchMessages[i].err == RD_KAFKA_RESP_ERR_NO_ERROR)
                     continue;
-                } else
-                    break;
-            } else
-                break;
+
+                auto msg = reinterpret_cast<BuilderMsg*>(batchMessages[i]._private);
+                throw RuntimeException(10077, "Kafka: failed to produce to topic: " + std::string(rd_kafka_topic_name(batchRkt)) +
+                                       ", message: " + std::to_string(msg->id) + ", error: " + rd_kafka_err2str(batchMessages[i].err));
+            }
         }
 
-        rd_kafka_poll(rk, 0);
+        batchMessages.clear();
+        batchKeyOffsets.clear();
+        batchKeys.clear();
     }
 
     std::string WriterKafka::getName() const {
@@ -153,7 +354,9 @@ namespace OpenLogReplicator {
         if (metadata->status == METADATA_STATUS_READY)
             metadata->setStatusStart();
 
-        if (currentQueueSize > 0)
-            rd_kafka_poll(rk, 0);
+    }
+
+    void WriterKafka::flush() {
+        produceBatch();
     }
 }
@@ -20,37 +20,80 @@ along with OpenLogReplicator; see the file LICENSE;  If not see
 #include <librdkafka/rdkafka.h>
 
 #include <map>
+#include <unordered_map>
+#include <vector>
+
 #include "Writer.h"
 
 #ifndef WRITER_KAFKA_H_
 #define WRITER_KAFKA_H_
 
 #define MAX_KAFKA_MESSAGE_MB        953
+#define KAFKA_KEY_NONE              0
+#define KAFKA_KEY_PRIMARY_KEY       1
+#define KAFKA_BATCH_SIZE_DEFAULT    1000
+#define KAFKA_BATCH_SIZE_MAX        1000000
 
 namespace OpenLogReplicator {
+    struct KafkaTopicRoute {
+        std::string owner;
+        std::string table;
+        std::string topic;
+    };
+
+    class WriterKafka;
+
+    class WriterKafkaDelivery final : public Thread {
+    protected:
+        WriterKafka* writer;
+
+        void run() override;
+
+    public:
+        WriterKafkaDelivery(Ctx* newCtx, const std::string& newAlias, WriterKafka* newWriter);
+    };
+
     class WriterKafka final : public Writer {
     protected:
         std::string topic;
+        uint64_t key;
+        uint64_t batchSize;
+        // Messages waiting for rd_kafka_produce_batch(), all for the same topic
+        std::vector<rd_kafka_message_t> batchMessages;
+        std::vector<uint64_t> batchKeyOffsets;
+        std::string batchKeys;
+        rd_kafka_topic_t* batchRkt;
+        WriterKafkaDelivery* delivery;
+        rd_kafka_queue_t* eventQueue;
+        std::vector<KafkaTopicRoute> topicRoutes;
+        // Topic handles by name and by owner/table tag
+        std::unordered_map<std::string, rd_kafka_topic_t*> topicHandles;
+        std::unordered_map<std::string, rd_kafka_topic_t*> tableTopics;
         char errStr[512];
         std::map<std::string, std::string> properties;
         rd_kafka_t* rk;
         rd_kafka_topic_t* rkt;
         rd_kafka_conf_t* conf;
-        static void dr_msg_cb(rd_kafka_t* rkCb, const rd_kafka_message_t* rkMessage, void* opaque);
-        static void error_cb(rd_kafka_t* rkCb, int err, const char* reason, void* opaque);
         static void logger_cb(const rd_kafka_t* rkCb, int level, const char* fac, const char* buf);
 
-        void sendMessage(BuilderMsg* msg) override;
+        rd_kafka_topic_t* getTopic(const std::string& tableTag);
+        void produceBatch();
+        void run() override;
+        void sendMessage(BuilderMsg* msg, const struct iovec* msgSegments, uint64_t msgSegmentsCount) override;
         std::string getName() const override;
         void pollQueue() override;
+        void flush() override;
 
     public:
         WriterKafka(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata,
-                    const char* newTopic);
+                    const char* newTopic, uint64_t newKey, uint64_t newBatchSize);
         ~WriterKafka() override;
 
-        void addProperty(const std::string& key, const std::string& value);
+        void addProperty(const std::string& propertyKey, const std::string& value);
+        void addTopicRoute(const std::string& owner, const std::string& table, const std::string& routeTopic);
         void initialize() override;
+        void pollEvents();
+        void purgeQueue();
     };
 }
 
@@ -0,0 +1,305 @@
+/* Thread writing to shared memory ring
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../builder/Builder.h"
+#include "../common/RuntimeException.h"
+#include "../metadata/Metadata.h"
+#include "../stream/ShmRing.h"
+#include "WriterShm.h"
+
+namespace OpenLogReplicator {
+    WriterShm::WriterShm(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata,
+                         const char* newName, uint64_t newSizeMb, bool newDiscard) :
+        Writer(newCtx, newAlias, newDatabase, newBuilder, newMetadata),
+        name(newName),
+        dataSize(newSizeMb * 1024 * 1024),
+        discard(newDiscard),
+        fd(-1),
+        segmentSize(0),
+        header(nullptr),
+        data(nullptr),
+        limitPos(0) {
+    }
+
+    WriterShm::~WriterShm() {
+        // The segment is kept, consumers continue after the next start
+        if (header != nullptr) {
+            builder->setWriterNotify(builderWriterId, nullptr);
+            munmap(reinterpret_cast<void*>(header), segmentSize);
+            header = nullptr;
+            data = nullptr;
+        }
+
+        if (fd != -1) {
+            close(fd);
+            fd = -1;
+        }
+    }
+
+    void WriterShm::closeSegment(uint64_t oldSize) {
+        // Consumers attached to a segment of different size or version attach again to the new one
+        if (oldSize >= sizeof(struct ShmHeader)) {
+            void* segment = mmap(nullptr, oldSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (segment != MAP_FAILED) {
+                auto oldHeader = reinterpret_cast<ShmHeader*>(segment);
+                if (oldHeader->magic == SHM_MAGIC && oldHeader->version == SHM_VERSION) {
+                    oldHeader->generation.store(SHM_GENERATION_CLOSED, std::memory_order_release);
+                    ++oldHeader->writeSeq;
+                    ShmRing::wake(&oldHeader->writeSeq);
+                }
+                munmap(segment, oldSize);
+            }
+        }
+
+        close(fd);
+        fd = -1;
+        shm_unlink(name.c_str());
+    }
+
+    void WriterShm::initialize() {
+        Writer::initialize();
+
+        segmentSize = ShmRing::segmentSize(dataSize);
+        fd = shm_open(name.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
+        if (fd == -1)
+            throw RuntimeException(10070, "shared memory: " + name + " - open returned: " + strerror(errno));
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0)
+            throw RuntimeException(10003, "file: " + name + " - stat returned: " + strerror(errno));
+        uint64_t oldSize = fileStat.st_size;
+
+        if (oldSize != 0 && oldSize != segmentSize) {
+            closeSegment(oldSize);
+            oldSize = 0;
+            fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
+            if (fd == -1)
+                throw RuntimeException(10070, "shared memory: " + name + " - open returned: " + strerror(errno));
+        }
+
+        if (oldSize == 0 && ftruncate(fd, static_cast<off_t>(segmentSize)) != 0)
+            throw RuntimeException(10071, "shared memory: " + name + " - truncate to " + std::to_string(segmentSize) + " bytes returned: " +
+                                   strerror(errno));
+
+        void* segment = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (segment == MAP_FAILED)
+            throw RuntimeException(10072, "shared memory: " + name + " - mmap returned: " + strerror(errno));
+        header = reinterpret_cast<ShmHeader*>(segment);
+
+        if (oldSize != 0 && header->magic == SHM_MAGIC && header->version == SHM_VERSION && header->dataSize == dataSize) {
+            // Segment from the previous run is reused, so attached consumers keep working. Data not confirmed by all consumers
+            // is sent again from the checkpoint, the consumers start reading from the current position of the new generation.
+            // Their confirmed positions are kept until they switch to it, so records they still read are not overwritten.
+            uint64_t writePos = header->writePos.load(std::memory_order_acquire);
+            header->tailPos.store(writePos);
+            for (ShmConsumerSlot& slot : header->consumers) {
+                uint64_t pid = slot.pid.load(std::memory_order_acquire);
+                if (pid != 0 && kill(static_cast<pid_t>(pid), 0) != 0 && errno == ESRCH)
+                    slot.pid.compare_exchange_strong(pid, 0);
+            }
+            uint64_t generation = header->generation.load(std::memory_order_relaxed) + 1;
+            if (generation == SHM_GENERATION_CLOSED)
+                generation = 0;
+            header->generation.store(generation, std::memory_order_release);
+            data = reinterpret_cast<uint8_t*>(segment) + header->dataOffset;
+            ctx->info(0, "shared memory: " + name + " - reusing segment, generation: " + std::to_string(generation));
+
+            ++header->writeSeq;
+            ShmRing::wake(&header->writeSeq);
+        } else {
+            // New segment is filled with zeros, content of an incompatible one is cleared
+            if (oldSize != 0)
+                memset(segment, 0, sizeof(struct ShmHeader));
+            header->dataSize = dataSize;
+            header->dataOffset = segmentSize - dataSize;
+            data = reinterpret_cast<uint8_t*>(segment) + header->dataOffset;
+            header->version = SHM_VERSION;
+            // Consumers verify magic last
+            std::atomic_thread_fence(std::memory_order_release);
+            header->magic = SHM_MAGIC;
+        }
+
+        messageEnds.resize(ctx->queueSize, 0);
+        limitPos = confirmedPos(false);
+        streaming = true;
+        builder->setWriterNotify(builderWriterId, this);
+    }
+
+    std::string WriterShm::getName() const {
+        return "Shm:" + name;
+    }
+
+    uint64_t WriterShm::confirmedPos(bool checkConsumers) {
+        uint64_t minPos = header->writePos;
+        bool found = false;
+
+        for (ShmConsumerSlot& slot : header->consumers) {
+            uint64_t pid = slot.pid.load(std::memory_order_acquire);
+            if (pid == 0)
+                continue;
+
+            // Consumer process terminated without detaching
+            if (checkConsumers && kill(static_cast<pid_t>(pid), 0) != 0 && errno == ESRCH) {
+                ctx->warning(60037, "shared memory: " + name + " - consumer with pid: " + std::to_string(pid) + " is gone, releasing");
+                slot.pid.compare_exchange_strong(pid, 0);
+                continue;
+            }
+
+            uint64_t pos = slot.confirmedPos.load(std::memory_order_acquire);
+            if (pos < minPos)
+                minPos = pos;
+            found = true;
+        }
+
+        // Without consumers the data is kept for the next one, unless configured to be dropped
+        uint64_t tailPos = header->tailPos;
+        if (!found && !discard) {
+            limitPos = tailPos;
+            return limitPos;
+        }
+
+        if (minPos > tailPos && header->tailPos.compare_exchange_strong(tailPos, minPos))
+            tailPos = minPos;
+
+        // A consumer attaching during the scan may start from the old tail: it stores its position before checking the tail again,
+        // so either the consumer sees the new tail or the position is found here and nothing before it is overwritten
+        limitPos = tailPos;
+        for (ShmConsumerSlot& slot : header->consumers) {
+            if (slot.pid == 0)
+                continue;
+            uint64_t pos = slot.confirmedPos;
+            if (pos < limitPos)
+                limitPos = pos;
+        }
+        return limitPos;
+    }
+
+    void WriterShm::sendMessage(BuilderMsg* msg, const struct iovec* msgSegments, uint64_t msgSegmentsCount) {
+        uint64_t length = msg->length - msg->tagSize;
+        uint64_t recordSize = sizeof(struct ShmRecord) + ((length + 7) & 0xFFFFFFFFFFFFFFF8);
+        if (recordSize > dataSize)
+            throw RuntimeException(10073, "shared memory: " + name + " - message size: " + std::to_string(length) +
+                                   " exceeds ring size: " + std::to_string(dataSize));
+
+        uint64_t writePos = header->writePos.load(std::memory_order_relaxed);
+        uint64_t offset = writePos % dataSize;
+        uint64_t skip = 0;
+        if (offset + recordSize > dataSize)
+            skip = dataSize - offset;
+
+        // Wait until consumers confirm enough data
+        uint64_t tailPos = limitPos;
+        while (writePos + skip + recordSize - tailPos > dataSize && !ctx->hardShutdown) {
+            uint32_t confirmSeq = header->confirmSeq.load(std::memory_order_acquire);
+            tailPos = confirmedPos(true);
+            if (writePos + skip + recordSize - tailPos <= dataSize)
+                break;
+
+            if (ctx->trace & TRACE_WRITER)
+                ctx->logTrace(TRACE_WRITER, "shared memory ring is full, waiting for consumers");
+            ++header->confirmWaiters;
+            ShmRing::wait(&header->confirmSeq, confirmSeq, ctx->pollIntervalUs);
+            --header->confirmWaiters;
+            pollQueue();
+        }
+        if (ctx->hardShutdown)
+            return;
+
+        if (skip > 0) {
+            *reinterpret_cast<uint64_t*>(data + offset) = SHM_RECORD_WRAP;
+            writePos += skip;
+            offset = 0;
+        }
+
+        auto record = reinterpret_cast<ShmRecord*>(data + offset);
+        record->length = length;
+        record->scn = msg->lwnScn;
+        record->idx = msg->lwnIdx;
+        uint8_t* payload = data + offset + sizeof(struct ShmRecord);
+        for (uint64_t i = 0; i < msgSegmentsCount; ++i) {
+            memcpy(reinterpret_cast<void*>(payload), msgSegments[i].iov_base, msgSegments[i].iov_len);
+            payload += msgSegments[i].iov_len;
+        }
+
+        writePos += recordSize;
+        messageEnds[msg->id % ctx->queueSize] = writePos;
+        header->writePos.store(writePos, std::memory_order_release);
+        ++header->writeSeq;
+        if (header->writeWaiters > 0)
+            ShmRing::wake(&header->writeSeq);
+    }
+
+    // Consumers wake up the writer with a futex when they confirm data
+    void WriterShm::waitForQueue() {
+        if (currentQueueSize == 0)
+            return;
+
+        uint32_t confirmSeq = header->confirmSeq.load(std::memory_order_acquire);
+        BuilderMsg* msg = queue[queueFirstId % ctx->queueSize];
+        if (messageEnds[msg->id % ctx->queueSize] <= confirmedPos(false))
+            return;
+
+        ++header->confirmWaiters;
+        ShmRing::wait(&header->confirmSeq, confirmSeq, ctx->pollIntervalUs);
+        --header->confirmWaiters;
+    }
+
+    // Confirmations of consumers and new data from the builder both change the confirm futex word.
+    // The word is read before checking the builder, so a notification sent in between ends the wait at once.
+    void WriterShm::waitForWork() {
+        uint32_t confirmSeq = header->confirmSeq.load(std::memory_order_acquire);
+        if (builder->checkWriterWork(builderWorkSeq))
+            return;
+
+        ++header->confirmWaiters;
+        ShmRing::wait(&header->confirmSeq, confirmSeq, idleWaitUs());
+        --header->confirmWaiters;
+    }
+
+    void WriterShm::notifyWork() {
+        ++header->confirmSeq;
+        if (header->confirmWaiters > 0)
+            ShmRing::wake(&header->confirmSeq);
+    }
+
+    void WriterShm::pollQueue() {
+        if (metadata->status == METADATA_STATUS_READY)
+            metadata->setStatusStart();
+
+        if (currentQueueSize == 0)
+            return;
+
+        // Messages are confirmed when all consumers confirmed them
+        uint64_t pos = confirmedPos(false);
+        while (currentQueueSize > 0) {
+            BuilderMsg* msg = queue[queueFirstId % ctx->queueSize];
+            if (messageEnds[msg->id % ctx->queueSize] > pos)
+                break;
+            confirmMessage(msg);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/* Header for WriterShm class
+   Copyright (C) 2018-2023 Adam Leszczynski (aleszczynski@bersler.com)
+
+This file is part of OpenLogReplicator.
+
+OpenLogReplicator is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 3, or (at your option)
+any later version.
+
+OpenLogReplicator is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenLogReplicator; see the file LICENSE;  If not see
+<http://www.gnu.org/licenses/>.  */
+
+#include <vector>
+
+#include "Writer.h"
+
+#ifndef WRITER_SHM_H_
+#define WRITER_SHM_H_
+
+namespace OpenLogReplicator {
+    struct ShmHeader;
+
+    class WriterShm final : public Writer {
+    protected:
+        std::string name;
+        uint64_t dataSize;
+        bool discard;
+        int fd;
+        uint64_t segmentSize;
+        ShmHeader* header;
+        uint8_t* data;
+        // Ring data before this position may be overwritten, the tail or an older position of a consumer
+        uint64_t limitPos;
+        // Position in the ring after every sent message, indexed by message id
+        std::vector<uint64_t> messageEnds;
+
+        void closeSegment(uint64_t oldSize);
+        uint64_t confirmedPos(bool checkConsumers);
+        void sendMessage(BuilderMsg* msg, const struct iovec* msgSegments, uint64_t msgSegmentsCount) override;
+        std::string getName() const override;
+        void pollQueue() override;
+        void waitForQueue() override;
+        void waitForWork() override;
+
+    public:
+        WriterShm(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata,
+                  const char* newName, uint64_t newSizeMb, bool newDiscard);
+        ~WriterShm() override;
+
+        void initialize() override;
+        void notifyWork() override;
+    };
+}
+
+#endif
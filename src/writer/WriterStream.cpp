@@ -17,10 +17,14 @@ You should have received a copy of the GNU General Public License
 along with OpenLogReplicator; see the file LICENSE;  If not see
 <http://www.gnu.org/licenses/>.  */
 
+#include <cerrno>
+#include <cstring>
+#include <sys/eventfd.h>
 #include <unistd.h>
 
 #include "../builder/Builder.h"
 #include "../common/NetworkException.h"
+#include "../common/RuntimeException.h"
 #include "../common/OraProtoBuf.pb.h"
 #include "../metadata/Metadata.h"
 #include "../stream/Stream.h"
@@ -30,11 +34,20 @@ namespace OpenLogReplicator {
     WriterStream::WriterStream(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata,
                                Stream* newStream) :
         Writer(newCtx, newAlias, newDatabase, newBuilder, newMetadata),
-        stream(newStream) {
+        stream(newStream),
+        window(0),
+        unconfirmedBytes(0),
+        workFD(-1) {
         metadata->bootFailsafe = true;
     }
 
     WriterStream::~WriterStream() {
+        if (workFD != -1) {
+            builder->setWriterNotify(builderWriterId, nullptr);
+            close(workFD);
+            workFD = -1;
+        }
+
         if (stream != nullptr) {
             delete stream;
             stream = nullptr;
@@ -45,6 +58,11 @@ namespace OpenLogReplicator {
         Writer::initialize();
 
         stream->initializeServer();
+
+        workFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (workFD == -1)
+            throw RuntimeException(10080, "eventfd returned: " + std::string(strerror(errno)));
+        builder->setWriterNotify(builderWriterId, this);
     }
 
     std::string WriterStream::getName() const {
@@ -61,6 +79,7 @@ namespace OpenLogReplicator {
 
         if (metadata->status == METADATA_STATUS_READY) {
             ctx->logTrace(TRACE_WRITER, "info, ready");
+            processWindow();
             response.set_code(pb::ResponseCode::READY);
             return;
         }
@@ -71,6 +90,7 @@ namespace OpenLogReplicator {
         }
 
         ctx->logTrace(TRACE_WRITER, "info, first scn: " + std::to_string(metadata->firstDataScn));
+        processWindow();
         response.set_code(pb::ResponseCode::REPLICATE);
         response.set_scn(metadata->firstDataScn);
         response.set_c_scn(confirmedScn);
@@ -135,11 +155,17 @@ namespace OpenLogReplicator {
                 response.set_code(pb::ResponseCode::INVALID_COMMAND);
                 return;
         }
+        // The client has no position yet, all its data is new
+        clientScn = ZERO_SCN;
+        clientIdx = 0;
+        metadata->setWriterClient(metadataWriterId, clientScn, clientIdx);
         metadata->setStatusStart();
 
         metadata->waitForReplicator();
 
         if (metadata->status == METADATA_STATUS_REPLICATE) {
+            processWindow();
+            unconfirmedBytes = 0;
             response.set_code(pb::ResponseCode::REPLICATE);
             response.set_scn(metadata->firstDataScn);
             response.set_c_scn(confirmedScn);
@@ -162,21 +188,24 @@ namespace OpenLogReplicator {
         }
 
         // default values
-        metadata->clientScn = confirmedScn;
-        metadata->clientIdx = confirmedIdx;
+        clientScn = confirmedScn;
+        clientIdx = confirmedIdx;
         std::string paramIdx;
 
         // 0 means continue with last value
         if (request.has_c_scn() && request.c_scn() != 0) {
-            metadata->clientScn = request.c_scn();
+            clientScn = request.c_scn();
 
             if (request.has_c_idx())
-                metadata->clientIdx = request.c_idx();
-            paramIdx = ", idx: " + std::to_string(metadata->clientIdx);
+                clientIdx = request.c_idx();
+            paramIdx = ", idx: " + std::to_string(clientIdx);
         }
-        ctx->info(0, "client requested scn: " + std::to_string(metadata->clientScn) + paramIdx);
+        metadata->setWriterClient(metadataWriterId, clientScn, clientIdx);
+        ctx->info(0, "client requested scn: " + std::to_string(clientScn) + paramIdx);
 
         resetMessageQueue();
+        processWindow();
+        unconfirmedBytes = 0;
         response.set_code(pb::ResponseCode::REPLICATE);
         ctx->info(0, "streaming to client");
         streaming = true;
@@ -188,8 +217,29 @@ namespace OpenLogReplicator {
             return;
         }
 
-        while (currentQueueSize > 0 && (queue[0]->lwnScn < request.c_scn() || (queue[0]->lwnScn == request.c_scn() && queue[0]->lwnIdx <= request.c_idx())))
-            confirmMessage(queue[0]);
+        while (currentQueueSize > 0) {
+            BuilderMsg* msg = queue[queueFirstId % ctx->queueSize];
+            if (msg->lwnScn > request.c_scn() || (msg->lwnScn == request.c_scn() && msg->lwnIdx > request.c_idx()))
+                break;
+            if (unconfirmedBytes > msg->length - msg->tagSize)
+                unconfirmedBytes -= msg->length - msg->tagSize;
+            else
+                unconfirmedBytes = 0;
+            confirmMessage(msg);
+        }
+    }
+
+    void WriterStream::processWindow() {
+        // Clients not aware of the window get messages one by one
+        if (!request.has_window()) {
+            window = 0;
+            return;
+        }
+
+        window = request.window();
+        response.set_window(window);
+        if (ctx->trace & TRACE_WRITER)
+            ctx->logTrace(TRACE_WRITER, "client window: " + std::to_string(window) + " bytes");
     }
 
     void WriterStream::pollQueue() {
@@ -200,75 +250,125 @@ namespace OpenLogReplicator {
         uint8_t msgR[READ_NETWORK_BUFFER];
         std::string msgS;
 
-        uint64_t length = stream->receiveMessageNB(msgR, READ_NETWORK_BUFFER);
-
-        if (length > 0) {
-            request.Clear();
-            if (request.ParseFromArray(msgR, static_cast<int>(length))) {
-                if (streaming) {
-                    switch (request.code()) {
-                        case pb::RequestCode::INFO:
-                            processInfo();
-                            response.SerializeToString(&msgS);
-                            stream->sendMessage(msgS.c_str(), msgS.length());
-                            streaming = false;
-                            break;
-
-                        case pb::RequestCode::CONFIRM:
-                            processConfirm();
-                            break;
-
-                        default:
-                            ctx->warning(60032, "unknown request code: " + request.code());
-                            response.Clear();
-                            response.set_code(pb::ResponseCode::INVALID_COMMAND);
-                            response.SerializeToString(&msgS);
-                            stream->sendMessage(msgS.c_str(), msgS.length());
-                            break;
+        // Process all pending requests, confirmations are cumulative
+        for (;;) {
+            uint64_t length = stream->receiveMessageNB(msgR, READ_NETWORK_BUFFER);
+
+            if (length > 0) {
+                request.Clear();
+                if (request.ParseFromArray(msgR, static_cast<int>(length))) {
+                    if (streaming) {
+                        switch (request.code()) {
+                            case pb::RequestCode::INFO:
+                                processInfo();
+                                response.SerializeToString(&msgS);
+                                stream->sendMessage(msgS.c_str(), msgS.length());
+                                streaming = false;
+                                break;
+
+                            case pb::RequestCode::CONFIRM:
+                                processConfirm();
+                                break;
+
+                            default:
+                                ctx->warning(60032, "unknown request code: " + request.code());
+                                response.Clear();
+                                response.set_code(pb::ResponseCode::INVALID_COMMAND);
+                                response.SerializeToString(&msgS);
+                                stream->sendMessage(msgS.c_str(), msgS.length());
+                                break;
+                        }
+                    } else {
+                        switch (request.code()) {
+                            case pb::RequestCode::INFO:
+                                processInfo();
+                                response.SerializeToString(&msgS);
+                                stream->sendMessage(msgS.c_str(), msgS.length());
+                                break;
+
+                            case pb::RequestCode::START:
+                                processStart();
+                                response.SerializeToString(&msgS);
+                                stream->sendMessage(msgS.c_str(), msgS.length());
+                                break;
+
+                            case pb::RequestCode::CONTINUE:
+                                processContinue();
+                                response.SerializeToString(&msgS);
+                                stream->sendMessage(msgS.c_str(), msgS.length());
+                                break;
+
+                            default:
+                                ctx->warning(60032, "unknown request code: " + request.code());
+                                response.Clear();
+                                response.set_code(pb::ResponseCode::INVALID_COMMAND);
+                                response.SerializeToString(&msgS);
+                                stream->sendMessage(msgS.c_str(), msgS.length());
+                                break;
+                        }
                     }
                 } else {
-                    switch (request.code()) {
-                        case pb::RequestCode::INFO:
-                            processInfo();
-                            response.SerializeToString(&msgS);
-                            stream->sendMessage(msgS.c_str(), msgS.length());
-                            break;
-
-                        case pb::RequestCode::START:
-                            processStart();
-                            response.SerializeToString(&msgS);
-                            stream->sendMessage(msgS.c_str(), msgS.length());
-                            break;
-
-                        case pb::RequestCode::CONTINUE:
-                            processContinue();
-                            response.SerializeToString(&msgS);
-                            stream->sendMessage(msgS.c_str(), msgS.length());
-                            break;
-
-                        default:
-                            ctx->warning(60032, "unknown request code: " + request.code());
-                            response.Clear();
-                            response.set_code(pb::ResponseCode::INVALID_COMMAND);
-                            response.SerializeToString(&msgS);
-                            stream->sendMessage(msgS.c_str(), msgS.length());
-                            break;
-                    }
+                    std::ostringstream ss;
+                    ss << "request decoder[" << std::dec << length << "]: ";
+                    for (uint64_t i = 0; i < static_cast<uint64_t>(length); ++i)
+                        ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<uint64_t>(msgR[i]) << " ";
+                    ctx->warning(60033, ss.str());
                 }
-            } else {
-                std::ostringstream ss;
-                ss << "request decoder[" << std::dec << length << "]: ";
-                for (uint64_t i = 0; i < static_cast<uint64_t>(length); ++i)
-                    ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<uint64_t>(msgR[i]) << " ";
-                ctx->warning(60033, ss.str());
-            }
-        } else if (length == 0) {
-            // No request
-        } else if (errno != EAGAIN)
-            throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " + strerror(errno));
+            } else if (length == 0) {
+                // No request
+                break;
+            } else if (errno != EAGAIN)
+                throw NetworkException(10061, "network error, errno: " + std::to_string(errno) + ", message: " + strerror(errno));
+        }
+    }
+
+    void WriterStream::sendMessage(BuilderMsg* msg, const struct iovec* msgSegments, uint64_t msgSegmentsCount) {
+        uint64_t length = msg->length - msg->tagSize;
+
+        // Message memory is kept until confirmation, the stream may send it without copying
+        if (window == 0) {
+            stream->queueMessage(msgSegments, msgSegmentsCount, length);
+            stream->flush();
+            return;
+        }
+
+        // Wait for confirmations when the window is exhausted, the last message may exceed the window
+        while (unconfirmedBytes >= window && streaming && !ctx->hardShutdown) {
+            stream->flush();
+            if (ctx->trace & TRACE_WRITER)
+                ctx->logTrace(TRACE_WRITER, "client window is full (" + std::to_string(unconfirmedBytes) + " bytes), waiting");
+            stream->waitForMessage(ctx->pollIntervalUs, -1);
+            pollQueue();
+        }
+
+        stream->queueMessage(msgSegments, msgSegmentsCount, length);
+        unconfirmedBytes += length;
+    }
+
+    // Connection of a new client and requests of the client wake up the writer
+    void WriterStream::waitForClient() {
+        stream->waitForMessage(ctx->pollIntervalUs, -1);
+    }
+
+    // Confirmations are received by the writer thread
+    void WriterStream::waitForQueue() {
+        stream->waitForMessage(ctx->pollIntervalUs, -1);
+    }
+
+    // Requests and confirmations of the client wake up the writer as well as new data from the builder
+    void WriterStream::waitForWork() {
+        stream->waitForMessage(idleWaitUs(), workFD);
+
+        uint64_t value;
+        if (read(workFD, &value, sizeof(value)) == -1 && errno != EAGAIN)
+            throw RuntimeException(10080, "eventfd returned: " + std::string(strerror(errno)));
+    }
+
+    void WriterStream::notifyWork() {
+        eventfd_write(workFD, 1);
     }
 
-    void WriterStream::sendMessage(BuilderMsg* msg) {
-        stream->sendMessage(msg->data, msg->length);
+    void WriterStream::flush() {
+        stream->flush();
     }
 }
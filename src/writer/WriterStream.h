@@ -29,6 +29,11 @@ namespace OpenLogReplicator {
     class WriterStream final : public Writer {
     protected:
         Stream* stream;
+        // Credit window negotiated with the client: maximum bytes sent and not confirmed, 0 - messages sent one by one
+        uint64_t window;
+        uint64_t unconfirmedBytes;
+        // Signalled by the builder on new data, so the writer waits for the client and the builder at once
+        int workFD;
         pb::RedoRequest request;
         pb::RedoResponse response;
 
@@ -37,14 +42,20 @@ namespace OpenLogReplicator {
         void processStart();
         void processContinue();
         void processConfirm();
+        void processWindow();
         void pollQueue() override;
-        void sendMessage(BuilderMsg* msg) override;
+        void sendMessage(BuilderMsg* msg, const struct iovec* msgSegments, uint64_t msgSegmentsCount) override;
+        void flush() override;
+        void waitForClient() override;
+        void waitForQueue() override;
+        void waitForWork() override;
 
     public:
         WriterStream(Ctx* newCtx, const std::string& newAlias, const std::string& newDatabase, Builder* newBuilder, Metadata* newMetadata, Stream* newStream);
         ~WriterStream() override;
 
         void initialize() override;
+        void notifyWork() override;
     };
 }
 